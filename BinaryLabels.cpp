@@ -0,0 +1,115 @@
+#include "BinaryLabels.h"
+#include <stdio.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+bool writeBinaryLabels(const std::string& filename, const BinaryLabelHeader& header, const std::vector<BinaryLabelRecord>& records) {
+    FILE* f = fopen(filename.c_str(), "wb");
+    if (!f) return false;
+    bool ok = fwrite(&header, sizeof(header), 1, f) == 1;
+    if (ok && !records.empty()) {
+        ok = fwrite(records.data(), sizeof(BinaryLabelRecord), records.size(), f) == records.size();
+    }
+    fclose(f);
+    return ok;
+}
+
+BinaryLabelFile::~BinaryLabelFile() {
+    close();
+}
+
+const BinaryLabelRecord* BinaryLabelFile::record(uint32_t k) const {
+    if (!m_pHeader || k >= m_pHeader->count) return NULL;
+    if (!m_upgraded.empty()) return &m_upgraded[k];
+    return (const BinaryLabelRecord*)(m_pData + sizeof(BinaryLabelHeader) + (size_t)k * m_pHeader->recordSize);
+}
+
+#ifdef _WIN32
+bool BinaryLabelFile::mapFile(const std::string& filename) {
+    HANDLE hFile = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (hFile == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(hFile, &size) || size.QuadPart == 0) {
+        CloseHandle(hFile);
+        return false;
+    }
+    HANDLE hMap = CreateFileMappingA(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (hMap == NULL) {
+        CloseHandle(hFile);
+        return false;
+    }
+    m_pData = (const uint8_t*)MapViewOfFile(hMap, FILE_MAP_READ, 0, 0, 0);
+    m_hFile = hFile;
+    m_hMap = hMap;
+    m_size = (size_t)size.QuadPart;
+    return m_pData != NULL;
+}
+#else
+bool BinaryLabelFile::mapFile(const std::string& filename) {
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        ::close(fd);
+        return false;
+    }
+    void* p = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    m_fd = fd;
+    m_size = (size_t)st.st_size;
+    m_pData = p == MAP_FAILED ? NULL : (const uint8_t*)p;
+    return m_pData != NULL;
+}
+#endif
+
+bool BinaryLabelFile::open(const std::string& filename) {
+    close();
+    if (!mapFile(filename)) {
+        close();
+        return false;
+    }
+
+    //Validate before exposing records. Older versions are read, their records are a prefix of the current one.
+    const BinaryLabelHeader* header = (const BinaryLabelHeader*)m_pData;
+    if (m_size < sizeof(BinaryLabelHeader) || header->magic != BINARY_LABEL_MAGIC ||
+        header->version == 0 || header->version > BINARY_LABEL_VERSION || header->recordSize < BINARY_LABEL_V1_RECORD_SIZE ||
+        m_size < sizeof(BinaryLabelHeader) + (size_t)header->count * header->recordSize) {
+        close();
+        return false;
+    }
+
+    if (header->recordSize < sizeof(BinaryLabelRecord)) {
+        m_upgraded.assign(header->count, BinaryLabelRecord());
+        const uint8_t* src = m_pData + sizeof(BinaryLabelHeader);
+        for (uint32_t k = 0; k < header->count; ++k) {
+            memcpy(&m_upgraded[k], src + (size_t)k * header->recordSize, header->recordSize);
+        }
+    }
+    m_pHeader = header;
+    return true;
+}
+
+void BinaryLabelFile::close() {
+#ifdef _WIN32
+    if (m_pData) UnmapViewOfFile(m_pData);
+    if (m_hMap) CloseHandle((HANDLE)m_hMap);
+    if (m_hFile) CloseHandle((HANDLE)m_hFile);
+    m_hMap = NULL;
+    m_hFile = NULL;
+#else
+    if (m_pData) munmap((void*)m_pData, m_size);
+    if (m_fd >= 0) ::close(m_fd);
+    m_fd = -1;
+#endif
+    m_pData = NULL;
+    m_pHeader = NULL;
+    m_size = 0;
+    m_upgraded.clear();
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+//Binary label file (label_bin/*.glb), written alongside the KITTI text labels
+//Layout: BinaryLabelHeader followed by count fixed size BinaryLabelRecords, all little-endian.
+//It holds every entity written to label_aug_2; flags say which of label_2/labelsUnprocessed it is also in.
+
+const uint32_t BINARY_LABEL_MAGIC = 0x31424C47;//"GLB1" little-endian
+const uint16_t BINARY_LABEL_VERSION = 2;//2: towLink
+//Record size of version 1 files (no towLink), the smallest a reader accepts
+const uint16_t BINARY_LABEL_V1_RECORD_SIZE = 232;
+
+//BinaryLabelRecord::flags
+const uint32_t BINARY_LABEL_IN_LABEL_2 = 1;
+const uint32_t BINARY_LABEL_IN_UNPROCESSED = 2;
+const uint32_t BINARY_LABEL_PED_IN_VEHICLE = 4;
+
+const int BINARY_LABEL_TYPE_LEN = 16;
+const int BINARY_LABEL_MODEL_LEN = 32;
+
+#pragma pack(push, 1)
+struct BinaryLabelHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t recordSize;//sizeof(BinaryLabelRecord), lets readers skip fields added later
+    uint32_t count;
+    int32_t instanceIndex;
+    int32_t seriesIndex;
+    int32_t timeHours;
+    float focalLen;
+    float speed;//Ego vehicle
+    float yawRate;
+    int32_t imageWidth;
+    int32_t imageHeight;
+};
+
+struct BinaryLabelRecord {
+    int32_t entityID;
+    int32_t classID;
+    uint32_t flags;
+    char objType[BINARY_LABEL_TYPE_LEN];//Null terminated (truncated if longer)
+    char modelString[BINARY_LABEL_MODEL_LEN];
+
+    float truncation;
+    int32_t occlusion;
+    float alpha;
+    int32_t bbox2d[4];//left, top, right, bottom
+    int32_t bbox2dUnprocessed[4];
+
+    float height;
+    float width;
+    float length;
+    float location[3];//KITTI camera coordinates
+    float rotation_y;
+    float distance;
+
+    int32_t pointsHit2D;
+    int32_t pointsHit3D;
+    float speed;
+    float roll;
+    float pitch;
+    int32_t vPedIsIn;//0 if not a ped in a vehicle
+
+    float entity_velocity_vector[3];
+    float own_vehicle_velocity_vector[3];
+    float entity_world_coordinates[3];
+    float player_world_coordinates[3];
+    float entity_velocity_vector_camcoords[3];
+    float own_vehicle_velocity_vector_camcoords[3];
+    int32_t towLink;//Tractor of a trailer or trailer of a tractor (0 if none)
+};
+#pragma pack(pop)
+
+static_assert(sizeof(BinaryLabelHeader) == 44, "BinaryLabelHeader layout changed");
+static_assert(sizeof(BinaryLabelRecord) == 236, "BinaryLabelRecord layout changed");
+static_assert(offsetof(BinaryLabelRecord, towLink) == BINARY_LABEL_V1_RECORD_SIZE, "Version 1 records end before towLink");
+
+bool writeBinaryLabels(const std::string& filename, const BinaryLabelHeader& header, const std::vector<BinaryLabelRecord>& records);
+
+//Read-only memory mapped view of a .glb file. Records point straight into the mapping, except for files from
+//older versions: their shorter records are copied out once with the newer fields zeroed.
+class BinaryLabelFile {
+public:
+    ~BinaryLabelFile();
+    bool open(const std::string& filename);
+    void close();
+
+    const BinaryLabelHeader* header() const { return m_pHeader; }
+    uint32_t count() const { return m_pHeader ? m_pHeader->count : 0; }
+    //Record k (uses header recordSize as the stride)
+    const BinaryLabelRecord* record(uint32_t k) const;
+
+private:
+    bool mapFile(const std::string& filename);
+
+    const uint8_t* m_pData = NULL;
+    size_t m_size = 0;
+    const BinaryLabelHeader* m_pHeader = NULL;
+    //Records of an older version, extended to the current layout
+    std::vector<BinaryLabelRecord> m_upgraded;
+#ifdef _WIN32
+    void* m_hFile = NULL;
+    void* m_hMap = NULL;
+#else
+    int m_fd = -1;
+#endif
+};
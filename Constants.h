@@ -24,87 +24,157 @@ const float PED_BOX_WALKING_LEN = 1.44f;
 
 const float BBOX_ADJUSTMENT_FACTOR = 1.1f;
 
-//TODO: These should be moved to a settings file so don't need to rebuild when only changing settings
+//Feature switches. These are read from the settings file at initCollection/initReplay (see Settings.h),
+//the defaults are in Settings.cpp
 
 //Use the same time of day throughout the collection process
-const bool SAME_TIME_OF_DAY = true;
+extern bool SAME_TIME_OF_DAY;
 //Drive in specified area or wander entire map
-const bool DRIVE_SPEC_AREA = true;
-const bool START_SPEC_AREA = true;
+extern bool DRIVE_SPEC_AREA;
+extern bool START_SPEC_AREA;
 
 //Some settings for testing pointcloud generation
 //This prints the 2D map of where lidar beams hit on the screen (not consistent when moving)
-const bool GENERATE_2D_POINTMAP = false;
+extern bool GENERATE_2D_POINTMAP;
 //Outputs secondary pointcloud with raycast points
-const bool OUTPUT_RAYCAST_POINTS = false;
+extern bool OUTPUT_RAYCAST_POINTS;
 //Uses ray casting then transforms 3D point back to 2D plane to use depth buffer value
-const bool USE_RAYCASTING = false;
+extern bool USE_RAYCASTING;
 
 //Outputs pointcloud with 1:1 ratio of pixels in image < MAX_LIDAR_DIST
-const bool OUTPUT_DM_POINTCLOUD = false;
+extern bool OUTPUT_DM_POINTCLOUD;
 //If OUTPUT_DM_POINTCLOUD, outputs all points, even those past MAX_LIDAR_DIST (good for testing)
-const bool OUTPUT_FULL_DM_POINTCLOUD = false;
+extern bool OUTPUT_FULL_DM_POINTCLOUD;
 //Output offset pointclouds (for testing alignment)
-const bool OUTPUT_OFFSET_POINTCLOUDS = false;
+extern bool OUTPUT_OFFSET_POINTCLOUDS;
 
 //Sends animals to client. Check client also outputs them
-const bool RETAIN_ANIMALS = true;
+extern bool RETAIN_ANIMALS;
 
 //For testing
-const bool OUTPUT_OCCLUSION_IMAGE = false;
-const bool OUTPUT_UNUSED_PIXELS_IMAGE = false;
+extern bool OUTPUT_OCCLUSION_IMAGE;
+extern bool OUTPUT_UNUSED_PIXELS_IMAGE;
 
 //Can be used to get general outline of some objects with raycasting
 //WARNING: NOT ALL VEHICLES ARE HIT WITH RAYCASTING
-const bool OBTAIN_RAY_POINTS_HIT = false;
+extern bool OBTAIN_RAY_POINTS_HIT;
 //Overlays adjusted points on top of pointcloud (using raycasting + depth map)
-const bool OUTPUT_ADJUSTED_POINTS = false;
+extern bool OUTPUT_ADJUSTED_POINTS;
 
 //2d points will be shrunk with stencil cull
-const bool CORRECT_2D_POINTS_BEHIND_CAMERA = false;
+extern bool CORRECT_2D_POINTS_BEHIND_CAMERA;
 
-const bool LIDAR_GAUSSIAN_NOISE = false;
-const double DEPTH_NOISE_STDDEV = 0.006;//3 standard deviations is approximately 2cm
-const double DEPTH_NOISE_MEAN = 0.0;
+extern bool LIDAR_GAUSSIAN_NOISE;
+extern double DEPTH_NOISE_STDDEV;//3 standard deviations is approximately 2cm
+extern double DEPTH_NOISE_MEAN;
 
 //Extends bboxes/segmentation for bike type vehicles with rider (ped) information
-const bool PROCESS_PEDS_ON_BIKES = true;
-const bool TESTING_PEDS_ON_BIKES = true;
+extern bool PROCESS_PEDS_ON_BIKES;
+extern bool TESTING_PEDS_ON_BIKES;
 
 //Outputs stats on lidar vs depth map conversion (used for testing)
-const bool OUTPUT_DEPTH_STATS = false;
+extern bool OUTPUT_DEPTH_STATS;
 
 //Maximum distance from ground to be considered ground point:
-const float GROUND_POINT_MAX_DIST = 0.1;//in metres
+extern float GROUND_POINT_MAX_DIST;//in metres
 //Prints out image in groundPointsImg for testing
-const bool OUTPUT_GROUND_PIXELS = false;
+extern bool OUTPUT_GROUND_PIXELS;
 
 //Outputs separate stencil segmentation images for each stencil value
-const bool OUTPUT_SEPARATE_STENCILS = true;
+extern bool OUTPUT_SEPARATE_STENCILS;
 
 //Outputs stencil image which shows stencil of some classes (for debugging)
-const bool OUTPUT_STENCIL_IMAGE = false;
+extern bool OUTPUT_STENCIL_IMAGE;
 
 //Needs OUTPUT_SEPARATE_STENCILS to be true, only outputs log messages for values which are unknown 
-const bool ONLY_OUTPUT_UNKNOWN_STENCILS = true;
+extern bool ONLY_OUTPUT_UNKNOWN_STENCILS;
 
 //If set to true DeepGTAV outputs all information from nearby vehicles within specified range
-const bool GENERATE_SECONDARY_PERSPECTIVES = false;
-const int SECONDARY_PERSPECTIVE_RANGE = 100;
+extern bool GENERATE_SECONDARY_PERSPECTIVES;
+extern int SECONDARY_PERSPECTIVE_RANGE;
 //Only generates secondary perspectives from occupied vehicles (prevents capturing parking garages)
 //This should be set to true except for stationary scenarios
-const bool ONLY_OCCUPIED_VEHICLES = true;
-const bool TRUPERCEPT_SCENARIO = false;
+extern bool ONLY_OCCUPIED_VEHICLES;
+extern bool TRUPERCEPT_SCENARIO;
 
 //Outputs self location (For finding spots for stationary scenes)
-const bool OUTPUT_SELF_LOCATION = true;
+extern bool OUTPUT_SELF_LOCATION;
 
 //Outputs unprocessed labels file (for testing)
-const bool OUTPUT_UNPROCESSED_LABELS = false;
+extern bool OUTPUT_UNPROCESSED_LABELS;
+//Fixed record binary labels (label_bin/*.glb, see BinaryLabels.h) alongside the KITTI text labels
+extern bool OUTPUT_BINARY_LABELS;
 
 //Processes overlapping points for segmentation images
 //Warning!!!! There is a memory leak in here that needs to be investigated
-const bool PROCESS_OVERLAPPING_POINTS = false;
+extern bool PROCESS_OVERLAPPING_POINTS;
+
+//Adds the pixels of trailers to the vehicle towing them in the segmentation (they stay separate labels)
+extern bool MERGE_TRAILER_SEGMENTATION;
 
 //Outputs all vehicles within range in augmented labels
-const bool AUGMENT_ALL_VEHICLES_IN_RANGE = true;
\ No newline at end of file
+extern bool AUGMENT_ALL_VEHICLES_IN_RANGE;
+
+//Tests each entity's bounding sphere against the camera frustum before fetching its state.
+//Entities outside it skip the on screen/2D box natives and all per pixel tests, and are not fetched
+//at all unless they are needed for augmented labels or secondary perspectives.
+extern bool ENABLE_ENTITY_CULLING;
+//Logs the per frame cull counts
+extern bool OUTPUT_CULL_STATS;
+
+//Keeps entity geometry across frames and reuses it while an entity's model and pose are unchanged (see EntityState.h)
+extern bool REUSE_ENTITY_STATE;
+//Largest change in position (m) or in a unit axis of the entity matrix that still counts as the same pose
+extern float ENTITY_POSE_EPSILON;
+//Logs the per frame reuse ratio of the entity state store
+extern bool OUTPUT_ENTITY_STATE_STATS;
+
+//When collecting tracking series, appends KITTI tracking (label_02) and MOTChallenge (mot) ground truth per series
+extern bool OUTPUT_TRACKING_LABELS;
+//Frames an entity can be missing before its track ends (it gets a new track ID if it returns)
+extern int TRACK_EVICT_FRAMES;
+
+//Writes the game state each frame is built from to worldState/*.bin so the frame can be replayed offline (see WorldState.h).
+//Off by default: it is one more file per frame, about 120 bytes per vehicle and ped in the world plus ~70 per model
+//(typically 10-50 KB a frame). Turn it on for collections that should be replayable or kept as a golden corpus.
+extern bool OUTPUT_WORLD_STATE;
+
+//Writes the depth buffer compressed to depth/*.gdz (see DepthCompression.h) instead of raw floats to depth/*.bin.
+//Readers of depth/*.bin have to decode the new format (decompressDepthBuffer, loadCompressedDepth).
+//OUTPUT_DEPTH_COMPRESSION_STATS logs the ratio and time per captured frame, BM_compressRecordedDepth in deepgtav_bench
+//measures a capture offline.
+extern bool COMPRESS_DEPTH_BUFFER;
+//Log-quantises the depth buffer to 16/24 bits instead of compressing losslessly
+extern bool LOSSY_DEPTH_COMPRESSION;
+//Maximum depth error allowed at LOSSY_DEPTH_REF_DIST for lossy compression
+extern float LOSSY_DEPTH_MAX_ERROR;//in metres
+extern float LOSSY_DEPTH_REF_DIST;//in metres
+//Appends ratio and encode/decode times of every compressed depth buffer to DepthCompression.txt
+extern bool OUTPUT_DEPTH_COMPRESSION_STATS;
+
+//Per-entity instance masks (instSegMasks/*.json), collected while the instance segmentation is built
+//INSTANCE_MASK_RLE: COCO compressed RLE, INSTANCE_MASK_POLYGON: contour polygons, INSTANCE_MASK_NONE: off
+extern int INSTANCE_MASK_FORMAT;
+//Full-frame 32 bit instance segmentation png (instSeg). Off by default, instSegMasks replaces it: readers of instSeg/*.png
+//decode the json masks (pycocotools) or turn this back on in DeepGTAVSettings.ini.
+extern bool OUTPUT_INSTANCE_SEG_PNG;
+//Colour visualisation of the instance segmentation (instSegImage)
+extern bool OUTPUT_INSTANCE_SEG_IMAGE;
+
+//Publishes depth, stencil, instance seg, point cloud and labels of every frame to a shared memory ring
+//so live consumers can read frames without waiting for them to land on disk (see FrameRing.h)
+extern bool PUBLISH_FRAME_RING;
+const char* const FRAME_RING_NAME = "DeepGTAVFrames";
+extern int FRAME_RING_SLOTS;
+//Bytes per slot on top of the image sized buffers (point cloud and labels)
+extern int FRAME_RING_EXTRA_BYTES;
+
+//Sets of per-frame buffers (depth map points, stencil/segmentation/occlusion images, velodyne outputs) in
+//the frame buffer pool. Each set is sized from the camera resolution and the LiDAR beam count.
+//A set is only cleared when it is reused, so a frame's buffers stay intact for FRAMES_IN_FLIGHT - 1 more frames.
+extern int FRAMES_IN_FLIGHT;
+
+//Lowers LiDAR azimuth density, ground grid resolution and skips debug outputs while live capture (generateMessage
+//and the exports) runs over FRAME_BUDGET_MS per frame (see FrameBudget.h). Each frame's quality is logged to FrameBudget.csv.
+extern bool USE_FRAME_BUDGET;
+extern float FRAME_BUDGET_MS;//10 Hz capture
\ No newline at end of file
@@ -0,0 +1,42 @@
+#pragma once
+
+//Game and Win32 types used by the headless core (everything but the LiveWorld natives, see CMakeLists.txt).
+//The plugin takes them from the ScriptHook headers. Builds without the game (DEEPGTAV_HEADLESS) get the same
+//layout so recorded world states and binary labels read the same on both.
+
+#ifdef DEEPGTAV_HEADLESS
+
+#include <stdint.h>
+
+typedef int BOOL;
+#ifndef TRUE
+#define TRUE 1
+#define FALSE 0
+#endif
+typedef uint8_t BYTE;
+typedef unsigned int UINT;
+typedef uint32_t DWORD;
+
+typedef uint32_t Hash;
+typedef int Entity;
+typedef int Ped;
+typedef int Player;
+typedef int Vehicle;
+typedef int Cam;
+
+#pragma pack(push, 1)
+struct Vector3 {
+    float x;
+    uint32_t _paddingx;
+    float y;
+    uint32_t _paddingy;
+    float z;
+    uint32_t _paddingz;
+};
+#pragma pack(pop)
+
+#else
+
+#include "..\ObjectDetIncludes.h"
+
+#endif
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+//Compressed container for the NDC depth buffer (depth/*.gdz)
+//Lossless: row delta of the float bit patterns -> byte-plane shuffle -> zlib (fastest level, run-length matches)
+//Lossy: log-quantised NDC (16 or 24 bits) -> row delta -> byte-plane shuffle -> zlib
+//Layout is a DepthCompressionHeader followed by payloadSize bytes of zlib data
+
+const uint32_t DEPTH_COMPRESSION_MAGIC = 0x315A4447;//"GDZ1" little-endian
+const uint16_t DEPTH_COMPRESSION_VERSION = 1;
+
+enum DepthCompressionMode {
+    DEPTH_MODE_LOSSLESS = 0,
+    DEPTH_MODE_LOSSY_LOG = 1
+};
+
+#pragma pack(push, 1)
+struct DepthCompressionHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint8_t mode;
+    uint8_t bits;//Bits per stored value (32 for lossless, 16/24 for lossy)
+    int32_t width;
+    int32_t height;
+    //Range of log(ndc) covered by the quantiser (lossy only)
+    float logMin;
+    float logMax;
+    uint32_t payloadSize;
+};
+#pragma pack(pop)
+
+struct DepthCompressionStats {
+    size_t rawBytes = 0;
+    size_t compressedBytes = 0;
+    int bits = 32;
+    double encodeMs = 0;
+    double decodeMs = 0;
+
+    double ratio() const {
+        return compressedBytes == 0 ? 0 : (double)rawBytes / (double)compressedBytes;
+    }
+};
+
+//Compresses a width*height NDC depth buffer into out.
+//If lossy is set, the number of quantisation bits is chosen so the metric error at refDist stays below maxErrorMetres.
+//Falls back to lossless if 24 bits cannot meet the bound.
+bool compressDepthBuffer(const float* pDepth, int width, int height, std::vector<uint8_t>& out,
+    bool lossy = false, float maxErrorMetres = 0.01f, float refDist = 100.0f, DepthCompressionStats* stats = NULL);
+
+//Decodes a buffer produced by compressDepthBuffer. Lossless buffers return the exact original floats.
+bool decompressDepthBuffer(const uint8_t* in, size_t size, std::vector<float>& out, int& width, int& height);
+
+//For replay tools: reads a .gdz file and returns a malloc'd width*height float buffer (caller frees), NULL on failure
+float* loadCompressedDepth(const std::string& filename, int& width, int& height);
+
+//Smallest of 16/24 bits meeting the error bound at refDist for a log(ndc) span, 0 if neither does
+int depthQuantBits(float maxErrorMetres, float refDist, float logSpan);
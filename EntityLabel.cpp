@@ -0,0 +1,182 @@
+#include "EntityLabel.h"
+#include "GeometryCore.h"
+#include "ModelInfoCache.h"
+#include "Constants.h"
+#include <math.h>
+#include <algorithm>
+#include <float.h>
+
+void entityGeometry(const EntitySnapshot& snap, int idx, const ModelInfo& info, bool pedestrian, EntityGeometry& geom) {
+    Vector3 forwardVector = snap.forward[idx];
+    Vector3 rightVector = snap.right[idx];
+    Vector3 upVector = snap.up[idx];
+    Vector3 min = info.min;
+    Vector3 max = info.max;
+
+    //Need to adjust dimensions for pedestrians
+    if (pedestrian) {
+        float groundZ = snap.groundZ[idx];
+        float negZ = groundZ - snap.position[idx].z;
+
+        //Pedestrians on balconies can cause problems
+        if (negZ > -PED_MAX_GROUND_DROP && negZ < 0) {
+            min.z = negZ;
+        }
+
+        if (SET_PED_BOXES) {
+            min.x = -PED_BOX_WIDTH / 2.0f;
+            max.x = PED_BOX_WIDTH / 2.0f;
+            if (snap.speed[idx] > 1) {
+                min.y = -PED_BOX_WALKING_LEN / 2.0f;
+                max.y = PED_BOX_WALKING_LEN / 2.0f;
+            }
+            else {
+                min.y = -PED_BOX_LENGTH / 2.0f;
+                max.y = PED_BOX_LENGTH / 2.0f;
+            }
+        }
+    }
+    geom.min = min;
+    geom.max = max;
+
+    //Calculate size
+    geom.dim.x = 0.5*(max.x - min.x);
+    geom.dim.y = 0.5*(max.y - min.y);
+    geom.dim.z = 0.5*(max.z - min.z);
+
+    //Converting vehicle dimensions from vehicle to world coordinates for offset position
+    Vector3 worldX; worldX.x = 1; worldX.y = 0; worldX.z = 0;
+    Vector3 worldY; worldY.x = 0; worldY.y = 1; worldY.z = 0;
+    Vector3 worldZ; worldZ.x = 0; worldZ.y = 0; worldZ.z = 1;
+    geom.xVector = convertCoordinateSystem(worldX, forwardVector, rightVector, upVector);
+    geom.yVector = convertCoordinateSystem(worldY, forwardVector, rightVector, upVector);
+    geom.zVector = convertCoordinateSystem(worldZ, forwardVector, rightVector, upVector);
+
+    geom.worldPos = correctOffcenter(snap.position[idx], min, max, forwardVector, rightVector, upVector, geom.offcenter);
+}
+
+float pedBoxRadius(const ModelInfo& info) {
+    Vector3 min = info.min;
+    Vector3 max = info.max;
+    min.z = std::min(min.z, -PED_MAX_GROUND_DROP);
+    if (SET_PED_BOXES) {
+        min.x = -PED_BOX_WIDTH / 2.0f;
+        max.x = PED_BOX_WIDTH / 2.0f;
+        min.y = -std::max(PED_BOX_WALKING_LEN, PED_BOX_LENGTH) / 2.0f;
+        max.y = -min.y;
+    }
+    float x = std::max(fabs(min.x), fabs(max.x));
+    float y = std::max(fabs(min.y), fabs(max.y));
+    float z = std::max(fabs(min.z), fabs(max.z));
+    return sqrt(x * x + y * y + z * z);
+}
+
+void entityLabel(const EntitySnapshot& snap, int idx, const EntityGeometry& geom, const LabelFrameState& frame,
+                 int classid, const std::string& type, ObjEntity& entity) {
+    Vector3 forwardVector = snap.forward[idx];
+    Vector3 rightVector = snap.right[idx];
+    Vector3 speedVector = snap.speedVector[idx];
+    float speed = snap.speed[idx];
+
+    float heading;
+    if (speed > 0) {
+        heading = headingFromVector2d(speedVector.x - frame.vehicleForward.x, speedVector.y - frame.vehicleForward.y);
+    }
+    else {
+        heading = headingFromVector2d(forwardVector.x - frame.vehicleForward.x, forwardVector.y - frame.vehicleForward.y);
+    }
+
+    //Kitti dimensions
+    entity.height = 2 * geom.dim.z;
+    entity.width = 2 * geom.dim.x;
+    entity.length = 2 * geom.dim.y;
+
+    //Have only seen sitting people with height <= 1.0
+    entity.objType = classid == PEDESTRIAN_CLASS_ID && entity.height <= 1.0 ? "Person_sitting" : type;
+
+    float rot_y = kittiRotationY(forwardVector, frame.camForward, frame.camRight, frame.camUp);
+    entity.location = kittiLocation(*frame.cam, geom.worldPos, frame.camForward, frame.camRight, frame.camUp);
+    entity.rotation_y = rot_y;
+    entity.alpha = kittiAlpha(rot_y, entity.location);
+
+    float roll = 0;
+    float pitch = 0;
+    getRollAndPitch(rightVector, forwardVector, frame.camForward, frame.camRight, frame.camUp, pitch, roll);
+    //To prevent negative zeros
+    if (fabs(roll) <= 0.0001) roll = 0.0f;
+    if (fabs(pitch) <= 0.0001) pitch = 0.0f;
+
+    entity.entityID = snap.ids[idx];
+    entity.classID = classid;
+    entity.speed = speed;
+    entity.heading = heading;
+    entity.dim = geom.dim;
+    entity.offcenter = geom.offcenter;
+    entity.worldPos = geom.worldPos;
+    entity.distance = snap.distance[idx];
+    entity.pitch = pitch;
+    entity.roll = roll;
+    entity.model = snap.models[idx];
+    entity.modelString = geom.info->displayName;
+    entity.towLink = snap.attachedTo[idx];
+    entity.inFrustum = snap.cullTier[idx] == CULL_TIER_FULL;
+
+    //Calculated during processSegmentation and processOcclusion
+    entity.pointsHit2D = 0;
+    entity.pointsHit3D = 0;
+    entity.occlusion = 0;
+
+    entity.xVector = geom.xVector;
+    entity.yVector = geom.yVector;
+    entity.zVector = geom.zVector;
+
+    entity.entity_velocity_vector = speedVector;
+    entity.own_vehicle_velocity_vector = frame.ego.velocity;
+    entity.entity_world_coordinates = snap.worldCoords[idx];
+    entity.player_world_coordinates = frame.ego.worldCoords;
+    entity.own_vehicle_velocity_vector_camcoords = convertCoordinateSystem(frame.ego.velocity, frame.camForward, frame.camRight, frame.camUp);
+    entity.entity_velocity_vector_camcoords = convertCoordinateSystem(speedVector, frame.camForward, frame.camRight, frame.camUp);
+}
+
+//dim is in full width/height/length
+static void updatePosition(float &origPos, float pedPos, float &origDim, float pedDim) {
+    float diffPos = pedPos + pedDim / 2 - (origPos + origDim / 2);
+    float diffNeg = pedPos - pedDim / 2 - (origPos - origDim / 2);
+    if (diffPos > 0) { //If ped dim is outside original bike dimension
+        origPos += diffPos / 2;
+        origDim += diffPos;
+    }
+    if (diffNeg < 0) { //If ped dim is outside original bike dimension
+        //If it is negative we need to add the position (since it is relative)
+        //but subtract the dimension (really make it bigger since diffNeg < 0 if it is bigger)
+        origPos += diffNeg / 2;
+        origDim -= diffNeg;
+    }
+}
+
+void mergeRider(ObjEntity& vehicle, const EntityRecord& ped) {
+    //This method assume the pedestrian x/z coordinates are the same as the vehicles (only update relative height position)
+    vehicle.width = vehicle.width > ped.width ? vehicle.width : ped.width;
+    vehicle.length = vehicle.length > ped.length ? vehicle.length : ped.length;
+    updatePosition(vehicle.location.y, ped.location.y, vehicle.height, ped.height);
+
+    //This method would need to be changed to accommodate object coordinate system vs kitti coordinate system
+    /*updatePosition(vehicle.location.x, ped.location.x, vehicle.width, ped.width);
+    updatePosition(vehicle.location.y, ped.location.y, vehicle.width, ped.width);
+    updatePosition(vehicle.location.z, ped.location.z, vehicle.width, ped.width);*/
+}
+
+int mergeRidersInRange(ObjEntity& vehicle, const PedSpatialHash& grid, EntityTable& peds, std::vector<int>& hits) {
+    //Horizontal window only, mergeRider does not move x/z
+    grid.query(vehicle.location, RIDER_HORIZ_DIST, FLT_MAX, hits);
+    int riders = 0;
+    for (int pedID : hits) {
+        EntityRecord& ped = peds.record(peds.find(pedID));
+        if (ped.location.y - vehicle.location.y > RIDER_MAX_VERT_DIST) continue;
+        ped.isPedInV = true;
+        ped.vPedIsIn = vehicle.entityID;
+        mergeRider(vehicle, ped);
+        ++riders;
+    }
+    return riders;
+}
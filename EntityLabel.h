@@ -0,0 +1,45 @@
+#pragma once
+
+#include "EntitySnapshot.h"
+#include "EntityState.h"
+#include "PedSpatialHash.h"
+#include "CamParams.h"
+#include <string>
+
+const int PEDESTRIAN_CLASS_ID = 10;
+//Window for peds riding a bike type vehicle, from the vehicle's KITTI location
+const float RIDER_HORIZ_DIST = 0.5f;
+const float RIDER_MAX_VERT_DIST = 2.0f;//How far below the vehicle (KITTI y points down)
+//Furthest a ped box bottom is lowered to the ground below the ped's origin (balconies are left alone)
+const float PED_MAX_GROUND_DROP = 2.0f;
+
+//Camera and capture vehicle state of a frame: everything entityLabel reads besides the entity's snapshot
+struct LabelFrameState {
+    const CamParams* cam;
+    Vector3 camForward;
+    Vector3 camRight;
+    Vector3 camUp;
+    Vector3 vehicleForward;//Capture vehicle, headings are relative to it
+    EgoSnapshot ego;
+};
+
+//World space geometry of snapshot entry idx from its model bounds (for peds, lowered to the snapshot's ground Z
+//and set to the SET_PED_BOXES sizes). Fills the fields from min to zVector, the key and the caching are left
+//to the caller (see EntityStateStore).
+void entityGeometry(const EntitySnapshot& snap, int idx, const ModelInfo& info, bool pedestrian, EntityGeometry& geom);
+//Radius about the origin which holds any box entityGeometry can give a ped of this model, for the frustum cull
+//(which runs before the ground Z is known)
+float pedBoxRadius(const ModelInfo& info);
+
+//Label fields of snapshot entry idx from its geometry and the frame. No game calls and no state, the same
+//inputs always give the same label. The 2D boxes, truncation, riders and trackFirstFrame are left to the caller.
+void entityLabel(const EntitySnapshot& snap, int idx, const EntityGeometry& geom, const LabelFrameState& frame,
+                 int classid, const std::string& type, ObjEntity& entity);
+
+//Grows a vehicle's KITTI size and location to hold a ped riding it. x/z are assumed to be the vehicle's,
+//only the height is merged.
+void mergeRider(ObjEntity& vehicle, const EntityRecord& ped);
+//Merges the peds of grid in the rider window of vehicle and marks them as in it, returns how many there were.
+//Peds are visited in ascending ID order and the vertical window is checked against the location as it grows
+//with each rider, like the scan over all peds which the grid replaced.
+int mergeRidersInRange(ObjEntity& vehicle, const PedSpatialHash& grid, EntityTable& peds, std::vector<int>& hits);
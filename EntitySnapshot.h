@@ -0,0 +1,69 @@
+#pragma once
+
+#include <vector>
+#include <stdint.h>
+#include "FrameObjectInfo.h"
+
+//Native state of the ego vehicle, fetched once per frame
+struct EgoSnapshot {
+    Vector3 velocity;//GET_ENTITY_SPEED_VECTOR of own vehicle
+    Vector3 worldCoords;//Own vehicle origin in world coordinates
+};
+
+//Result of the position/bounding sphere test in snapshotEntities
+enum EntityCullTier : uint8_t {
+    CULL_TIER_SKIP,//Past the far clip, or off screen and not needed for augmented labels
+    CULL_TIER_AUGMENT,//Off screen but in range, only the augmented label fields are filled
+    CULL_TIER_FULL//Bounding sphere intersects the camera frustum
+};
+
+//Native state of all vehicles or peds in a frame, gathered in one sweep (structure of arrays)
+//so label calculations can run over it without calling back into the game.
+//Skipped entities only have their matrix (inRange = 0).
+struct EntitySnapshot {
+    std::vector<int> ids;
+    std::vector<Hash> models;
+    std::vector<Vector3> forward;
+    std::vector<Vector3> right;
+    std::vector<Vector3> up;
+    std::vector<Vector3> position;
+    std::vector<float> distance;//From camera
+    std::vector<uint8_t> cullTier;//EntityCullTier
+    std::vector<uint8_t> inRange;
+    std::vector<uint8_t> onScreen;
+    std::vector<uint8_t> driverSeatFree;//Vehicles only
+    std::vector<int> attachedTo;//Trailers only, entity towing the trailer (0 if none)
+    std::vector<int> vehicleIn;//Peds only, vehicle the ped is in (-1 if none)
+    std::vector<Hash> vehicleInModel;//Peds only, model of vehicleIn
+    std::vector<float> groundZ;//Peds only, ground height below the ped
+    std::vector<int> pedType;//Peds only
+    std::vector<float> speed;
+    std::vector<Vector3> speedVector;
+    std::vector<Vector3> worldCoords;
+    CullStats cullStats;
+
+    size_t size() const { return ids.size(); }
+
+    void resize(size_t n) {
+        ids.resize(n);
+        models.resize(n);
+        forward.resize(n);
+        right.resize(n);
+        up.resize(n);
+        position.resize(n);
+        distance.resize(n);
+        cullTier.assign(n, CULL_TIER_SKIP);
+        inRange.assign(n, 0);
+        onScreen.assign(n, 0);
+        driverSeatFree.assign(n, 0);
+        attachedTo.assign(n, 0);
+        vehicleIn.assign(n, -1);
+        vehicleInModel.assign(n, 0);
+        groundZ.assign(n, 0.0f);
+        pedType.assign(n, 0);
+        speed.assign(n, 0.0f);
+        speedVector.resize(n);
+        worldCoords.resize(n);
+        cullStats = CullStats();
+    }
+};
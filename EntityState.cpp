@@ -0,0 +1,73 @@
+#include "EntityState.h"
+#include <math.h>
+
+static bool nearlyEqual(const Vector3& a, const Vector3& b, float eps) {
+    return fabs(a.x - b.x) <= eps && fabs(a.y - b.y) <= eps && fabs(a.z - b.z) <= eps;
+}
+
+void EntityStateStore::beginFrame() {
+    ++m_frame;
+    m_stats = EntityStateStats();
+}
+
+EntityGeometry& EntityStateStore::lookup(int entityID, Hash model, const Vector3& forward, const Vector3& right, const Vector3& up,
+                                         const Vector3& position, bool walking) {
+    EntityGeometry& g = m_entries[entityID];
+    g.lastFrame = m_frame;
+
+    //Default constructed entries are not valid so they always fall through.
+    //Compared with the pose the geometry was computed from, a hit leaves the key as it is.
+    if (g.valid && g.model == model && g.walking == walking &&
+        nearlyEqual(g.position, position, ENTITY_POSE_EPSILON) &&
+        nearlyEqual(g.forward, forward, ENTITY_POSE_EPSILON) &&
+        nearlyEqual(g.right, right, ENTITY_POSE_EPSILON) &&
+        nearlyEqual(g.up, up, ENTITY_POSE_EPSILON)) {
+        ++m_stats.reused;
+        return g;
+    }
+
+    g.model = model;
+    g.forward = forward;
+    g.right = right;
+    g.up = up;
+    g.position = position;
+    g.walking = walking;
+    g.valid = false;
+    g.boxValid = false;
+    g.groundZValid = false;
+    ++m_stats.recomputed;
+    return g;
+}
+
+EntityGeometry* EntityStateStore::find(int entityID) {
+    auto found = m_entries.find(entityID);
+    if (found == m_entries.end() || found->second.lastFrame != m_frame) return NULL;
+    return &found->second;
+}
+
+bool EntityStateStore::cachedGroundZ(int entityID, const Vector3& position, float& groundZ) const {
+    auto found = m_entries.find(entityID);
+    if (found == m_entries.end() || !found->second.groundZValid ||
+        !nearlyEqual(found->second.position, position, ENTITY_POSE_EPSILON)) {
+        return false;
+    }
+    groundZ = found->second.groundZ;
+    return true;
+}
+
+void EntityStateStore::endFrame() {
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (it->second.lastFrame != m_frame) {
+            it = m_entries.erase(it);
+            ++m_stats.evicted;
+        }
+        else {
+            ++it;
+        }
+    }
+}
+
+float EntityStateStore::reuseRatio() const {
+    int total = m_stats.reused + m_stats.recomputed;
+    return total > 0 ? (float)m_stats.reused / total : 0.0f;
+}
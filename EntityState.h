@@ -0,0 +1,71 @@
+#pragma once
+
+#include "CoreTypes.h"
+#include <Eigen/Core>
+#include "CamParams.h"
+#include "Functions.h"
+#include "EntityTable.h"
+#include <unordered_map>
+
+struct ModelInfo;
+
+//World space geometry of an entity which only depends on its model and pose.
+//Camera relative fields (KITTI location, rotation, alpha, roll/pitch) are not stored.
+struct EntityGeometry {
+    //Key: the pose the geometry below was computed from, i.e. the pose the labels are emitted with.
+    //It is not refreshed when the geometry is reused, so a slow drift is recomputed once it adds up to
+    //ENTITY_POSE_EPSILON instead of being carried along frame by frame.
+    Hash model;
+    Vector3 forward;
+    Vector3 right;
+    Vector3 up;
+    Vector3 position;//Entity origin
+    bool walking;//Peds use a longer box above walking speed
+
+    bool valid = false;//Set once the fields below are filled for the current key
+    const ModelInfo* info;//s_modelCache entry of model (entries are never removed)
+    Vector3 min;//After the ped ground/box adjustments
+    Vector3 max;
+    Vector3 dim;
+    Vector3 offcenter;
+    Vector3 worldPos;//Position after correctOffcenter
+    Vector3 xVector;
+    Vector3 yVector;
+    Vector3 zVector;
+
+    bool boxValid = false;
+    EntityBox box;
+
+    //Peds: ground Z under position (the native result), cleared with valid
+    bool groundZValid = false;
+    float groundZ;
+
+    int lastFrame;
+};
+
+//Entity geometry kept across frames, keyed by entity ID.
+//Parked vehicles and idle peds keep their entry so their geometry (and the ped ground Z native) is only
+//computed again once they move. Poses within ENTITY_POSE_EPSILON of the stored key (the last emitted pose) count as unchanged.
+class EntityStateStore {
+public:
+    void beginFrame();
+    //Entry for an entity this frame. valid/boxValid are cleared if the model or pose changed.
+    EntityGeometry& lookup(int entityID, Hash model, const Vector3& forward, const Vector3& right, const Vector3& up,
+                           const Vector3& position, bool walking);
+    //NULL if the entity was not looked up this frame
+    EntityGeometry* find(int entityID);
+    //Ground Z stored for an entity whose position is still within ENTITY_POSE_EPSILON of the stored key.
+    //For the world snapshot, before this frame's lookup (so it sees entities kept by the last endFrame).
+    bool cachedGroundZ(int entityID, const Vector3& position, float& groundZ) const;
+    //Removes entities which were not looked up this frame
+    void endFrame();
+
+    const EntityStateStats& stats() const { return m_stats; }
+    float reuseRatio() const;
+    size_t size() const { return m_entries.size(); }
+
+private:
+    std::unordered_map<int, EntityGeometry> m_entries;
+    EntityStateStats m_stats;
+    int m_frame = 0;
+};
@@ -0,0 +1,51 @@
+#include "EntityTable.h"
+
+void EntityTable::clear() {
+    m_records.clear();
+    m_slots.clear();
+    ids.clear();
+    inFrustum.clear();
+    bbox2dUnprocessed.clear();
+    boxes.clear();
+    bbox2d.clear();
+    pointsHit2D.clear();
+    vehicleSlot.clear();
+    pixelSlots.clear();
+}
+
+int EntityTable::insert(const ObjEntity& e) {
+    auto found = m_slots.find(e.entityID);
+    if (found != m_slots.end()) return found->second;
+
+    int slot = (int)m_records.size();
+    m_slots.insert(std::pair<int, int>(e.entityID, slot));
+    m_records.push_back(static_cast<const EntityRecord&>(e));
+
+    ids.push_back(e.entityID);
+    inFrustum.push_back(e.inFrustum);
+    bbox2dUnprocessed.push_back(e.bbox2dUnprocessed);
+    boxes.push_back(EntityBox());
+    bbox2d.push_back(e.bbox2d);
+    pointsHit2D.push_back(e.pointsHit2D);
+    vehicleSlot.push_back(-1);
+    if (e.inFrustum) pixelSlots.push_back(slot);
+    return slot;
+}
+
+int EntityTable::find(int entityID) const {
+    auto found = m_slots.find(entityID);
+    return found != m_slots.end() ? found->second : -1;
+}
+
+void EntityTable::entity(int slot, ObjEntity& out) const {
+    static_cast<EntityRecord&>(out) = m_records[slot];
+    out.entityID = ids[slot];
+    out.bbox2d = bbox2d[slot];
+    out.bbox2dUnprocessed = bbox2dUnprocessed[slot];
+    out.pointsHit2D = pointsHit2D[slot];
+    out.inFrustum = inFrustum[slot] != 0;
+}
+
+int EntityTableView::size() const {
+    return table ? table->size() : 0;
+}
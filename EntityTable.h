@@ -0,0 +1,49 @@
+#pragma once
+
+#include "GeometryCore.h"
+#include "FrameObjectInfo.h"
+#include <vector>
+#include <unordered_map>
+
+//Dense storage for the vehicles or peds of one frame. Slots follow insertion order and stay fixed until clear().
+//Fields used per pixel are kept in hot arrays indexed by slot and nowhere else. The EntityRecord part (strings,
+//velocities and the other label fields) is stored separately and only touched once per entity.
+class EntityTable {
+public:
+    void clear();
+    //Adds e unless its entityID is already present. Returns the entity's slot either way.
+    int insert(const ObjEntity& e);
+    //Slot of an entity ID, -1 if not present
+    int find(int entityID) const;
+    int size() const { return (int)m_records.size(); }
+
+    EntityRecord& record(int slot) { return m_records[slot]; }
+    const EntityRecord& record(int slot) const { return m_records[slot]; }
+
+    //Puts the record and the hot fields of a slot back together (for the exports, once per entity)
+    void entity(int slot, ObjEntity& out) const;
+
+    //Hot data, indexed by slot
+    std::vector<int> ids;
+    std::vector<uint8_t> inFrustum;
+    std::vector<BBox2D> bbox2dUnprocessed;//In pixels
+    std::vector<EntityBox> boxes;//Only set for entities in the frustum
+    std::vector<BBox2D> bbox2d;//Grown by every segmented pixel
+    std::vector<int> pointsHit2D;
+    std::vector<int> vehicleSlot;//Slot in the vehicle table that this entity's pixels go to (peds in vehicles, merged trailers), -1 otherwise
+    //Slots with inFrustum set, the only ones the per pixel passes scan. Entities kept for augmented labels
+    //(most of the table with AUGMENT_ALL_VEHICLES_IN_RANGE) cost nothing per pixel.
+    std::vector<int> pixelSlots;
+
+private:
+    std::vector<EntityRecord> m_records;
+    std::unordered_map<int, int> m_slots;//entityID -> slot
+};
+
+//An entity in either table, for the per pixel code which handles vehicles and peds together
+struct EntityRef {
+    EntityTable* table;
+    int slot;
+
+    EntityRecord& record() const { return table->record(slot); }
+};
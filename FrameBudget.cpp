@@ -0,0 +1,128 @@
+#include "FrameBudget.h"
+#include "Logger.h"
+
+static const FrameQuality FULL_QUALITY = { 0, 1, 2, true };
+static const int MAX_LIDAR_AZIMUTH_STRIDE = 4;
+static const int MAX_GROUND_GRID_INTERVAL = 8;
+
+//Weight of the newest frame in the running averages
+static const double BUDGET_AVG_WEIGHT = 0.2;
+//Frames at a level before the next step (lets the average settle on the new cost)
+static const int BUDGET_DEGRADE_FRAMES = 5;
+static const int BUDGET_RECOVER_FRAMES = 30;
+//Fraction of the budget the average has to stay under before quality is raised again
+static const double BUDGET_RECOVER_RATIO = 0.7;
+//Expected fraction of a stage's time saved by one step: debug outputs are skipped entirely,
+//a doubled LiDAR stride casts half the rays, a doubled ground grid spacing samples a quarter of the points
+static const double STEP_SAVING[] = { 1.0, 0.5, 0.75 };
+static const FrameBudgetStage STEP_STAGE[] = { BUDGET_STAGE_DEBUG, BUDGET_STAGE_LIDAR, BUDGET_STAGE_GROUND };
+static const char* const STEP_NAMES[] = { "debug outputs", "LiDAR azimuth stride", "ground grid interval" };
+
+FrameBudget::~FrameBudget() {
+    if (m_file) fclose(m_file);
+}
+
+bool FrameBudget::open(const std::string& logFile, float budgetMs) {
+    if (m_file) return true;
+    m_file = fopen(logFile.c_str(), "w");
+    if (!m_file) return false;
+    m_budgetMs = budgetMs;
+    fprintf(m_file, "frame,series,level,frame_ms,avg_ms,budget_ms,generate_ms,export_detections_ms,export_image_ms,lidar_ms,ground_ms,debug_ms,"
+        "lidar_azimuth_stride,ground_grid_interval,debug_outputs\n");
+    return true;
+}
+
+const FrameQuality& FrameBudget::quality() const {
+    return m_file ? m_quality : FULL_QUALITY;
+}
+
+const FrameQuality& FrameBudget::beginFrame(int frame, int series) {
+    if (m_file) {
+        if (m_inFrame) endFrame();
+        m_inFrame = true;
+        m_frame = frame;
+        m_series = series;
+        for (int s = 0; s < BUDGET_STAGE_COUNT; ++s) {
+            m_stageMs[s] = 0.0;
+        }
+    }
+    return quality();
+}
+
+//The step with the largest expected saving, from the stage averages. STEP_NONE if no step would save anything.
+FrameBudget::Step FrameBudget::pickStep() const {
+    bool available[] = { m_quality.debugOutputs, m_quality.lidarAzimuthStride < MAX_LIDAR_AZIMUTH_STRIDE,
+        m_quality.groundGridInterval < MAX_GROUND_GRID_INTERVAL };
+    Step best = STEP_NONE;
+    double bestSaving = 0.0;
+    for (int step = 0; step < STEP_NONE; ++step) {
+        double saving = STEP_SAVING[step] * m_stageAvgMs[STEP_STAGE[step]];
+        if (available[step] && saving > bestSaving) {
+            best = (Step)step;
+            bestSaving = saving;
+        }
+    }
+    return best;
+}
+
+void FrameBudget::applySteps() {
+    int level = m_quality.level;
+    m_quality = FULL_QUALITY;
+    m_quality.level = level;
+    for (int i = 0; i < level; ++i) {
+        switch (m_steps[i]) {
+        case STEP_DEBUG: m_quality.debugOutputs = false; break;
+        case STEP_LIDAR: m_quality.lidarAzimuthStride *= 2; break;
+        case STEP_GROUND: m_quality.groundGridInterval *= 2; break;
+        default: break;
+        }
+    }
+}
+
+void FrameBudget::endFrame() {
+    if (!m_file || !m_inFrame) return;
+    m_inFrame = false;
+
+    double frameMs = 0.0;
+    for (int s = 0; s < BUDGET_TOP_LEVEL_STAGES; ++s) {
+        frameMs += m_stageMs[s];
+    }
+    m_avgMs = m_avgMs < 0 ? frameMs : m_avgMs + BUDGET_AVG_WEIGHT * (frameMs - m_avgMs);
+    for (int s = 0; s < BUDGET_STAGE_COUNT; ++s) {
+        double& avg = m_stageAvgMs[s];
+        avg = avg < 0 ? m_stageMs[s] : avg + BUDGET_AVG_WEIGHT * (m_stageMs[s] - avg);
+    }
+
+    const FrameQuality& q = m_quality;
+    fprintf(m_file, "%d,%d,%d,%.2f,%.2f,%.1f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%d,%d,%d\n", m_frame, m_series, q.level, frameMs, m_avgMs, m_budgetMs,
+        m_stageMs[BUDGET_STAGE_GENERATE], m_stageMs[BUDGET_STAGE_EXPORT_DETECTIONS], m_stageMs[BUDGET_STAGE_EXPORT_IMAGE],
+        m_stageMs[BUDGET_STAGE_LIDAR], m_stageMs[BUDGET_STAGE_GROUND], m_stageMs[BUDGET_STAGE_DEBUG],
+        q.lidarAzimuthStride, q.groundGridInterval, q.debugOutputs ? 1 : 0);
+    fflush(m_file);
+
+    ++m_framesAtLevel;
+    //The last frame has to be over too, the average lags behind a step that already helped
+    if (m_avgMs > m_budgetMs && frameMs > m_budgetMs && m_framesAtLevel >= BUDGET_DEGRADE_FRAMES) {
+        Step step = pickStep();
+        if (step != STEP_NONE) {
+            LOG_INFO("Frame budget: " << STEP_NAMES[step] << " lowered after frame " << m_frame << " (avg " << m_avgMs << " ms, budget "
+                << m_budgetMs << " ms, " << m_stageAvgMs[STEP_STAGE[step]] << " ms in that stage)");
+            m_steps[m_quality.level++] = step;
+            applySteps();
+            m_framesAtLevel = 0;
+        }
+        else if (!m_stuckLogged) {
+            LOG_WARN("Frame budget: over budget after frame " << m_frame << " (avg " << m_avgMs << " ms) with nothing left to lower, export "
+                << m_stageAvgMs[BUDGET_STAGE_EXPORT_DETECTIONS] + m_stageAvgMs[BUDGET_STAGE_EXPORT_IMAGE] << " ms");
+            m_stuckLogged = true;
+        }
+    }
+    else if (m_avgMs < m_budgetMs * BUDGET_RECOVER_RATIO && m_framesAtLevel >= BUDGET_RECOVER_FRAMES && m_quality.level > 0) {
+        Step step = m_steps[--m_quality.level];
+        LOG_INFO("Frame budget: " << STEP_NAMES[step] << " restored after frame " << m_frame << " (avg " << m_avgMs << " ms, budget "
+            << m_budgetMs << " ms)");
+        applySteps();
+        m_framesAtLevel = 0;
+        m_stuckLogged = false;
+    }
+}
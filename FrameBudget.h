@@ -0,0 +1,93 @@
+#pragma once
+
+#include <stdio.h>
+#include <chrono>
+#include <string>
+
+//Keeps live capture within a per-frame processing budget (USE_FRAME_BUDGET, FRAME_BUDGET_MS).
+//The frame time is generateMessage plus exportDetections and exportImage (the time the game waits between
+//captures is not counted). While its running average is over budget the controller gives up one step of
+//quality, picked from the running average of each stage: the step expected to save the most time of
+//  debug outputs skipped (stencil/occlusion/unused/ground/depth/instance seg images, depth stats)
+//  LiDAR azimuth stride doubled (up to every 4th sample)
+//  ground point grid spacing doubled (up to 8 m)
+//Once it has been comfortably under budget for a while the last step given up is restored.
+//Labels, segmentation, the image and the standard point clouds are always written.
+//
+//Every frame is logged to FrameBudget.csv with its stage times and the quality it was captured at, so
+//degraded frames can be filtered out or weighted by dataset consumers.
+
+enum FrameBudgetStage {
+    //Top level parts of a frame, their sum is the frame time
+    BUDGET_STAGE_GENERATE,//generateMessage, including the stages below
+    BUDGET_STAGE_EXPORT_DETECTIONS,
+    BUDGET_STAGE_EXPORT_IMAGE,
+    //Parts of generateMessage the controller can trade off
+    BUDGET_STAGE_LIDAR,
+    BUDGET_STAGE_GROUND,
+    BUDGET_STAGE_DEBUG,
+    BUDGET_STAGE_COUNT
+};
+const int BUDGET_TOP_LEVEL_STAGES = BUDGET_STAGE_LIDAR;
+
+struct FrameQuality {
+    int level;//Steps given up, 0 is full quality
+    int lidarAzimuthStride;//Every nth horizontal LiDAR sample is cast
+    int groundGridInterval;//Spacing of ground_points_grid in metres
+    bool debugOutputs;
+};
+
+class FrameBudget {
+public:
+    ~FrameBudget();
+
+    //Starts controlling and logging. Until then quality() stays at full quality.
+    bool open(const std::string& logFile, float budgetMs);
+    bool isOpen() const { return m_file != NULL; }
+
+    //Settings for the frame about to be processed
+    const FrameQuality& beginFrame(int frame, int series);
+    //Adds time spent in a stage (see BudgetScope)
+    void addStage(FrameBudgetStage stage, double ms) { m_stageMs[stage] += ms; }
+    //Logs the frame and picks the quality of the next one. beginFrame ends the previous frame if this was not called,
+    //so the exports after generateMessage are counted in their frame.
+    void endFrame();
+
+    const FrameQuality& quality() const;
+    //Running average of a stage (-1 before the first frame)
+    double stageAverage(FrameBudgetStage stage) const { return m_stageAvgMs[stage]; }
+
+private:
+    //Steps that can be given up, in the order they are undone in m_steps
+    enum Step { STEP_DEBUG, STEP_LIDAR, STEP_GROUND, STEP_NONE };
+    Step pickStep() const;
+    void applySteps();
+
+    FILE* m_file = NULL;
+    float m_budgetMs = 0;
+    FrameQuality m_quality = { 0, 1, 2, true };
+    Step m_steps[5];//Steps given up, oldest first (m_quality.level of them: one debug, two LiDAR and two ground at most)
+    int m_framesAtLevel = 0;
+    double m_avgMs = -1;
+    bool m_inFrame = false;
+    bool m_stuckLogged = false;
+    int m_frame = 0;
+    int m_series = 0;
+    double m_stageMs[BUDGET_STAGE_COUNT];
+    double m_stageAvgMs[BUDGET_STAGE_COUNT] = { -1, -1, -1, -1, -1, -1 };
+};
+
+//Adds the time until the end of the enclosing block to a budget stage
+class BudgetScope {
+public:
+    BudgetScope(FrameBudget& budget, FrameBudgetStage stage) : m_budget(budget), m_stage(stage),
+        m_start(std::chrono::steady_clock::now()) {}
+    ~BudgetScope() {
+        m_budget.addStage(m_stage, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_start).count());
+    }
+
+private:
+    FrameBudget& m_budget;
+    FrameBudgetStage m_stage;
+    std::chrono::steady_clock::time_point m_start;
+};
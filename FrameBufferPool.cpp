@@ -0,0 +1,82 @@
+#include "FrameBufferPool.h"
+#include <Eigen/Core>
+#include "Constants.h"
+#include <algorithm>
+
+template <typename T>
+static size_t vectorBytes(const std::vector<T>& v) {
+    return v.size() * sizeof(T);
+}
+
+size_t FrameBufferSet::bytes() const {
+    size_t total = vectorBytes(dmPointClouds) + vectorBytes(dmImage) + vectorBytes(stencilImage) + vectorBytes(occlusionImage)
+        + vectorBytes(unusedStencilImage) + vectorBytes(groundPointsImage) + vectorBytes(stencilSeg) + vectorBytes(instanceSeg)
+        + vectorBytes(instanceSegImg);
+    for (int k = 0; k < VELODYNE_OUTPUT_COUNT; ++k) {
+        total += vectorBytes(velodyne[k]);
+    }
+    return total;
+}
+
+void FrameBufferSet::repackPointCloud(const float* pointCloud, int points, float* entityOut) {
+    static_assert(FLOATS_PER_POINT == 3 + VELODYNE_OUTPUT_COUNT, "one velodyne output per LiDAR point value");
+
+    float* out[VELODYNE_OUTPUT_COUNT];
+    for (int k = 0; k < VELODYNE_OUTPUT_COUNT; ++k) {
+        out[k] = velodyne[k].data();
+    }
+    if (entityOut) out[VELODYNE_ENTITY] = entityOut;
+    for (int n = 0; n < points; ++n) {
+        const float* p = pointCloud + n * FLOATS_PER_POINT;
+        for (int k = 0; k < VELODYNE_OUTPUT_COUNT; ++k) {
+            float* o = out[k] + n * VELODYNE_FLOATS_PER_POINT;
+            o[0] = p[0];
+            o[1] = p[1];
+            o[2] = p[2];
+            o[3] = p[3 + k];
+        }
+    }
+}
+
+size_t FrameBufferPool::init(int width, int height, int lidarPoints, int slots) {
+    size_t pixels = (size_t)width * height;
+    m_sets.clear();
+    m_sets.resize(slots > 0 ? slots : 1);
+    m_next = 0;
+    for (FrameBufferSet& set : m_sets) {
+        //Zero filled, next() clears the accumulated images again when the set is reused
+        set.dmPointClouds.assign(pixels * FLOATS_PER_POINT, 0.0f);
+        set.dmImage.assign(pixels, 0);
+        set.stencilImage.assign(pixels, 0);
+        set.occlusionImage.assign(pixels, 0);
+        set.unusedStencilImage.assign(pixels, 0);
+        set.groundPointsImage.assign(pixels, 0);
+        set.stencilSeg.assign(pixels * 3, 0);
+        set.instanceSeg.assign(pixels, 0);
+        set.instanceSegImg.assign(pixels * 3, 0);
+        for (int k = 0; k < VELODYNE_OUTPUT_COUNT; ++k) {
+            set.velodyne[k].assign((size_t)lidarPoints * VELODYNE_FLOATS_PER_POINT, 0.0f);
+        }
+    }
+    return bytes();
+}
+
+FrameBufferSet& FrameBufferPool::next() {
+    FrameBufferSet& set = m_sets[m_next];
+    m_next = (m_next + 1) % (int)m_sets.size();
+
+    std::fill(set.occlusionImage.begin(), set.occlusionImage.end(), 0);
+    std::fill(set.unusedStencilImage.begin(), set.unusedStencilImage.end(), 0);
+    std::fill(set.stencilSeg.begin(), set.stencilSeg.end(), 0);
+    std::fill(set.instanceSeg.begin(), set.instanceSeg.end(), 0);
+    std::fill(set.instanceSegImg.begin(), set.instanceSegImg.end(), 0);
+    return set;
+}
+
+size_t FrameBufferPool::bytes() const {
+    size_t total = 0;
+    for (const FrameBufferSet& set : m_sets) {
+        total += set.bytes();
+    }
+    return total;
+}
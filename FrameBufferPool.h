@@ -0,0 +1,61 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+//Per-frame working buffers of ObjectDetection, sized from the camera resolution and the LiDAR beam count.
+//The pool holds FRAMES_IN_FLIGHT sets and hands them out round robin. A set is only cleared when next()
+//hands it out again, so a frame's buffers stay valid while the following frames are filled.
+//Memory is owned by the pool and released with it.
+
+//Point cloud layouts written to the velodyne_* folders (x, y, z and one value per point).
+//In the order of the values after x, y, z in a LiDAR point (FLOATS_PER_POINT).
+enum VelodyneOutput {
+    VELODYNE_ENTITY,//Entity ID as intensity (default PreSIL output)
+    VELODYNE_GT_CAR,//1 for 'Car' points, 0 otherwise
+    VELODYNE_ZERO_INTENSITY,//All points 0
+    VELODYNE_RADIAL_VELOCITY,//Relative velocity
+    VELODYNE_ABS_SPEED,//Absolute speed
+    VELODYNE_MOVING,//1 for points on moving objects, 0 otherwise
+    VELODYNE_GT_PED,//1 for 'Pedestrian' points, 0 otherwise
+    VELODYNE_OUTPUT_COUNT
+};
+const int VELODYNE_FLOATS_PER_POINT = 4;
+
+struct FrameBufferSet {
+    //Image sized (width * height pixels)
+    std::vector<float> dmPointClouds;//FLOATS_PER_POINT per pixel
+    std::vector<uint16_t> dmImage;
+    std::vector<uint8_t> stencilImage;
+    std::vector<uint8_t> occlusionImage;
+    std::vector<uint8_t> unusedStencilImage;
+    std::vector<uint8_t> groundPointsImage;
+    std::vector<uint8_t> stencilSeg;//RGB
+    std::vector<uint32_t> instanceSeg;
+    std::vector<uint8_t> instanceSegImg;//RGB
+
+    //Point sized (LiDAR beams * LIDAR_POINTS_PER_BEAM points)
+    std::vector<float> velodyne[VELODYNE_OUTPUT_COUNT];
+
+    size_t bytes() const;
+    //Splits points LiDAR points (FLOATS_PER_POINT floats each) into the velodyne outputs.
+    //entityOut replaces velodyne[VELODYNE_ENTITY] when set (e.g. a frame ring record).
+    void repackPointCloud(const float* pointCloud, int points, float* entityOut = NULL);
+};
+
+class FrameBufferPool {
+public:
+    //Allocates slots buffer sets and returns the resident bytes of all of them
+    size_t init(int width, int height, int lidarPoints, int slots);
+    bool isInit() const { return !m_sets.empty(); }
+
+    //Buffers for the next frame (the oldest set), with the images that are accumulated over a frame
+    //(segmentation, occlusion and unused stencil pixels) cleared. The others are overwritten every frame.
+    FrameBufferSet& next();
+    size_t bytes() const;
+
+private:
+    std::vector<FrameBufferSet> m_sets;
+    int m_next = 0;
+};
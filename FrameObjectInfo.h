@@ -1,80 +1,107 @@
 #pragma once
 
-#include <map>
+#include "GeometryCore.h"
+#include <memory>
+#include <string>
+#include <vector>
 
-struct ObjEntity {
-    int entityID;
-    int classID;
+//Label fields of an entity which are set once per frame and read once at export (strings, velocities,
+//model info). The fields the per pixel passes touch are in ObjEntity, EntityTable keeps those in hot arrays.
+struct EntityRecord {
+    int classID = 0;
 
     //Consistent with kitti coordinate system (relative to camera)
-    Vector3 location;
-    Vector3 worldPos;//To reduce calculations. Center of object at it's bottom
-    float speed;
-    float heading;
-    float height;
-    float width;
-    float length;
-    Vector3 dim;
-    Vector3 offcenter;
-
-    float rotation_y;
-    float alpha;
+    Vector3 location{};
+    Vector3 worldPos{};//To reduce calculations. Center of object at it's bottom
+    float speed = 0;
+    float heading = 0;
+    float height = 0;
+    float width = 0;
+    float length = 0;
+    Vector3 dim{};
+    Vector3 offcenter{};
+
+    float rotation_y = 0;
+    float alpha = 0;
     
-    float distance;
-    BBox2D bbox2d;
-    BBox2D bbox2dUnprocessed;
+    float distance = 0;
     
-    int pointsHit3D;
-    int pointsHit2D;
-    float truncation;
-    int occlusion;
+    int pointsHit3D = 0;
+    float truncation = 0;
+    int occlusion = 0;
+    float visibility = 1.0f;//Fraction of the entity's pixels which are not occluded (occlusion is this in 3 levels)
 
-    Hash model;
+    Hash model = 0;
     std::string modelString;
     std::string objType;
 
-    int trackFirstFrame; //First frame (of sequence) it is seen in
+    int trackFirstFrame = 0; //First frame (of sequence) it is seen in
 
     //These are in world coords right now (probably needs to be changed)
-    float pitch;
-    float roll;
+    float pitch = 0;
+    float roll = 0;
 
     bool isPedInV = false;
-    int vPedIsIn;
+    int vPedIsIn = 0;
 
+    //Tractor of a trailer, or trailer of a tractor (0 if none)
+    int towLink = 0;
 
-    //The following are saved to reduce calculations for checking if each pixels
-    //resides in the 3D bounding box of an entity
     //Vectors which transform from vehicle into world coordinates
-    Vector3 xVector;
-    Vector3 yVector;
-    Vector3 zVector;
-    Vector3 u;
-    Vector3 v;
-    Vector3 w;
-
-    Vector3 rearBotLeft;
-    Vector3 frontBotLeft;
-    Vector3 rearTopLeft;
-    Vector3 rearBotRight;
-    Vector3 rearMiddleLeft;
-    Vector3 rearThirdLeft;
-    Vector3 rearTopExactLeft;
+    //(the box test geometry built from them is kept in EntityTable::boxes)
+    Vector3 xVector{};
+    Vector3 yVector{};
+    Vector3 zVector{};
 
     /* New augmented label outputs */
-    Vector3 entity_velocity_vector;
-    Vector3 own_vehicle_velocity_vector;
-    Vector3 entity_world_coordinates;
-    Vector3 player_world_coordinates;
-    Vector3 entity_velocity_vector_camcoords;
-    Vector3 own_vehicle_velocity_vector_camcoords;
+    Vector3 entity_velocity_vector{};
+    Vector3 own_vehicle_velocity_vector{};
+    Vector3 entity_world_coordinates{};
+    Vector3 player_world_coordinates{};
+    Vector3 entity_velocity_vector_camcoords{};
+    Vector3 own_vehicle_velocity_vector_camcoords{};
+};
+
+//A whole entity, as built by getEntityVector and handed to the label writers.
+//Inside an EntityTable only the EntityRecord part is stored as is (see EntityTable::entity).
+struct ObjEntity : EntityRecord {
+    int entityID = 0;
+
+    BBox2D bbox2d;
+    BBox2D bbox2dUnprocessed;
+    int pointsHit2D = 0;
+
+    //False for entities kept only for augmented labels (bounding sphere outside the camera frustum).
+    //These are left out of all per pixel tests.
+    bool inFrustum = true;
 
     ObjEntity(int _entityID) : entityID(_entityID) {};
     ObjEntity() {};
 };
 
-typedef std::pair<int, ObjEntity> EntityMapEntry;
-typedef std::map<int, ObjEntity> EntityMap;
+//Per frame counts of the entity cull tiers (see snapshotEntities)
+struct CullStats {
+    int full = 0;
+    int augment = 0;
+    int skipped = 0;
+};
+
+//Per frame counts for the entity state store (see EntityState.h)
+struct EntityStateStats {
+    int reused = 0;//Pose and model unchanged, geometry reused
+    int recomputed = 0;//New or moved entities
+    int evicted = 0;//No longer in the world (or culled)
+};
+
+class EntityTable;
+
+//Read only view of the vehicles or peds of a frame (see EntityTable.h). It keeps its table alive,
+//ObjectDetection only refills a table in place once no view of it is left.
+struct EntityTableView {
+    std::shared_ptr<const EntityTable> table;
+
+    int size() const;
+};
 
 struct FrameObjectInfo
 {
@@ -99,10 +126,11 @@ struct FrameObjectInfo
     float focalLen;
     int timeHours;//In-game time of day (hours)
 
-    //These are maps for when we do 4 cameras for full LiDAR
-    //It will enable quicker checking to see if entity is already discovered
-    EntityMap vehicles;
-    EntityMap peds;
+    EntityTableView vehicles;
+    EntityTableView peds;
+    CullStats vehicleCull;
+    CullStats pedCull;
+    EntityStateStats entityState;
 
     std::vector<Vector3> groundPlanePoints;
 };
\ No newline at end of file
@@ -0,0 +1,332 @@
+#include "FrameRing.h"
+#include <string.h>
+#include <new>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+//Slots start on cache line boundaries so the producer and readers of different slots don't share lines
+static const size_t FRAME_RING_ALIGN = 64;
+
+static size_t alignUp(size_t v) {
+    return (v + FRAME_RING_ALIGN - 1) & ~(FRAME_RING_ALIGN - 1);
+}
+
+static size_t headerBytes() {
+    return alignUp(sizeof(FrameRingHeader));
+}
+
+static size_t slotBytes(uint32_t slotSize) {
+    return alignUp(sizeof(FrameSlotHeader)) + alignUp(slotSize);
+}
+
+static FrameSlotHeader* slotAt(uint8_t* base, const FrameRingHeader* header, uint64_t frameSeq) {
+    size_t idx = (size_t)((frameSeq - 1) % header->slotCount);
+    return (FrameSlotHeader*)(base + headerBytes() + idx * slotBytes(header->slotSize));
+}
+
+static uint8_t* slotData(FrameSlotHeader* slot) {
+    return (uint8_t*)slot + alignUp(sizeof(FrameSlotHeader));
+}
+
+/* ------------------------------ SharedMapping ------------------------------ */
+
+SharedMapping::~SharedMapping() {
+    close();
+}
+
+#ifdef _WIN32
+bool SharedMapping::create(const std::string& name, size_t size) {
+    close();
+    std::string mapName = "Local\\" + name;
+    HANDLE hMap = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE,
+        (DWORD)((uint64_t)size >> 32), (DWORD)(size & 0xFFFFFFFF), mapName.c_str());
+    if (hMap == NULL) return false;
+
+    m_pData = (uint8_t*)MapViewOfFile(hMap, FILE_MAP_ALL_ACCESS, 0, 0, size);
+    if (m_pData == NULL) {
+        CloseHandle(hMap);
+        return false;
+    }
+    m_hMap = hMap;
+    m_size = size;
+    m_owner = true;
+    m_name = mapName;
+    return true;
+}
+
+bool SharedMapping::open(const std::string& name) {
+    close();
+    std::string mapName = "Local\\" + name;
+    HANDLE hMap = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, mapName.c_str());
+    if (hMap == NULL) return false;
+
+    m_pData = (uint8_t*)MapViewOfFile(hMap, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+    if (m_pData == NULL) {
+        CloseHandle(hMap);
+        return false;
+    }
+    MEMORY_BASIC_INFORMATION info;
+    VirtualQuery(m_pData, &info, sizeof(info));
+    m_hMap = hMap;
+    m_size = info.RegionSize;
+    m_owner = false;
+    m_name = mapName;
+    return true;
+}
+
+void SharedMapping::close() {
+    if (m_pData) UnmapViewOfFile(m_pData);
+    if (m_hMap) CloseHandle((HANDLE)m_hMap);
+    m_pData = NULL;
+    m_hMap = NULL;
+    m_size = 0;
+}
+#else
+bool SharedMapping::create(const std::string& name, size_t size) {
+    close();
+    std::string shmName = "/" + name;
+    int fd = shm_open(shmName.c_str(), O_CREAT | O_RDWR, 0666);
+    if (fd < 0) return false;
+    if (ftruncate(fd, (off_t)size) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    void* p = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED) {
+        ::close(fd);
+        return false;
+    }
+    m_pData = (uint8_t*)p;
+    m_fd = fd;
+    m_size = size;
+    m_owner = true;
+    m_name = shmName;
+    return true;
+}
+
+bool SharedMapping::open(const std::string& name) {
+    close();
+    std::string shmName = "/" + name;
+    int fd = shm_open(shmName.c_str(), O_RDWR, 0666);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        ::close(fd);
+        return false;
+    }
+    void* p = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED) {
+        ::close(fd);
+        return false;
+    }
+    m_pData = (uint8_t*)p;
+    m_fd = fd;
+    m_size = (size_t)st.st_size;
+    m_owner = false;
+    m_name = shmName;
+    return true;
+}
+
+void SharedMapping::close() {
+    if (m_pData) munmap(m_pData, m_size);
+    if (m_fd >= 0) ::close(m_fd);
+    if (m_owner && !m_name.empty()) shm_unlink(m_name.c_str());
+    m_pData = NULL;
+    m_fd = -1;
+    m_size = 0;
+    m_owner = false;
+}
+#endif
+
+/* ------------------------------ FrameRingProducer ------------------------------ */
+
+bool FrameRingProducer::init(const std::string& name, uint32_t slotCount, uint32_t slotSize) {
+    if (slotCount == 0) return false;
+    size_t total = headerBytes() + slotCount * slotBytes(slotSize);
+    if (!m_mapping.create(name, total)) return false;
+
+    uint8_t* base = m_mapping.data();
+    memset(base, 0, total);
+    m_pHeader = new (base) FrameRingHeader();
+    m_pHeader->slotCount = slotCount;
+    m_pHeader->slotSize = (uint32_t)alignUp(slotSize);
+    m_pHeader->version = FRAME_RING_VERSION;
+    m_pHeader->published.store(0, std::memory_order_relaxed);
+    for (uint32_t s = 1; s <= slotCount; ++s) {
+        new (slotAt(base, m_pHeader, s)) FrameSlotHeader();
+    }
+    //Readers check the magic last so they never see a half initialised ring
+    std::atomic_thread_fence(std::memory_order_release);
+    m_pHeader->magic = FRAME_RING_MAGIC;
+    m_frameSeq = 0;
+    m_pSlot = NULL;
+    return true;
+}
+
+void FrameRingProducer::beginFrame(int instanceIndex, int seriesIndex) {
+    if (!m_pHeader) return;
+    if (m_pSlot) publishFrame();
+
+    ++m_frameSeq;
+    m_pSlot = slotAt(m_mapping.data(), m_pHeader, m_frameSeq);
+    //Odd sequence marks the slot as being written so readers still holding it see it is gone
+    m_pSlot->seq.store(2 * m_frameSeq - 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    m_pSlot->frameSeq = m_frameSeq;
+    m_pSlot->instanceIndex = instanceIndex;
+    m_pSlot->seriesIndex = seriesIndex;
+    m_pSlot->recordCount = 0;
+    m_pSlot->usedBytes = 0;
+}
+
+void* FrameRingProducer::reserveRecord(FrameRecordType type, uint32_t size, int width, int height) {
+    if (!m_pSlot || m_pSlot->recordCount >= FRAME_RING_MAX_RECORDS) return NULL;
+    size_t offset = alignUp(m_pSlot->usedBytes);
+    if (offset + size > m_pHeader->slotSize) return NULL;
+
+    FrameRecord& rec = m_pSlot->records[m_pSlot->recordCount++];
+    rec.type = type;
+    rec.offset = (uint32_t)offset;
+    rec.size = size;
+    rec.width = width;
+    rec.height = height;
+    m_pSlot->usedBytes = (uint32_t)(offset + size);
+    return slotData(m_pSlot) + offset;
+}
+
+bool FrameRingProducer::addRecord(FrameRecordType type, const void* data, uint32_t size, int width, int height) {
+    void* dst = reserveRecord(type, size, width, height);
+    if (!dst) return false;
+    memcpy(dst, data, size);
+    return true;
+}
+
+void FrameRingProducer::publishFrame() {
+    if (!m_pSlot) return;
+    m_pSlot->seq.store(2 * m_frameSeq, std::memory_order_release);
+    m_pHeader->published.store(m_frameSeq, std::memory_order_release);
+    m_pSlot = NULL;
+}
+
+/* ------------------------------ FrameRingReader ------------------------------ */
+
+const uint8_t* FrameView::find(FrameRecordType type, uint32_t* size) const {
+    for (size_t k = 0; k < records.size(); ++k) {
+        if (records[k].type == (uint32_t)type) {
+            if (size) *size = records[k].size;
+            return data[k];
+        }
+    }
+    return NULL;
+}
+
+bool FrameRingReader::attach(const std::string& name, bool fromOldest) {
+    if (!m_mapping.open(name)) return false;
+    if (m_mapping.size() < headerBytes()) {
+        m_mapping.close();
+        return false;
+    }
+    FrameRingHeader* header = (FrameRingHeader*)m_mapping.data();
+    if (header->magic != FRAME_RING_MAGIC || header->version != FRAME_RING_VERSION ||
+        m_mapping.size() < headerBytes() + header->slotCount * slotBytes(header->slotSize)) {
+        m_mapping.close();
+        return false;
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    m_pHeader = header;
+
+    uint64_t published = m_pHeader->published.load(std::memory_order_acquire);
+    if (fromOldest) {
+        m_nextSeq = published > m_pHeader->slotCount ? published - m_pHeader->slotCount + 1 : 1;
+    }
+    else {
+        m_nextSeq = published > 0 ? published : 1;
+    }
+    m_dropped = 0;
+    return true;
+}
+
+const FrameSlotHeader* FrameRingReader::slot(uint64_t frameSeq) const {
+    return slotAt(m_mapping.data(), m_pHeader, frameSeq);
+}
+
+bool FrameRingReader::next(FrameView& view) {
+    if (!m_pHeader) return false;
+    uint64_t published = m_pHeader->published.load(std::memory_order_acquire);
+    if (m_nextSeq > published) return false;
+
+    //Lapped by the producer: skip to the oldest frame still in the ring
+    if (published - m_nextSeq >= m_pHeader->slotCount) {
+        uint64_t oldest = published - m_pHeader->slotCount + 1;
+        m_dropped += oldest - m_nextSeq;
+        m_nextSeq = oldest;
+    }
+
+    const FrameSlotHeader* s = slot(m_nextSeq);
+    uint64_t seq1 = s->seq.load(std::memory_order_acquire);
+    if (seq1 != 2 * m_nextSeq) {
+        //Overwritten between reading published and the slot
+        ++m_dropped;
+        ++m_nextSeq;
+        return false;
+    }
+
+    view.frameSeq = s->frameSeq;
+    view.instanceIndex = s->instanceIndex;
+    view.seriesIndex = s->seriesIndex;
+    uint32_t count = s->recordCount;
+    if (count > FRAME_RING_MAX_RECORDS) count = FRAME_RING_MAX_RECORDS;
+    view.records.assign(s->records, s->records + count);
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (s->seq.load(std::memory_order_relaxed) != seq1) {
+        ++m_dropped;
+        ++m_nextSeq;
+        return false;
+    }
+
+    const uint8_t* base = slotData((FrameSlotHeader*)s);
+    view.data.resize(view.records.size());
+    for (size_t k = 0; k < view.records.size(); ++k) {
+        const FrameRecord& rec = view.records[k];
+        view.data[k] = (rec.offset + (uint64_t)rec.size <= m_pHeader->slotSize) ? base + rec.offset : NULL;
+    }
+    ++m_nextSeq;
+    return true;
+}
+
+bool FrameRingReader::stillValid(const FrameView& view) const {
+    if (!m_pHeader || view.frameSeq == 0) return false;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return slot(view.frameSeq)->seq.load(std::memory_order_relaxed) == 2 * view.frameSeq;
+}
+
+bool FrameRingReader::copyFrame(FrameView& view, std::vector<uint8_t>& buffer) {
+    if (!next(view)) return false;
+
+    size_t total = 0;
+    for (const FrameRecord& rec : view.records) total += rec.size;
+    buffer.resize(total);
+
+    size_t offset = 0;
+    for (size_t k = 0; k < view.records.size(); ++k) {
+        if (view.data[k]) memcpy(buffer.data() + offset, view.data[k], view.records[k].size);
+        view.data[k] = buffer.data() + offset;
+        offset += view.records[k].size;
+    }
+    if (!stillValid(view)) {
+        ++m_dropped;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <atomic>
+
+//Shared memory ring of captured frames for live consumers (online training, QA)
+//Windows: named file mapping (Local\<name>), Linux: POSIX shm (/<name>)
+//
+//The producer never waits on readers. Each slot is guarded by a seqlock: the slot sequence is odd
+//while it is being written and 2 * frameSeq once frame frameSeq is complete. A reader that falls more
+//than slotCount frames behind skips ahead and counts the skipped frames as dropped.
+
+const uint32_t FRAME_RING_MAGIC = 0x47524654;//"TFRG" little-endian
+const uint32_t FRAME_RING_VERSION = 1;
+const int FRAME_RING_MAX_RECORDS = 16;
+
+enum FrameRecordType {
+    FRAME_RECORD_DEPTH = 1,//float NDC, width * height
+    FRAME_RECORD_STENCIL = 2,//uint8_t, width * height
+    FRAME_RECORD_INSTANCE_SEG = 3,//uint32_t entity IDs, width * height
+    FRAME_RECORD_POINT_CLOUD = 4,//float x, y, z, entity ID per point (velodyne_entity layout)
+    FRAME_RECORD_LABELS = 5//KITTI label_2 text
+};
+
+struct FrameRingHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t slotCount;
+    uint32_t slotSize;//Bytes of record data per slot
+    std::atomic<uint64_t> published;//Number of completed frames
+};
+
+struct FrameRecord {
+    uint32_t type;
+    uint32_t offset;//From the start of the slot data
+    uint32_t size;
+    int32_t width;
+    int32_t height;
+};
+
+struct FrameSlotHeader {
+    std::atomic<uint64_t> seq;
+    uint64_t frameSeq;
+    int32_t instanceIndex;
+    int32_t seriesIndex;
+    uint32_t recordCount;
+    uint32_t usedBytes;
+    FrameRecord records[FRAME_RING_MAX_RECORDS];
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Frame ring needs lock free 64 bit atomics");
+
+//Platform shared memory mapping used by both ends
+class SharedMapping {
+public:
+    ~SharedMapping();
+    bool create(const std::string& name, size_t size);
+    bool open(const std::string& name);
+    void close();
+    uint8_t* data() const { return m_pData; }
+    size_t size() const { return m_size; }
+
+private:
+    uint8_t* m_pData = NULL;
+    size_t m_size = 0;
+    bool m_owner = false;
+    std::string m_name;
+#ifdef _WIN32
+    void* m_hMap = NULL;
+#else
+    int m_fd = -1;
+#endif
+};
+
+class FrameRingProducer {
+public:
+    bool init(const std::string& name, uint32_t slotCount, uint32_t slotSize);
+    bool isOpen() const { return m_pHeader != NULL; }
+
+    //Starts writing the next slot. An unfinished frame is published first.
+    void beginFrame(int instanceIndex, int seriesIndex);
+    //Returns a pointer into the slot for the caller to fill (NULL if the frame is full). Buffers that are
+    //built during the frame should be written here directly, the memory is not cleared.
+    void* reserveRecord(FrameRecordType type, uint32_t size, int width = 0, int height = 0);
+    //Copies a record in, for data that already lives elsewhere (e.g. the captured depth and stencil)
+    bool addRecord(FrameRecordType type, const void* data, uint32_t size, int width = 0, int height = 0);
+    //Makes the frame visible to readers
+    void publishFrame();
+    bool inFrame() const { return m_pSlot != NULL; }
+
+private:
+    SharedMapping m_mapping;
+    FrameRingHeader* m_pHeader = NULL;
+    FrameSlotHeader* m_pSlot = NULL;
+    uint64_t m_frameSeq = 0;
+};
+
+//Records of one frame. Pointers reference the shared mapping and must be checked with
+//FrameRingReader::stillValid after use, or copied out with FrameRingReader::copyFrame.
+struct FrameView {
+    uint64_t frameSeq = 0;
+    int instanceIndex = 0;
+    int seriesIndex = 0;
+    std::vector<FrameRecord> records;
+    std::vector<const uint8_t*> data;
+
+    const uint8_t* find(FrameRecordType type, uint32_t* size = NULL) const;
+};
+
+class FrameRingReader {
+public:
+    //Attaches by name. Starts at the newest frame unless fromOldest is set.
+    bool attach(const std::string& name, bool fromOldest = false);
+    bool isOpen() const { return m_pHeader != NULL; }
+
+    //Returns false if no new frame is available (or the next one was overwritten mid-read)
+    bool next(FrameView& view);
+    bool stillValid(const FrameView& view) const;
+    //Copies the next frame's records out of the ring, validating afterwards
+    bool copyFrame(FrameView& view, std::vector<uint8_t>& buffer);
+
+    uint64_t dropped() const { return m_dropped; }
+
+private:
+    const FrameSlotHeader* slot(uint64_t frameSeq) const;
+
+    SharedMapping m_mapping;
+    FrameRingHeader* m_pHeader = NULL;
+    uint64_t m_nextSeq = 1;
+    uint64_t m_dropped = 0;
+};
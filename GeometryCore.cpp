@@ -0,0 +1,333 @@
+#include "GeometryCore.h"
+#include "FrameObjectInfo.h"
+#include "Logger.h"
+#include <algorithm>
+
+//Global variable for storing camera parameters
+CamParams s_camParams;
+
+Vector3 camToWorld(Vector3 relPos, Vector3 camForward, Vector3 camRight, Vector3 camUp) {
+    Vector3 worldX; worldX.x = 1; worldX.y = 0; worldX.z = 0;
+    Vector3 worldY; worldY.x = 0; worldY.y = 1; worldY.z = 0;
+    Vector3 worldZ; worldZ.x = 0; worldZ.y = 0; worldZ.z = 1;
+    Vector3 xVectorCam = convertCoordinateSystem(worldX, camForward, camRight, camUp);
+    Vector3 yVectorCam = convertCoordinateSystem(worldY, camForward, camRight, camUp);
+    Vector3 zVectorCam = convertCoordinateSystem(worldZ, camForward, camRight, camUp);
+
+    Vector3 worldPos = convertCoordinateSystem(relPos, yVectorCam, xVectorCam, zVectorCam);
+    worldPos.x += s_camParams.pos.x;
+    worldPos.y += s_camParams.pos.y;
+    worldPos.z += s_camParams.pos.z;
+
+    return worldPos;
+}
+
+void updateCamEigen(CamParams& cam) {
+    cam.eigenPos = Eigen::Vector3f(cam.pos.x, cam.pos.y, cam.pos.z);
+    cam.eigenRot = Eigen::Vector3f(cam.theta.x, cam.theta.y, cam.theta.z);
+    cam.eigenTheta = (PI / 180.0) * cam.eigenRot;
+    cam.eigenCamDir = rotate(WORLD_NORTH, cam.eigenTheta);
+    cam.eigenCamUp = rotate(WORLD_UP, cam.eigenTheta);
+    cam.eigenCamEast = rotate(WORLD_EAST, cam.eigenTheta);
+    cam.eigenClipPlaneCenter = cam.eigenPos + cam.nearClip * cam.eigenCamDir;
+    cam.eigenCameraCenter = -cam.nearClip * cam.eigenCamDir;
+}
+
+Eigen::Vector2f projectToScreen(const CamParams& cam, const Eigen::Vector3f& vertex) {
+    // Inspired by Artur Filopowicz: Video Games for Autonomous Driving: https://github.com/arturf1/GTA5-Scripts/blob/master/Annotator.cs#L379
+    const Eigen::Vector3f near_clip_to_target = vertex - cam.eigenClipPlaneCenter; // del
+
+    Eigen::Vector3f camera_to_target = near_clip_to_target - cam.eigenCameraCenter; // Total distance - subtracting a negative to add clip distance
+
+    Eigen::Vector3f camera_to_target_unit_vector = camera_to_target * (1. / camera_to_target.norm()); // Unit vector in direction of plane / line intersection
+
+    double view_plane_dist = cam.nearClip / cam.eigenCamDir.dot(camera_to_target_unit_vector);
+
+    Eigen::Vector3f new_origin = cam.eigenClipPlaneCenter + (cam.ncHeight / 2.) * cam.eigenCamUp - (cam.ncWidth / 2.) * cam.eigenCamEast;
+
+    Eigen::Vector3f view_plane_point = view_plane_dist * camera_to_target_unit_vector + cam.eigenCameraCenter;
+    view_plane_point = (view_plane_point + cam.eigenClipPlaneCenter) - new_origin;
+    double viewPlaneX = view_plane_point.dot(cam.eigenCamEast) / cam.eigenCamEast.dot(cam.eigenCamEast);
+    double viewPlaneZ = view_plane_point.dot(cam.eigenCamUp) / cam.eigenCamUp.dot(cam.eigenCamUp);
+    double screenX = viewPlaneX / (double)cam.ncWidth;
+    double screenY = -viewPlaneZ / (double)cam.ncHeight;
+    return Eigen::Vector2f(screenX, screenY);
+}
+
+float depthFromNDC(const CamParams& cam, const float* depthMap, int x, int y) {
+    if (x >= cam.width) {
+        x = cam.width - 1;
+    }
+    if (y >= cam.height) {
+        y = cam.height - 1;
+    }
+
+    float xNorm = (float)x / (cam.width - 1);
+    float yNorm = (float)y / (cam.height - 1);
+    float normScreenX = fabsf(2 * xNorm - 1);
+    float normScreenY = fabsf(2 * yNorm - 1);
+
+    float ncX = normScreenX * cam.ncWidth / 2;
+    float ncY = normScreenY * cam.ncHeight / 2;
+
+    //Distance to near clip (hypotenus)
+    float d2nc = sqrtf(cam.nearClip * cam.nearClip + ncX * ncX + ncY * ncY);
+
+    //depth value in normalized device coordinates (NDC)
+    float ndc = depthMap[y * cam.width + x];
+
+    //Conversion from ndc to depth in camera coordinates
+    float depth = d2nc / ndc;
+    float depthDivisor = (cam.nearClip * depth) / (2 * cam.farClip);
+    depth = depth / (1 + depthDivisor);
+
+    return depth;
+}
+
+float depthFromScreenPos(const CamParams& cam, const float* depthMap, float screenX, float screenY) {
+    float halfW = 0.5f / cam.width;
+    float halfH = 0.5f / cam.height;
+    if (screenX > halfW && screenX < 1 - halfW
+        && screenY > halfH && screenY < 1 - halfH) {
+        //Need to do -0.5 as indexing starts at 0
+        float x = screenX * cam.width - 0.5f;
+        float y = screenY * cam.height - 0.5f;
+
+        int x0 = (int)floorf(x);
+        int x1 = (int)ceilf(x);
+        int y0 = (int)floorf(y);
+        int y1 = (int)ceilf(y);
+
+        float d00 = depthFromNDC(cam, depthMap, x0, y0);
+        float d01 = depthFromNDC(cam, depthMap, x0, y1);
+        float d10 = depthFromNDC(cam, depthMap, x1, y0);
+        float d11 = depthFromNDC(cam, depthMap, x1, y1);
+
+        //Normalize x/y to be between 0 and 1 to simplify interpolation
+        float normX = x - x0;
+        float normY = y - y0;
+
+        //Bilinear interpolation
+        //TODO: Would be better to use depth/stencil buffer to only interpolate on pixels of same object
+        float minDepth = std::min(d00, std::min(d01, std::min(d10, d11)));
+        float maxDepth = std::max(d00, std::max(d01, std::max(d10, d11)));
+        if (maxDepth <= minDepth * 1.08f) {
+            return (1 - normX)*(1 - normY)*d00 + normX * (1 - normY)*d10 + (1 - normX)*normY*d01 + normX * normY*d11;
+        }
+    }
+
+    //Pixels are 0 indexed
+    int x = (int)floorf(screenX * cam.width);
+    int y = (int)floorf(screenY * cam.height);
+    return depthFromNDC(cam, depthMap, x, y);
+}
+
+float focalLength(int width) {
+    return width / (2 * tan(HOR_CAM_FOV * PI / 360));
+}
+
+float observationAngle(Vector3 position, Vector3 camRight, Vector3 camUp) {
+    float x1 = camRight.x;
+    float y1 = camRight.y;
+    float z1 = camRight.z;
+    float x2 = position.x;
+    float y2 = position.y;
+    float z2 = position.z;
+    float xn = camUp.x;
+    float yn = camUp.y;
+    float zn = camUp.z;
+
+    float dot = x1 * x2 + y1 * y2 + z1 * z2;
+    float det = x1 * y2*zn + x2 * yn*z1 + xn * y1*z2 - z1 * y2*xn - z2 * yn*x1 - zn * y1*x2;
+    float observationAngle = atan2(det, dot);
+
+    LOG_DEBUG("Forward is: " << x1 << ", " << y1 << ", " << z1 <<
+        "\nNormal is: " << x2 << ", " << y2 << ", " << z2 <<
+        "\nPosition is: " << position.x << ", " << position.y << ", " << position.z << " and angle is: " << observationAngle);
+
+    return observationAngle;
+}
+
+void getRollAndPitch(Vector3 rightVector, Vector3 forwardVector,
+    Vector3 camForward, Vector3 camRight, Vector3 camUp, float &pitch, float &roll) {
+    Vector3 kittiForwardVector = convertCoordinateSystem(forwardVector, camForward, camRight, camUp);
+    Vector3 kittiRightVector = convertCoordinateSystem(rightVector, camForward, camRight, camUp);
+
+    roll = atan2(-kittiRightVector.z, sqrt(pow(kittiRightVector.y, 2) + pow(kittiRightVector.x, 2)));
+    pitch = atan2(-kittiForwardVector.z, sqrt(pow(kittiForwardVector.y, 2) + pow(kittiForwardVector.x, 2)));
+}
+
+Vector3 kittiLocation(const CamParams& cam, Vector3 worldPos, Vector3 camForward, Vector3 camRight, Vector3 camUp) {
+    Vector3 relativePos;
+    relativePos.x = worldPos.x - cam.pos.x;
+    relativePos.y = worldPos.y - cam.pos.y;
+    relativePos.z = worldPos.z - cam.pos.z;
+    relativePos = convertCoordinateSystem(relativePos, camForward, camRight, camUp);
+
+    //Convert to KITTI camera coordinates
+    Vector3 kittiPos;
+    kittiPos.x = relativePos.x;
+    kittiPos.y = -relativePos.z;
+    kittiPos.z = relativePos.y;
+    return kittiPos;
+}
+
+float kittiRotationY(Vector3 forwardVector, Vector3 camForward, Vector3 camRight, Vector3 camUp) {
+    Vector3 kittiForwardVector = convertCoordinateSystem(forwardVector, camForward, camRight, camUp);
+    return -atan2(kittiForwardVector.y, kittiForwardVector.x);
+}
+
+float kittiAlpha(float rotationY, Vector3 location) {
+    float beta_kitti = atan2(location.z, location.x);
+    return rotationY + beta_kitti - PI / 2;
+}
+
+int occlusionLevel(int occludingPoints, int entityPoints, float &visibility) {
+    float occtreshold = 1.0;
+    int divisor = occludingPoints + entityPoints;
+    if (divisor != 0) {
+        occtreshold = (float)occludingPoints / (float)(divisor);
+    }
+    visibility = 1.0f - occtreshold;
+    if (occtreshold < 0.2) return 0;
+    if (occtreshold < 0.6) return 1;
+    return 2;
+}
+
+Vector3 correctOffcenter(Vector3 position, Vector3 min, Vector3 max, Vector3 forwardVector, Vector3 rightVector, Vector3 upVector, Vector3 &offcenter) {
+    //Amount dimensions are offcenter
+    offcenter.x = (max.x + min.x) / 2;
+    offcenter.y = (max.y + min.y) / 2;
+    offcenter.z = min.z; //KITTI position is at object ground plane
+
+    //Converting vehicle dimensions from vehicle to world coordinates for offset position
+    Vector3 worldX; worldX.x = 1; worldX.y = 0; worldX.z = 0;
+    Vector3 worldY; worldY.x = 0; worldY.y = 1; worldY.z = 0;
+    Vector3 worldZ; worldZ.x = 0; worldZ.y = 0; worldZ.z = 1;
+    Vector3 xVector = convertCoordinateSystem(worldX, forwardVector, rightVector, upVector);
+    Vector3 yVector = convertCoordinateSystem(worldY, forwardVector, rightVector, upVector);
+    Vector3 zVector = convertCoordinateSystem(worldZ, forwardVector, rightVector, upVector);
+    Vector3 offcenterPosition = convertCoordinateSystem(offcenter, yVector, xVector, zVector);
+
+    //Update object position to be consistent with KITTI (symmetrical dimensions except for z which is ground)
+    position.x = position.x + offcenterPosition.x;
+    position.y = position.y + offcenterPosition.y;
+    position.z = position.z + offcenterPosition.z;
+
+    return position;
+}
+
+bool sphereInFrustum(const CamParams& cam, Vector3 camForward, Vector3 camRight, Vector3 camUp, const Vector3 &position, float radius) {
+    float rx = position.x - cam.pos.x;
+    float ry = position.y - cam.pos.y;
+    float rz = position.z - cam.pos.z;
+    float depth = rx * camForward.x + ry * camForward.y + rz * camForward.z;
+    if (depth < -radius) return false;
+
+    //fov is vertical
+    float tanV = tan(cam.fov / 2. * (PI / 180.));
+    float tanH = tanV * cam.width / cam.height;
+    float horiz = rx * camRight.x + ry * camRight.y + rz * camRight.z;
+    float vert = rx * camUp.x + ry * camUp.y + rz * camUp.z;
+
+    //Distance from a side plane is (|offset| - depth * tan) * cos, compare against the radius
+    if (fabsf(horiz) > depth * tanH + radius * sqrt(1 + tanH * tanH)) return false;
+    if (fabsf(vert) > depth * tanV + radius * sqrt(1 + tanV * tanV)) return false;
+    return true;
+}
+
+bool in3DBox(Vector3 point, Vector3 objPos, Vector3 dim, Vector3 yVector, Vector3 xVector, Vector3 zVector) {
+    Vector3 forward; forward.y = dim.y; forward.x = 0; forward.z = 0;
+    forward = convertCoordinateSystem(forward, yVector, xVector, zVector);
+
+    Vector3 right; right.x = dim.x; right.y = 0; right.z = 0;
+    right = convertCoordinateSystem(right, yVector, xVector, zVector);
+
+    Vector3 up; up.z = dim.z; up.x = 0; up.y = 0;
+    up = convertCoordinateSystem(up, yVector, xVector, zVector);
+
+    Vector3 rearBotLeft;
+    rearBotLeft.x = objPos.x - forward.x - right.x - up.x;
+    rearBotLeft.y = objPos.y - forward.y - right.y - up.y;
+    rearBotLeft.z = objPos.z - forward.z - right.z - up.z;
+
+    Vector3 frontBotLeft;
+    frontBotLeft.x = objPos.x + forward.x - right.x - up.x;
+    frontBotLeft.y = objPos.y + forward.y - right.y - up.y;
+    frontBotLeft.z = objPos.z + forward.z - right.z - up.z;
+
+    Vector3 rearTopLeft;
+    rearTopLeft.x = objPos.x - forward.x - right.x + up.x;
+    rearTopLeft.y = objPos.y - forward.y - right.y + up.y;
+    rearTopLeft.z = objPos.z - forward.z - right.z + up.z;
+
+    Vector3 rearBotRight;
+    rearBotRight.x = objPos.x - forward.x + right.x - up.x;
+    rearBotRight.y = objPos.y - forward.y + right.y - up.y;
+    rearBotRight.z = objPos.z - forward.z + right.z - up.z;
+
+    LOG_DEBUG(" rearBotLeft are: " << rearBotLeft.x << ", " << rearBotLeft.y << ", " << rearBotLeft.z <<
+        "\nfrontBotLeft: " << frontBotLeft.x << ", " << frontBotLeft.y << ", " << frontBotLeft.z <<
+        "\nrearTopLeft: " << rearTopLeft.x << ", " << rearTopLeft.y << ", " << rearTopLeft.z <<
+        "\nrearBotRight: " << rearBotRight.x << ", " << rearBotRight.y << ", " << rearBotRight.z <<
+        "\ndim: " << dim.x << ", " << dim.y << ", " << dim.z);
+
+    Vector3 u = getUnitVector(subtractVecs(frontBotLeft, rearBotLeft));
+    Vector3 v = getUnitVector(subtractVecs(rearTopLeft, rearBotLeft));
+    Vector3 w = getUnitVector(subtractVecs(rearBotRight, rearBotLeft));
+
+    if (!checkDirection(u, point, rearBotLeft, frontBotLeft)) return false;
+    if (!checkDirection(v, point, rearBotLeft, rearTopLeft)) return false;
+    if (!checkDirection(w, point, rearBotLeft, rearBotRight)) return false;
+
+    return true;
+}
+
+//Point and objPos should be in world coordinates
+void setEntityBBoxParameters(const EntityRecord &e, EntityBox &box) {
+
+    //Added BBOX_ADJUSTMENT_FACTOR as detailed models sometimes go outside 3D bboxes
+    Vector3 forward; forward.y = e.dim.y * BBOX_ADJUSTMENT_FACTOR; forward.x = 0; forward.z = 0;
+    forward = convertCoordinateSystem(forward, e.yVector, e.xVector, e.zVector);
+
+    Vector3 right; right.x = e.dim.x * BBOX_ADJUSTMENT_FACTOR; right.y = 0; right.z = 0;
+    right = convertCoordinateSystem(right, e.yVector, e.xVector, e.zVector);
+
+    Vector3 up; up.z = e.dim.z; up.x = 0; up.y = 0;
+    up = convertCoordinateSystem(up, e.yVector, e.xVector, e.zVector);
+
+    //position is given at bottom of bounding box (as per kitti)
+    Vector3 objPos = e.worldPos;
+
+    box.rearBotLeft.x = objPos.x - forward.x - right.x - up.x * (BBOX_ADJUSTMENT_FACTOR - 1);
+    box.rearBotLeft.y = objPos.y - forward.y - right.y - up.y * (BBOX_ADJUSTMENT_FACTOR - 1);
+    box.rearBotLeft.z = objPos.z - forward.z - right.z - up.z * (BBOX_ADJUSTMENT_FACTOR - 1);
+
+    box.frontBotLeft.x = objPos.x + forward.x - right.x - up.x * (BBOX_ADJUSTMENT_FACTOR - 1);
+    box.frontBotLeft.y = objPos.y + forward.y - right.y - up.y * (BBOX_ADJUSTMENT_FACTOR - 1);
+    box.frontBotLeft.z = objPos.z + forward.z - right.z - up.z * (BBOX_ADJUSTMENT_FACTOR - 1);
+
+    box.rearTopLeft.x = objPos.x - forward.x - right.x + 2 * up.x + up.x * BBOX_ADJUSTMENT_FACTOR;
+    box.rearTopLeft.y = objPos.y - forward.y - right.y + 2 * up.y + up.y * BBOX_ADJUSTMENT_FACTOR;
+    box.rearTopLeft.z = objPos.z - forward.z - right.z + 2 * up.z + up.z * BBOX_ADJUSTMENT_FACTOR;
+
+    box.rearBotRight.x = objPos.x - forward.x + right.x - up.x * (BBOX_ADJUSTMENT_FACTOR - 1);
+    box.rearBotRight.y = objPos.y - forward.y + right.y - up.y * (BBOX_ADJUSTMENT_FACTOR - 1);
+    box.rearBotRight.z = objPos.z - forward.z + right.z - up.z * (BBOX_ADJUSTMENT_FACTOR - 1);
+
+    box.rearMiddleLeft.x = objPos.x - forward.x - right.x + up.x;
+    box.rearMiddleLeft.y = objPos.y - forward.y - right.y + up.y;
+    box.rearMiddleLeft.z = objPos.z - forward.z - right.z + up.z;
+
+    box.rearThirdLeft.x = objPos.x - forward.x - right.x + 2 / 3 * up.x;
+    box.rearThirdLeft.y = objPos.y - forward.y - right.y + 2 / 3 * up.y;
+    box.rearThirdLeft.z = objPos.z - forward.z - right.z + 2 / 3 * up.z;
+
+    box.rearTopExactLeft.x = objPos.x - forward.x - right.x + 2 * up.x;
+    box.rearTopExactLeft.y = objPos.y - forward.y - right.y + 2 * up.y;
+    box.rearTopExactLeft.z = objPos.z - forward.z - right.z + 2 * up.z;
+
+    box.u = getUnitVector(subtractVecs(box.frontBotLeft, box.rearBotLeft));
+    box.v = getUnitVector(subtractVecs(box.rearTopLeft, box.rearBotLeft));
+    box.w = getUnitVector(subtractVecs(box.rearBotRight, box.rearBotLeft));
+}
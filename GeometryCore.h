@@ -0,0 +1,243 @@
+#pragma once
+
+#include "CoreTypes.h"
+#include <Eigen/Core>
+#include <math.h>
+#include "Constants.h"
+#include "CamParams.h"
+
+//Camera and bounding box geometry: unprojection of depth pixels, projection to the screen, box tests and the
+//KITTI label angles. Nothing here calls the game, so it is part of the headless core library (CMakeLists.txt).
+//Game queries stay in ObjectDetection/LiDAR, which pass their results in.
+
+struct EntityRecord;
+
+const float VERT_CAM_FOV = 59; //In degrees
+                               //Need to input the vertical FOV with GTA functions.
+                               //90 degrees horizontal (KITTI) corresponds to 59 degrees vertical (https://www.gtaall.com/info/fov-calculator.html).
+const float HOR_CAM_FOV = 90; //In degrees
+
+struct BBox2D {
+    float left;
+    float top;
+    float right;
+    float bottom;
+
+    float width() {
+        return right - left;
+    }
+
+    float height() {
+        return bottom - top;
+    }
+
+    float posX() {
+        return left + width() / 2;
+    }
+
+    float posY() {
+        return top + height() / 2;
+    }
+
+    BBox2D() :
+        left(s_camParams.width),
+        top(s_camParams.height),
+        right(0),
+        bottom(0)
+    {};
+};
+
+//Box test geometry in world coordinates (see setEntityBBoxParameters)
+struct EntityBox {
+    //Unit vectors along the box edges
+    Vector3 u;
+    Vector3 v;
+    Vector3 w;
+
+    Vector3 rearBotLeft;
+    Vector3 frontBotLeft;
+    Vector3 rearTopLeft;
+    Vector3 rearBotRight;
+    Vector3 rearMiddleLeft;
+    Vector3 rearThirdLeft;
+    Vector3 rearTopExactLeft;
+};
+
+// Converts a vector 'vec' into the coordinate system with the specified unit vectors in terms of the original coordinate system
+inline Vector3 convertCoordinateSystem(Vector3 vec, Vector3 forwardVector, Vector3 rightVector, Vector3 upVector) {
+    Vector3 newVec;
+
+    newVec.x = vec.x*rightVector.x + vec.y*rightVector.y + vec.z*rightVector.z;
+    newVec.y = vec.x*forwardVector.x + vec.y*forwardVector.y + vec.z*forwardVector.z;
+    newVec.z = vec.x*upVector.x + vec.y*upVector.y + vec.z*upVector.z;
+
+    return newVec;
+}
+
+inline Vector3 subtractVector(Vector3 first, Vector3 subtract) {
+    Vector3 diff;
+    diff.x = first.x - subtract.x;
+    diff.y = first.y - subtract.y;
+    diff.z = first.z - subtract.z;
+    return diff;
+}
+
+inline Eigen::Vector3f rotate(Eigen::Vector3f a, Eigen::Vector3f theta)
+{
+    Eigen::Vector3f d;
+
+    d(0) = (float)cos((double)theta(2))*((float)cos((double)theta(1))*a(0) + (float)sin((double)theta(1))*((float)sin((double)theta(0))*a(1) + (float)cos((double)theta(0))*a(2))) - (float)sin((double)theta(2))*((float)cos((double)theta(0))*a(1) - (float)sin((double)theta(0))*a(2));
+    d(1) = (float)sin((double)theta(2))*((float)cos((double)theta(1))*a(0) + (float)sin((double)theta(1))*((float)sin((double)theta(0))*a(1) + (float)cos((double)theta(0))*a(2))) + (float)cos((double)theta(2))*((float)cos((double)theta(0))*a(1) - (float)sin((double)theta(0))*a(2));
+    d(2) = -(float)sin((double)theta(1))*a(0) + (float)cos((double)theta(1))*((float)sin((double)theta(0))*a(1) + (float)cos((double)theta(0))*a(2));
+
+    return d;
+}
+
+inline Vector3 getUnitVector(Vector3 vector) {
+    float distance = sqrtf(vector.x * vector.x + vector.y * vector.y + vector.z * vector.z);
+    Vector3 unitVec;
+    unitVec.x = vector.x / distance;
+    unitVec.y = vector.y / distance;
+    unitVec.z = vector.z / distance;
+    return unitVec;
+}
+
+inline Vector3 subtractVecs(Vector3 first, Vector3 subtract) {
+    Vector3 difference;
+    difference.x = first.x - subtract.x;
+    difference.y = first.y - subtract.y;
+    difference.z = first.z - subtract.z;
+    return difference;
+}
+
+inline float dotProd(Vector3 first, Vector3 sec) {
+    return (first.x * sec.x + first.y * sec.y + first.z * sec.z);
+}
+
+//Squared distance between two points (same result as SYSTEM::VDIST2, without a native call per pixel/point)
+inline float vdist2(float x1, float y1, float z1, float x2, float y2, float z2) {
+    float dx = x1 - x2;
+    float dy = y1 - y2;
+    float dz = z1 - z2;
+    return dx * dx + dy * dy + dz * dz;
+}
+
+//Heading of a 2D vector in degrees, 0 is north (+y) and 90 west (-x), in [0, 360)
+//(same result as GAMEPLAY::GET_HEADING_FROM_VECTOR_2D, without a native call per entity)
+inline float headingFromVector2d(float dx, float dy) {
+    float heading = (float)(atan2(-dx, dy) * 180 / PI);
+    if (heading < 0) heading += 360;
+    //Tiny negative angles round up to 360
+    return heading < 360 ? heading : 0;
+}
+
+//Relative position in the camera frame to world coordinates (around s_camParams.pos)
+Vector3 camToWorld(Vector3 relPos, Vector3 camForward, Vector3 camRight, Vector3 camUp);
+
+//Camera basis and near clip plane from cam.pos and cam.theta (for optimizing 3d to 2d and unit vector to 2d calculations)
+void updateCamEigen(CamParams& cam);
+//Screen position of a world point, (0,0) top left and (1,1) bottom right of the image
+Eigen::Vector2f projectToScreen(const CamParams& cam, const Eigen::Vector3f& vertex);
+//Focal length in pixels for an image width (KITTI horizontal FOV)
+float focalLength(int width);
+
+//ndc is Normalized Device Coordinates which is value received from depth buffer
+//Returns the position relative to the camera (X is right, Y is forward, Z is up)
+inline Vector3 depthToCamCoords(const CamParams& cam, float ndc, float screenX, float screenY) {
+    float normScreenX = 2 * screenX / float(cam.width - 1) - 1.0f;
+    float normScreenY = 2 * screenY / float(cam.height - 1) - 1.0f;
+
+    float ncX = normScreenX * cam.ncWidth / 2;
+    float ncY = normScreenY * cam.ncHeight / 2;
+
+    //Distance to near clip (hypotenus)
+    float d2nc = sqrt(cam.nearClip * cam.nearClip + ncX * ncX + ncY * ncY);
+    float depth = d2nc / ndc;
+    if (ndc <= 0 || depth > cam.farClip) {
+        depth = cam.farClip;
+    }
+
+    float depthDivisor = (cam.nearClip * depth) / (2 * cam.farClip);
+    depth = depth / (1 + depthDivisor);
+
+    //X is right, Y is forward, Z is up (GTA coordinate frame)
+    Vector3 unitVec;
+    unitVec.x = ncX / d2nc;
+    unitVec.y = cam.nearClip / d2nc;
+    unitVec.z = -ncY / d2nc;
+
+    Vector3 relPos;
+    relPos.x = unitVec.x * depth;
+    relPos.y = unitVec.y * depth;
+    relPos.z = unitVec.z * depth;
+
+    return relPos;
+}
+
+//Distance along the ray of pixel (x, y) from a depth buffer in NDC (clamped to the image)
+float depthFromNDC(const CamParams& cam, const float* depthMap, int x, int y);
+//Depth at a screen position (0 to 1), bilinear between the four nearest pixels unless they span an edge
+float depthFromScreenPos(const CamParams& cam, const float* depthMap, float screenX, float screenY);
+
+//Returns the angle between a relative position vector and the camera right vector (rotated about the camera up axis)
+float observationAngle(Vector3 position, Vector3 camRight, Vector3 camUp);
+//Roll and pitch of an entity's basis in the camera frame
+void getRollAndPitch(Vector3 rightVector, Vector3 forwardVector,
+    Vector3 camForward, Vector3 camRight, Vector3 camUp, float &pitch, float &roll);
+
+//KITTI label values of an entity (location is the bottom center from correctOffcenter)
+//Camera coordinates: x right, y down, z forward
+Vector3 kittiLocation(const CamParams& cam, Vector3 worldPos, Vector3 camForward, Vector3 camRight, Vector3 camUp);
+//Yaw about the camera y axis
+float kittiRotationY(Vector3 forwardVector, Vector3 camForward, Vector3 camRight, Vector3 camUp);
+//Observation angle, rotation_y + tan^-1(z/x) - PI/2
+float kittiAlpha(float rotationY, Vector3 location);
+//KITTI occlusion level (0 fully visible, 1 partly, 2 largely occluded) from the occluding and the entity's own pixels in its box.
+//visibility is set to the visible fraction.
+int occlusionLevel(int occludingPoints, int entityPoints, float &visibility);
+//Moves an entity position to the bottom center of its model bounds (KITTI), offcenter is set to the offset in model coordinates
+Vector3 correctOffcenter(Vector3 position, Vector3 min, Vector3 max, Vector3 forwardVector, Vector3 rightVector, Vector3 upVector, Vector3 &offcenter);
+//Conservative sphere/frustum test using the camera basis (near and far planes are handled by the caller)
+bool sphereInFrustum(const CamParams& cam, Vector3 camForward, Vector3 camRight, Vector3 camUp, const Vector3 &position, float radius);
+
+inline bool checkDirection(Vector3 unit, Vector3 point, Vector3 min, Vector3 max) {
+    float dotPoint = dotProd(point, unit);
+    float dotMax = dotProd(max, unit);
+    float dotMin = dotProd(min, unit);
+
+    if ((dotMax <= dotPoint && dotPoint <= dotMin) ||
+        (dotMax >= dotPoint && dotPoint >= dotMin)) {
+        return true;
+    }
+    return false;
+}
+
+//Return true if pixel (i,j) is inside the entity's unprocessed 2D bounding box
+inline bool in2DBoxUnprocessed(const int &i, const int &j, const BBox2D &b) {
+    if (i < b.left) return false;
+    if (i > b.right) return false;
+    if (j < b.top) return false;
+    if (j > b.bottom) return false;
+
+    return true;
+}
+
+//Point and objPos should be in world coordinates
+bool in3DBox(Vector3 point, Vector3 objPos, Vector3 dim, Vector3 yVector, Vector3 xVector, Vector3 zVector);
+
+//Takes in an entity's box and a point (in world coordinates) and returns true if the point resides within the
+//entity's 3D bounding box.
+//Note: Need to set the box with setEntityBBoxParameters first
+inline bool in3DBox(const EntityBox &box, const Vector3 &point, bool &upperHalf) {
+    upperHalf = false;
+    if (checkDirection(box.v, point, box.rearMiddleLeft, box.rearTopExactLeft)) upperHalf = true;
+
+    if (!checkDirection(box.u, point, box.rearBotLeft, box.frontBotLeft)) return false;
+    if (!checkDirection(box.v, point, box.rearBotLeft, box.rearTopLeft)) return false;
+    if (!checkDirection(box.w, point, box.rearBotLeft, box.rearBotRight)) return false;
+
+    return true;
+}
+
+//Box of the entity's worldPos, dim and basis for in3DBox
+void setEntityBBoxParameters(const EntityRecord &e, EntityBox &box);
@@ -0,0 +1,326 @@
+#include "InstanceMasks.h"
+#include <limits.h>
+#include <sstream>
+
+void InstanceMaskSet::reset(int width, int height) {
+    m_width = width;
+    m_height = height;
+    m_masks.clear();
+    m_maskIdx.clear();
+    m_lastMaskIdx = -1;
+}
+
+void InstanceMaskSet::addPixel(int entityID, int i, int j) {
+    int idx = j * m_width + i;
+
+    int maskIdx = m_lastMaskIdx;
+    if (maskIdx < 0 || entityID != m_lastEntityID) {
+        auto search = m_maskIdx.find(entityID);
+        maskIdx = search != m_maskIdx.end() ? search->second : -1;
+    }
+    m_lastEntityID = entityID;
+    if (maskIdx < 0) {
+        InstanceMask mask;
+        mask.entityID = entityID;
+        mask.left = i;
+        mask.right = i;
+        mask.top = j;
+        mask.bottom = j;
+        mask.area = 1;
+        mask.runs.push_back({ idx, 1 });
+        m_lastMaskIdx = (int)m_masks.size();
+        m_maskIdx.insert(std::pair<int, int>(entityID, m_lastMaskIdx));
+        m_masks.push_back(mask);
+        return;
+    }
+
+    m_lastMaskIdx = maskIdx;
+    InstanceMask& mask = m_masks[maskIdx];
+    if (i < mask.left) mask.left = i;
+    if (i > mask.right) mask.right = i;
+    if (j < mask.top) mask.top = j;
+    if (j > mask.bottom) mask.bottom = j;
+    ++mask.area;
+
+    //Pixels are visited in row-major order so most pixels extend the last run
+    InstanceRun& last = mask.runs.back();
+    if (last.start + last.length == idx) {
+        ++last.length;
+    }
+    else {
+        mask.runs.push_back({ idx, 1 });
+    }
+}
+
+void addPointToSegImages(uint32_t* pInstanceSeg, uint8_t* pStencilSeg, InstanceMaskSet* masks, int width, int i, int j, int entityID) {
+    //Index of point in all image buffers
+    int idx = j * width + i;
+
+    //instance seg is image with exact entityIDs
+    pInstanceSeg[idx] = (uint32_t)entityID;
+    if (masks) {
+        masks->addPixel(entityID, i, j);
+    }
+
+    //RGB image is 3 bytes per pixel
+    uint8_t* p = pStencilSeg + 3 * idx;
+    if (p[0] == 0 && p[1] == 0 && p[2] == 0) {
+        int newVal = 47 * entityID; //Just to produce unique but different colours
+        p[0] = (newVal + 13 * entityID) % 255;
+        p[1] = (newVal / 255) % 255;
+        p[2] = newVal % 255;
+    }
+    else {
+        p[0] = 255;
+        p[1] = 255;
+        p[2] = 255;
+    }
+}
+
+void InstanceMaskSet::rasterise(const InstanceMask& mask, const uint32_t* pInstanceSeg, std::vector<uint8_t>& bitmap) const {
+    int bw = mask.right - mask.left + 1;
+    int bh = mask.bottom - mask.top + 1;
+    bitmap.assign(bw * bh, 0);
+
+    for (const InstanceRun& run : mask.runs) {
+        for (int idx = run.start; idx < run.start + run.length; ++idx) {
+            if (pInstanceSeg && pInstanceSeg[idx] != (uint32_t)mask.entityID) continue;
+            int i = idx % m_width;
+            int j = idx / m_width;
+            bitmap[(j - mask.top) * bw + (i - mask.left)] = 1;
+        }
+    }
+}
+
+//COCO RLE counts are column-major over the full image, starting with a run of zeros
+//The string form is the LEB128-like encoding used by pycocotools (rleToString), escaped for json
+std::string InstanceMaskSet::toCocoRle(const InstanceMask& mask, const std::vector<uint8_t>& bitmap, int& area) const {
+    int bw = mask.right - mask.left + 1;
+    int bh = mask.bottom - mask.top + 1;
+
+    std::vector<long long> counts;
+    long long prevEnd = 0;
+    long long runStart = -1;
+    long long runEnd = -1;
+    area = 0;
+    for (int x = 0; x < bw; ++x) {
+        for (int y = 0; y < bh; ++y) {
+            if (!bitmap[y * bw + x]) continue;
+            ++area;
+            long long p = (long long)(x + mask.left) * m_height + (y + mask.top);
+            if (runStart >= 0 && p == runEnd) {
+                ++runEnd;
+                continue;
+            }
+            if (runStart >= 0) {
+                counts.push_back(runStart - prevEnd);
+                counts.push_back(runEnd - runStart);
+                prevEnd = runEnd;
+            }
+            runStart = p;
+            runEnd = p + 1;
+        }
+    }
+    if (runStart >= 0) {
+        counts.push_back(runStart - prevEnd);
+        counts.push_back(runEnd - runStart);
+        prevEnd = runEnd;
+    }
+    long long total = (long long)m_width * m_height;
+    if (prevEnd < total) {
+        counts.push_back(total - prevEnd);
+    }
+
+    std::string str;
+    for (size_t i = 0; i < counts.size(); ++i) {
+        long long x = counts[i];
+        if (i > 2) x -= counts[i - 2];
+        bool more = true;
+        while (more) {
+            char c = x & 0x1f;
+            x >>= 5;
+            more = (c & 0x10) ? x != -1 : x != 0;
+            if (more) c |= 0x20;
+            c += 48;
+            //The characters run from '0' to 'o', only the backslash needs escaping in json
+            if (c == '\\') str.push_back('\\');
+            str.push_back(c);
+        }
+    }
+    return str;
+}
+
+//Outer borders of the 8-connected components which are not inside another component, traced as in
+//Suzuki and Abe's border following (findContours with RETR_EXTERNAL and CHAIN_APPROX_SIMPLE):
+//only the end points of horizontal, vertical and diagonal segments are kept
+static void findExternalContours(const std::vector<uint8_t>& bitmap, int bw, int bh, std::vector<std::vector<std::pair<int, int>>>& contours) {
+    //Padded by one background pixel on every side
+    //0 background, 1 mask, 2 background outside every component, 3 mask already traced
+    int pw = bw + 2;
+    int ph = bh + 2;
+    std::vector<uint8_t> img(pw * ph, 0);
+    for (int y = 0; y < bh; ++y) {
+        for (int x = 0; x < bw; ++x) {
+            img[(y + 1) * pw + x + 1] = bitmap[y * bw + x] ? 1 : 0;
+        }
+    }
+
+    //The background is 4-connected when the components are 8-connected
+    std::vector<int> stack(1, 0);
+    img[0] = 2;
+    while (!stack.empty()) {
+        int idx = stack.back();
+        stack.pop_back();
+        int x = idx % pw;
+        int y = idx / pw;
+        int neighbours[4] = { x > 0 ? idx - 1 : -1, x < pw - 1 ? idx + 1 : -1, y > 0 ? idx - pw : -1, y < ph - 1 ? idx + pw : -1 };
+        for (int n : neighbours) {
+            if (n >= 0 && img[n] == 0) {
+                img[n] = 2;
+                stack.push_back(n);
+            }
+        }
+    }
+
+    //Chain code directions counterclockwise from east (y is down)
+    const int dx[8] = { 1, 1, 0, -1, -1, -1, 0, 1 };
+    const int dy[8] = { 0, -1, -1, -1, 0, 1, 1, 1 };
+    int delta[8];
+    for (int s = 0; s < 8; ++s) delta[s] = dy[s] * pw + dx[s];
+
+    //The first pixel of an outer component in raster order has the outside on its left
+    for (int start = pw; start < pw * (ph - 1); ++start) {
+        if (img[start] != 1 || img[start - 1] != 2) continue;
+
+        std::vector<std::pair<int, int>> contour;
+        int px = start % pw - 1;
+        int py = start / pw - 1;
+
+        //First neighbour clockwise from the west
+        int s = 4;
+        do {
+            s = (s + 7) & 7;
+        } while (img[start + delta[s]] != 1 && s != 4);
+
+        if (s == 4) {
+            contour.push_back({ px, py });
+        }
+        else {
+            int i1 = start + delta[s];
+            int i3 = start;
+            int prevS = s ^ 4;
+            for (;;) {
+                //Counterclockwise from the pixel after the previous one
+                int i4;
+                do {
+                    s = (s + 1) & 7;
+                    i4 = i3 + delta[s];
+                } while (img[i4] != 1);
+
+                if (s != prevS) {
+                    contour.push_back({ px, py });
+                    prevS = s;
+                }
+                px += dx[s];
+                py += dy[s];
+                if (i4 == start && i3 == i1) break;
+                i3 = i4;
+                s = (s + 4) & 7;
+            }
+        }
+        contours.push_back(contour);
+
+        //Mark the component so its other pixels don't start a contour
+        stack.assign(1, start);
+        img[start] = 3;
+        while (!stack.empty()) {
+            int idx = stack.back();
+            stack.pop_back();
+            for (int d = 0; d < 8; ++d) {
+                int n = idx + delta[d];
+                if (img[n] == 1) {
+                    img[n] = 3;
+                    stack.push_back(n);
+                }
+            }
+        }
+    }
+}
+
+std::string InstanceMaskSet::toPolygons(const InstanceMask& mask, std::vector<uint8_t>& bitmap) const {
+    int bw = mask.right - mask.left + 1;
+    int bh = mask.bottom - mask.top + 1;
+
+    std::vector<std::vector<std::pair<int, int>>> contours;
+    findExternalContours(bitmap, bw, bh, contours);
+
+    std::ostringstream oss;
+    oss << "[";
+    bool first = true;
+    for (auto &contour : contours) {
+        //COCO polygons need at least 3 points
+        if (contour.size() < 3) continue;
+        if (!first) oss << ", ";
+        first = false;
+        oss << "[";
+        for (size_t k = 0; k < contour.size(); ++k) {
+            if (k != 0) oss << ", ";
+            oss << contour[k].first + mask.left << ", " << contour[k].second + mask.top;
+        }
+        oss << "]";
+    }
+    oss << "]";
+    return oss.str();
+}
+
+//Bounds of the set pixels of a bbox sized bitmap (bw pixels per row), false if none are set
+static bool bitmapBounds(const std::vector<uint8_t>& bitmap, int bw, int& left, int& top, int& right, int& bottom) {
+    left = bw;
+    top = INT_MAX;
+    right = -1;
+    bottom = -1;
+    for (int k = 0; k < (int)bitmap.size(); ++k) {
+        if (!bitmap[k]) continue;
+        int x = k % bw;
+        int y = k / bw;
+        if (x < left) left = x;
+        if (x > right) right = x;
+        if (y < top) top = y;
+        bottom = y;
+    }
+    return right >= 0;
+}
+
+std::string InstanceMaskSet::toJson(int format, const uint32_t* pInstanceSeg, int imageID) const {
+    std::ostringstream oss;
+    oss << "{\"image_id\": " << imageID << ", \"height\": " << m_height << ", \"width\": " << m_width << ", \"instances\": [";
+
+    std::vector<uint8_t> bitmap;
+    bool first = true;
+    for (const InstanceMask& mask : m_masks) {
+        rasterise(mask, pInstanceSeg, bitmap);
+
+        //The box collected in addPixel still covers pixels which were reassigned since
+        int left, top, right, bottom;
+        if (!bitmapBounds(bitmap, mask.right - mask.left + 1, left, top, right, bottom)) continue;
+
+        int area = 0;
+        std::string segmentation;
+        if (format == INSTANCE_MASK_POLYGON) {
+            for (uint8_t b : bitmap) area += b;
+            segmentation = toPolygons(mask, bitmap);
+        }
+        else {
+            segmentation = "{\"size\": [" + std::to_string(m_height) + ", " + std::to_string(m_width) +
+                "], \"counts\": \"" + toCocoRle(mask, bitmap, area) + "\"}";
+        }
+
+        if (!first) oss << ",";
+        first = false;
+        oss << "\n{\"entity_id\": " << mask.entityID << ", \"bbox\": [" << mask.left + left << ", " << mask.top + top << ", " <<
+            right - left + 1 << ", " << bottom - top + 1 << "], \"area\": " << area <<
+            ", \"segmentation\": " << segmentation << "}";
+    }
+    oss << "\n]}\n";
+    return oss.str();
+}
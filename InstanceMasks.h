@@ -0,0 +1,59 @@
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+//Mask formats for the per-entity instance export (see INSTANCE_MASK_FORMAT)
+const int INSTANCE_MASK_NONE = 0;
+const int INSTANCE_MASK_RLE = 1;//COCO compressed RLE
+const int INSTANCE_MASK_POLYGON = 2;//Outer contours as COCO polygons
+
+//Row-major run of pixels (start is the pixel index j * width + i)
+struct InstanceRun {
+    int start;
+    int length;
+};
+
+struct InstanceMask {
+    int entityID;
+    int left;
+    int top;
+    int right;
+    int bottom;
+    int area;
+    std::vector<InstanceRun> runs;
+};
+
+//Collects the pixels of every entity while the instance segmentation buffer is filled
+//so masks can be exported without another pass over the full frame
+class InstanceMaskSet {
+public:
+    void reset(int width, int height);
+    void addPixel(int entityID, int i, int j);
+
+    //Writes the masks of this frame as json. pInstanceSeg is used to drop pixels which were later reassigned,
+    //bbox and area are those of the remaining pixels
+    std::string toJson(int format, const uint32_t* pInstanceSeg, int imageID) const;
+
+    size_t size() const { return m_masks.size(); }
+
+private:
+    //Rasterises a mask into a bbox sized buffer (1 where the pixel belongs to the entity)
+    void rasterise(const InstanceMask& mask, const uint32_t* pInstanceSeg, std::vector<uint8_t>& bitmap) const;
+    std::string toCocoRle(const InstanceMask& mask, const std::vector<uint8_t>& bitmap, int& area) const;
+    std::string toPolygons(const InstanceMask& mask, std::vector<uint8_t>& bitmap) const;
+
+    int m_width = 0;
+    int m_height = 0;
+    std::vector<InstanceMask> m_masks;
+    std::unordered_map<int, int> m_maskIdx;//entityID -> index in m_masks
+    //Neighbouring pixels mostly belong to the same entity, so the last lookup is kept
+    int m_lastEntityID = 0;
+    int m_lastMaskIdx = -1;
+};
+
+//Writes entityID to pixel (i, j) of the instance segmentation (width pixels per row) and its colour to the RGB
+//segmentation image. A pixel coloured twice turns white. masks collects the pixel unless it is NULL.
+void addPointToSegImages(uint32_t* pInstanceSeg, uint8_t* pStencilSeg, InstanceMaskSet* masks, int width, int i, int j, int entityID);
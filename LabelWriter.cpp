@@ -0,0 +1,187 @@
+#include "LabelWriter.h"
+#include <charconv>
+#include <stdio.h>
+#include <string.h>
+
+void LabelWriter::appendFloat(float v) {
+    char tmp[32];
+    auto res = std::to_chars(tmp, tmp + sizeof(tmp), v);
+    m_buf.append(tmp, res.ptr);
+}
+
+void LabelWriter::appendInt(int v) {
+    char tmp[16];
+    auto res = std::to_chars(tmp, tmp + sizeof(tmp), v);
+    m_buf.append(tmp, res.ptr);
+}
+
+void LabelWriter::appendVec(const Vector3& v) {
+    m_buf.push_back(' ');
+    appendFloat(v.x);
+    m_buf.push_back(' ');
+    appendFloat(v.y);
+    m_buf.push_back(' ');
+    appendFloat(v.z);
+}
+
+void LabelWriter::appendKitti(const ObjEntity& e, const BBox2D& b) {
+    m_buf.append(e.objType);
+    m_buf.push_back(' ');
+    appendFloat(e.truncation);
+    m_buf.push_back(' ');
+    appendInt(e.occlusion);
+    m_buf.push_back(' ');
+    appendFloat(e.alpha);
+    m_buf.push_back(' ');
+    appendInt((int)b.left);
+    m_buf.push_back(' ');
+    appendInt((int)b.top);
+    m_buf.push_back(' ');
+    appendInt((int)b.right);
+    m_buf.push_back(' ');
+    appendInt((int)b.bottom);
+    m_buf.push_back(' ');
+    appendFloat(e.height);
+    m_buf.push_back(' ');
+    appendFloat(e.width);
+    m_buf.push_back(' ');
+    appendFloat(e.length);
+    appendVec(e.location);
+    m_buf.push_back(' ');
+    appendFloat(e.rotation_y);
+}
+
+void LabelWriter::appendEntity(const ObjEntity& e, const BBox2D& b, bool augmented) {
+    appendKitti(e, b);
+
+    if (augmented) {
+        int vPedIsIn = e.isPedInV ? e.vPedIsIn : 0;
+        m_buf.push_back(' ');
+        appendInt(e.entityID);
+        m_buf.push_back(' ');
+        appendInt(e.pointsHit2D);
+        m_buf.push_back(' ');
+        appendInt(e.pointsHit3D);
+        m_buf.push_back(' ');
+        appendFloat(e.speed);
+        m_buf.push_back(' ');
+        appendFloat(e.roll);
+        m_buf.push_back(' ');
+        appendFloat(e.pitch);
+        m_buf.push_back(' ');
+        m_buf.append(e.modelString);
+        m_buf.push_back(' ');
+        appendInt(vPedIsIn);
+        appendVec(e.entity_velocity_vector);
+        appendVec(e.own_vehicle_velocity_vector);
+        appendVec(e.entity_world_coordinates);
+        appendVec(e.player_world_coordinates);
+        appendVec(e.entity_velocity_vector_camcoords);
+        appendVec(e.own_vehicle_velocity_vector_camcoords);
+        m_buf.push_back(' ');
+        appendInt(e.towLink);
+    }
+    m_buf.push_back('\n');
+}
+
+void LabelWriter::appendTrack(int frame, int trackID, const ObjEntity& e, const BBox2D& b) {
+    appendInt(frame);
+    m_buf.push_back(' ');
+    appendInt(trackID);
+    m_buf.push_back(' ');
+    appendKitti(e, b);
+    appendVec(e.entity_velocity_vector_camcoords);
+    m_buf.push_back('\n');
+}
+
+//MOT17 classes
+//Entities MOT has no class for are distractors (8), which the MOT evaluation ignores rather than count as cars:
+//Misc (animals, classID 11, and Misc vehicles such as trailers, forklifts and tractors) and vehicles off the road
+//(boats, planes, helicopters, submersibles). Cars, vans, trucks and trams are cars (3).
+static int motClass(const ObjEntity& e) {
+    if (e.objType == "Pedestrian") return 1;
+    if (e.objType == "Person_sitting") return 7;
+    if (e.objType == "Misc" || e.classID == 11) return 8;
+    if (e.classID == 2) return 4;//Bicycle
+    if (e.classID == 1 || e.classID == 3) return 5;//Motorbike, quadbike
+    if (e.classID == 4 || e.classID == 5 || e.classID == 6 || e.classID == 8) return 8;
+    return 3;//Car
+}
+
+void LabelWriter::appendMot(int frame, int trackID, const ObjEntity& e, const BBox2D& b) {
+    appendInt(frame + 1);
+    m_buf.push_back(',');
+    appendInt(trackID + 1);
+    m_buf.push_back(',');
+    appendInt((int)b.left);
+    m_buf.push_back(',');
+    appendInt((int)b.top);
+    m_buf.push_back(',');
+    appendInt((int)(b.right - b.left));
+    m_buf.push_back(',');
+    appendInt((int)(b.bottom - b.top));
+    m_buf.append(",1,");
+    appendInt(motClass(e));
+    m_buf.push_back(',');
+    appendFloat(e.visibility);
+    m_buf.push_back('\n');
+}
+
+bool LabelWriter::writeFile(const std::string& filename) const {
+    FILE* f = fopen(filename.c_str(), "w");
+    if (!f) return false;
+    size_t written = fwrite(m_buf.data(), 1, m_buf.size(), f);
+    fclose(f);
+    return written == m_buf.size();
+}
+
+static void copyVec(const Vector3& v, float* out) {
+    out[0] = v.x;
+    out[1] = v.y;
+    out[2] = v.z;
+}
+
+static void copyBBox(const BBox2D& b, int32_t* out) {
+    out[0] = (int)b.left;
+    out[1] = (int)b.top;
+    out[2] = (int)b.right;
+    out[3] = (int)b.bottom;
+}
+
+void fillBinaryLabel(const ObjEntity& e, uint32_t flags, BinaryLabelRecord& rec) {
+    memset(&rec, 0, sizeof(rec));
+    rec.entityID = e.entityID;
+    rec.classID = e.classID;
+    rec.flags = flags;
+    if (e.isPedInV) rec.flags |= BINARY_LABEL_PED_IN_VEHICLE;
+    strncpy(rec.objType, e.objType.c_str(), BINARY_LABEL_TYPE_LEN - 1);
+    strncpy(rec.modelString, e.modelString.c_str(), BINARY_LABEL_MODEL_LEN - 1);
+
+    rec.truncation = e.truncation;
+    rec.occlusion = e.occlusion;
+    rec.alpha = e.alpha;
+    copyBBox(e.bbox2d, rec.bbox2d);
+    copyBBox(e.bbox2dUnprocessed, rec.bbox2dUnprocessed);
+
+    rec.height = e.height;
+    rec.width = e.width;
+    rec.length = e.length;
+    copyVec(e.location, rec.location);
+    rec.rotation_y = e.rotation_y;
+    rec.distance = e.distance;
+
+    rec.pointsHit2D = e.pointsHit2D;
+    rec.pointsHit3D = e.pointsHit3D;
+    rec.speed = e.speed;
+    rec.roll = e.roll;
+    rec.pitch = e.pitch;
+    rec.vPedIsIn = e.isPedInV ? e.vPedIsIn : 0;
+
+    copyVec(e.entity_velocity_vector, rec.entity_velocity_vector);
+    copyVec(e.own_vehicle_velocity_vector, rec.own_vehicle_velocity_vector);
+    copyVec(e.entity_world_coordinates, rec.entity_world_coordinates);
+    copyVec(e.player_world_coordinates, rec.player_world_coordinates);
+    copyVec(e.entity_velocity_vector_camcoords, rec.entity_velocity_vector_camcoords);
+    copyVec(e.own_vehicle_velocity_vector_camcoords, rec.own_vehicle_velocity_vector_camcoords);
+    rec.towLink = e.towLink;
+}
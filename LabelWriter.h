@@ -0,0 +1,41 @@
+#pragma once
+
+#include "GeometryCore.h"
+#include "FrameObjectInfo.h"
+#include "BinaryLabels.h"
+#include <string>
+
+//Formats KITTI label lines into a reusable buffer.
+//Floats use the shortest representation that round-trips (std::to_chars), ints are formatted directly.
+class LabelWriter {
+public:
+    void clear() { m_buf.clear(); }
+
+    //Appends one label line: type, truncation, occlusion, alpha, bbox, dims, location, rotation_y
+    //Augmented labels add entityID, points hit, speed, roll/pitch, model, vehicle ped is in, velocities, world coordinates
+    //and the tractor/trailer link
+    void appendEntity(const ObjEntity& e, const BBox2D& b, bool augmented);
+    //KITTI tracking line: frame, track ID, the label_2 fields, then the velocity in camera coordinates
+    void appendTrack(int frame, int trackID, const ObjEntity& e, const BBox2D& b);
+    //MOTChallenge (MOT17 gt) line: frame, ID (both 1-based), left, top, width, height, 1, class, visibility
+    void appendMot(int frame, int trackID, const ObjEntity& e, const BBox2D& b);
+
+    void appendFloat(float v);
+    void appendInt(int v);
+    void appendString(const std::string& s) { m_buf.append(s); }
+    void appendChar(char c) { m_buf.push_back(c); }
+
+    const std::string& str() const { return m_buf; }
+    //Writes the buffer as is (no format string parsing)
+    bool writeFile(const std::string& filename) const;
+
+private:
+    void appendVec(const Vector3& v);
+    //label_2 fields without the line end
+    void appendKitti(const ObjEntity& e, const BBox2D& b);
+
+    std::string m_buf;
+};
+
+//Copies every exported field of an entity into a binary label record (see BinaryLabels.h)
+void fillBinaryLabel(const ObjEntity& e, uint32_t flags, BinaryLabelRecord& rec);
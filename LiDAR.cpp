@@ -15,16 +15,15 @@
 
 #include "Functions.h"
 #include "Constants.h"
+#include "ModelInfoCache.h"
+#include "OutputPaths.h"
 
 boost::random::mt19937 s_rng;
 boost::random::normal_distribution<> s_nDist(DEPTH_NOISE_MEAN, DEPTH_NOISE_STDDEV);
 
 LiDAR::LiDAR()
 {
-    m_pPointClouds = NULL;
-    m_pRaycastPointCloud = NULL;
-    m_lidar2DPoints = NULL;
-    m_updatedPointCloud = NULL;
+    m_maxPoints = 0;
     m_pointsHit = 0;
     m_maxRange = 0;
     m_vertiUpLimit = 0;
@@ -35,8 +34,11 @@ LiDAR::LiDAR()
     m_horizSmplNum = 0;
     m_vertiResolu = 0;
     m_horizResolu = 0;
+    m_azimuthStride = 1;
+    m_generateHorizPointClouds = &LiDAR::GenerateHorizPointClouds<false, false, false, false, false>;
     m_camera = 0;
     m_lidarVehicle = 0;
+    m_world = defaultWorld();
     m_initType = _LIDAR_NOT_INIT_YET_;
     m_isAttach = false;
     VehicleLookUpTable();
@@ -62,10 +64,7 @@ void LiDAR::Init2DLiDAR_SmplNum(float maxRange, int horizSmplNum, float horizLeL
     m_horizLeLimit = horizLeLimit;
     m_horizRiLimit = horizRiLimit;
     m_horizResolu = (m_horizLeLimit + 360.0 - m_horizRiLimit) / m_horizSmplNum;
-    if (!m_pPointClouds)
-        m_pPointClouds = (float *)malloc(m_horizSmplNum * sizeof(float));
-    if (m_pPointClouds == NULL)
-        printf("\nLiDAR: memory alloc err");
+    allocateBuffers(m_horizSmplNum);
 
     m_initType = _LIDAR_INIT_AS_2D_;
 
@@ -82,10 +81,7 @@ void LiDAR::Init2DLiDAR_SmplNum(float maxRange, int horizSmplNum, float horizLeL
 void LiDAR::Init3DLiDAR_SmplNum(float maxRange, int horizSmplNum, float horizLeLimit, float horizRiLimit,
     int vertiSmplNum, float vertiUpLimit, float vertiUnLimit)
 {
-    std::ostringstream oss;
-    oss << "Vertical sample number: " << vertiSmplNum;
-    std::string str = oss.str();
-    log(str);
+    LOG_DEBUG("Vertical sample number: " << vertiSmplNum);
 
     if (m_initType != _LIDAR_NOT_INIT_YET_)
         DestroyLiDAR();
@@ -113,30 +109,7 @@ void LiDAR::Init3DLiDAR_SmplNum(float maxRange, int horizSmplNum, float horizLeL
     m_horizRiLimit = horizRiLimit;
     m_horizResolu = (m_horizLeLimit + 360.0 - m_horizRiLimit) / m_horizSmplNum;
 
-    if (!m_pPointClouds)
-        //Malloc 4*max number of points bytes for the point cloud
-        m_pPointClouds = (float*)malloc((MAX_POINTS * sizeof(float)));
-    if (m_pPointClouds == NULL)
-        printf("\nLiDAR: memory alloc err");
-
-    if (!m_pRaycastPointCloud)
-        //Malloc 4*max number of points bytes for the point cloud
-        m_pRaycastPointCloud = (float*)malloc((MAX_POINTS * sizeof(float)));
-    if (m_pRaycastPointCloud == NULL)
-        printf("\nLiDAR: memory alloc err3");
-
-    if (!m_updatedPointCloud)
-        //Malloc 4*max number of points bytes for the point cloud
-        m_updatedPointCloud = (float*)malloc((MAX_POINTS * sizeof(float)));
-    if (m_updatedPointCloud == NULL)
-        printf("\nLiDAR: memory alloc err4");
-
-    //Malloc 2*max number of points bytes for the 3d -> 2d point map
-    if (GENERATE_2D_POINTMAP) {
-        m_lidar2DPoints = (float*)malloc((MAX_POINTS * sizeof(float)) / 2);
-        if (m_lidar2DPoints == NULL)
-            printf("\nLiDAR: memory alloc err2");
-    }
+    allocateBuffers(m_vertiSmplNum * m_horizSmplNum);
 
     m_initType = _LIDAR_INIT_AS_3D_;
 
@@ -163,6 +136,45 @@ void LiDAR::Init3DLiDAR_FOV(float maxRange, float horizFOV, float horizAngResolu
     Init3DLiDAR_SmplNum(maxRange, horizFOV / horizAngResolu, horizFOV / 2, 360.0 - horizFOV / 2, vertiFOV / vertiAngResolu, 90.0 - vertiUpLimit, 90.0 + vertiFOV - vertiUpLimit);
 }
 
+template <bool... FIXED>
+LiDAR::HorizPointCloudsFn LiDAR::horizPointCloudsVariant(const bool* flags) {
+    if constexpr (sizeof...(FIXED) == HORIZ_VARIANT_FLAGS) {
+        return &LiDAR::GenerateHorizPointClouds<FIXED...>;
+    }
+    else {
+        return flags[sizeof...(FIXED)] ? horizPointCloudsVariant<FIXED..., true>(flags) : horizPointCloudsVariant<FIXED..., false>(flags);
+    }
+}
+
+//Each beam adds at most LIDAR_POINTS_PER_BEAM points to the point cloud and one point to each of the others
+void LiDAR::allocateBuffers(int beams)
+{
+    m_maxPoints = beams * LIDAR_POINTS_PER_BEAM;
+    m_pointClouds.assign((size_t)m_maxPoints * FLOATS_PER_POINT, 0.0f);
+    m_updatedPointCloud.assign((size_t)m_maxPoints * FLOATS_PER_POINT, 0.0f);
+    if (OUTPUT_RAYCAST_POINTS) m_raycastPointCloud.assign((size_t)beams * FLOATS_PER_POINT, 0.0f);
+    if (GENERATE_2D_POINTMAP) m_lidar2DPoints.assign((size_t)beams * 2, 0.0f);
+
+    //Settings are loaded before the LiDAR is set up and don't change afterwards
+    bool debugOutput = GENERATE_2D_POINTMAP || OUTPUT_DEPTH_STATS;
+    const bool flags[HORIZ_VARIANT_FLAGS] = { USE_RAYCASTING, debugOutput, LIDAR_GAUSSIAN_NOISE, OUTPUT_ADJUSTED_POINTS, OBTAIN_RAY_POINTS_HIT };
+    m_generateHorizPointClouds = horizPointCloudsVariant<>(flags);
+    s_nDist = boost::random::normal_distribution<>(DEPTH_NOISE_MEAN, DEPTH_NOISE_STDDEV);
+
+    LOG_INFO("LiDAR buffers: " << beams << " beams, " << m_maxPoints << " points, " << bufferBytes() << " bytes");
+}
+
+void LiDAR::SetWorld(IWorld* world)
+{
+    m_world = world;
+    s_modelCache.setWorld(world);
+}
+
+void LiDAR::SetAzimuthStride(int stride)
+{
+    m_azimuthStride = stride > 0 ? stride : 1;
+}
+
 void LiDAR::AttachLiDAR2Camera(Cam camera, Entity ownCar)
 {
     if (!m_isAttach)
@@ -180,22 +192,12 @@ void LiDAR::AttachLiDAR2Camera(Cam camera, Entity ownCar)
 
 void LiDAR::DestroyLiDAR()
 {
-    if (m_pPointClouds) {
-        free(m_pPointClouds);
-        m_pPointClouds = NULL;
-    }
-    if (m_pRaycastPointCloud) {
-        free(m_pRaycastPointCloud);
-        m_pRaycastPointCloud = NULL;
-    }
-    if (m_updatedPointCloud) {
-        free(m_updatedPointCloud);
-        m_updatedPointCloud = NULL;
-    }
-    if (m_lidar2DPoints) {
-        free(m_lidar2DPoints);
-        m_lidar2DPoints = NULL;
-    }
+    //swap releases the memory, clear() would keep the capacity
+    std::vector<float>().swap(m_pointClouds);
+    std::vector<float>().swap(m_raycastPointCloud);
+    std::vector<float>().swap(m_updatedPointCloud);
+    std::vector<float>().swap(m_lidar2DPoints);
+    m_maxPoints = 0;
     m_maxRange = 0;
     m_vertiUpLimit = 0;
     m_vertiUnLimit = 0;
@@ -213,23 +215,34 @@ void LiDAR::DestroyLiDAR()
 
 float * LiDAR::Get2DPoints(int &size) {
     size = m_beamCount;
-    return m_lidar2DPoints;
+    return m_lidar2DPoints.data();
 }
 
 float * LiDAR::GetRaycastPointcloud(int &size) {
     size = m_raycastPoints;
-    return m_pRaycastPointCloud;
+    return m_raycastPointCloud.data();
 }
 
 float* LiDAR::UpdatePointCloud(int &size, float* depthMap) {
     m_depthMap = depthMap;
-    for (int i = 0; i < m_hitDepthPoints.size(); i++) {
-        Vector3 vec_cam_coord = get3DFromDepthTarget(m_hitDepthPoints[i].target, m_hitDepthPoints[i].target2D);
+    if (LIDAR_GAUSSIAN_NOISE) updatePoints<true>();
+    else updatePoints<false>();
 
-        float newDistance = sqrt(SYSTEM::VDIST2(0, 0, 0, vec_cam_coord.x, vec_cam_coord.y, vec_cam_coord.z));
+    size = m_updatedPointCount;
+    m_hitDepthPoints.clear();
+    return m_updatedPointCloud.data();
+}
+
+//Per point part of UpdatePointCloud
+template <bool NOISE>
+void LiDAR::updatePoints() {
+    for (int i = 0; i < m_hitDepthPoints.size() && m_updatedPointCount < m_maxPoints; i++) {
+        Vector3 vec_cam_coord = get3DFromDepthTarget<NOISE>(m_hitDepthPoints[i].target, m_hitDepthPoints[i].target2D);
+
+        float newDistance = sqrt(vdist2(0, 0, 0, vec_cam_coord.x, vec_cam_coord.y, vec_cam_coord.z));
         if (newDistance <= MAX_LIDAR_DIST) {
             //Note: The y/x axes are changed to conform with KITTI velodyne axes
-            float* p = m_updatedPointCloud + (m_updatedPointCount * FLOATS_PER_POINT);
+            float* p = m_updatedPointCloud.data() + (m_updatedPointCount * FLOATS_PER_POINT);
             *p = vec_cam_coord.y;
             *(p + 1) = -vec_cam_coord.x;
             *(p + 2) = vec_cam_coord.z;
@@ -237,10 +250,6 @@ float* LiDAR::UpdatePointCloud(int &size, float* depthMap) {
             ++m_updatedPointCount;
         }
     }
-
-    size = m_updatedPointCount;
-    m_hitDepthPoints.clear();
-    return m_updatedPointCloud;
 }
 
 void LiDAR::printDepthStats() {
@@ -255,9 +264,11 @@ void LiDAR::printDepthStats() {
     int count120 = 0;
     int countAbove100 = 0;
     for (int i = 0; i < m_hitDepthPoints.size(); i++) {
-        Vector3 vec_cam_coord = get3DFromDepthTarget(m_hitDepthPoints[i].target, m_hitDepthPoints[i].target2D);
+        //Debug stats, not worth a variant
+        Vector3 vec_cam_coord = LIDAR_GAUSSIAN_NOISE ? get3DFromDepthTarget<true>(m_hitDepthPoints[i].target, m_hitDepthPoints[i].target2D)
+                                                     : get3DFromDepthTarget<false>(m_hitDepthPoints[i].target, m_hitDepthPoints[i].target2D);
 
-        float newDistance = sqrt(SYSTEM::VDIST2(0, 0, 0, vec_cam_coord.x, vec_cam_coord.y, vec_cam_coord.z));
+        float newDistance = sqrt(vdist2(0, 0, 0, vec_cam_coord.x, vec_cam_coord.y, vec_cam_coord.z));
 
         //Only use ground points since they aren't affected by object models
         if (m_hitDepthPoints[i].groundDist > 0) continue;
@@ -288,13 +299,11 @@ void LiDAR::printDepthStats() {
         }
     }
 
-    std::ostringstream oss;
-    oss << "Avg distance ratio: " << totalRatio/(float)countTotal <<
+    LOG_INFO("Avg distance ratio: " << totalRatio/(float)countTotal <<
         "\nOver 100: " << ratioAbove100/(float)countAbove100 <<
         "\nUnder 120: " << ratio120/(float)count120 <<
         "\nUnder 40: " << ratio40/(float)count40 <<
-        "\nUnder 10: " << ratio10/(float)count10;
-    log(oss.str(), true);
+        "\nUnder 10: " << ratio10/(float)count10);
 }
 
 float * LiDAR::GetPointClouds(int &size, std::unordered_map<int, HitLidarEntity*> *entitiesHit, int param, float* depthMap, uint32_t* pInstanceSeg, Entity perspectiveVehicle)
@@ -313,12 +322,14 @@ float * LiDAR::GetPointClouds(int &size, std::unordered_map<int, HitLidarEntity*
     m_depthMapPoints = 0;
     m_beamCount = 0;
     m_updatedPointCount = 0;
+    //Only the last frame's depth points are used by UpdatePointCloud
+    m_hitDepthPoints.clear();
 
-    if (m_pPointClouds == NULL || m_initType == _LIDAR_NOT_INIT_YET_ || !m_isAttach)
+    if (m_pointClouds.empty() || m_initType == _LIDAR_NOT_INIT_YET_ || !m_isAttach)
         return NULL;
     switch (m_initType)
     {
-    case _LIDAR_INIT_AS_2D_: GenerateHorizPointClouds(90, m_pPointClouds);
+    case _LIDAR_INIT_AS_2D_: (this->*m_generateHorizPointClouds)(90, m_pointClouds.data());
     case _LIDAR_INIT_AS_3D_:
     {
         m_max_dist = 0;
@@ -335,24 +346,19 @@ float * LiDAR::GetPointClouds(int &size, std::unordered_map<int, HitLidarEntity*
                 break;
 
             ++horizBeamCount;
-            GenerateHorizPointClouds(phi, m_pPointClouds);
+            (this->*m_generateHorizPointClouds)(phi, m_pointClouds.data());
         }
-        std::ostringstream oss;
-        oss << "Max distance: " << m_max_dist << " min distance: " << m_min_dist
-            << "\nBeamCount: " << horizBeamCount;
-        log(oss.str());
+        LOG_DEBUG("Max distance: " << m_max_dist << " min distance: " << m_min_dist
+            << "\nBeamCount: " << horizBeamCount);
     }
     default:
         break;
     }
 
-    std::ostringstream oss1;
-    oss1 << "Raycast points: " << m_raycastPoints << " DM points: " << m_depthMapPoints << " total: " << m_pointsHit;
-    std::string str1 = oss1.str();
-    log(str1);
+    LOG_DEBUG("Raycast points: " << m_raycastPoints << " DM points: " << m_depthMapPoints << " total: " << m_pointsHit);
 
     size = m_pointsHit;
-    return m_pPointClouds;
+    return m_pointClouds.data();
 }
 
 int LiDAR::getTotalSmplNum()
@@ -368,6 +374,16 @@ int LiDAR::getTotalSmplNum()
     }
 }
 
+int LiDAR::getMaxPoints()
+{
+    return m_maxPoints;
+}
+
+size_t LiDAR::bufferBytes()
+{
+    return (m_pointClouds.size() + m_raycastPointCloud.size() + m_updatedPointCloud.size() + m_lidar2DPoints.size()) * sizeof(float);
+}
+
 int LiDAR::getVertiSmplNum()
 {
     return m_vertiSmplNum;
@@ -398,36 +414,6 @@ static float ReverseFloat(const float inFloat)
     return retVal;
 }
 
-float LiDAR::depthFromNDC(int x, int y, float screenX, float screenY) {
-    if (x >= s_camParams.width) {
-        x = s_camParams.width - 1;
-    }
-    if (y >= s_camParams.height) {
-        y = s_camParams.height - 1;
-    }
-
-    float xNorm = (float)x / (s_camParams.width - 1);
-    float yNorm = (float)y / (s_camParams.height - 1);
-    float normScreenX = abs(2 * xNorm - 1);
-    float normScreenY = abs(2 * yNorm - 1);
-
-    float ncX = normScreenX * s_camParams.ncWidth / 2;
-    float ncY = normScreenY * s_camParams.ncHeight / 2;
-
-    //Distance to near clip (hypotenus)
-    float d2nc = sqrt(s_camParams.nearClip * s_camParams.nearClip + ncX * ncX + ncY * ncY);
-
-    //depth value in normalized device coordinates (NDC)
-    float ndc = m_depthMap[y * s_camParams.width + x];
-
-    //Conversion from ndc to depth in camera coordinates
-    float depth = d2nc / ndc;
-    float depthDivisor = (s_camParams.nearClip * depth) / (2 * s_camParams.farClip);
-    depth = depth / (1 + depthDivisor);
-
-    return depth;
-}
-
 static bool isPositionOnScreen(float screenX, float screenY) {
     bool onScreen = true;
     if (screenX < 0 || screenY < 0 || screenX > 1 || screenY > 1) {
@@ -436,54 +422,11 @@ static bool isPositionOnScreen(float screenX, float screenY) {
     return onScreen;
 }
 
+template <bool NOISE>
 float LiDAR::getDepthFromScreenPos(float screenX, float screenY) {
-    float depth;
-    float halfW = 0.5 / s_camParams.width;
-    float halfH = 0.5 / s_camParams.height;
-    bool interpolated = false;
-    if (screenX > halfW && screenX < 1 - halfW
-        && screenY > halfH && screenY < 1 - halfH) {
-        //Need to do -0.5 as indexing starts at 0
-        float x = screenX * s_camParams.width - 0.5;
-        float y = screenY * s_camParams.height - 0.5;
-
-        int x0 = (int)floor(x);
-        int x1 = (int)ceil(x);
-        int y0 = (int)floor(y);
-        int y1 = (int)ceil(y);
-
-        float d00 = depthFromNDC(x0, y0);
-        float d01 = depthFromNDC(x0, y1);
-        float d10 = depthFromNDC(x1, y0);
-        float d11 = depthFromNDC(x1, y1);
-
-        //Normalize x/y to be between 0 and 1 to simplify interpolation
-        float normX = (float)x - x0;
-        float normY = (float)y - y0;
-
-        //Bilinear interpolation
-        //TODO: Would be better to use depth/stencil buffer to only interpolate on pixels of same object
-        bool outsideThreshold = false;
-        float minDepth = std::min(d00, std::min(d01, std::min(d10, d11)));
-        float maxDepth = std::max(d00, std::max(d01, std::max(d10, d11)));
-        if (maxDepth > minDepth * 1.08) {
-            outsideThreshold = true;
-        }
-        if (!outsideThreshold) {
-            interpolated = true;
-            depth = (1 - normX)*(1 - normY)*d00 + normX * (1 - normY)*d10 + (1 - normX)*normY*d01 + normX * normY*d11;
-        }
-    }
+    float depth = depthFromScreenPos(s_camParams, m_depthMap, screenX, screenY);
 
-    if (!interpolated) {
-        //Pixels are 0 indexed
-        int x = (int)floor(screenX * s_camParams.width);
-        int y = (int)floor(screenY * s_camParams.height);
-
-        depth = depthFromNDC(x, y, screenX, screenY);
-    }
-
-    if (LIDAR_GAUSSIAN_NOISE) {
+    if (NOISE) {
         float before = depth;
         depth += s_nDist(s_rng);
 
@@ -495,6 +438,7 @@ float LiDAR::getDepthFromScreenPos(float screenX, float screenY) {
     return depth;
 }
 
+template <bool NOISE>
 Vector3 LiDAR::adjustEndCoord(Vector3 pos, Vector3 relPos) {
     float scrX, scrY;
     //Use this function over native function as native function fails at edges of screen
@@ -511,7 +455,7 @@ Vector3 LiDAR::adjustEndCoord(Vector3 pos, Vector3 relPos) {
         log("Screen position is out of bounds.");
     }
     else {
-        float depth = getDepthFromScreenPos(screenX, screenY);
+        float depth = getDepthFromScreenPos<NOISE>(screenX, screenY);
 
         float originalDepth = sqrt(relPos.x * relPos.x + relPos.y * relPos.y + relPos.z * relPos.z);
         float multiplier = depth / originalDepth;
@@ -533,14 +477,15 @@ Vector3 LiDAR::adjustEndCoord(Vector3 pos, Vector3 relPos) {
     return relPos;
 }
 
+template <bool NOISE>
 Vector3 LiDAR::get3DFromDepthTarget(Vector3 target, Eigen::Vector2f target2D){
     Vector3 unitVec;
-    float distance = sqrt(SYSTEM::VDIST2(s_camParams.pos.x, s_camParams.pos.y, s_camParams.pos.z, target.x, target.y, target.z));
+    float distance = sqrt(vdist2(s_camParams.pos.x, s_camParams.pos.y, s_camParams.pos.z, target.x, target.y, target.z));
     unitVec.x = (target.x - s_camParams.pos.x) / distance;
     unitVec.y = (target.y - s_camParams.pos.y) / distance;
     unitVec.z = (target.z - s_camParams.pos.z) / distance;
 
-    float depth = getDepthFromScreenPos(target2D(0), target2D(1));
+    float depth = getDepthFromScreenPos<NOISE>(target2D(0), target2D(1));
 
     //Depth is already in relative coordinates
     Vector3 depthEndCoord;
@@ -582,17 +527,19 @@ void LiDAR::addToHitEntities(const Eigen::Vector2f &target2D) {
         Vector3 rightVector;
         Vector3 upVector;
         Vector3 position;
-        ENTITY::GET_ENTITY_MATRIX(entityID, &forwardVector, &rightVector, &upVector, &position); //Blue or red pill
+        m_world->getEntityMatrix(entityID, &forwardVector, &rightVector, &upVector, &position); //Blue or red pill
         position = subtractVector(position, s_camParams.pos);
         HitLidarEntity* hitEnt = new HitLidarEntity(forwardVector, position);
         m_entitiesHit->insert(std::pair<int, HitLidarEntity*>(entityID, hitEnt));
     }
 }
 
+template <bool RAYCAST, bool DEBUG_OUTPUT, bool NOISE, bool ADJUSTED_POINTS, bool RAY_POINTS_HIT>
 void LiDAR::GenerateSinglePoint(float phi, float theta, float* p)
 {
-    if (m_pointsHit >= MAX_POINTS) {
-        log("WARNING: MAX NUMBER OF POINTS REACHED! INCREASE MAX_POINTS\n", true);
+    if (m_pointsHit + LIDAR_POINTS_PER_BEAM > m_maxPoints) {
+        LOG_RATE_LIMITED(LOG_LEVEL_WARN, 1, "LiDAR point cloud full (" << m_maxPoints << " points), beam dropped");
+        return;
     }
     BOOL isHit = false;
     Entity hitEntity;
@@ -609,22 +556,22 @@ void LiDAR::GenerateSinglePoint(float phi, float theta, float* p)
     target.y = m_rotDCM[3] * endCoord.x + m_rotDCM[4] * endCoord.y + m_rotDCM[5] * endCoord.z + s_camParams.pos.y;
     target.z = m_rotDCM[6] * endCoord.x + m_rotDCM[7] * endCoord.y + m_rotDCM[8] * endCoord.z + s_camParams.pos.z;
 
-    if (USE_RAYCASTING) {
+    if (RAYCAST) {
         //options: -1=everything
         //New function is called _START_SHAPE_TEST_RAY
-        raycast_handle = WORLDPROBE::_CAST_RAY_POINT_TO_POINT(s_camParams.pos.x, s_camParams.pos.y, s_camParams.pos.z, target.x, target.y, target.z, -1, m_lidarVehicle, native_param);
+        raycast_handle = m_world->castRayPointToPoint(s_camParams.pos.x, s_camParams.pos.y, s_camParams.pos.z, target.x, target.y, target.z, -1, m_lidarVehicle, native_param);
 
         //New function is called GET_SHAPE_TEST_RESULT
-        WORLDPROBE::_GET_RAYCAST_RESULT(raycast_handle, &isHit, &endCoord, &surfaceNorm, &hitEntity);
+        m_world->getRaycastResult(raycast_handle, &isHit, &endCoord, &surfaceNorm, &hitEntity);
     }
 
     //The 2D screen coords of the target
     //This is what should be used for sampling depth map as endCoord will not hit same points as depth map
     target2D = get_2d_from_3d(Eigen::Vector3f(target.x, target.y, target.z));
 
-    if (GENERATE_2D_POINTMAP) {
-        *(m_lidar2DPoints + 2 * m_beamCount) = target2D(0);
-        *(m_lidar2DPoints + 2 * m_beamCount + 1) = target2D(1);
+    if (DEBUG_OUTPUT && GENERATE_2D_POINTMAP) {
+        *(m_lidar2DPoints.data() + 2 * m_beamCount) = target2D(0);
+        *(m_lidar2DPoints.data() + 2 * m_beamCount + 1) = target2D(1);
         ++m_beamCount;
     }
 
@@ -634,23 +581,23 @@ void LiDAR::GenerateSinglePoint(float phi, float theta, float* p)
         hitDepth.target = target;
         hitDepth.target2D = target2D;
         hitDepth.groundDist = -1;
-        if (OUTPUT_DEPTH_STATS) {
+        if (DEBUG_OUTPUT && OUTPUT_DEPTH_STATS) {
             float groundZ;
-            GAMEPLAY::GET_GROUND_Z_FOR_3D_COORD(endCoord.x, endCoord.y, endCoord.z, &(groundZ), 0);
+            m_world->getGroundZFor3dCoord(endCoord.x, endCoord.y, endCoord.z, &(groundZ), 0);
             hitDepth.groundDist = endCoord.z - groundZ;
         }
-        float rayDist = sqrt(SYSTEM::VDIST2(s_camParams.pos.x, s_camParams.pos.y, s_camParams.pos.z, endCoord.x, endCoord.y, endCoord.z));
+        float rayDist = sqrt(vdist2(s_camParams.pos.x, s_camParams.pos.y, s_camParams.pos.z, endCoord.x, endCoord.y, endCoord.z));
         hitDepth.rayCastDepth = rayDist;
         m_hitDepthPoints.push_back(hitDepth);
 
-        Vector3 vec_cam_coord = get3DFromDepthTarget(target, target2D);
+        Vector3 vec_cam_coord = get3DFromDepthTarget<NOISE>(target, target2D);
 
         /*std::ostringstream oss2;
         oss2 << "***vec_cam_coord is: " << vec_cam_coord.x << ", " << vec_cam_coord.y << ", " << vec_cam_coord.z;
         std::string str = oss2.str();
         log(str, true);*/
 
-        float newDistance = sqrt(SYSTEM::VDIST2(0, 0, 0, vec_cam_coord.x, vec_cam_coord.y, vec_cam_coord.z));
+        float newDistance = sqrt(vdist2(0, 0, 0, vec_cam_coord.x, vec_cam_coord.y, vec_cam_coord.z));
         if (newDistance <= MAX_LIDAR_DIST) {
             //Note: The y/x axes are changed to conform with KITTI velodyne axes
             *p = vec_cam_coord.y;
@@ -668,29 +615,22 @@ void LiDAR::GenerateSinglePoint(float phi, float theta, float* p)
 
             //*(p + 3) = m_pInstanceSeg[s_camParams.width * j + i];//We don't have the entityID if we're using the depth map
             int entityID = int(m_pInstanceSeg[s_camParams.width * j + i]);
-            int ownVehicleID= PED::GET_VEHICLE_PED_IS_IN(PLAYER::PLAYER_PED_ID(), false);
+            int ownVehicleID= m_world->getVehiclePedIsIn(m_world->playerPedId(), false);
 
 
 
-            Hash model = ENTITY::GET_ENTITY_MODEL(entityID); //Obtain vehicle model 
+            Hash model = m_world->getEntityModel(entityID); //Obtain vehicle model 
 
-            //Get the model string, convert it to lowercase then find it in lookup table
-            std::string modelString = VEHICLE::GET_DISPLAY_NAME_FROM_VEHICLE_MODEL(model);
-            std::string before = modelString;
-            std::transform(modelString.begin(), modelString.end(), modelString.begin(), ::tolower);
-            std::string type = "Unknown";
-            modelString.erase(remove_if(modelString.begin(), modelString.end(), [](char c) { return !isalpha(c); }), modelString.end());
-            auto search = m_vLookupLidar.find(modelString);
-            if (search != m_vLookupLidar.end()) { //model found
-                type = search->second;
-            }
-            else { //model not found
+            //Type from vehicle_labels.csv (resolved once per model)
+            const ModelInfo& modelInfo = s_modelCache.get(model);
+            bool isCar = modelInfo.inLookup && modelInfo.type == "Car";
+            if (!modelInfo.inLookup) { //model not found
                 *(p + 4) = 0;
                 *(p + 3) = 0;
             }
             /* TESTE */
             Vector3 vehicleForwardVector, vehicleRightVector, vehicleUpVector, currentPos;
-            ENTITY::GET_ENTITY_MATRIX(ownVehicleID, &vehicleForwardVector, &vehicleRightVector, &vehicleUpVector, &currentPos); //Blue or red pill
+            m_world->getEntityMatrix(ownVehicleID, &vehicleForwardVector, &vehicleRightVector, &vehicleUpVector, &currentPos); //Blue or red pill
 
             /* :::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::: POINT ::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::: */
                                                    /* :::::: GROUND POINT COORDINATES :::::: */
@@ -716,7 +656,7 @@ void LiDAR::GenerateSinglePoint(float phi, float theta, float* p)
 
 
             /* ----------------------------------------------------- Point cloud: Ground truth 'Pedestrian'  -------------------------------------------------------------*/
-            if (ENTITY::IS_ENTITY_A_PED(entityID)) {
+            if (m_world->isEntityAPed(entityID)) {
                 *(p + 9) = 1.0;
             }
             else {
@@ -729,9 +669,9 @@ void LiDAR::GenerateSinglePoint(float phi, float theta, float* p)
             /* ----------------------------------------------------- Point cloud: Ground truth 'Car'  -------------------------------------------------------------*/
             //Intensity value will be 1 for every object of the 'Car' class (ideal segmentation).
 
-            float ObjectSpeed = ENTITY::GET_ENTITY_SPEED(entityID);
+            float ObjectSpeed = m_world->getEntitySpeed(entityID);
 
-            if (type == "Car" && entityID != ownVehicleID) { //if the model is a 'Car' and not the player's vehicle, intensity is 1
+            if (isCar && entityID != ownVehicleID) { //if the model is a 'Car' and not the player's vehicle, intensity is 1
                 *(p + 4) = 1.0;           
             }
             else { //model is not a 'Car' or points are from player's own vehicle
@@ -764,19 +704,19 @@ void LiDAR::GenerateSinglePoint(float phi, float theta, float* p)
                                                                     /* :::::: PLAYER VELOCITY :::::: */
             //Obtain the velocity vector of the vehicle the player is using.
             Vector3 velocity_player;
-            if (VEHICLE::IS_VEHICLE_STOPPED(ownVehicleID)) {
+            if (m_world->isVehicleStopped(ownVehicleID)) {
                 velocity_player.x = 0;
                 velocity_player.y = 0;
                 velocity_player.z = 0;
             }else {
-                velocity_player = ENTITY::GET_ENTITY_SPEED_VECTOR(ownVehicleID, false);
+                velocity_player = m_world->getEntitySpeedVector(ownVehicleID, false);
             }
 
-            float InstantaneousSpeedPlayer = ENTITY::GET_ENTITY_SPEED(ownVehicleID);
+            float InstantaneousSpeedPlayer = m_world->getEntitySpeed(ownVehicleID);
 
                                                                    /* :::::: PLAYER COORDINATES :::::: */
             //Obtain the coordinates of the vehicle the player is using.
-            Vector3 player_coords = ENTITY::GET_OFFSET_FROM_ENTITY_IN_WORLD_COORDS(ownVehicleID, 0.0, 0.0, 0.0);
+            Vector3 player_coords = m_world->getOffsetFromEntityInWorldCoords(ownVehicleID, 0.0, 0.0, 0.0);
 
 
 
@@ -785,7 +725,7 @@ void LiDAR::GenerateSinglePoint(float phi, float theta, float* p)
              //Obtain ground coordinates for LiDAR placement and create a new position vector. World coordinates have different depth due to
              //vehicle or pedestrian.
              float groundZ_player;
-             GAMEPLAY::GET_GROUND_Z_FOR_3D_COORD(player_coords.x, player_coords.y, player_coords.z, &(groundZ_player), 0);
+             m_world->getGroundZFor3dCoord(player_coords.x, player_coords.y, player_coords.z, &(groundZ_player), 0);
 
              Vector3 PlayerPoint;
              PlayerPoint.x = player_coords.x;
@@ -801,18 +741,18 @@ void LiDAR::GenerateSinglePoint(float phi, float theta, float* p)
 
 
             Vector3 VectorDeltaVelocity;
-            Vector3 velocity_point = ENTITY::GET_ENTITY_SPEED_VECTOR(entityID, false);
+            Vector3 velocity_point = m_world->getEntitySpeedVector(entityID, false);
             float ObjectInstantaneousSpeed= sqrt(pow(velocity_point.x, 2) + pow(velocity_point.y, 2) + pow(velocity_point.z, 2));
 
 
             bool isEntityStoppedFlag = false;
-            if (ENTITY::IS_ENTITY_A_VEHICLE(entityID)) {
-                if (VEHICLE::IS_VEHICLE_STOPPED(entityID)) {
+            if (m_world->isEntityAVehicle(entityID)) {
+                if (m_world->isVehicleStopped(entityID)) {
                     isEntityStoppedFlag = true;
                 }
             }
-            if (ENTITY::IS_ENTITY_A_PED(entityID)) {
-                if (PED::IS_PED_STOPPED(entityID)) {
+            if (m_world->isEntityAPed(entityID)) {
+                if (m_world->isPedStopped(entityID)) {
                     isEntityStoppedFlag = true;
                 }
             }
@@ -875,10 +815,10 @@ void LiDAR::GenerateSinglePoint(float phi, float theta, float* p)
         }
     }
 
-    if (USE_RAYCASTING && isHit) {
+    if (RAYCAST && isHit) {
         int entityID = 0;
-        if ((ENTITY::IS_ENTITY_A_PED(hitEntity) && PED::GET_PED_TYPE(hitEntity) != 28) //PED_TYPE 28 are animals
-            || ENTITY::IS_ENTITY_A_VEHICLE(hitEntity)) {
+        if ((m_world->isEntityAPed(hitEntity) && m_world->getPedType(hitEntity) != 28) //PED_TYPE 28 are animals
+            || m_world->isEntityAVehicle(hitEntity)) {
             entityID = hitEntity;
         }
 
@@ -898,7 +838,7 @@ void LiDAR::GenerateSinglePoint(float phi, float theta, float* p)
             *(p + 3) = entityID;//This is the entityID (Only non-zero for pedestrians and vehicles)
             ++m_pointsHit;
 
-            float* pUpdatedPC = m_updatedPointCloud + (m_updatedPointCount * FLOATS_PER_POINT);
+            float* pUpdatedPC = m_updatedPointCloud.data() + (m_updatedPointCount * FLOATS_PER_POINT);
             *pUpdatedPC = vec_cam_coord.y;
             *(pUpdatedPC + 1) = -vec_cam_coord.x;
             *(pUpdatedPC + 2) = vec_cam_coord.z;
@@ -908,7 +848,7 @@ void LiDAR::GenerateSinglePoint(float phi, float theta, float* p)
 
         if (OUTPUT_RAYCAST_POINTS) {
             //Note: The y/x axes are changed to conform with KITTI velodyne axes
-            float* ptr = m_pRaycastPointCloud + (m_raycastPoints * FLOATS_PER_POINT);
+            float* ptr = m_raycastPointCloud.data() + (m_raycastPoints * FLOATS_PER_POINT);
             *ptr = vec_cam_coord.y;
             *(ptr + 1) = -vec_cam_coord.x;
             *(ptr + 2) = vec_cam_coord.z;
@@ -917,13 +857,13 @@ void LiDAR::GenerateSinglePoint(float phi, float theta, float* p)
         }
 
         //Likely just for testing purposes
-        if (OUTPUT_ADJUSTED_POINTS) {
+        if (ADJUSTED_POINTS) {
             //To convert from world coordinates to GTA vehicle coordinates (where y axis is forward)
             vec_cam_coord = convertCoordinateSystem(vec, cameraForwardVec, cameraRightVec, cameraUpVec);
 
-            vec_cam_coord = adjustEndCoord(endCoord, vec_cam_coord);
+            vec_cam_coord = adjustEndCoord<NOISE>(endCoord, vec_cam_coord);
 
-            float distance = sqrt(SYSTEM::VDIST2(0, 0, 0, vec_cam_coord.x, vec_cam_coord.y, vec_cam_coord.z));
+            float distance = sqrt(vdist2(0, 0, 0, vec_cam_coord.x, vec_cam_coord.y, vec_cam_coord.z));
             if (distance <= MAX_LIDAR_DIST) {
                 //Note: The y/x axes are changed to conform with KITTI velodyne axes
                 *(p + 4) = vec_cam_coord.y;
@@ -936,7 +876,7 @@ void LiDAR::GenerateSinglePoint(float phi, float theta, float* p)
 
         //Can be used to get general outline of some objects with raycasting
         //WARNING: NOT ALL VEHICLES ARE HIT WITH RAYCASTING
-        if (OBTAIN_RAY_POINTS_HIT) {
+        if (RAY_POINTS_HIT) {
             if (m_entitiesHit->find(entityID) != m_entitiesHit->end()) {
                 HitLidarEntity* hitEnt = m_entitiesHit->at(entityID);
                 hitEnt->pointsHit++;
@@ -950,7 +890,7 @@ void LiDAR::GenerateSinglePoint(float phi, float theta, float* p)
                 Vector3 rightVector;
                 Vector3 upVector;
                 Vector3 position;
-                ENTITY::GET_ENTITY_MATRIX(entityID, &forwardVector, &rightVector, &upVector, &position); //Blue or red pill
+                m_world->getEntityMatrix(entityID, &forwardVector, &rightVector, &upVector, &position); //Blue or red pill
                 position = subtractVector(position, s_camParams.pos);
                 HitLidarEntity* hitEnt = new HitLidarEntity(forwardVector, position);
                 m_entitiesHit->insert(std::pair<int, HitLidarEntity*>(entityID, hitEnt));
@@ -965,41 +905,39 @@ void LiDAR::GenerateSinglePoint(float phi, float theta, float* p)
 
 #ifdef DEBUG_GRAPHICS_LIDAR
     //GRAPHICS::DRAW_BOX(endCoord.x - 0.05, endCoord.y - 0.05, endCoord.z - 0.05, endCoord.x + 0.05, endCoord.y + 0.05, endCoord.z + 0.05, 0, 255, 0, 255);
-    GRAPHICS::DRAW_LINE(endCoord.x - 0.03, endCoord.y - 0.03, endCoord.z - 0.03, endCoord.x + 0.03, endCoord.y + 0.03, endCoord.z + 0.03, 255, 255, 255, 255);
+    m_world->drawLine(endCoord.x - 0.03, endCoord.y - 0.03, endCoord.z - 0.03, endCoord.x + 0.03, endCoord.y + 0.03, endCoord.z + 0.03, 255, 255, 255, 255);
 #endif //DEBUG_GRAPHICS_LIDAR
 }
 
+template <bool RAYCAST, bool DEBUG_OUTPUT, bool NOISE, bool ADJUSTED_POINTS, bool RAY_POINTS_HIT>
 void LiDAR::GenerateHorizPointClouds(float phi, float *p)
 {
     int i, j;
     float theta = 0.0, quaterion[4];
     calcDCM();
 
+    //Both sides check the new angle, with an azimuth stride the previous one can be several steps short of the limit
     //Right side:
-    theta = m_horizRiLimit;
-    for (j = 0; j < m_horizSmplNum; j++)
+    for (j = 0; j < m_horizSmplNum; j += m_azimuthStride)
     {
-        if (theta < 360.0 - m_horizResolu)
-            theta = m_horizRiLimit + j * m_horizResolu;
-        else
+        theta = m_horizRiLimit + j * m_horizResolu;
+        if (theta >= 360.0)
             break;
-        GenerateSinglePoint(phi, theta, p + (m_pointsHit * FLOATS_PER_POINT));
+        GenerateSinglePoint<RAYCAST, DEBUG_OUTPUT, NOISE, ADJUSTED_POINTS, RAY_POINTS_HIT>(phi, theta, p + (m_pointsHit * FLOATS_PER_POINT));
     }
     //Left side:
-    theta = theta - 360.0;
-    for (i = 0; i < m_horizSmplNum - j; i++)
+    for (i = 0; i < m_horizSmplNum - j; i += m_azimuthStride)
     {
-        if (theta < m_horizLeLimit - m_horizResolu)
-            theta = 0.0 + i * m_horizResolu;
-        else
+        theta = 0.0 + i * m_horizResolu;
+        if (theta >= m_horizLeLimit)
             break;
-        GenerateSinglePoint(phi, theta, p + (m_pointsHit * FLOATS_PER_POINT));
+        GenerateSinglePoint<RAYCAST, DEBUG_OUTPUT, NOISE, ADJUSTED_POINTS, RAY_POINTS_HIT>(phi, theta, p + (m_pointsHit * FLOATS_PER_POINT));
     }
 }
 
 void LiDAR::calcDCM()
 {
-    ENTITY::GET_ENTITY_QUATERNION(m_lidarVehicle, &m_quaterion[0], &m_quaterion[1], &m_quaterion[2], &m_quaterion[3]);
+    m_world->getEntityQuaternion(m_lidarVehicle, &m_quaterion[0], &m_quaterion[1], &m_quaterion[2], &m_quaterion[3]);
     //m_quaterion: R - coord spins to b - coord
     float q00 = m_quaterion[3] * m_quaterion[3], q11 = m_quaterion[0] * m_quaterion[0], q22 = m_quaterion[1] * m_quaterion[1], q33 = m_quaterion[2] * m_quaterion[2];
     float q01 = m_quaterion[3] * m_quaterion[0], q02 = m_quaterion[3] * m_quaterion[1], q03 = m_quaterion[3] * m_quaterion[2], q12 = m_quaterion[0] * m_quaterion[1];
@@ -1025,37 +963,7 @@ void LiDAR::updateCurrentPosition(Vector3 cameraForwardVector, Vector3 cameraRig
 
 
 void LiDAR::VehicleLookUpTable() {
-    if (!m_vLookupInitLidar) {
-        std::string translationFile = std::string(getenv("DEEPGTAV_DIR")) + "\\ObjectDet\\vehicle_labels.csv";
-        std::ifstream inFile(translationFile);
-        std::string line;
-        log("Translation file:", true);
-        log(translationFile, true);
-        while (std::getline(inFile, line)) // read whole line into line
-        {
-            std::istringstream iss(line); // string stream
-            std::string model;
-            std::string vehicleType;
-            std::getline(iss, model, ','); // read first part up to comma, ignore the comma
-            std::string before = model;
-            model.erase(remove_if(model.begin(), model.end(), [](char c) { return !isalpha(c); }), model.end());
-            iss >> vehicleType; // read the second part
-            m_vLookupLidar.insert(std::pair< std::string, std::string>(model, vehicleType));
-
-            //Modelstrings seem to be missing last few letters on occasion (this should fix that)
-            if (model.size() >= 2) {
-                model = model.substr(0, model.size() - 1);
-                m_vLookupLidar.insert(std::pair< std::string, std::string>(model, vehicleType));
-            }
-            if (model.size() >= 2) {
-                model = model.substr(0, model.size() - 1);
-                m_vLookupLidar.insert(std::pair< std::string, std::string>(model, vehicleType));
-            }
-            if (model.size() >= 2) {
-                model = model.substr(0, model.size() - 1);
-                m_vLookupLidar.insert(std::pair< std::string, std::string>(model, vehicleType));
-            }
-        }
-        m_vLookupInitLidar = true;
-    }
+    //The vehicle type table is compiled in (VehicleTypeTable.h), only the optional override file is read
+    const char* dir = getenv("DEEPGTAV_DIR");
+    if (dir) s_modelCache.loadOverrides(withSeparator(dir) + "ObjectDet" + PATH_SEPARATOR + "vehicle_labels_override.csv");
 }
\ No newline at end of file
@@ -6,16 +6,19 @@ https://github.com/gdpinchina/A-virtual-LiDAR-for-DeepGTAV
 */
 
 #pragma once
-#include "..\ObjectDetIncludes.h"
+#include "CoreTypes.h"
 #include <unordered_map>
+#include <vector>
 #include <Eigen/Core>
 #include "CamParams.h"
+#include "World.h"
 
 #define _LIDAR_NOT_INIT_YET_ 0
 #define _LIDAR_INIT_AS_2D_ 1
 #define _LIDAR_INIT_AS_3D_ 2
 
-const int MAX_POINTS = 5000000;
+//Points a single beam can add to the point cloud (the depth map or raycast point plus an adjusted point)
+const int LIDAR_POINTS_PER_BEAM = 2;
 extern Vector3 Camera_Obj_fwd;
 extern Vector3 Camera_Obj_right;
 extern Vector3 Camera_Obj_up;
@@ -80,6 +83,11 @@ public:
 
     void AttachLiDAR2Camera(Cam camera, Entity ownCar);
 
+    //World the rays are cast into (defaultWorld unless set)
+    void SetWorld(IWorld* world);
+    //Casts every stride-th horizontal sample (1 = full density)
+    void SetAzimuthStride(int stride);
+
     void DestroyLiDAR();
 
     float* GetPointClouds(int &size, std::unordered_map<int, HitLidarEntity*> *entitiesHit, int param, float* depthMap, uint32_t* pInstanceSeg, Entity perspectiveVehicle = -1);
@@ -90,6 +98,10 @@ public:
     int getVertiSmplNum();
     int getHorizSmplNum();
     int getCurType();
+    //Capacity of the point cloud, sized from the beam count at init
+    int getMaxPoints();
+    //Bytes held by the point cloud buffers
+    size_t bufferBytes();
 
     void updateCurrentPosition(Vector3 cameraForwardVec, Vector3 cameraRightVector, Vector3 cameraUpVector);
 
@@ -98,16 +110,32 @@ public:
 
 private:
 
+    //RAYCAST: USE_RAYCASTING, DEBUG_OUTPUT: GENERATE_2D_POINTMAP or OUTPUT_DEPTH_STATS, NOISE: LIDAR_GAUSSIAN_NOISE,
+    //ADJUSTED_POINTS: OUTPUT_ADJUSTED_POINTS, RAY_POINTS_HIT: OBTAIN_RAY_POINTS_HIT
+    //Disabled features are compiled out of the per beam code, the variant is picked in allocateBuffers
+    template <bool RAYCAST, bool DEBUG_OUTPUT, bool NOISE, bool ADJUSTED_POINTS, bool RAY_POINTS_HIT>
     void GenerateSinglePoint(float phi, float theta, float *p);
+    template <bool RAYCAST, bool DEBUG_OUTPUT, bool NOISE, bool ADJUSTED_POINTS, bool RAY_POINTS_HIT>
     void GenerateHorizPointClouds(float phi, float *p);
+    typedef void (LiDAR::*HorizPointCloudsFn)(float phi, float *p);
+    HorizPointCloudsFn m_generateHorizPointClouds;
+    //GenerateHorizPointClouds variant for the settings in flags (template parameter order), FIXED are the ones picked so far
+    static const int HORIZ_VARIANT_FLAGS = 5;
+    template <bool... FIXED>
+    static HorizPointCloudsFn horizPointCloudsVariant(const bool* flags);
+    template <bool NOISE>
+    void updatePoints();
     void calcDCM();
     void addToHitEntities(const Eigen::Vector2f &target2D);
+    void allocateBuffers(int beams);
 
 
 private:
 
-    float* m_pPointClouds;
-    float* m_pRaycastPointCloud;
+    //Sized by allocateBuffers() for the configured beams
+    std::vector<float> m_pointClouds;
+    std::vector<float> m_raycastPointCloud;
+    int m_maxPoints;
     int m_pointsHit;
     int m_depthMapPoints;
     int m_raycastPoints;
@@ -120,12 +148,11 @@ private:
     int m_horizSmplNum;
     float m_vertiResolu;//deg, vertical angle resolution
     float m_horizResolu;//deg, horizontal angle resolution
-
-    bool m_vLookupInitLidar = false;
-    std::unordered_map<std::string, std::string> m_vLookupLidar; //Vehicle lookup
+    int m_azimuthStride;
 
     Cam m_camera;
     Entity m_lidarVehicle;
+    IWorld* m_world;
     float m_quaterion[4];
     float m_rotDCM[9];//convert n-coord to b-coord
     int m_initType;
@@ -139,7 +166,7 @@ private:
     float m_max_dist;
     float m_min_dist;
 
-    float* m_lidar2DPoints;
+    std::vector<float> m_lidar2DPoints;
     int m_beamCount;
 
     std::unordered_map<int, HitLidarEntity*>* m_entitiesHit;
@@ -148,13 +175,16 @@ private:
 
     //Depth map variables
     float * m_depthMap;
+    //NOISE adds the LIDAR_GAUSSIAN_NOISE depth noise
+    template <bool NOISE>
     Vector3 adjustEndCoord(Vector3 pos, Vector3 relPos);
-    float depthFromNDC(int x, int y, float screenX = 0.0f, float screenY = 0.0f);
+    template <bool NOISE>
     float getDepthFromScreenPos(float screenX, float screenY);
 
     //Updating at a later time with the new depth map
     int m_updatedPointCount;
-    float * m_updatedPointCloud;
+    std::vector<float> m_updatedPointCloud;
+    template <bool NOISE>
     Vector3 get3DFromDepthTarget(Vector3 target, Eigen::Vector2f target2D);
     std::vector<Hit2DDepth> m_hitDepthPoints;
 
@@ -0,0 +1,131 @@
+#include "Logger.h"
+#include <stdlib.h>
+
+Logger s_logger;
+
+static const char* const LOG_LEVEL_NAMES[] = { "DEBUG", "INFO", "WARN", "ERROR" };
+
+Logger::Logger() : m_path(getenv("DEEPGTAV_LOG_FILE")), m_level(LOG_DEFAULT_LEVEL), m_tail(0), m_head(0), m_written(0),
+    m_dropped(0), m_started(false), m_stop(false) {
+    m_start = std::chrono::steady_clock::now();
+    for (size_t k = 0; k < LOG_QUEUE_SIZE; ++k) {
+        m_slots[k].sequence.store(k, std::memory_order_relaxed);
+    }
+}
+
+Logger::~Logger() {
+#ifdef _WIN32
+    //Joining here can deadlock on the loader lock. shutdown() has stopped the thread, or process exit has ended it.
+    if (m_thread.joinable()) m_thread.detach();
+#else
+    shutdown();
+#endif
+}
+
+void Logger::write(LogLevel level, std::string&& message) {
+    //The thread is not started from a static constructor (loader lock in the plugin DLL)
+    if (!m_started.load(std::memory_order_acquire)) {
+        bool expected = false;
+        if (m_started.compare_exchange_strong(expected, true)) {
+            m_thread = std::thread(&Logger::run, this);
+        }
+    }
+    if (!push(level, std::move(message))) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void Logger::flush() {
+    size_t target = m_tail.load(std::memory_order_acquire);
+    while (m_started.load() && m_written.load(std::memory_order_acquire) < target) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+void Logger::shutdown() {
+    if (!m_thread.joinable()) return;
+    m_stop.store(true);
+    m_thread.join();
+    m_stop.store(false);
+    m_started.store(false, std::memory_order_release);
+}
+
+//Bounded multi-producer queue: each slot's sequence says whether it is free for the ticket at m_tail
+//or holds the message for the ticket at m_head
+bool Logger::push(LogLevel level, std::string&& message) {
+    size_t pos = m_tail.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot& slot = m_slots[pos & (LOG_QUEUE_SIZE - 1)];
+        size_t seq = slot.sequence.load(std::memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+        if (diff == 0) {
+            if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                slot.level = level;
+                slot.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+                slot.message = std::move(message);
+                slot.sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (diff < 0) {
+            return false;
+        }
+        else {
+            pos = m_tail.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool Logger::pop(LogLevel& level, double& seconds, std::string& message) {
+    size_t pos = m_head.load(std::memory_order_relaxed);
+    Slot& slot = m_slots[pos & (LOG_QUEUE_SIZE - 1)];
+    if (slot.sequence.load(std::memory_order_acquire) != pos + 1) return false;
+    level = slot.level;
+    seconds = slot.seconds;
+    message.swap(slot.message);
+    slot.message.clear();
+    m_head.store(pos + 1, std::memory_order_relaxed);
+    slot.sequence.store(pos + LOG_QUEUE_SIZE, std::memory_order_release);
+    return true;
+}
+
+void Logger::run() {
+    FILE* f = fopen(m_path, "a");
+    LogLevel level;
+    double seconds;
+    std::string message;
+    for (;;) {
+        bool any = false;
+        while (pop(level, seconds, message)) {
+            any = true;
+            if (f) {
+                uint32_t dropped = m_dropped.exchange(0, std::memory_order_relaxed);
+                if (dropped > 0) fprintf(f, "%.3f WARN %u log messages dropped (queue full)\n", seconds, dropped);
+                fprintf(f, "%.3f %s %s\n", seconds, LOG_LEVEL_NAMES[level], message.c_str());
+            }
+            m_written.fetch_add(1, std::memory_order_release);
+        }
+        if (any && f) fflush(f);
+        if (!any) {
+            if (m_stop.load()) break;
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+    }
+    if (f) fclose(f);
+}
+
+bool LogRateLimit::allow(int perSecond, int& suppressedOut) {
+    int64_t now = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    if (now != windowStart) {
+        windowStart = now;
+        count = 0;
+    }
+    if (count >= perSecond) {
+        ++suppressed;
+        return false;
+    }
+    ++count;
+    suppressedOut = suppressed;
+    suppressed = 0;
+    return true;
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <atomic>
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <thread>
+
+//Leveled logger writing to DEEPGTAV_LOG_FILE from a background thread.
+//Callers push onto a bounded lock-free queue and return; the thread keeps the file open and drains it.
+//If the queue is full the message is dropped and counted (the count is written with the next message).
+//
+//    LOG_DEBUG("Focal length is: " << f);
+//    LOG_RATE_LIMITED(LOG_LEVEL_WARN, 1, "unknown stencil type: " << s);
+//
+//The streamed arguments are only formatted when the level is enabled. Levels below LOG_COMPILED_LEVEL
+//(build flag, 0 = debug ... 3 = error) are removed at compile time.
+
+#ifndef LOG_COMPILED_LEVEL
+#define LOG_COMPILED_LEVEL 0
+#endif
+
+enum LogLevel : uint8_t {
+    LOG_LEVEL_DEBUG,
+    LOG_LEVEL_INFO,
+    LOG_LEVEL_WARN,
+    LOG_LEVEL_ERROR,
+    LOG_LEVEL_OFF
+};
+
+//Runtime level until setLevel is called. Debug messages (log() without override) are off by default.
+const LogLevel LOG_DEFAULT_LEVEL = LOG_LEVEL_INFO;
+const int LOG_QUEUE_SIZE = 4096;//Power of two
+
+class Logger {
+public:
+    Logger();
+    ~Logger();
+
+    bool enabled(LogLevel level) const {
+        return level >= m_level.load(std::memory_order_relaxed) && m_path != NULL;
+    }
+    void setLevel(LogLevel level) { m_level.store(level, std::memory_order_relaxed); }
+
+    //Queues the message (starts the writer thread on first use)
+    void write(LogLevel level, std::string&& message);
+    //Blocks until everything queued so far is in the file
+    void flush();
+    //Writes what is queued and joins the thread, a later write starts it again. Called when the script stops
+    //(~ObjectDetection) while no other thread logs; the static destructor runs under the DLL loader lock and must not join.
+    void shutdown();
+
+private:
+    struct Slot {
+        std::atomic<size_t> sequence;
+        LogLevel level;
+        double seconds;
+        std::string message;
+    };
+
+    bool push(LogLevel level, std::string&& message);
+    bool pop(LogLevel& level, double& seconds, std::string& message);
+    void run();
+
+    const char* m_path;
+    std::atomic<LogLevel> m_level;
+    std::chrono::steady_clock::time_point m_start;
+
+    Slot m_slots[LOG_QUEUE_SIZE];
+    std::atomic<size_t> m_tail;
+    std::atomic<size_t> m_head;
+    std::atomic<size_t> m_written;
+    std::atomic<uint32_t> m_dropped;
+
+    std::thread m_thread;
+    std::atomic<bool> m_started;
+    std::atomic<bool> m_stop;
+};
+
+extern Logger s_logger;
+
+//Allows perSecond messages per call site and counts the rest (call sites are on the script thread)
+struct LogRateLimit {
+    int64_t windowStart = -1;
+    int count = 0;
+    int suppressed = 0;
+
+    //suppressed is set to the number of messages dropped since the last one allowed
+    bool allow(int perSecond, int& suppressedOut);
+};
+
+#define LOG_AT(level, expr) do { \
+        if ((level) >= LOG_COMPILED_LEVEL && s_logger.enabled(level)) { \
+            std::ostringstream logStream; \
+            logStream << expr; \
+            s_logger.write(level, logStream.str()); \
+        } \
+    } while (0)
+
+#define LOG_RATE_LIMITED(level, perSecond, expr) do { \
+        static LogRateLimit logLimit; \
+        int logSuppressed; \
+        if ((level) >= LOG_COMPILED_LEVEL && s_logger.enabled(level) && logLimit.allow(perSecond, logSuppressed)) { \
+            std::ostringstream logStream; \
+            logStream << expr; \
+            if (logSuppressed > 0) logStream << " (" << logSuppressed << " similar suppressed)"; \
+            s_logger.write(level, logStream.str()); \
+        } \
+    } while (0)
+
+#if LOG_COMPILED_LEVEL <= 0
+#define LOG_DEBUG(expr) LOG_AT(LOG_LEVEL_DEBUG, expr)
+#else
+#define LOG_DEBUG(expr) do {} while (0)
+#endif
+#if LOG_COMPILED_LEVEL <= 1
+#define LOG_INFO(expr) LOG_AT(LOG_LEVEL_INFO, expr)
+#else
+#define LOG_INFO(expr) do {} while (0)
+#endif
+#if LOG_COMPILED_LEVEL <= 2
+#define LOG_WARN(expr) LOG_AT(LOG_LEVEL_WARN, expr)
+#else
+#define LOG_WARN(expr) do {} while (0)
+#endif
+#define LOG_ERROR(expr) LOG_AT(LOG_LEVEL_ERROR, expr)
@@ -0,0 +1,134 @@
+#include "ModelInfoCache.h"
+#include <Eigen/Core>
+#include "CamParams.h"
+#include "Functions.h"
+#include "World.h"
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <unordered_set>
+
+//Global model cache shared by ObjectDetection and LiDAR
+ModelInfoCache s_modelCache;
+
+//Same hash the game uses for model names (GET_HASH_KEY)
+static Hash joaat(const std::string& str) {
+    uint32_t h = 0;
+    for (char c : str) {
+        h += (uint8_t)tolower(c);
+        h += h << 10;
+        h ^= h >> 6;
+    }
+    h += h << 3;
+    h ^= h >> 11;
+    h += h << 15;
+    return h;
+}
+
+//Trailers considered for towing. These are display names, and also the model names of most of them,
+//so a model is a trailer if either its model hash or the hash of its display name is in the set.
+static const std::unordered_set<Hash> s_trailerHashes = {
+    joaat("TRAILERLARGE"), joaat("TRAILER"), joaat("DOCKTRAILER"), joaat("TR2"), joaat("TANKER"),
+    joaat("TRAILERL"), joaat("ARMYTRAILER"), joaat("TR3"), joaat("TRAILERS3")
+};
+
+static std::string lookupNameOf(std::string name) {
+    std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+    name.erase(remove_if(name.begin(), name.end(), [](char c) { return !isalpha(c); }), name.end());
+    return name;
+}
+
+void ModelInfoCache::loadOverrides(const std::string& overrideFile) {
+    if (m_overridesLoaded) return;
+    m_overridesLoaded = true;
+
+    std::ifstream inFile(overrideFile);
+    if (!inFile) return;
+    log("Vehicle label overrides:", true);
+    log(overrideFile, true);
+
+    std::string line;
+    while (std::getline(inFile, line))
+    {
+        std::istringstream iss(line);
+        std::string model;
+        std::string vehicleType;
+        std::getline(iss, model, ',');
+        iss >> vehicleType;
+
+        VehicleType type = VEHICLE_TYPE_UNKNOWN;
+        for (int t = 0; t < (int)(sizeof(VEHICLE_TYPE_NAMES) / sizeof(VEHICLE_TYPE_NAMES[0])); ++t) {
+            if (vehicleType == VEHICLE_TYPE_NAMES[t]) type = (VehicleType)t;
+        }
+        if (model.empty() || type == VEHICLE_TYPE_UNKNOWN) continue;
+
+        model.erase(remove_if(model.begin(), model.end(), [](char c) { return isspace(c); }), model.end());
+        m_modelOverrides[joaat(model)] = type;
+        m_nameOverrides[lookupNameOf(model)] = type;
+    }
+    //Types resolved before the overrides were loaded would be wrong
+    m_models.clear();
+}
+
+VehicleType ModelInfoCache::lookupType(Hash model, std::string_view lookupName) const {
+    auto modelOverride = m_modelOverrides.find(model);
+    if (modelOverride != m_modelOverrides.end()) return modelOverride->second;
+    VehicleType type = vehicleTypeFromModel(model);
+    if (type != VEHICLE_TYPE_UNKNOWN) return type;
+
+    auto nameOverride = m_nameOverrides.find(lookupName);
+    if (nameOverride != m_nameOverrides.end()) return nameOverride->second;
+    return vehicleTypeFromName(lookupName);
+}
+
+const ModelInfo& ModelInfoCache::get(Hash model) {
+    auto found = m_models.find(model);
+    if (found != m_models.end()) return found->second;
+
+    IWorld* world = m_world ? m_world : defaultWorld();
+    ModelInfo info;
+    info.min = info.max = Vector3();
+    if (world) world->getModelDimensions(model, &info.min, &info.max);
+    float rx = std::max(fabs(info.min.x), fabs(info.max.x));
+    float ry = std::max(fabs(info.min.y), fabs(info.max.y));
+    float rz = std::max(fabs(info.min.z), fabs(info.max.z));
+    info.radius = sqrt(rx * rx + ry * ry + rz * rz);
+
+    if (!world) info.classID = 9;
+    else if (world->isThisModelACar(model)) info.classID = 0;
+    else if (world->isThisModelABike(model)) info.classID = 1;
+    else if (world->isThisModelABicycle(model)) info.classID = 2;
+    else if (world->isThisModelAQuadbike(model)) info.classID = 3;
+    else if (world->isThisModelABoat(model)) info.classID = 4;
+    else if (world->isThisModelAPlane(model)) info.classID = 5;
+    else if (world->isThisModelAHeli(model)) info.classID = 6;
+    else if (world->isThisModelATrain(model)) info.classID = 7;
+    else if (world->isThisModelASubmersible(model)) info.classID = 8;
+    else info.classID = 9; //unknown (ufo?)
+
+    //Get the model string, convert it to lowercase then find it in lookup table
+    info.displayName = world ? world->getDisplayNameFromVehicleModel(model) : "CARNOTFOUND";
+    info.lookupName = lookupNameOf(info.displayName);
+    info.isTrailer = s_trailerHashes.count(model) != 0 || s_trailerHashes.count(joaat(info.displayName)) != 0;
+
+    info.vehicleType = lookupType(model, info.lookupName);
+    info.inLookup = info.vehicleType != VEHICLE_TYPE_UNKNOWN;
+    if (info.inLookup) {
+        info.type = VEHICLE_TYPE_NAMES[info.vehicleType];
+    }
+    else {
+        //Any vehicle model which is missing from the table
+        info.type = info.classID != 9 ? "UNK" : "Unknown";
+    }
+
+    return m_models.insert(std::pair<Hash, ModelInfo>(model, info)).first->second;
+}
+
+const ModelInfo* ModelInfoCache::find(Hash model) const {
+    auto found = m_models.find(model);
+    return found != m_models.end() ? &found->second : NULL;
+}
+
+void ModelInfoCache::add(Hash model, const ModelInfo& info) {
+    m_models[model] = info;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "CoreTypes.h"
+#include "VehicleTypeTable.h"
+#include <string>
+#include <string_view>
+#include <map>
+#include <unordered_map>
+
+class IWorld;
+
+//Per model metadata which never changes for a given Hash
+struct ModelInfo {
+    Vector3 min;//GET_MODEL_DIMENSIONS
+    Vector3 max;
+    float radius;//Bounding sphere about the entity origin
+    int classID;//Vehicle class (0 car ... 8 submersible, 9 unknown)
+    std::string displayName;//GET_DISPLAY_NAME_FROM_VEHICLE_MODEL
+    std::string lookupName;//Lowercase letters of the display name (key into vehicle_labels.csv)
+    VehicleType vehicleType;//VEHICLE_TYPE_UNKNOWN if not in vehicle_labels.csv or the override file
+    bool inLookup;
+    std::string type;//Name of vehicleType, "UNK" for other vehicle models, otherwise "Unknown"
+    bool isTrailer;//Can be towed (see s_trailerHashes in ModelInfoCache.cpp)
+};
+
+//Model metadata filled on first sight of a model and kept for the whole session.
+//Shared by ObjectDetection and LiDAR (both run on the script thread).
+class ModelInfoCache {
+public:
+    //Types come from the table generated from vehicle_labels.csv (VehicleTypeTable.h).
+    //An optional csv in the same format overrides it, first by model name hash and then by lookup name.
+    //Only the first call does anything. Missing files are fine.
+    void loadOverrides(const std::string& overrideFile);
+
+    //World asked for models which are not cached yet (NULL: defaultWorld())
+    void setWorld(IWorld* world) { m_world = world; }
+
+    const ModelInfo& get(Hash model);
+    //NULL if the model has not been seen yet
+    const ModelInfo* find(Hash model) const;
+    //Seeds the cache with known metadata (e.g. from a recorded world state) so get() does not ask the game
+    void add(Hash model, const ModelInfo& info);
+
+    //Generated table first, then overrides. Does not allocate.
+    VehicleType lookupType(Hash model, std::string_view lookupName) const;
+
+private:
+    IWorld* m_world = NULL;
+    bool m_overridesLoaded = false;
+    std::unordered_map<Hash, VehicleType> m_modelOverrides;
+    std::map<std::string, VehicleType, std::less<>> m_nameOverrides;
+    std::unordered_map<Hash, ModelInfo> m_models;
+};
+
+extern ModelInfoCache s_modelCache;
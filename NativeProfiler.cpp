@@ -0,0 +1,83 @@
+#include "NativeProfiler.h"
+
+#ifdef PROFILE_NATIVES
+
+#include <string.h>
+
+NativeProfiler s_nativeProfiler;
+
+NativeProfiler::NativeProfiler() {
+    m_epoch = std::chrono::steady_clock::now();
+}
+
+NativeProfiler::~NativeProfiler() {
+    close();
+}
+
+bool NativeProfiler::open(const std::string& filename, const std::string& traceFile) {
+    if (m_file) return true;
+    m_file = fopen(filename.c_str(), "w");
+    if (!m_file) return false;
+    fprintf(m_file, "frame,native,calls,total_us,max_us\n");
+    m_traceFile = fopen(traceFile.c_str(), "w");
+    if (m_traceFile) fputs("[", m_traceFile);
+    m_firstTraceEvent = true;
+    return true;
+}
+
+void NativeProfiler::close() {
+    endFrame();
+    if (m_file) fclose(m_file);
+    if (m_traceFile) {
+        fputs("\n]\n", m_traceFile);
+        fclose(m_traceFile);
+    }
+    m_file = NULL;
+    m_traceFile = NULL;
+}
+
+int NativeProfiler::registerNative(const char* name) {
+    //Call sites of the same native share its counters
+    for (size_t k = 0; k < m_stats.size(); ++k) {
+        if (strcmp(m_stats[k].name, name) == 0) return (int)k;
+    }
+    m_stats.push_back({ name, 0, 0.0, 0.0 });
+    return (int)m_stats.size() - 1;
+}
+
+void NativeProfiler::beginFrame(int frame) {
+    endFrame();
+    m_frame = frame;
+}
+
+void NativeProfiler::endFrame() {
+    if (m_file && m_frame >= 0) {
+        for (const NativeStat& stat : m_stats) {
+            if (stat.calls == 0) continue;
+            fprintf(m_file, "%d,%s,%llu,%.1f,%.1f\n", m_frame, stat.name, (unsigned long long)stat.calls, stat.totalUs, stat.maxUs);
+        }
+        fflush(m_file);
+        writeTrace();
+    }
+    for (NativeStat& stat : m_stats) {
+        stat.calls = 0;
+        stat.totalUs = 0.0;
+        stat.maxUs = 0.0;
+    }
+    m_eventCount = 0;
+    m_frame = -1;
+}
+
+void NativeProfiler::writeTrace() {
+    if (!m_traceFile) return;
+    //Natives on their own row (tid 2) so the trace can be loaded alongside StageTrace.json
+    for (int k = 0; k < m_eventCount; ++k) {
+        const NativeEvent& e = m_events[k];
+        fprintf(m_traceFile, "%s\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":2,\"ts\":%.1f,\"dur\":%.1f,\"args\":{\"frame\":%d}}",
+            m_firstTraceEvent ? "" : ",", m_stats[e.id].name, e.startUs, e.durUs, m_frame);
+        m_firstTraceEvent = false;
+    }
+    fflush(m_traceFile);
+}
+
+#endif
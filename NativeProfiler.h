@@ -0,0 +1,110 @@
+#pragma once
+
+//Call counts and latency of every game native made through LiveWorld (World.cpp), per frame
+//Only built when PROFILE_NATIVES is defined. Otherwise NATIVE(fn) is just fn and there is no cost at all.
+//
+//NATIVE wraps the native rather than the call so call sites keep their arguments:
+//    NATIVE(ENTITY::GET_ENTITY_MODEL)(entity)
+//Each frame is written when the next one begins:
+//  NativeProfile.csv  the counters as frame,native,calls,total_us,max_us
+//  NativeTrace.json   every call as a Chrome trace event (chrome://tracing or ui.perfetto.dev), as StageTrace.json
+
+#ifdef PROFILE_NATIVES
+
+#include <stdint.h>
+#include <stdio.h>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <utility>
+
+//Trace events kept per frame, later calls are only counted in the CSV
+const int NATIVE_MAX_EVENTS = 4096;
+
+struct NativeEvent {
+    int id;
+    double startUs;
+    double durUs;
+};
+
+struct NativeStat {
+    const char* name;
+    uint64_t calls;
+    double totalUs;
+    double maxUs;
+};
+
+class NativeProfiler {
+public:
+    NativeProfiler();
+    ~NativeProfiler();
+
+    bool open(const std::string& filename, const std::string& traceFile);
+    //Writes the current frame and closes the files
+    void close();
+    //Each call site registers once (from a function-local static), sites of the same native get the same id
+    int registerNative(const char* name);
+
+    double nowUs() const {
+        return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - m_epoch).count();
+    }
+    void record(int id, double startUs, double us) {
+        NativeStat& stat = m_stats[id];
+        ++stat.calls;
+        stat.totalUs += us;
+        if (us > stat.maxUs) stat.maxUs = us;
+        if (m_eventCount < NATIVE_MAX_EVENTS) {
+            m_events[m_eventCount++] = { id, startUs, us };
+        }
+    }
+
+    //Writes the counters of the previous frame (if any) and starts counting for frame
+    void beginFrame(int frame);
+    //Writes and resets the counters without starting a new frame
+    void endFrame();
+
+private:
+    void writeTrace();
+
+    FILE* m_file = NULL;
+    FILE* m_traceFile = NULL;
+    bool m_firstTraceEvent = true;
+    std::chrono::steady_clock::time_point m_epoch;
+    int m_frame = -1;
+    std::vector<NativeStat> m_stats;
+    int m_eventCount = 0;
+    NativeEvent m_events[NATIVE_MAX_EVENTS];
+};
+
+extern NativeProfiler s_nativeProfiler;
+
+template <typename Fn>
+struct TimedNative {
+    Fn fn;
+    int id;
+
+    template <typename... Args>
+    auto operator()(Args&&... args) const {
+        struct Timer {
+            int id;
+            double startUs;
+            ~Timer() {
+                s_nativeProfiler.record(id, startUs, s_nativeProfiler.nowUs() - startUs);
+            }
+        } timer{ id, s_nativeProfiler.nowUs() };
+        return fn(std::forward<Args>(args)...);
+    }
+};
+
+template <typename Fn>
+TimedNative<Fn> timedNative(Fn fn, int id) {
+    return TimedNative<Fn>{ fn, id };
+}
+
+#define NATIVE(fn) timedNative(&fn, []() { static const int id = s_nativeProfiler.registerNative(#fn); return id; }())
+
+#else
+
+#define NATIVE(fn) fn
+
+#endif
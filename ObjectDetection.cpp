@@ -1,9 +1,9 @@
 #define NOMINMAX
 
 #include "ObjectDetection.h"
-#include "..\ObjectDetIncludes.h"
-#include <Windows.h>
+#include "CoreTypes.h"
 #include <time.h>
+#include <float.h>
 #include <fstream>
 #include <string>
 #include <sstream>
@@ -11,7 +11,18 @@
 #include "Constants.h"
 #include <Eigen/Core>
 #include <sstream>
+#include <chrono>
+#include <algorithm>
 #include "lodepng.h"
+#include "DepthCompression.h"
+#include "LabelWriter.h"
+#include "EntityLabel.h"
+#include "ModelInfoCache.h"
+#include "NativeProfiler.h"
+#include "StageProfiler.h"
+#include "Settings.h"
+#include "OutputPaths.h"
+#include <unordered_set>
 
 #include "LiDAR.h"
 
@@ -21,16 +32,10 @@ ObjectDetection::ObjectDetection()
 
 ObjectDetection::~ObjectDetection()
 {
+    //The plugin deletes ObjectDetection when the script stops, the log thread is not joined at DLL unload
+    s_logger.shutdown();
 }
 
-//Global variable for storing camera parameters
-CamParams s_camParams;
-
-const float VERT_CAM_FOV = 59; //In degrees
-                               //Need to input the vertical FOV with GTA functions.
-                               //90 degrees horizontal (KITTI) corresponds to 59 degrees vertical (https://www.gtaall.com/info/fov-calculator.html).
-const float HOR_CAM_FOV = 90; //In degrees
-
 //Known stencil types
 const int STENCIL_TYPE_DEFAULT = 0;//Ground, buildings, etc...
 const int STENCIL_TYPE_NPC = 1;
@@ -43,18 +48,20 @@ const int STENCIL_TYPE_SELF = 129;
 const int STENCIL_TYPE_OWNCAR = 130;
 const std::vector<int> KNOWN_STENCIL_TYPES = { STENCIL_TYPE_DEFAULT, STENCIL_TYPE_NPC, STENCIL_TYPE_VEHICLE, STENCIL_TYPE_VEGETATION, STENCIL_TYPE_FLOOR, STENCIL_TYPE_SKY, STENCIL_TYPE_SELF, STENCIL_TYPE_OWNCAR, STENCIL_TYPE_UNDERGROUND_ENTRANCE };
 
-const int PEDESTRIAN_CLASS_ID = 10;
 const int CAR_CLASS_ID = 0;
 
-void ObjectDetection::initCollection(UINT camWidth, UINT camHeight, bool exportEVE, int startIndex) {
+void ObjectDetection::initCollection(UINT camWidth, UINT camHeight, bool exportEVE, int startIndex, IWorld* world) {
     if (m_initialized) {
         return;
     }
+    loadSettings(settingsFile());
+    m_world = world ? world : defaultWorld();
+    s_modelCache.setWorld(m_world);
     m_eve = exportEVE;
     instance_index = startIndex;
 
-    ped = PLAYER::PLAYER_PED_ID();
-    m_ownVehicle = PED::GET_VEHICLE_PED_IS_IN(ped, false);
+    ped = m_world->playerPedId();
+    m_ownVehicle = m_world->getVehiclePedIsIn(ped, false);
     m_vehicle = m_ownVehicle;
     setOwnVehicleObject();
 
@@ -68,7 +75,7 @@ void ObjectDetection::initCollection(UINT camWidth, UINT camHeight, bool exportE
 
     //Need to set camera params
     s_camParams.init = false;
-    camera = CAM::GET_RENDERING_CAM();
+    camera = m_world->getRenderingCam();
     //Create camera intrinsics matrix
     calcCameraIntrinsics();
     pointclouds = true;
@@ -76,21 +83,65 @@ void ObjectDetection::initCollection(UINT camWidth, UINT camHeight, bool exportE
 
     //Export directory
     log("Before getting export dir");
-    baseFolder = std::string(getenv("DEEPGTAV_EXPORT_DIR")) + "\\";
-    CreateDirectory(baseFolder.c_str(), NULL);
+    baseFolder = withSeparator(getenv("DEEPGTAV_EXPORT_DIR"));
+    makeDirectory(baseFolder);
     if (exportEVE) {
-        baseFolder += "eve\\";
+        baseFolder = withSeparator(baseFolder + "eve");
     }
     if (collectTracking) {
-        baseFolder += "tracking\\";
+        baseFolder = withSeparator(baseFolder + "tracking");
     }
     else {
-        baseFolder += "object\\";
+        baseFolder = withSeparator(baseFolder + "object");
     }
     log("After getting export dir");
-    CreateDirectory(baseFolder.c_str(), NULL);
-    m_timeTrackFile = baseFolder + "\\TimeAnalysis.txt";
-    m_usedPixelFile = baseFolder + "\\UsedPixels.txt";
+    initOutput();
+
+    if (PUBLISH_FRAME_RING) {
+        uint32_t pixels = s_camParams.width * s_camParams.height;
+        uint32_t slotSize = pixels * (sizeof(float) + sizeof(uint8_t) + sizeof(uint32_t)) + FRAME_RING_EXTRA_BYTES;
+        if (!m_frameRing.init(FRAME_RING_NAME, FRAME_RING_SLOTS, slotSize)) {
+            log("Failed to create frame ring", true);
+        }
+    }
+    m_initialized = true;
+}
+
+//For rerunning captured frames with replayFrame. Nothing is read from the game.
+void ObjectDetection::initReplay(UINT camWidth, UINT camHeight, const std::string &exportDir, IWorld* world, bool tracking) {
+    if (m_initialized) {
+        return;
+    }
+    loadSettings(settingsFile());
+    m_world = world;
+    s_modelCache.setWorld(m_world);
+    s_camParams.width = (int)camWidth;
+    s_camParams.height = (int)camHeight;
+    s_camParams.init = false;
+    calcCameraIntrinsics();
+    pointclouds = true;
+    collectTracking = tracking;
+
+    baseFolder = withSeparator(exportDir);
+    initOutput();
+    m_initialized = true;
+}
+
+//Creates the export directory, the per-collection stats files and the LiDAR buffers
+void ObjectDetection::initOutput() {
+    makeDirectory(baseFolder);
+    m_timeTrackFile = baseFolder + "TimeAnalysis.txt";
+    m_usedPixelFile = baseFolder + "UsedPixels.txt";
+    m_depthCompressionFile = baseFolder + "DepthCompression.txt";
+#ifdef PROFILE_NATIVES
+    s_nativeProfiler.open(baseFolder + "NativeProfile.csv", baseFolder + "NativeTrace.json");
+#endif
+#ifdef PROFILE_STAGES
+    s_stageProfiler.open(baseFolder + "StageTimes.csv", baseFolder + "StageTrace.json");
+#endif
+    //Settings the collection was made with
+    writeSettings(baseFolder + "settings.ini");
+    if (USE_FRAME_BUDGET) m_frameBudget.open(baseFolder + "FrameBudget.csv", FRAME_BUDGET_MS);
     log("After getting export dir2");
 
     //Overwrite previous time analysis file so it is empty
@@ -99,7 +150,7 @@ void ObjectDetection::initCollection(UINT camWidth, UINT camHeight, bool exportE
     oss << "Mean err, var, avg speed, avg dist";
     oss << "\nResults are in metres. Frames attempted to capture at 10 Hz.";
     std::string str = oss.str();
-    fprintf(f, str.c_str());
+    fputs(str.c_str(), f);
     fprintf(f, "\n");
     fclose(f);
 
@@ -108,21 +159,29 @@ void ObjectDetection::initCollection(UINT camWidth, UINT camHeight, bool exportE
     std::ostringstream oss1;
     oss1 << "Unused pixels, index, series (if tracking)";
     std::string str1 = oss1.str();
-    fprintf(f, str1.c_str());
+    fputs(str1.c_str(), f);
     fprintf(f, "\n");
     fclose(f);
+
+    if (COMPRESS_DEPTH_BUFFER && OUTPUT_DEPTH_COMPRESSION_STATS) {
+        f = fopen(m_depthCompressionFile.c_str(), "w");
+        fputs("Raw bytes, compressed bytes, ratio, bits, encode ms, decode ms, index, series (if tracking)\n", f);
+        fclose(f);
+    }
     log("Before initVehicleLookup");
 
     initVehicleLookup();
     //Setup LiDAR before collecting
     setupLiDAR();
-    m_initialized = true;
 }
 
 //Set own object info for exporting position_world
 void ObjectDetection::setOwnVehicleObject() {
+    setOwnVehicleObject(m_world->getEntityModel(m_ownVehicle));
+}
+
+void ObjectDetection::setOwnVehicleObject(Hash model) {
     Vector3 min, max;
-    Hash model = ENTITY::GET_ENTITY_MODEL(m_ownVehicle);
     Vector3 dim = getVehicleDims(m_ownVehicle, model, min, max);
     m_ownVehicleObj = ObjEntity(m_ownVehicle);
 
@@ -153,7 +212,8 @@ void ObjectDetection::setOwnVehicleObject() {
 
     m_ownVehicleObj.truncation = -1;
     m_ownVehicleObj.occlusion = -1;
-    m_ownVehicleObj.modelString = VEHICLE::GET_DISPLAY_NAME_FROM_VEHICLE_MODEL(model);
+    m_ownVehicleObj.model = model;
+    m_ownVehicleObj.modelString = s_modelCache.get(model).displayName;
 
     m_ownVehicleObj.speed = -1;
     m_ownVehicleObj.roll = -1;
@@ -186,6 +246,8 @@ FrameObjectInfo ObjectDetection::setDepthAndStencil(bool prevDepth, float* pDept
 }
 
 FrameObjectInfo ObjectDetection::generateMessage(float* pDepth, uint8_t* pStencil, int entityID) {
+    STAGE_SCOPE(STAGE_GENERATE_MESSAGE);
+    BudgetScope budgetScope(m_frameBudget, BUDGET_STAGE_GENERATE);
     //LOG(LL_ERR, "Depth data generate: ", pDepth[0], pDepth[1], pDepth[2], pDepth[3], pDepth[4], pDepth[5], pDepth[6], pDepth[7]);
     m_pDepth = pDepth;
     m_pStencil = pStencil;
@@ -197,80 +259,145 @@ FrameObjectInfo ObjectDetection::generateMessage(float* pDepth, uint8_t* pStenci
         m_vehicle = m_ownVehicle;
     }
 
-    //TODO pass this through
-    bool depthMap = true;
+    setIndex();
+    bindFrameBuffers();
+#ifdef PROFILE_NATIVES
+    s_nativeProfiler.beginFrame(instance_index);
+#endif
+#ifdef PROFILE_STAGES
+    s_stageProfiler.beginFrame(instance_index);
+#endif
+    lidar.SetAzimuthStride(m_frameBudget.beginFrame(instance_index, series_index).lidarAzimuthStride);
+    TIMED_STAGE(STAGE_SET_POSITION, setPosition());
+    TIMED_STAGE(STAGE_EGO_SNAPSHOT, setEgoSnapshot());
+    TIMED_STAGE(STAGE_REAL_SPEED, outputRealSpeed());
+    TIMED_STAGE(STAGE_DEPTH_STENCIL, setDepthAndStencil());
+
+    if (m_frameRing.isOpen()) {
+        STAGE_SCOPE(STAGE_FRAME_RING);
+        uint32_t pixels = s_camParams.width * s_camParams.height;
+        m_frameRing.beginFrame(instance_index, series_index);
+        m_frameRing.addRecord(FRAME_RECORD_DEPTH, m_pDepth, pixels * sizeof(float), s_camParams.width, s_camParams.height);
+        m_frameRing.addRecord(FRAME_RECORD_STENCIL, m_pStencil, pixels * sizeof(uint8_t), s_camParams.width, s_camParams.height);
+        //The instance segmentation is filled in place, in the slot instead of the frame buffer set
+        if (lidar_initialized) {
+            void* instanceSeg = m_frameRing.reserveRecord(FRAME_RECORD_INSTANCE_SEG, m_instanceSegLength, s_camParams.width, s_camParams.height);
+            if (instanceSeg) {
+                memset(instanceSeg, 0, m_instanceSegLength);
+                m_pInstanceSeg = (uint32_t*)instanceSeg;
+            }
+        }
+    }
+    TIMED_STAGE(STAGE_SNAPSHOT_WORLD, snapshotWorld());
+    setEntityLists();
+    {
+        STAGE_SCOPE(STAGE_FRAME_VALUES);
+        setSpeed();
+        setYawRate();
+        setTime();
+    }
+    if (OUTPUT_WORLD_STATE) TIMED_STAGE(STAGE_RECORD_WORLD_STATE, recordWorldState());
+
+    processFrame();
+    //The frame budget frame stays open for exportDetections and exportImage, the next beginFrame ends it
+    return m_curFrame;
+}
+
+//Replays a captured frame from its depth, stencil and world state (see WorldState.h) without calling the game
+//for the world state. Output goes to the directory given to initReplay.
+FrameObjectInfo ObjectDetection::replayFrame(float* pDepth, uint8_t* pStencil, const WorldStateFrame &state) {
+    m_pDepth = pDepth;
+    m_pStencil = pStencil;
+    restoreWorldState(state);
 
     setIndex();
-    setPosition();
-    outputRealSpeed();
-    setDepthAndStencil();
+    bindFrameBuffers();
+#ifdef PROFILE_NATIVES
+    s_nativeProfiler.beginFrame(instance_index);
+#endif
+#ifdef PROFILE_STAGES
+    s_stageProfiler.beginFrame(instance_index);
+#endif
+    TIMED_STAGE(STAGE_DEPTH_STENCIL, setDepthAndStencil());
+    setEntityLists();
+
+    processFrame();
+    return m_curFrame;
+}
+
+//Everything read from the game for the entity lists. Replay restores these from the world state instead.
+void ObjectDetection::snapshotWorld() {
+    const int ARR_SIZE = 1024;
+    int ids[ARR_SIZE];
+
+    int count = m_world->getAllPeds(ids, ARR_SIZE);
+    snapshotEntities(ids, count, false, m_pedSnapshot);
+    count = m_world->getAllVehicles(ids, ARR_SIZE);
+    snapshotEntities(ids, count, true, m_vehicleSnapshot);
+}
+
+void ObjectDetection::setEntityLists() {
+    m_labelFrame = { &s_camParams, m_camForwardVector, m_camRightVector, m_camUpVector, vehicleForwardVector, m_egoSnapshot };
     //Need to set peds list first for integrating peds on bikes
-    setPedsList();
-    setVehiclesList();
-    setSpeed();
-    setYawRate();
-    setTime();
-    setFocalLength();
+    m_entityState.beginFrame();
+    TIMED_STAGE(STAGE_PEDS_LIST, setPedsList());
+    TIMED_STAGE(STAGE_VEHICLES_LIST, setVehiclesList());
+    m_entityState.endFrame();
+    m_curFrame.entityState = m_entityState.stats();
+    if (OUTPUT_CULL_STATS) {
+        LOG_INFO("Cull (full/augment/skipped) vehicles: " << m_curFrame.vehicleCull.full << "/" << m_curFrame.vehicleCull.augment <<
+            "/" << m_curFrame.vehicleCull.skipped << " peds: " << m_curFrame.pedCull.full << "/" << m_curFrame.pedCull.augment <<
+            "/" << m_curFrame.pedCull.skipped);
+    }
+    if (OUTPUT_ENTITY_STATE_STATS) {
+        LOG_INFO("Entity state reused/recomputed/evicted: " << m_curFrame.entityState.reused << "/" << m_curFrame.entityState.recomputed <<
+            "/" << m_curFrame.entityState.evicted << " reuse ratio: " << m_entityState.reuseRatio());
+    }
+}
+
+//Segmentation, occlusion, LiDAR and the per-frame images, once the entity lists are set
+void ObjectDetection::processFrame() {
+    //TODO pass this through
+    bool depthMap = true;
+
+    TIMED_STAGE(STAGE_FOCAL_LENGTH, setFocalLength());
     log("After focalLength");
 
     //Update 2D bboxes, and create segmentation of stencil values
-    processSegmentation2D();
-    processSegmentation3D();
-    processOcclusion();
+    TIMED_STAGE(STAGE_SEGMENTATION_2D, processSegmentation2D());
+    TIMED_STAGE(STAGE_SEGMENTATION_3D, processSegmentation3D());
+    TIMED_STAGE(STAGE_OCCLUSION, processOcclusion());
 
-    if (pointclouds && lidar_initialized) collectLiDAR();
-    update3DPointsHit();
+    if (pointclouds && lidar_initialized) TIMED_STAGE(STAGE_COLLECT_LIDAR, collectLiDAR());
+    TIMED_STAGE(STAGE_POINTS_HIT, update3DPointsHit());
 
-    if (depthMap && lidar_initialized) printSegImage();
+    if (depthMap && lidar_initialized) TIMED_STAGE(STAGE_SEG_IMAGE, printSegImage());
     log("After printSeg");
-    if (depthMap && lidar_initialized) outputOcclusion();
+    if (depthMap && lidar_initialized) TIMED_STAGE(STAGE_OUTPUT_OCCLUSION, outputOcclusion());
     log("After output occlusion");
-    if (depthMap && lidar_initialized) outputUnusedStencilPixels();
+    if (depthMap && lidar_initialized) TIMED_STAGE(STAGE_UNUSED_STENCIL, outputUnusedStencilPixels());
     log("After output unused stencil");
 
-    setGroundPlanePoints();
-
-    return m_curFrame;
+    TIMED_STAGE(STAGE_GROUND_PLANE, setGroundPlanePoints());
 }
 
 //Returns the angle between a relative position vector and the forward vector (rotated about up axis)
 float ObjectDetection::observationAngle(Vector3 position) {
-    float x1 = m_camRightVector.x;
-    float y1 = m_camRightVector.y;
-    float z1 = m_camRightVector.z;
-    float x2 = position.x;
-    float y2 = position.y;
-    float z2 = position.z;
-    float xn = m_camUpVector.x;
-    float yn = m_camUpVector.y;
-    float zn = m_camUpVector.z;
-
-    float dot = x1 * x2 + y1 * y2 + z1 * z2;
-    float det = x1 * y2*zn + x2 * yn*z1 + xn * y1*z2 - z1 * y2*xn - z2 * yn*x1 - zn * y1*x2;
-    float observationAngle = atan2(det, dot);
-
-    if (DEBUG_LOGGING) {
-        std::ostringstream oss;
-        oss << "Forward is: " << x1 << ", " << y1 << ", " << z1 <<
-            "\nNormal is: " << x2 << ", " << y2 << ", " << z2 <<
-            "\nPosition is: " << position.x << ", " << position.y << ", " << position.z << " and angle is: " << observationAngle;
-        std::string str = oss.str();
-        log(str);
-    }
-
-    return observationAngle;
+    return ::observationAngle(position, m_camRightVector, m_camUpVector);
 }
 
 void ObjectDetection::drawVectorFromPosition(Vector3 vector, int blue, int green) {
-    GRAPHICS::DRAW_LINE(s_camParams.pos.x, s_camParams.pos.y, s_camParams.pos.z, vector.x * 1000 + s_camParams.pos.x, vector.y * 1000 + s_camParams.pos.y, vector.z * 1000 + s_camParams.pos.z, 0, green, blue, 200);
+    m_world->drawLine(s_camParams.pos.x, s_camParams.pos.y, s_camParams.pos.z, vector.x * 1000 + s_camParams.pos.x, vector.y * 1000 + s_camParams.pos.y, vector.z * 1000 + s_camParams.pos.z, 0, green, blue, 200);
+#ifndef DEEPGTAV_HEADLESS
     WAIT(0);
+#endif
 }
 
 //Saves the position and vectors of the capture vehicle
 void ObjectDetection::setPosition() {
     //NOTE: The forward and right vectors are swapped (compared to native function labels) to keep consistency with coordinate system
     if (m_eve) {
-        ENTITY::GET_ENTITY_MATRIX(m_vehicle, &vehicleForwardVector, &vehicleRightVector, &vehicleUpVector, &currentPos); //Blue or red pill
+        m_world->getEntityMatrix(m_vehicle, &vehicleForwardVector, &vehicleRightVector, &vehicleUpVector, &currentPos); //Blue or red pill
 
         /*LOG(LL_ERR, "Eve Forward vector: ", m_camForwardVector.x, " Y: ", m_camForwardVector.y, " Z: ", m_camForwardVector.z);
         LOG(LL_ERR, "Forward vector: ", vehicleForwardVector.x, " Y: ", vehicleForwardVector.y, " Z: ", vehicleForwardVector.z);
@@ -302,8 +429,8 @@ void ObjectDetection::setPosition() {
     }
     else {
         //If not eve, the camera and vehicle are aligned by pausing and flushing the buffers
-        ENTITY::GET_ENTITY_MATRIX(m_vehicle, &m_camForwardVector, &m_camRightVector, &m_camUpVector, &currentPos);
-        ENTITY::GET_ENTITY_MATRIX(m_vehicle, &vehicleForwardVector, &vehicleRightVector, &vehicleUpVector, &currentPos); //Blue or red pill
+        m_world->getEntityMatrix(m_vehicle, &m_camForwardVector, &m_camRightVector, &m_camUpVector, &currentPos);
+        m_world->getEntityMatrix(m_vehicle, &vehicleForwardVector, &vehicleRightVector, &vehicleUpVector, &currentPos); //Blue or red pill
     }
 
     m_curFrame.position = currentPos;
@@ -322,23 +449,25 @@ void ObjectDetection::setPosition() {
 
     //Check if we see it (not occluded)
     Vector3 min, max, offcenter;
-    Hash model = ENTITY::GET_ENTITY_MODEL(m_vehicle);
-    GAMEPLAY::GET_MODEL_DIMENSIONS(model, &min, &max);
+    Hash model = m_world->getEntityModel(m_vehicle);
+    const ModelInfo &info = s_modelCache.get(model);
+    min = info.min;
+    max = info.max;
     Vector3 kittiWorldPos = correctOffcenter(currentPos, min, max, vehicleForwardVector, vehicleRightVector, vehicleUpVector, offcenter);
     m_curFrame.kittiWorldPos = kittiWorldPos;
 }
 
 void ObjectDetection::setSpeed() {
-    m_curFrame.speed = ENTITY::GET_ENTITY_SPEED(m_vehicle);
+    m_curFrame.speed = m_world->getEntitySpeed(m_vehicle);
 }
 
 void ObjectDetection::setYawRate() {
-    Vector3 rates = ENTITY::GET_ENTITY_ROTATION_VELOCITY(m_vehicle);
+    Vector3 rates = m_world->getEntityRotationVelocity(m_vehicle);
     m_curFrame.yawRate = rates.z*180.0 / 3.14159265359;
 }
 
 void ObjectDetection::setTime() {
-    m_curFrame.timeHours = TIME::GET_CLOCK_HOURS();
+    m_curFrame.timeHours = m_world->getClockHours();
 }
 
 //Cycle through 8 corners of bbox and see if the ray makes it to or past this point
@@ -373,13 +502,13 @@ bool ObjectDetection::hasLOSToEntity(Entity entityID, Vector3 position, Vector3
 
                 //options: -1=everything
                 //New function is called _START_SHAPE_TEST_RAY
-                int raycast_handle = WORLDPROBE::_CAST_RAY_POINT_TO_POINT(oPos.x, oPos.y, oPos.z, target.x, target.y, target.z, -1, m_vehicle, 7);
+                int raycast_handle = m_world->castRayPointToPoint(oPos.x, oPos.y, oPos.z, target.x, target.y, target.z, -1, m_vehicle, 7);
 
                 //New function is called GET_SHAPE_TEST_RESULT
-                WORLDPROBE::_GET_RAYCAST_RESULT(raycast_handle, &isHit, &endCoord, &surfaceNorm, &hitEntity);
+                m_world->getRaycastResult(raycast_handle, &isHit, &endCoord, &surfaceNorm, &hitEntity);
 
-                float distance = sqrt(SYSTEM::VDIST2(oPos.x, oPos.y, oPos.z, pos.x, pos.y, pos.z));
-                float rayDistance = sqrt(SYSTEM::VDIST2(oPos.x, oPos.y, oPos.z, endCoord.x, endCoord.y, endCoord.z));
+                float distance = sqrt(vdist2(oPos.x, oPos.y, oPos.z, pos.x, pos.y, pos.z));
+                float rayDistance = sqrt(vdist2(oPos.x, oPos.y, oPos.z, endCoord.x, endCoord.y, endCoord.z));
 
                 if (!isHit || rayDistance > distance) {
                     return true;
@@ -410,12 +539,9 @@ BBox2D ObjectDetection::BBox2DFrom3DObject(Vector3 position, Vector3 dim, Vector
 
                 float screenX, screenY;
 //This function always returns false, do not worry about return value
-bool success = GRAPHICS::_WORLD3D_TO_SCREEN2D(pos.x, pos.y, pos.z, &screenX, &screenY);
+bool success = m_world->world3dToScreen2d(pos.x, pos.y, pos.z, &screenX, &screenY);
 
-std::ostringstream oss2;
-oss2 << "\nnew ScreenX: " << screenX << " ScreenY: " << screenY;
-std::string str2 = oss2.str();
-log(str2);
+LOG_DEBUG("\nnew ScreenX: " << screenX << " ScreenY: " << screenY);
 
 //Calculate with eigen if off-screen
 Eigen::Vector3f pt(pos.x, pos.y, pos.z);
@@ -474,166 +600,27 @@ if (screenY > bbox2d.bottom) bbox2d.bottom = screenY;
         return bbox2d;
     }
 
-    std::ostringstream oss2;
-    oss2 << "BBox left: " << bbox2d.left << " right: " << bbox2d.right << " top: " << bbox2d.top << " bot: " << bbox2d.bottom << std::endl <<
-        "PosX: " << bbox2d.posX() << " PosY: " << bbox2d.posY() << " Width: " << bbox2d.width() << " Height: " << bbox2d.height();
-    std::string str2 = oss2.str();
-    log(str2);
+    LOG_DEBUG("BBox left: " << bbox2d.left << " right: " << bbox2d.right << " top: " << bbox2d.top << " bot: " << bbox2d.bottom << std::endl <<
+        "PosX: " << bbox2d.posX() << " PosY: " << bbox2d.posY() << " Width: " << bbox2d.width() << " Height: " << bbox2d.height());
     return bbox2d;
 }
 
-bool ObjectDetection::checkDirection(Vector3 unit, Vector3 point, Vector3 min, Vector3 max) {
-    float dotPoint = dotProd(point, unit);
-    float dotMax = dotProd(max, unit);
-    float dotMin = dotProd(min, unit);
-
-    if ((dotMax <= dotPoint && dotPoint <= dotMin) ||
-        (dotMax >= dotPoint && dotPoint >= dotMin)) {
-        return true;
-    }
-    return false;
-}
-
-//Point and objPos should be in world coordinates
-void ObjectDetection::setEntityBBoxParameters(ObjEntity* e) {
-
-    //Added BBOX_ADJUSTMENT_FACTOR as detailed models sometimes go outside 3D bboxes
-    Vector3 forward; forward.y = e->dim.y * BBOX_ADJUSTMENT_FACTOR; forward.x = 0; forward.z = 0;
-    forward = convertCoordinateSystem(forward, e->yVector, e->xVector, e->zVector);
-
-    Vector3 right; right.x = e->dim.x * BBOX_ADJUSTMENT_FACTOR; right.y = 0; right.z = 0;
-    right = convertCoordinateSystem(right, e->yVector, e->xVector, e->zVector);
-
-    Vector3 up; up.z = e->dim.z; up.x = 0; up.y = 0;
-    up = convertCoordinateSystem(up, e->yVector, e->xVector, e->zVector);
-
-    //position is given at bottom of bounding box (as per kitti)
-    Vector3 objPos = e->worldPos;
-
-    e->rearBotLeft.x = objPos.x - forward.x - right.x - up.x * (BBOX_ADJUSTMENT_FACTOR - 1);
-    e->rearBotLeft.y = objPos.y - forward.y - right.y - up.y * (BBOX_ADJUSTMENT_FACTOR - 1);
-    e->rearBotLeft.z = objPos.z - forward.z - right.z - up.z * (BBOX_ADJUSTMENT_FACTOR - 1);
-
-    e->frontBotLeft.x = objPos.x + forward.x - right.x - up.x * (BBOX_ADJUSTMENT_FACTOR - 1);
-    e->frontBotLeft.y = objPos.y + forward.y - right.y - up.y * (BBOX_ADJUSTMENT_FACTOR - 1);
-    e->frontBotLeft.z = objPos.z + forward.z - right.z - up.z * (BBOX_ADJUSTMENT_FACTOR - 1);
-
-    e->rearTopLeft.x = objPos.x - forward.x - right.x + 2 * up.x + up.x * BBOX_ADJUSTMENT_FACTOR;
-    e->rearTopLeft.y = objPos.y - forward.y - right.y + 2 * up.y + up.y * BBOX_ADJUSTMENT_FACTOR;
-    e->rearTopLeft.z = objPos.z - forward.z - right.z + 2 * up.z + up.z * BBOX_ADJUSTMENT_FACTOR;
-
-    e->rearBotRight.x = objPos.x - forward.x + right.x - up.x * (BBOX_ADJUSTMENT_FACTOR - 1);
-    e->rearBotRight.y = objPos.y - forward.y + right.y - up.y * (BBOX_ADJUSTMENT_FACTOR - 1);
-    e->rearBotRight.z = objPos.z - forward.z + right.z - up.z * (BBOX_ADJUSTMENT_FACTOR - 1);
-
-    e->rearMiddleLeft.x = objPos.x - forward.x - right.x + up.x;
-    e->rearMiddleLeft.y = objPos.y - forward.y - right.y + up.y;
-    e->rearMiddleLeft.z = objPos.z - forward.z - right.z + up.z;
-
-    e->rearThirdLeft.x = objPos.x - forward.x - right.x + 2 / 3 * up.x;
-    e->rearThirdLeft.y = objPos.y - forward.y - right.y + 2 / 3 * up.y;
-    e->rearThirdLeft.z = objPos.z - forward.z - right.z + 2 / 3 * up.z;
-
-    e->rearTopExactLeft.x = objPos.x - forward.x - right.x + 2 * up.x;
-    e->rearTopExactLeft.y = objPos.y - forward.y - right.y + 2 * up.y;
-    e->rearTopExactLeft.z = objPos.z - forward.z - right.z + 2 * up.z;
-
-    e->u = getUnitVector(subtractVecs(e->frontBotLeft, e->rearBotLeft));
-    e->v = getUnitVector(subtractVecs(e->rearTopLeft, e->rearBotLeft));
-    e->w = getUnitVector(subtractVecs(e->rearBotRight, e->rearBotLeft));
-}
-
-//Return true if pixel (i,j) is inside the entity's unprocessed 2D bounding box
-bool ObjectDetection::in2DBoxUnprocessed(const int &i, const int &j, ObjEntity* e) {
-    if (i < e->bbox2dUnprocessed.left) return false;
-    if (i > e->bbox2dUnprocessed.right) return false;
-    if (j < e->bbox2dUnprocessed.top) return false;
-    if (j > e->bbox2dUnprocessed.bottom) return false;
-
-    return true;
-}
-
-//Point and objPos should be in world coordinates
-bool ObjectDetection::in3DBox(Vector3 point, Vector3 objPos, Vector3 dim, Vector3 yVector, Vector3 xVector, Vector3 zVector) {
-    Vector3 forward; forward.y = dim.y; forward.x = 0; forward.z = 0;
-    forward = convertCoordinateSystem(forward, yVector, xVector, zVector);
-
-    Vector3 right; right.x = dim.x; right.y = 0; right.z = 0;
-    right = convertCoordinateSystem(right, yVector, xVector, zVector);
-
-    Vector3 up; up.z = dim.z; up.x = 0; up.y = 0;
-    up = convertCoordinateSystem(up, yVector, xVector, zVector);
-
-    Vector3 rearBotLeft;
-    rearBotLeft.x = objPos.x - forward.x - right.x - up.x;
-    rearBotLeft.y = objPos.y - forward.y - right.y - up.y;
-    rearBotLeft.z = objPos.z - forward.z - right.z - up.z;
-
-    Vector3 frontBotLeft;
-    frontBotLeft.x = objPos.x + forward.x - right.x - up.x;
-    frontBotLeft.y = objPos.y + forward.y - right.y - up.y;
-    frontBotLeft.z = objPos.z + forward.z - right.z - up.z;
-
-    Vector3 rearTopLeft;
-    rearTopLeft.x = objPos.x - forward.x - right.x + up.x;
-    rearTopLeft.y = objPos.y - forward.y - right.y + up.y;
-    rearTopLeft.z = objPos.z - forward.z - right.z + up.z;
-
-    Vector3 rearBotRight;
-    rearBotRight.x = objPos.x - forward.x + right.x - up.x;
-    rearBotRight.y = objPos.y - forward.y + right.y - up.y;
-    rearBotRight.z = objPos.z - forward.z + right.z - up.z;
-
-    std::ostringstream oss2;
-    oss2 << " rearBotLeft are: " << rearBotLeft.x << ", " << rearBotLeft.y << ", " << rearBotLeft.z;
-    oss2 << "\nfrontBotLeft: " << frontBotLeft.x << ", " << frontBotLeft.y << ", " << frontBotLeft.z;
-    oss2 << "\nrearTopLeft: " << rearTopLeft.x << ", " << rearTopLeft.y << ", " << rearTopLeft.z;
-    oss2 << "\nrearBotRight: " << rearBotRight.x << ", " << rearBotRight.y << ", " << rearBotRight.z;
-    oss2 << "\ndim: " << dim.x << ", " << dim.y << ", " << dim.z;
-    std::string str2 = oss2.str();
-    log(str2);
-
-    Vector3 u = getUnitVector(subtractVecs(frontBotLeft, rearBotLeft));
-    Vector3 v = getUnitVector(subtractVecs(rearTopLeft, rearBotLeft));
-    Vector3 w = getUnitVector(subtractVecs(rearBotRight, rearBotLeft));
-
-    if (!checkDirection(u, point, rearBotLeft, frontBotLeft)) return false;
-    if (!checkDirection(v, point, rearBotLeft, rearTopLeft)) return false;
-    if (!checkDirection(w, point, rearBotLeft, rearBotRight)) return false;
-
-    return true;
-}
-
-//Takes in an entity and a point (in world coordinates) and returns true if the point resides within the
-//entity's 3D bounding box.
-//Note: Need to set the entity's parameters u,v,w, and rearBotLeft, etc...
-bool ObjectDetection::in3DBox(ObjEntity* e, Vector3 point, bool &upperHalf) {
-    upperHalf = false;
-    if (checkDirection(e->v, point, e->rearMiddleLeft, e->rearTopExactLeft)) upperHalf = true;
-
-    if (!checkDirection(e->u, point, e->rearBotLeft, e->frontBotLeft)) return false;
-    if (!checkDirection(e->v, point, e->rearBotLeft, e->rearTopLeft)) return false;
-    if (!checkDirection(e->w, point, e->rearBotLeft, e->rearBotRight)) return false;
-
-    return true;
-}
-
-bool ObjectDetection::isPointOccluding(Vector3 worldPos, ObjEntity *e) {
+bool ObjectDetection::isPointOccluding(const Vector3 &worldPos, const EntityBox &box, const Vector3 &objWorldPos) {
     //Need to test in3DBox as stencil buffer goes through windows but depth buffer does not
     bool upperHalf;
-    if (in3DBox(e, worldPos, upperHalf)) {
+    if (in3DBox(box, worldPos, upperHalf)) {
         return false;
     }
 
-    float pointDist = sqrt(SYSTEM::VDIST2(s_camParams.pos.x, s_camParams.pos.y, s_camParams.pos.z, worldPos.x, worldPos.y, worldPos.z));
-    float distObjCenter = sqrt(SYSTEM::VDIST2(s_camParams.pos.x, s_camParams.pos.y, s_camParams.pos.z, e->worldPos.x, e->worldPos.y, e->worldPos.z));
+    float pointDist = sqrt(vdist2(s_camParams.pos.x, s_camParams.pos.y, s_camParams.pos.z, worldPos.x, worldPos.y, worldPos.z));
+    float distObjCenter = sqrt(vdist2(s_camParams.pos.x, s_camParams.pos.y, s_camParams.pos.z, objWorldPos.x, objWorldPos.y, objWorldPos.z));
 
     //Point needs to be closer
     if (pointDist < distObjCenter) {
         float groundZ;
-        GAMEPLAY::GET_GROUND_Z_FOR_3D_COORD(worldPos.x, worldPos.y, worldPos.z + 0.5, &(groundZ), 0);
+        m_world->getGroundZFor3dCoord(worldPos.x, worldPos.y, worldPos.z + 0.5, &(groundZ), 0);
         //Check it is not the ground in the image (or the ground is much higher/lower than the object)
-        if ((groundZ + GROUND_POINT_MAX_DIST) < worldPos.z || s_camParams.pos.z > (e->worldPos.z + 4) || s_camParams.pos.z < (e->worldPos.z - 2)) {
+        if ((groundZ + GROUND_POINT_MAX_DIST) < worldPos.z || s_camParams.pos.z > (objWorldPos.z + 4) || s_camParams.pos.z < (objWorldPos.z - 2)) {
             return true;
         }
     }
@@ -671,24 +658,35 @@ void ObjectDetection::processSegmentation3D() {
     Vector3 yVectorCam = convertCoordinateSystem(worldY, m_camForwardVector, m_camRightVector, m_camUpVector);
     Vector3 zVectorCam = convertCoordinateSystem(worldZ, m_camForwardVector, m_camRightVector, m_camUpVector);
 
-    //Create depth array to use later
-    for (int j = 0; j < s_camParams.height; ++j) {
-        for (int i = 0; i < s_camParams.width; ++i) {
-            float ndc = m_pDepth[j * s_camParams.width + i];
-            Vector3 relPos = depthToCamCoords(ndc, i, j);
-            float distance = sqrt(SYSTEM::VDIST2(0, 0, 0, relPos.x, relPos.y, relPos.z));
-            m_depthMat.at<float>(j, i) = distance;
+    //Set the bounding box parameters (for reducing # of calculations per pixel)
+    for (EntityTable* table : { m_vehicleTable.get(), m_pedTable.get() }) {
+        for (int slot : table->pixelSlots) {
+            //Box corners only depend on the world space geometry, reuse them for entities which have not moved
+            EntityGeometry* geom = REUSE_ENTITY_STATE ? m_entityState.find(table->ids[slot]) : NULL;
+            if (geom && geom->boxValid) {
+                table->boxes[slot] = geom->box;
+                continue;
+            }
+            setEntityBBoxParameters(table->record(slot), table->boxes[slot]);
+            if (geom) {
+                geom->box = table->boxes[slot];
+                geom->boxValid = true;
+            }
         }
     }
 
-    //Set the bounding box parameters (for reducing # of calculations per pixel)
-    for (auto &entry : m_curFrame.vehicles) {
-        setEntityBBoxParameters(&entry.second);
+    if (PROCESS_OVERLAPPING_POINTS) {
+        segmentStencilPixels3D<true>(xVectorCam, yVectorCam, zVectorCam);
+        processOverlappingPoints();
     }
-    for (auto &entry : m_curFrame.peds) {
-        setEntityBBoxParameters(&entry.second);
+    else {
+        segmentStencilPixels3D<false>(xVectorCam, yVectorCam, zVectorCam);
     }
+}
 
+//Per pixel part of processSegmentation3D. OVERLAPPING_POINTS keeps pixels inside several boxes for processOverlappingPoints.
+template <bool OVERLAPPING_POINTS>
+void ObjectDetection::segmentStencilPixels3D(const Vector3 &xVectorCam, const Vector3 &yVectorCam, const Vector3 &zVectorCam) {
     for (int j = 0; j < s_camParams.height; ++j) {
         for (int i = 0; i < s_camParams.width; ++i) {
             uint8_t stencilVal = m_pStencil[j * s_camParams.width + i];
@@ -697,34 +695,51 @@ void ObjectDetection::processSegmentation3D() {
                 addPointToSegImages(i, j, m_ownVehicle);
             }
             else {
-                processStencilPixel3D(stencilVal, j, i, xVectorCam, yVectorCam, zVectorCam);
+                processStencilPixel3D<OVERLAPPING_POINTS>(stencilVal, j, i, xVectorCam, yVectorCam, zVectorCam);
             }
         }
     }
+}
 
-    if (PROCESS_OVERLAPPING_POINTS) {
-        processOverlappingPoints();
+//Sets the 4-connected area of points with the same value as mask[seed] to val
+void ObjectDetection::floodFill(std::vector<int> &mask, int seed, int val, std::vector<int> &stack) {
+    int from = mask[seed];
+    mask[seed] = val;
+    stack.assign(1, seed);
+    while (!stack.empty()) {
+        int idx = stack.back();
+        stack.pop_back();
+        int i = idx % s_camParams.width;
+        int j = idx / s_camParams.width;
+        int neighbours[4] = { i > 0 ? idx - 1 : -1, i < s_camParams.width - 1 ? idx + 1 : -1,
+            j > 0 ? idx - s_camParams.width : -1, j < s_camParams.height - 1 ? idx + s_camParams.width : -1 };
+        for (int n : neighbours) {
+            if (n >= 0 && mask[n] == from) {
+                mask[n] = val;
+                stack.push_back(n);
+            }
+        }
     }
 }
 
 //Goes through points which were in multiple 3D boxes (overlapping points)
-//Uses opencv to flood fill all points for sets of entities which have overlapping points
+//Flood fills (4-connected) all points for sets of entities which have overlapping points
 //If filled areas have a unique entityID (other than the overlapping points), entire area gets set to the unique entityID
 //TODO: Step 2: find contour with depth for areas which have more than a single unique entityID
 void ObjectDetection::processOverlappingPoints() {
     //Create mask with only points from overlapping entities
     //Process one set of entity IDs at a time
     while (!m_overlappingPoints.empty()) {
-        std::vector<ObjEntity*> objEntities = m_overlappingPoints.begin()->second;
+        std::vector<EntityRef> objEntities = m_overlappingPoints.begin()->second;
         int ptIdx = m_overlappingPoints.begin()->first;
 
         int stencilType = STENCIL_TYPE_VEHICLE;
-        if (objEntities[0]->objType == "Pedestrian") {
+        if (objEntities[0].record().objType == "Pedestrian") {
             stencilType = STENCIL_TYPE_NPC;
         }
 
-        //Initialize mask
-        cv::Mat allPointsMask = cv::Mat::zeros(cv::Size(s_camParams.width, s_camParams.height), CV_8U);
+        //Initialize mask (255 marks a point, flood fill labels start at 1)
+        std::vector<int> allPointsMask(s_camParams.width * s_camParams.height, 0);
 
         //Create mask of all points from overlapping entities
         for (int j = 0; j < s_camParams.height; ++j) {
@@ -735,12 +750,12 @@ void ObjectDetection::processOverlappingPoints() {
                 if (stencilVal == stencilType) {
                     if (m_overlappingPoints.find(idx) != m_overlappingPoints.end()) {
                         //Add to mask
-                        allPointsMask.at<uchar>(j, i) = 255;
+                        allPointsMask[idx] = 255;
                     }
                     else {
-                        for (auto pObjEntity : objEntities) {
-                            if (m_pInstanceSeg[idx] == pObjEntity->entityID) {
-                                allPointsMask.at<uchar>(j, i) = 255;
+                        for (auto &ref : objEntities) {
+                            if (m_pInstanceSeg[idx] == ref.table->ids[ref.slot]) {
+                                allPointsMask[idx] = 255;
                                 break;
                             }
                         }
@@ -761,15 +776,14 @@ void ObjectDetection::processOverlappingPoints() {
             cv::imwrite(filename, allPointsMask);
         }*/
 
-        //Create individual segmented masks
+        //Create individual segmented masks. Labels skip 255 so filled areas are never taken for unfilled points.
         int floodVal = 1;
-        for (int j = 0; j < s_camParams.height; ++j) {
-            for (int i = 0; i < s_camParams.width; ++i) {
-                if (allPointsMask.at<uchar>(j, i) == 255) {
-                    cv::floodFill(allPointsMask, cv::Point(i,j), cv::Scalar(floodVal));
-                    ++floodVal;
-                }
-            }
+        std::vector<int> floodStack;
+        for (int idx = 0; idx < (int)allPointsMask.size(); ++idx) {
+            if (allPointsMask[idx] != 255) continue;
+            if (floodVal == 255) ++floodVal;
+            floodFill(allPointsMask, idx, floodVal, floodStack);
+            ++floodVal;
         }
 
         //Test by printing out image
@@ -790,7 +804,7 @@ void ObjectDetection::processOverlappingPoints() {
 
         for (int j = 0; j < s_camParams.height; ++j) {
             for (int i = 0; i < s_camParams.width; ++i) {
-                int curFloodVal = allPointsMask.at<uchar>(j, i);
+                int curFloodVal = allPointsMask[j * s_camParams.width + i];
 
                 if (curFloodVal != 0) {
                     int idx = j * s_camParams.width + i;
@@ -810,15 +824,15 @@ void ObjectDetection::processOverlappingPoints() {
         //If yes, set all points in that segment mask to the corresponding entity
         for (int j = 0; j < s_camParams.height; ++j) {
             for (int i = 0; i < s_camParams.width; ++i) {
-                int curFloodVal = allPointsMask.at<uchar>(j, i);
+                int curFloodVal = allPointsMask[j * s_camParams.width + i];
 
                 if (curFloodVal != 0 && m_pInstanceSeg[j * s_camParams.width + i] == 0) {
                     if (goodFloods[curFloodVal - 1]) {
-                        for (ObjEntity* objEnt : objEntities) {
-                            if (objEnt->entityID == floodFillEntities[curFloodVal - 1]) {
-                                addSegmentedPoint3D(i, j, objEnt);
+                        for (auto &ref : objEntities) {
+                            if (ref.table->ids[ref.slot] == floodFillEntities[curFloodVal - 1]) {
+                                addSegmentedPoint3D(i, j, ref);
                                 //Also zero the mask pixel so we don't use it in the future
-                                allPointsMask.at<uchar>(j, i) = 0;
+                                allPointsMask[j * s_camParams.width + i] = 0;
                                 break;
                             }
                         }
@@ -827,14 +841,15 @@ void ObjectDetection::processOverlappingPoints() {
                         int idx = j * s_camParams.width + i;
                         //Last resort just set the point to be the entity of the nearest 3D point
                         float dist = FLT_MAX;
-                        ObjEntity* closestObj = NULL;
+                        EntityRef closestObj = objEntities[0];
                         float ndc = m_pDepth[idx];
                         Vector3 relPos = depthToCamCoords(ndc, i, j);
-                        for (auto pObjEntity : objEntities) {
-                            float distToObj = sqrt(SYSTEM::VDIST2(pObjEntity->location.x, pObjEntity->location.y, pObjEntity->location.z, relPos.x, relPos.y, relPos.z));
+                        for (auto &ref : objEntities) {
+                            const Vector3 &location = ref.record().location;
+                            float distToObj = sqrt(vdist2(location.x, location.y, location.z, relPos.x, relPos.y, relPos.z));
                             if (distToObj < dist) {
                                 dist = distToObj;
-                                closestObj = pObjEntity;
+                                closestObj = ref;
                             }
                         }
                         addSegmentedPoint3D(i, j, closestObj);
@@ -846,10 +861,7 @@ void ObjectDetection::processOverlappingPoints() {
         //For testing print out indices which can't separate with flood fill so they can be visually inspected
         for (int i = 0; i < floodVal; ++i) {
             if (goodFloods[i] == false) {
-                std::ostringstream oss2;
-                oss2 << "**************Found bad flood at index: " << instance_index << " with floodval: " <<floodVal << " and i: " << i;
-                std::string str = oss2.str();
-                log(str, true);
+                LOG_INFO("**************Found bad flood at index: " << instance_index << " with floodval: " <<floodVal << " and i: " << i);
             }
         }
 
@@ -860,7 +872,7 @@ void ObjectDetection::processOverlappingPoints() {
         //Create an image with the depth values only where the mask is
         //Initialize depth mask
         //cv::Mat depthMasked;
-        //m_depthMat.copyTo(depthMasked, allPointsMask);
+        //depthMat.copyTo(depthMasked, allPointsMask);
         //depthMasked *= FLT_MAX / s_camParams.farClip;
 
         ////Test by printing out image
@@ -875,37 +887,31 @@ void ObjectDetection::processOverlappingPoints() {
         //    cv::imwrite(filename, depthMasked);
         //}
 
-        std::ostringstream oss2;
-        oss2 << "Overlapping points size: " << m_overlappingPoints.size();
-        std::string str = oss2.str();
-        log(str, true);
+        LOG_INFO("Overlapping points size: " << m_overlappingPoints.size());
         
         //If point is still in overlapping points then remove it
         if (m_overlappingPoints.find(ptIdx) != m_overlappingPoints.end()) {
             m_overlappingPoints.erase(ptIdx);
         }
-
-        allPointsMask.release();
     }
 
     //Reset the map once done processing
     m_overlappingPoints.clear();
 }
 
-std::vector<ObjEntity*> ObjectDetection::pointInside3DEntities(const Vector3 &worldPos, EntityMap* eMap, const bool &checkUpperVehicle, const uint8_t &stencilVal) {
+std::vector<EntityRef> ObjectDetection::pointInside3DEntities(const Vector3 &worldPos, EntityTable* table, const bool &checkUpperVehicle, const uint8_t &stencilVal) {
     //Get vector of entities which point resides in their 3D box
-    std::vector<ObjEntity*> pointEntities;
-    for (auto &entry : *eMap) {
-        ObjEntity* e = &(entry.second);
+    std::vector<EntityRef> pointEntities;
+    for (int slot : table->pixelSlots) {
         bool upperHalf;
-        bool isIn3DBox = in3DBox(e, worldPos, upperHalf);
+        bool isIn3DBox = in3DBox(table->boxes[slot], worldPos, upperHalf);
         if (isIn3DBox) {
             //Add only pedestrian stencil types to pedestrian 3D bboxes
             //Add any points which are vehicle stencil type or
             //are in the upper half of the vehicle's 3D bounding box
             //This allows window points to be added for vehicles
             if (!checkUpperVehicle || stencilVal == STENCIL_TYPE_VEHICLE || upperHalf) {
-                pointEntities.push_back(e);
+                pointEntities.push_back({ table, slot });
             }
         }
     }
@@ -914,6 +920,7 @@ std::vector<ObjEntity*> ObjectDetection::pointInside3DEntities(const Vector3 &wo
 }
 
 //j is y coordinate (top=0), i is x coordinate (left = 0)
+template <bool OVERLAPPING_POINTS>
 void ObjectDetection::processStencilPixel3D(const uint8_t &stencilVal, const int &j, const int &i,
                                           const Vector3 &xVectorCam, const Vector3 &yVectorCam, const Vector3 &zVectorCam) {
     float ndc = m_pDepth[j * s_camParams.width + i];
@@ -923,27 +930,26 @@ void ObjectDetection::processStencilPixel3D(const uint8_t &stencilVal, const int
     worldPos.y += s_camParams.pos.y;
     worldPos.z += s_camParams.pos.z;
 
-    //Obtain proper map for stencil type
+    //Obtain proper table for stencil type
     //Need to check all points for vehicles since depth map hits windows but
     //stencil buffer hits entities through windows
-    EntityMap* eMap;
+    EntityTable* table;
     bool checkUpperVehicle = false;
     if (stencilVal == STENCIL_TYPE_NPC) {
-        eMap = &m_curFrame.peds;
+        table = m_pedTable.get();
     }
     else {
-        eMap = &m_curFrame.vehicles;
+        table = m_vehicleTable.get();
         checkUpperVehicle = true;
     }
 
     //Check 2D boxes first for vehicle and pedestrian stencil pixels
     //Stencil goes through vehicle windows but depth buffer does not
-    std::vector<ObjEntity*> pointEntities2D;
+    std::vector<EntityRef> pointEntities2D;
     if (stencilVal == STENCIL_TYPE_NPC || stencilVal == STENCIL_TYPE_VEHICLE) {
-        for (auto &entry : *eMap) {
-            ObjEntity* e = &(entry.second);
-            if (in2DBoxUnprocessed(i, j, e)) {
-                pointEntities2D.push_back(e);
+        for (int slot : table->pixelSlots) {
+            if (in2DBoxUnprocessed(i, j, table->bbox2dUnprocessed[slot])) {
+                pointEntities2D.push_back({ table, slot });
             }
         }
         //If point only lies in one 2D bounding box then accept this entity as the true entity
@@ -953,15 +959,15 @@ void ObjectDetection::processStencilPixel3D(const uint8_t &stencilVal, const int
         }
     }
 
-    std::vector<ObjEntity*> pointEntities = pointInside3DEntities(worldPos, eMap, checkUpperVehicle, stencilVal);
+    std::vector<EntityRef> pointEntities = pointInside3DEntities(worldPos, table, checkUpperVehicle, stencilVal);
 
     //All vehicle points should fall within a vehicle 3D bounding box
     //Pedestrians in vehicles may not since the windows are what the depth model hits
     //Try setting the pedestrian stencil type to a vehicle and checking again if this is the case
     if (pointEntities.empty() && stencilVal == STENCIL_TYPE_NPC) {
-        eMap = &m_curFrame.vehicles;
+        table = m_vehicleTable.get();
         checkUpperVehicle = true;
-        pointEntities = pointInside3DEntities(worldPos, eMap, checkUpperVehicle, STENCIL_TYPE_VEHICLE);
+        pointEntities = pointInside3DEntities(worldPos, table, checkUpperVehicle, STENCIL_TYPE_VEHICLE);
     }
 
     //3 choices, no, single, or multiple 3D box matches
@@ -974,11 +980,12 @@ void ObjectDetection::processStencilPixel3D(const uint8_t &stencilVal, const int
     else {
         //If the overlapping entities are all peds in the same vehicle
         //simply add it as it will just be set to the vehicle
-        if (stencilVal == STENCIL_TYPE_NPC && pointEntities[0]->isPedInV) {
-            int vEntityID = pointEntities[0]->vPedIsIn;
+        if (stencilVal == STENCIL_TYPE_NPC && pointEntities[0].record().isPedInV) {
+            int vEntityID = pointEntities[0].record().vPedIsIn;
             bool allSameV = true;
             for (int i = 1; i < pointEntities.size(); ++i) {
-                if (!pointEntities[i]->isPedInV || pointEntities[i]->vPedIsIn != pointEntities[0]->vPedIsIn) {
+                const EntityRecord &e = pointEntities[i].record();
+                if (!e.isPedInV || e.vPedIsIn != vEntityID) {
                     allSameV = false;
                     break;
                 }
@@ -989,13 +996,12 @@ void ObjectDetection::processStencilPixel3D(const uint8_t &stencilVal, const int
             }
         }
 
-        //Index of point
-        int idx = j * s_camParams.width + i;
-
         //Map should only hit each idx once, so no need for alternative if idx is found
-        if (PROCESS_OVERLAPPING_POINTS) {
+        if (OVERLAPPING_POINTS) {
+            //Index of point
+            int idx = j * s_camParams.width + i;
             if (m_overlappingPoints.find(idx) == m_overlappingPoints.end()) {
-                m_overlappingPoints.insert(std::pair<int, std::vector<ObjEntity*>>(idx, pointEntities));
+                m_overlappingPoints.insert(std::pair<int, std::vector<EntityRef>>(idx, pointEntities));
             }
             else {
                 log("************************This should never be here!!!!!!!!!!!!!!!!!!!", true);
@@ -1005,38 +1011,20 @@ void ObjectDetection::processStencilPixel3D(const uint8_t &stencilVal, const int
 }
 
 //Add 2D point to an entity
-void ObjectDetection::addSegmentedPoint3D(int i, int j, ObjEntity *e) {
+void ObjectDetection::addSegmentedPoint3D(int i, int j, EntityRef e) {
 
-    if (e->isPedInV) {
-        for (auto &entry : m_curFrame.vehicles) {
-            ObjEntity* entity = &(entry.second);
-            if (entity->entityID == e->vPedIsIn) {
-                e = entity;
-            }
-        }
+    //Peds in vehicles (and trailers with MERGE_TRAILER_SEGMENTATION) are added to their vehicle (set in setVehiclesList)
+    int vehicleSlot = e.table->vehicleSlot[e.slot];
+    if (vehicleSlot != -1) {
+        e = { m_vehicleTable.get(), vehicleSlot };
     }
 
-    /* TESTE */
-    //List of trailers to be considered for towing purposes
-    //std::list<std::string> list_of_trailers = { "TRAILERLARGE", "TRAILER","TRAILERS3", "DOCKTRAILER","TR2","TANKER","TRAILERL","ARMYTRAILER","TR3"};
-    //Hash model = ENTITY::GET_ENTITY_MODEL(e->entityID);
-    //std::string modelString = VEHICLE::GET_DISPLAY_NAME_FROM_VEHICLE_MODEL(model);
-    //std::list<std::string>::iterator it;
-    //it = std::find(list_of_trailers.begin(), list_of_trailers.end(), modelString);
-    //if (it != list_of_trailers.end()) //It's a car
-    //{
-    //    Entity TruckAttached = ENTITY::GET_ENTITY_ATTACHED_TO(e->entityID);
-    //    if (TruckAttached != 0) { // Detects if truck has a trailer
-    //        e->entityID = TruckAttached;
-    //    }
-    //}
-    /* FIM */
-
-    if (i < e->bbox2d.left) e->bbox2d.left = i;
-    if (i > e->bbox2d.right) e->bbox2d.right = i;
-    if (j < e->bbox2d.top) e->bbox2d.top = j;
-    if (j > e->bbox2d.bottom) e->bbox2d.bottom = j;
-    ++e->pointsHit2D;
+    BBox2D &bbox2d = e.table->bbox2d[e.slot];
+    if (i < bbox2d.left) bbox2d.left = i;
+    if (i > bbox2d.right) bbox2d.right = i;
+    if (j < bbox2d.top) bbox2d.top = j;
+    if (j > bbox2d.bottom) bbox2d.bottom = j;
+    ++e.table->pointsHit2D[e.slot];
 
     //Remove from overlappingPoints if it gets added
     int idx = j * s_camParams.width + i;
@@ -1044,36 +1032,12 @@ void ObjectDetection::addSegmentedPoint3D(int i, int j, ObjEntity *e) {
         m_overlappingPoints.erase(idx);
     }
 
-    addPointToSegImages(i, j, e->entityID);
+    addPointToSegImages(i, j, e.table->ids[e.slot]);
 }
 
 void ObjectDetection::addPointToSegImages(int i, int j, int entityID) {
-    //Index of point in all image buffers
-    int idx = j * s_camParams.width + i;
-
-    //instance seg is image with exact entityIDs
-    m_pInstanceSeg[idx] = (uint32_t)entityID; 
-
-    //RGB image is 3 bytes per pixel
-    int segIdx = 3 * idx;
-    uint8_t red = m_pStencilSeg[segIdx];
-    uint8_t green = m_pStencilSeg[segIdx + 1];
-    uint8_t blue = m_pStencilSeg[segIdx + 2];
-    if (red == 0 && green == 0 && blue == 0) {
-        int newVal = 47 * entityID; //Just to produce unique but different colours
-        red = (newVal + 13 * entityID) % 255;
-        green = (newVal / 255) % 255;
-        blue = newVal % 255;
-    }
-    else {
-        red = 255;
-        green = 255;
-        blue = 255;
-    }
-    uint8_t* p = m_pStencilSeg + segIdx;
-    *p = red;
-    *(p + 1) = green;
-    *(p + 2) = blue;
+    InstanceMaskSet* masks = INSTANCE_MASK_FORMAT != INSTANCE_MASK_NONE ? &m_instanceMasks : NULL;
+    ::addPointToSegImages(m_pInstanceSeg, m_pStencilSeg, masks, s_camParams.width, i, j, entityID);
 }
 
 //process occlusion after all 2D points are segmented
@@ -1086,23 +1050,30 @@ void ObjectDetection::processOcclusion() {
     Vector3 yVectorCam = convertCoordinateSystem(worldY, m_camForwardVector, m_camRightVector, m_camUpVector);
     Vector3 zVectorCam = convertCoordinateSystem(worldZ, m_camForwardVector, m_camRightVector, m_camUpVector);
 
-    for (auto &entry : m_curFrame.vehicles) {
-        processOcclusionForEntity(&entry.second, xVectorCam, yVectorCam, zVectorCam);
-    }
-    for (auto &entry : m_curFrame.peds) {
-        processOcclusionForEntity(&entry.second, xVectorCam, yVectorCam, zVectorCam);
+    for (EntityTable* table : { m_vehicleTable.get(), m_pedTable.get() }) {
+        for (int slot = 0; slot < table->size(); ++slot) {
+            processOcclusionForEntity(*table, slot, xVectorCam, yVectorCam, zVectorCam);
+        }
     }
 }
 
-void ObjectDetection::processOcclusionForEntity(ObjEntity *e, const Vector3 &xVectorCam, const Vector3 &yVectorCam, const Vector3 &zVectorCam) {
+void ObjectDetection::processOcclusionForEntity(EntityTable &table, int slot, const Vector3 &xVectorCam, const Vector3 &yVectorCam, const Vector3 &zVectorCam) {
     int occlusionPointCount = 0;
+    const BBox2D &bbox2dUnprocessed = table.bbox2dUnprocessed[slot];
+    EntityRecord &e = table.record(slot);
+
+    //Augmented only entities have no pixels (and no box geometry)
+    if (!table.inFrustum[slot]) {
+        e.occlusion = occlusionLevel(0, 0, e.visibility);
+        return;
+    }
 
-    for (int j = e->bbox2dUnprocessed.top; j < e->bbox2dUnprocessed.bottom; ++j) {
-        for (int i = e->bbox2dUnprocessed.left; i < e->bbox2dUnprocessed.right; ++i) {
+    for (int j = bbox2dUnprocessed.top; j < bbox2dUnprocessed.bottom; ++j) {
+        for (int i = bbox2dUnprocessed.left; i < bbox2dUnprocessed.right; ++i) {
 
             int entityID = int(m_pInstanceSeg[j * s_camParams.width + i]);
 
-            if (entityID != e->entityID) {
+            if (entityID != table.ids[slot]) {
                 uint8_t stencilVal = m_pStencil[j * s_camParams.width + i];
                 float ndc = m_pDepth[j * s_camParams.width + i];
                 Vector3 relPos = depthToCamCoords(ndc, i, j);
@@ -1111,7 +1082,7 @@ void ObjectDetection::processOcclusionForEntity(ObjEntity *e, const Vector3 &xVe
                 worldPos.y += s_camParams.pos.y;
                 worldPos.z += s_camParams.pos.z;
 
-                if (stencilVal != STENCIL_TYPE_SKY && isPointOccluding(worldPos, e)) {
+                if (stencilVal != STENCIL_TYPE_SKY && isPointOccluding(worldPos, table.boxes[slot], e.worldPos)) {
                     ++occlusionPointCount;
                     m_pOcclusionImage[j * s_camParams.width + i] = 255;
                 }
@@ -1119,295 +1090,292 @@ void ObjectDetection::processOcclusionForEntity(ObjEntity *e, const Vector3 &xVe
         }
     }
 
-    float occtreshold = 1.0;
-    
-    int divisor = occlusionPointCount + e->pointsHit2D;
-    if (divisor != 0) {
-        occtreshold = (float)occlusionPointCount / (float)(divisor);
-    }
-    if (occtreshold < 0.2) {
-        e->occlusion = 0;
-    }
-    else if (occtreshold < 0.6) {
-        e->occlusion = 1;
-    }
-    else {
-        e->occlusion = 2;
-    }
-    
-}
-
-//dim is in full width/height/length
-static void updatePosition(float &origPos, float pedPos, float &origDim, float pedDim) {
-    float diffPos = pedPos + pedDim / 2 - (origPos + origDim / 2);
-    float diffNeg = pedPos - pedDim / 2 - (origPos - origDim / 2);
-    if (diffPos > 0) { //If ped dim is outside original bike dimension
-        origPos += diffPos / 2;
-        origDim += diffPos;
-    }
-    if (diffNeg < 0) { //If ped dim is outside original bike dimension
-        //If it is negative we need to add the position (since it is relative)
-        //but subtract the dimension (really make it bigger since diffNeg < 0 if it is bigger)
-        origPos += diffNeg / 2;
-        origDim -= diffNeg;
-    }
-}
-
-void ObjectDetection::getRollAndPitch(Vector3 rightVector, Vector3 forwardVector, Vector3 upVector, float &pitch, float &roll) {
-    Vector3 kittiForwardVector = convertCoordinateSystem(forwardVector, m_camForwardVector, m_camRightVector, m_camUpVector);
-    Vector3 kittiRightVector = convertCoordinateSystem(rightVector, m_camForwardVector, m_camRightVector, m_camUpVector);
-
-    roll = atan2(-kittiRightVector.z, sqrt(pow(kittiRightVector.y, 2) + pow(kittiRightVector.x, 2)));
-    pitch = atan2(-kittiForwardVector.z, sqrt(pow(kittiForwardVector.y, 2) + pow(kittiForwardVector.x, 2)));
+    e.occlusion = occlusionLevel(occlusionPointCount, table.pointsHit2D[slot], e.visibility);
 }
 
-Vector3 ObjectDetection::correctOffcenter(Vector3 position, Vector3 min, Vector3 max, Vector3 forwardVector, Vector3 rightVector, Vector3 upVector, Vector3 &offcenter) {
-    //Amount dimensions are offcenter
-    offcenter.x = (max.x + min.x) / 2;
-    offcenter.y = (max.y + min.y) / 2;
-    offcenter.z = min.z; //KITTI position is at object ground plane
-
-    //Converting vehicle dimensions from vehicle to world coordinates for offset position
-    Vector3 worldX; worldX.x = 1; worldX.y = 0; worldX.z = 0;
-    Vector3 worldY; worldY.x = 0; worldY.y = 1; worldY.z = 0;
-    Vector3 worldZ; worldZ.x = 0; worldZ.y = 0; worldZ.z = 1;
-    Vector3 xVector = convertCoordinateSystem(worldX, forwardVector, rightVector, upVector);
-    Vector3 yVector = convertCoordinateSystem(worldY, forwardVector, rightVector, upVector);
-    Vector3 zVector = convertCoordinateSystem(worldZ, forwardVector, rightVector, upVector);
-    Vector3 offcenterPosition = convertCoordinateSystem(offcenter, yVector, xVector, zVector);
-
-    //Update object position to be consistent with KITTI (symmetrical dimensions except for z which is ground)
-    position.x = position.x + offcenterPosition.x;
-    position.y = position.y + offcenterPosition.y;
-    position.z = position.z + offcenterPosition.z;
-
-    return position;
+void ObjectDetection::getRollAndPitch(Vector3 rightVector, Vector3 forwardVector, float &pitch, float &roll) {
+    ::getRollAndPitch(rightVector, forwardVector, m_camForwardVector, m_camRightVector, m_camUpVector, pitch, roll);
 }
 
-void ObjectDetection::update3DPointsHit(ObjEntity* e) {
+void ObjectDetection::update3DPointsHit(int entityID, EntityRecord &e) {
     //Checks to see if LiDAR hit entity e
-    if (m_entitiesHit.find(e->entityID) != m_entitiesHit.end()) {
-        HitLidarEntity* hitLidarEnt = m_entitiesHit[e->entityID];
-        e->pointsHit3D = hitLidarEnt->pointsHit;
+    if (m_entitiesHit.find(entityID) != m_entitiesHit.end()) {
+        HitLidarEntity* hitLidarEnt = m_entitiesHit[entityID];
+        e.pointsHit3D = hitLidarEnt->pointsHit;
     }
     //Entities not found will have their 3D point count remain at zero
 }
 
 void ObjectDetection::update3DPointsHit() {
     //Update # of 2D and 3D pixels for each entity
-    for (auto &entry : m_curFrame.vehicles) {
-        update3DPointsHit(&entry.second);
-    }
-    for (auto &entry : m_curFrame.peds) {
-        update3DPointsHit(&entry.second);
+    for (EntityTable* table : { m_vehicleTable.get(), m_pedTable.get() }) {
+        for (int slot = 0; slot < table->size(); ++slot) {
+            update3DPointsHit(table->ids[slot], table->record(slot));
+        }
     }
 }
 
-bool ObjectDetection::getEntityVector(ObjEntity &entity, int entityID, Hash model, int classid, std::string type, std::string modelString, bool isPedInV, int vPedIsIn, bool &nearbyVehicle) {
-    bool success = false;
+void ObjectDetection::setEgoSnapshot() {
+    m_egoSnapshot.velocity = m_world->getEntitySpeedVector(m_ownVehicle, false);
+    m_egoSnapshot.worldCoords = m_world->getOffsetFromEntityInWorldCoords(m_ownVehicle, 0.0, 0.0, 0.0);
+}
 
-    Vector3 FUR; //Front Upper Right
-    Vector3 BLL; //Back Lower Left
-    Vector3 dim; //Vehicle dimensions
-    Vector3 upVector, rightVector, forwardVector, position; //Vehicle position
-    Vector3 m_upVector, m_rightVector, m_forwardVector, m_position; //Own Vehicle position
-    Vector3 min;
-    Vector3 max;
-    Vector3 speedVector;
+//Conservative sphere/frustum test using the camera basis (near and far planes are handled by the caller)
+bool ObjectDetection::sphereInFrustum(const Vector3 &position, float radius) {
+    return ::sphereInFrustum(s_camParams, m_camForwardVector, m_camRightVector, m_camUpVector, position, radius);
+}
+
+//All natives needed per entity are called here so getEntityVector only works on the snapshot
+//Entities are sorted into cull tiers first from their position and bounding sphere (model and matrix),
+//skipped entities get no other native calls
+void ObjectDetection::snapshotEntities(const int* ids, int count, bool vehicles, EntitySnapshot &snap) {
+    snap.resize(count);
+    for (int k = 0; k < count; ++k) {
+        int entityID = ids[k];
+        snap.ids[k] = entityID;
+        snap.models[k] = m_world->getEntityModel(entityID);
+        m_world->getEntityMatrix(entityID, &snap.forward[k], &snap.right[k], &snap.up[k], &snap.position[k]);
+        Vector3 position = snap.position[k];
+        snap.distance[k] = sqrt(vdist2(s_camParams.pos.x, s_camParams.pos.y, s_camParams.pos.z, position.x, position.y, position.z));
 
-    float heading, speed;
+        //Need to limit distance as pixels won't register entities past the far clip
+        if (snap.distance[k] > s_camParams.farClip) {
+            ++snap.cullStats.skipped;
+            continue;
+        }
+
+        bool inFrustum = true;
+        if (ENABLE_ENTITY_CULLING) {
+            const ModelInfo &info = s_modelCache.get(snap.models[k]);
+            float radius = info.radius;
+            //Ped boxes are resized and lowered to the ground in entityGeometry
+            if (!vehicles) radius = std::max(radius, pedBoxRadius(info));
+            inFrustum = sphereInFrustum(position, radius);
+
+            //Off screen entities are still needed for augmented labels and as nearby vehicles
+            bool nearbyVehicle = vehicles && snap.distance[k] <= SECONDARY_PERSPECTIVE_RANGE;
+            if (!inFrustum && !AUGMENT_ALL_VEHICLES_IN_RANGE && !nearbyVehicle) {
+                ++snap.cullStats.skipped;
+                continue;
+            }
+        }
 
-    ENTITY::GET_ENTITY_MATRIX(m_vehicle, &m_forwardVector, &m_rightVector, &m_upVector, &m_position); //Blue or red pill
+        snap.inRange[k] = 1;
+        if (vehicles) {
+            if (ONLY_OCCUPIED_VEHICLES && snap.distance[k] <= SECONDARY_PERSPECTIVE_RANGE) {
+                snap.driverSeatFree[k] = m_world->isVehicleSeatFree(entityID, -1);
+            }
+            if (s_modelCache.get(snap.models[k]).isTrailer) {
+                snap.attachedTo[k] = m_world->getEntityAttachedTo(entityID);
+            }
+        }
+        else {
+            if (m_world->isPedInAnyVehicle(entityID, TRUE)) {
+                snap.vehicleIn[k] = m_world->getVehiclePedIsIn(entityID, FALSE);
+                snap.vehicleInModel[k] = m_world->getEntityModel(snap.vehicleIn[k]);
+            }
+            snap.pedType[k] = m_world->getPedType(entityID);
+        }
+        //Peds which have not moved since the last frame keep their ground Z (see EntityStateStore)
+        if (!vehicles && !(REUSE_ENTITY_STATE && m_entityState.cachedGroundZ(entityID, position, snap.groundZ[k]))) {
+            m_world->getGroundZFor3dCoord(position.x, position.y, position.z, &snap.groundZ[k], 0);
+        }
+        if (inFrustum) {
+            snap.cullTier[k] = CULL_TIER_FULL;
+            ++snap.cullStats.full;
+            snap.onScreen[k] = m_world->isEntityOnScreen(entityID);
+        }
+        else {
+            snap.cullTier[k] = CULL_TIER_AUGMENT;
+            ++snap.cullStats.augment;
+        }
+        snap.speed[k] = m_world->getEntitySpeed(entityID);
+        snap.speedVector[k] = m_world->getEntitySpeedVector(entityID, false);
+        snap.worldCoords[k] = m_world->getOffsetFromEntityInWorldCoords(entityID, 0.0, 0.0, 0.0);
+    }
+}
+
+void ObjectDetection::recordWorldState() {
+    WorldStateFrame state;
+    state.instanceIndex = instance_index;
+    state.seriesIndex = series_index;
+    state.width = s_camParams.width;
+    state.height = s_camParams.height;
+    state.eve = m_eve;
+
+    state.nearClip = s_camParams.nearClip;
+    state.farClip = s_camParams.farClip;
+    state.fov = s_camParams.fov;
+    state.ncWidth = s_camParams.ncWidth;
+    state.ncHeight = s_camParams.ncHeight;
+    state.camPos = s_camParams.pos;
+    state.camTheta = s_camParams.theta;
+    state.camForward = m_camForwardVector;
+    state.camRight = m_camRightVector;
+    state.camUp = m_camUpVector;
+
+    state.vehicle = m_vehicle;
+    state.ownVehicle = m_ownVehicle;
+    state.ownVehicleModel = m_ownVehicleObj.model;
+    state.vehicleForward = vehicleForwardVector;
+    state.vehicleRight = vehicleRightVector;
+    state.vehicleUp = vehicleUpVector;
+    state.vehiclePos = currentPos;
+    state.kittiWorldPos = m_curFrame.kittiWorldPos;
+    state.heading = m_curFrame.heading;
+    state.roll = m_curFrame.roll;
+    state.pitch = m_curFrame.pitch;
+    state.speed = m_curFrame.speed;
+    state.yawRate = m_curFrame.yawRate;
+    state.timeHours = m_curFrame.timeHours;
+    state.ego = m_egoSnapshot;
+
+    state.vehicles = m_vehicleSnapshot;
+    state.peds = m_pedSnapshot;
+
+    //Metadata of every model replay will look up (all models are in the cache by now)
+    std::unordered_set<Hash> models;
+    models.insert(m_vehicleSnapshot.models.begin(), m_vehicleSnapshot.models.end());
+    models.insert(m_pedSnapshot.models.begin(), m_pedSnapshot.models.end());
+    models.insert(m_pedSnapshot.vehicleInModel.begin(), m_pedSnapshot.vehicleInModel.end());
+    models.insert(state.ownVehicleModel);
+    models.erase(0);
+    for (Hash model : models) {
+        const ModelInfo* info = s_modelCache.find(model);
+        if (info) state.models.push_back({ model, *info });
+    }
+
+    if (!writeWorldState(m_worldStateFilename, state)) {
+        log("Failed to write world state: " + m_worldStateFilename, true);
+    }
+}
+
+void ObjectDetection::restoreWorldState(const WorldStateFrame &state) {
+    if (state.seriesIndex != series_index) {
+        trackFirstFrame.clear();
+        m_trackExporters.clear();
+    }
+    instance_index = state.instanceIndex;
+    series_index = state.seriesIndex;
+    updateIndexStrings();
+    m_eve = state.eve;
+
+    for (const RecordedModel &m : state.models) {
+        s_modelCache.add(m.model, m.info);
+    }
+
+    s_camParams.nearClip = state.nearClip;
+    s_camParams.farClip = state.farClip;
+    s_camParams.fov = state.fov;
+    s_camParams.ncWidth = state.ncWidth;
+    s_camParams.ncHeight = state.ncHeight;
+    s_camParams.init = true;
+    s_camParams.pos = state.camPos;
+    s_camParams.theta = state.camTheta;
+    updateCamEigen();
+    m_camForwardVector = state.camForward;
+    m_camRightVector = state.camRight;
+    m_camUpVector = state.camUp;
+
+    m_vehicle = state.vehicle;
+    m_ownVehicle = state.ownVehicle;
+    m_vPerspective = state.vehicle == state.ownVehicle ? -1 : state.vehicle;
+    if (state.ownVehicleModel != 0) setOwnVehicleObject(state.ownVehicleModel);
+    vehicleForwardVector = state.vehicleForward;
+    vehicleRightVector = state.vehicleRight;
+    vehicleUpVector = state.vehicleUp;
+    currentPos = state.vehiclePos;
+
+    m_curFrame.position = state.vehiclePos;
+    m_curFrame.heading = state.heading;
+    m_curFrame.roll = state.roll;
+    m_curFrame.pitch = state.pitch;
+    m_curFrame.forwardVec = state.vehicleForward;
+    m_curFrame.rightVec = state.vehicleRight;
+    m_curFrame.upVec = state.vehicleUp;
+    m_curFrame.camPos = state.camPos;
+    m_curFrame.kittiWorldPos = state.kittiWorldPos;
+    m_curFrame.speed = state.speed;
+    m_curFrame.yawRate = state.yawRate;
+    m_curFrame.timeHours = state.timeHours;
+    m_egoSnapshot = state.ego;
+
+    m_vehicleSnapshot = state.vehicles;
+    m_pedSnapshot = state.peds;
+}
+
+bool ObjectDetection::getEntityVector(ObjEntity &entity, const EntitySnapshot &snap, int idx, int classid, std::string type, bool isPedInV, int vPedIsIn, bool &nearbyVehicle) {
+    bool success = false;
 
-    ENTITY::GET_ENTITY_MATRIX(entityID, &forwardVector, &rightVector, &upVector, &position); //Blue or red pill
-    float distance = sqrt(SYSTEM::VDIST2(s_camParams.pos.x, s_camParams.pos.y, s_camParams.pos.z, position.x, position.y, position.z));
+    int entityID = snap.ids[idx];
+    float distance = snap.distance[idx];
     if (nearbyVehicle) {
         //nearbyVehicle needs to be within range
         if (distance > SECONDARY_PERSPECTIVE_RANGE) {
             nearbyVehicle = false;
         }//nearby vehicle needs to be occupied
-        else if (ONLY_OCCUPIED_VEHICLES && VEHICLE::IS_VEHICLE_SEAT_FREE(entityID, -1)) {
+        else if (ONLY_OCCUPIED_VEHICLES && snap.driverSeatFree[idx]) {
             nearbyVehicle = false;
         }
     }
 
     //Check if it is on screen
-    bool isOnScreen = ENTITY::IS_ENTITY_ON_SCREEN(entityID);
+    bool isOnScreen = snap.onScreen[idx];
     if (isOnScreen || nearbyVehicle || AUGMENT_ALL_VEHICLES_IN_RANGE) {
         if (isOnScreen || AUGMENT_ALL_VEHICLES_IN_RANGE) {
             success = true;
         }
         
         //Need to limit distance as pixels won't register entities past the far clip
-        if (distance > s_camParams.farClip) return false;
-
-        speed = ENTITY::GET_ENTITY_SPEED(entityID);
-
-        
-        GAMEPLAY::GET_MODEL_DIMENSIONS(model, &min, &max);
-
-        //Need to adjust dimensions for pedestrians
-        if (classid == PEDESTRIAN_CLASS_ID) {
-            float groundZ;
-            GAMEPLAY::GET_GROUND_Z_FOR_3D_COORD(position.x, position.y, position.z, &(groundZ), 0);
-            float negZ = groundZ - position.z;
-
-            //Pedestrians on balconies can cause problems
-            if (negZ > -2.0 && negZ < 0) {
-                min.z = groundZ - position.z;
-            }
-
-            if (SET_PED_BOXES) {
-                min.x = -PED_BOX_WIDTH / 2.0f;
-                max.x = PED_BOX_WIDTH / 2.0f;
-                if (speed > 1) {
-                    min.y = -PED_BOX_WALKING_LEN / 2.0f;
-                    max.y = PED_BOX_WALKING_LEN / 2.0f;
-                }
-                else {
-                    min.y = -PED_BOX_LENGTH / 2.0f;
-                    max.y = PED_BOX_LENGTH / 2.0f;
-                }
-            }
-
-            std::ostringstream oss2;
-            oss2 << "***min: " << min.x << ", " << min.y << ", " << min.z <<
-                "\nmax: " << max.x << ", " << max.y << ", " << max.z;
-            std::string str = oss2.str();
-            log(str);
-        }
-
-        //Calculate size
-        dim.x = 0.5*(max.x - min.x);
-        dim.y = 0.5*(max.y - min.y);
-        dim.z = 0.5*(max.z - min.z);
-
-        //TODO Remove these calculations and put x/y/zVector and m_camRight/Forward/UpVector in s_camParams
-        //Converting vehicle dimensions from vehicle to world coordinates for offset position
-        Vector3 worldX; worldX.x = 1; worldX.y = 0; worldX.z = 0;
-        Vector3 worldY; worldY.x = 0; worldY.y = 1; worldY.z = 0;
-        Vector3 worldZ; worldZ.x = 0; worldZ.y = 0; worldZ.z = 1;
-        Vector3 xVector = convertCoordinateSystem(worldX, forwardVector, rightVector, upVector);
-        Vector3 yVector = convertCoordinateSystem(worldY, forwardVector, rightVector, upVector);
-        Vector3 zVector = convertCoordinateSystem(worldZ, forwardVector, rightVector, upVector);
-
-        Vector3 offcenter;
-        position = correctOffcenter(position, min, max, forwardVector, rightVector, upVector, offcenter);
-
-        speedVector = ENTITY::GET_ENTITY_SPEED_VECTOR(entityID, false);
-        if (speed > 0) {
-            heading = GAMEPLAY::GET_HEADING_FROM_VECTOR_2D(speedVector.x - vehicleForwardVector.x, speedVector.y - vehicleForwardVector.y);
-        }
-        else {
-            heading = GAMEPLAY::GET_HEADING_FROM_VECTOR_2D(forwardVector.x - vehicleForwardVector.x, forwardVector.y - vehicleForwardVector.y);
-        }
-
-        //Kitti dimensions
-        float kittiHeight = 2 * dim.z;
-        float kittiWidth = 2 * dim.x;
-        float kittiLength = 2 * dim.y;
-                    
-        //Have only seen sitting people with height <= 1.0
-        if (classid == PEDESTRIAN_CLASS_ID && kittiHeight <= 1.0) {
-            type = "Person_sitting";
+        if (!snap.inRange[idx]) return false;
+
+        //The label math only reads the snapshot, the geometry and the frame (see EntityLabel.h).
+        //Caches, riders, the 2D box (a game query) and the track state are handled here around it.
+        const EntityGeometry &geom = updateEntityGeometry(snap, idx, classid);
+        entityLabel(snap, idx, geom, m_labelFrame, classid, type, entity);
+
+        if (abs(geom.offcenter.y) > 0.5 && classid == 0) {
+            LOG_DEBUG("Instance Index: " << instance_index << " Dimensions are: " << geom.dim.x << ", " << geom.dim.y << ", " << geom.dim.z <<
+                "\nMax: " << geom.max.x << ", " << geom.max.y << ", " << geom.max.z <<
+                "\nMin: " << geom.min.x << ", " << geom.min.y << ", " << geom.min.z <<
+                "\noffset: " << geom.offcenter.x << ", " << geom.offcenter.y << ", " << geom.offcenter.z);
         }
 
-        if (abs(offcenter.y) > 0.5 && classid == 0) {
-            std::ostringstream oss2;
-            oss2 << "Instance Index: " << instance_index << " Dimensions are: " << dim.x << ", " << dim.y << ", " << dim.z;
-            oss2 << "\nMax: " << max.x << ", " << max.y << ", " << max.z;
-            oss2 << "\nMin: " << min.x << ", " << min.y << ", " << min.z;
-            oss2 << "\noffset: " << offcenter.x << ", " << offcenter.y << ", " << offcenter.z;
-            std::string str2 = oss2.str();
-            log(str2);
-        }
-
-        Vector3 relativePos;
-        relativePos.x = position.x - s_camParams.pos.x;
-        relativePos.y = position.y - s_camParams.pos.y;
-        relativePos.z = position.z - s_camParams.pos.z;
-
-        Vector3 kittiForwardVector = convertCoordinateSystem(forwardVector, m_camForwardVector, m_camRightVector, m_camUpVector);
-        float rot_y = -atan2(kittiForwardVector.y, kittiForwardVector.x);
-
-        relativePos = convertCoordinateSystem(relativePos, m_camForwardVector, m_camRightVector, m_camUpVector);
-
-        //Update object position to be consistent with KITTI (symmetrical dimensions except for z which is ground)
-        //relativePos.y = relativePos.y - CAM_OFFSET_FORWARD;
-        //relativePos.z = relativePos.z - CAM_OFFSET_UP;
-
-        //Convert to KITTI camera coordinates
-        Vector3 kittiPos;
-        kittiPos.x = relativePos.x;
-        kittiPos.y = -relativePos.z;
-        kittiPos.z = relativePos.y;
-
-        //alpha is rot_y + tan^-1(z/x) + PI/2
-        float beta_kitti = atan2(kittiPos.z, kittiPos.x);
-        float alpha_kitti = rot_y + beta_kitti - PI / 2;
-
         log("After processBBox2D");
         bool foundPedOnBike = false;
         if (PROCESS_PEDS_ON_BIKES) {
             if (m_pedsInVehicles.find(entityID) != m_pedsInVehicles.end()) {
-                std::vector<Ped> pedsOnV = m_pedsInVehicles[entityID];
+                const std::vector<Ped> &pedsOnV = m_pedsInVehicles[entityID];
 
                 for (auto ped : pedsOnV) {
-                    std::ostringstream oss;
-                    oss << "Found ped on bike at index: " << instance_index;
-                    std::string str = oss.str();
-                    log(str, true);
+                    LOG_INFO("Found ped on bike at index: " << instance_index);
                     log("Found ped on bike", true);
                     foundPedOnBike = true;
                     //Extend 3D/2D boxes with peds, change id in segmentation image
 
-                    if (m_curFrame.peds.find(ped) != m_curFrame.peds.end()) {
-                        ObjEntity pedO = m_curFrame.peds[ped];
+                    int pedSlot = m_pedTable->find(ped);
+                    if (pedSlot != -1) {
+                        EntityRecord &pedO = m_pedTable->record(pedSlot);
 
-                        float horizDist = sqrt(pow(pedO.location.x - kittiPos.x, 2) + pow(pedO.location.z - kittiPos.z, 2));
-                        float vertDist = pedO.location.y - kittiPos.y;
-                        if (horizDist < 0.5 && vertDist <= 2.0) {
+                        float dx = pedO.location.x - entity.location.x;
+                        float dz = pedO.location.z - entity.location.z;
+                        float horizDist = sqrt(dx * dx + dz * dz);
+                        float vertDist = pedO.location.y - entity.location.y;
+                        if (horizDist < RIDER_HORIZ_DIST && vertDist <= RIDER_MAX_VERT_DIST) {
                             foundPedOnBike = true;
-                            m_curFrame.peds[ped].isPedInV = true;
-                            m_curFrame.peds[ped].vPedIsIn = entityID;
-
-                            //This method assume the pedestrian x/z coordinates are the same as the vehicles (only update relative height position)
-                            kittiWidth = kittiWidth > pedO.width ? kittiWidth : pedO.width;
-                            kittiLength = kittiLength > pedO.length ? kittiLength : pedO.length;
-                            updatePosition(kittiPos.y, pedO.location.y, kittiHeight, pedO.height);
-
-                            //This method would need to be changed to accommodate object coordinate system vs kitti coordinate system
-                            /*updatePosition(kittiPos.x, pedO.location.x, kittiWidth, pedO.width);
-                            updatePosition(kittiPos.y, pedO.location.y, kittiWidth, pedO.width);
-                            updatePosition(kittiPos.z, pedO.location.z, kittiWidth, pedO.width);*/
+                            pedO.isPedInV = true;
+                            pedO.vPedIsIn = entityID;
+                            mergeRider(entity, pedO);
                         }
                     }
                 }
             }
-            else if (TESTING_PEDS_ON_BIKES && classid == 1 || classid == 2 || classid == 3) { //bicycle, bike, or quadbike
-                for (auto ped : m_curFrame.peds) {
-                    ObjEntity pedO = ped.second;
-                    float horizDist = sqrt(pow(pedO.location.x - kittiPos.x, 2) + pow(pedO.location.z - kittiPos.z, 2));
-                    float vertDist = pedO.location.y - kittiPos.y;
-                    if (horizDist < 0.5 && vertDist <= 2.0) {
-                        m_curFrame.peds[ped.first].isPedInV = true;
-                        m_curFrame.peds[ped.first].vPedIsIn = entityID;
-                        foundPedOnBike = true;
-                        std::ostringstream oss;
-                        oss << "****************************Alternate Found ped on bike at index: " << instance_index;
-                        std::string str = oss.str();
-                        log(str, true);
-                                    
-                        //This method assume the pedestrian x/z coordinates are the same as the vehicles (only update relative height position)
-                        kittiWidth = kittiWidth > pedO.width ? kittiWidth : pedO.width;
-                        kittiLength = kittiLength > pedO.length ? kittiLength : pedO.length;
-                        updatePosition(kittiPos.y, pedO.location.y, kittiHeight, pedO.height);
-
-                        //This method would need to be changed to accommodate object coordinate system vs kitti coordinate system
-                        /*updatePosition(kittiPos.x, pedO.location.x, kittiWidth, pedO.width);
-                        updatePosition(kittiPos.y, pedO.location.y, kittiWidth, pedO.width);
-                        updatePosition(kittiPos.z, pedO.location.z, kittiWidth, pedO.width);*/
-                    }
+            else if (TESTING_PEDS_ON_BIKES && (classid == 1 || classid == 2 || classid == 3)) { //bicycle, bike, or quadbike
+                //Peds near the vehicle from the grid built in setPedsList
+                int riders = mergeRidersInRange(entity, m_pedGrid, *m_pedTable, m_pedGridHits);
+                if (riders > 0) {
+                    foundPedOnBike = true;
+                    LOG_INFO("****************************Alternate Found " << riders << " ped(s) on bike at index: " << instance_index);
                 }
             }
         }
@@ -1417,60 +1385,17 @@ bool ObjectDetection::getEntityVector(ObjEntity &entity, int entityID, Hash mode
         float truncation = 0;
         BBox2D bbox2d;
         if (isOnScreen) {
-            bbox2d = BBox2DFrom3DObject(position, dim, forwardVector, rightVector, upVector, success, truncation);
+            bbox2d = BBox2DFrom3DObject(geom.worldPos, geom.dim, snap.forward[idx], snap.right[idx], snap.up[idx], success, truncation);
         }
-        //stencil type for vehicles like cars, bikes...
-        int stencilType = STENCIL_TYPE_VEHICLE;
-        //Pedestrian classid
-        if (classid == PEDESTRIAN_CLASS_ID) stencilType = STENCIL_TYPE_NPC; //For NPCs
-
-        float roll = atan2(-rightVector.z, sqrt(pow(rightVector.y, 2) + pow(rightVector.x, 2)));
-        float pitch = atan2(-forwardVector.z, sqrt(pow(forwardVector.y, 2) + pow(forwardVector.x, 2)));
-        getRollAndPitch(rightVector, forwardVector, upVector, pitch, roll);
-        //To prevent negative zeros
-        if (abs(roll) <= 0.0001) roll = 0.0f;
-        if (abs(pitch) <= 0.0001) pitch = 0.0f;
-
-        entity.entityID = entityID;
-        entity.classID = classid;
-        entity.speed = speed;
-        entity.heading = heading;
-
-        entity.height = kittiHeight;
-        entity.width = kittiWidth;
-        entity.length = kittiLength;
-        entity.dim = dim;
-
-        entity.offcenter = offcenter;
-        entity.location = kittiPos;
-        entity.worldPos = position;
-
-        entity.rotation_y = rot_y;
-        entity.alpha = alpha_kitti;
-        entity.distance = distance;
+        entity.truncation = truncation;
 
         //Blank bbox to be filled in later
-        BBox2D bbox2dProcessed = BBox2D();
-        entity.bbox2d = bbox2dProcessed;
-                    
+        entity.bbox2d = BBox2D();
         entity.bbox2dUnprocessed.left = bbox2d.left * s_camParams.width;
         entity.bbox2dUnprocessed.top = bbox2d.top * s_camParams.height;
         entity.bbox2dUnprocessed.right = bbox2d.right * s_camParams.width;
         entity.bbox2dUnprocessed.bottom = bbox2d.bottom * s_camParams.height;
 
-        //Calculated during processSegmentation and processOcclusion
-        entity.pointsHit2D = 0;
-        entity.pointsHit3D = 0;
-        entity.occlusion = 0;
-
-        entity.truncation = truncation;
-        entity.pitch = pitch;
-        entity.roll = roll;
-        entity.model = model;
-        //entity.modelString = modelString;
-        entity.modelString = VEHICLE::GET_DISPLAY_NAME_FROM_VEHICLE_MODEL(model);
-        entity.objType = type;
-
         if (trackFirstFrame.find(entityID) == trackFirstFrame.end()) {
             trackFirstFrame.insert(std::pair<int, int>(entityID, instance_index));
         }
@@ -1479,166 +1404,155 @@ bool ObjectDetection::getEntityVector(ObjEntity &entity, int entityID, Hash mode
         entity.isPedInV = isPedInV;
         entity.vPedIsIn = vPedIsIn;
 
-        entity.xVector = xVector;
-        entity.yVector = yVector;
-        entity.zVector = zVector;
-
-
-        Vector3 own_vehicle_velocity = ENTITY::GET_ENTITY_SPEED_VECTOR(m_ownVehicle, false);
-        Vector3 entity_velocity = ENTITY::GET_ENTITY_SPEED_VECTOR(entityID, false);
-
-        entity.entity_velocity_vector = speedVector;
-
-        entity.own_vehicle_velocity_vector = own_vehicle_velocity;
-
-        entity.entity_world_coordinates = ENTITY::GET_OFFSET_FROM_ENTITY_IN_WORLD_COORDS(entityID, 0.0, 0.0, 0.0);
-
-        entity.player_world_coordinates = ENTITY::GET_OFFSET_FROM_ENTITY_IN_WORLD_COORDS(m_ownVehicle, 0.0, 0.0, 0.0);
-
-        entity.own_vehicle_velocity_vector_camcoords = convertCoordinateSystem(own_vehicle_velocity, m_camForwardVector, m_camRightVector, m_camUpVector);
-
-        entity.entity_velocity_vector_camcoords = convertCoordinateSystem(entity_velocity, m_camForwardVector, m_camRightVector, m_camUpVector);
+        log("End of getEntityVector");
+    }
 
+    return success;
+}
 
+//World space geometry of a snapshot entry. Kept in m_entityState (and not recomputed) while the entity has not moved.
+const EntityGeometry& ObjectDetection::updateEntityGeometry(const EntitySnapshot &snap, int idx, int classid) {
+    bool pedestrian = classid == PEDESTRIAN_CLASS_ID;
+    EntityGeometry* geom = &m_entityGeometry;
+    if (REUSE_ENTITY_STATE) {
+        geom = &m_entityState.lookup(snap.ids[idx], snap.models[idx], snap.forward[idx], snap.right[idx], snap.up[idx], snap.position[idx],
+            pedestrian && snap.speed[idx] > 1);
+        if (geom->valid) return *geom;
+    }
 
-        log("End of getEntityVector");
+    geom->info = &s_modelCache.get(snap.models[idx]);
+    entityGeometry(snap, idx, *geom->info, pedestrian, *geom);
+    geom->valid = true;
+    if (pedestrian) {
+        geom->groundZ = snap.groundZ[idx];
+        geom->groundZValid = true;
     }
+    return *geom;
+}
 
-    return success;
+EntityTable& ObjectDetection::resetTable(std::shared_ptr<EntityTable> &table, EntityTableView &view) {
+    view.table.reset();
+    if (!table || table.use_count() > 1) {
+        table = std::make_shared<EntityTable>();
+    }
+    else {
+        table->clear();
+    }
+    return *table;
 }
 
 void ObjectDetection::setVehiclesList() {
-    m_curFrame.vehicles.clear();
+    EntityTable &vehicleTable = resetTable(m_vehicleTable, m_curFrame.vehicles);
     log("Setting vehicles list.");
-    const int ARR_SIZE = 1024;
-    Vehicle vehicles[ARR_SIZE];
-
     Hash model;
     int classid;
 
-    int count = worldGetAllVehicles(vehicles, ARR_SIZE);
+    int count = (int)m_vehicleSnapshot.size();
+    m_curFrame.vehicleCull = m_vehicleSnapshot.cullStats;
     for (int i = 0; i < count; i++) {
-        if (vehicles[i] == m_vehicle) continue; //Don't process perspective car!
-
-        model = ENTITY::GET_ENTITY_MODEL(vehicles[i]);
-        if (VEHICLE::IS_THIS_MODEL_A_CAR(model)) classid = 0;
-        else if (VEHICLE::IS_THIS_MODEL_A_BIKE(model)) classid = 1;
-        else if (VEHICLE::IS_THIS_MODEL_A_BICYCLE(model)) classid = 2;
-        else if (VEHICLE::IS_THIS_MODEL_A_QUADBIKE(model)) classid = 3;
-        else if (VEHICLE::IS_THIS_MODEL_A_BOAT(model)) classid = 4;
-        else if (VEHICLE::IS_THIS_MODEL_A_PLANE(model)) classid = 5;
-        else if (VEHICLE::IS_THIS_MODEL_A_HELI(model)) classid = 6;
-        else if (VEHICLE::IS_THIS_MODEL_A_TRAIN(model)) classid = 7;
-        else if (VEHICLE::_IS_THIS_MODEL_A_SUBMERSIBLE(model)) classid = 8;
-        else classid = 9; //unknown (ufo?)
-
-        //Get the model string, convert it to lowercase then find it in lookup table
-        std::string modelString = VEHICLE::GET_DISPLAY_NAME_FROM_VEHICLE_MODEL(model);
-        std::string before = modelString;
-        std::transform(modelString.begin(), modelString.end(), modelString.begin(), ::tolower);
-        std::string type = "Unknown";
-        modelString.erase(remove_if(modelString.begin(), modelString.end(), [](char c) { return !isalpha(c); }), modelString.end());
-        auto search = m_vLookup.find(modelString);
-        if (search != m_vLookup.end()) {
-            type = search->second;
-        }
-        else {
-            std::ostringstream oss;
-            oss << "Entity Model/type/hash: " << modelString << ", " << type << ", " << model << ", before: " << before << ", index: " << instance_index;
-            std::string str = oss.str();
-            log(str, true);
-        }
-
-        if (type == "Unknown") {
-            if (VEHICLE::IS_THIS_MODEL_A_CAR(model)) type = "UNK";
-            else if (VEHICLE::IS_THIS_MODEL_A_BIKE(model)) type = "UNK";
-            else if (VEHICLE::IS_THIS_MODEL_A_BICYCLE(model)) type = "UNK";
-            else if (VEHICLE::IS_THIS_MODEL_A_QUADBIKE(model)) type = "UNK";
-            else if (VEHICLE::IS_THIS_MODEL_A_BOAT(model)) type = "UNK";
-            else if (VEHICLE::IS_THIS_MODEL_A_PLANE(model)) type = "UNK";
-            else if (VEHICLE::IS_THIS_MODEL_A_HELI(model)) type = "UNK";
-            else if (VEHICLE::IS_THIS_MODEL_A_TRAIN(model)) type = "UNK";
-            else if (VEHICLE::_IS_THIS_MODEL_A_SUBMERSIBLE(model)) type = "UNK";
+        if (m_vehicleSnapshot.ids[i] == m_vehicle) continue; //Don't process perspective car!
+
+        model = m_vehicleSnapshot.models[i];
+        const ModelInfo &info = s_modelCache.get(model);
+        classid = info.classID;
+        std::string type = info.type;
+        if (!info.inLookup) {
+            LOG_RATE_LIMITED(LOG_LEVEL_INFO, 5, "Entity Model/type/hash: " << info.lookupName << ", " << type << ", " << model << ", before: " << info.displayName << ", index: " << instance_index);
         }
 
         ObjEntity objEntity;
         //Gets set to false in getEntityVector if outside SECONDARY_PERSPECTIVE_RANGE or if vehicle is unoccupied
         bool nearbyVehicle = true;
-        bool success = getEntityVector(objEntity, vehicles[i], model, classid, type, modelString, false, -1, nearbyVehicle);
+        bool success = getEntityVector(objEntity, m_vehicleSnapshot, i, classid, type, false, -1, nearbyVehicle);
 
 
 
         if (success) {
-            if (m_curFrame.vehicles.find(objEntity.entityID) == m_curFrame.vehicles.end()) {
-                m_curFrame.vehicles.insert(std::pair<int, ObjEntity>(objEntity.entityID, objEntity));
-            }
+            vehicleTable.insert(objEntity);
         }
         //Only change m_nearbyVehicles for the ego vehicle
         if (nearbyVehicle && m_vehicle == m_ownVehicle) {
             m_nearbyVehicles.push_back(objEntity);
         }
     }
+
+    //Pixels of peds in vehicles are added to the vehicle
+    for (int slot = 0; slot < m_pedTable->size(); ++slot) {
+        const EntityRecord &ped = m_pedTable->record(slot);
+        if (ped.isPedInV) m_pedTable->vehicleSlot[slot] = vehicleTable.find(ped.vPedIsIn);
+    }
+
+    //Link tractors back to their trailers (trailers were linked in snapshotEntities)
+    for (int slot = 0; slot < vehicleTable.size(); ++slot) {
+        const EntityRecord &trailer = vehicleTable.record(slot);
+        if (trailer.towLink == 0 || !s_modelCache.get(trailer.model).isTrailer) continue;
+
+        int tractorSlot = vehicleTable.find(trailer.towLink);
+        if (tractorSlot == -1) continue;
+        vehicleTable.record(tractorSlot).towLink = vehicleTable.ids[slot];
+        if (MERGE_TRAILER_SEGMENTATION) vehicleTable.vehicleSlot[slot] = tractorSlot;
+    }
+    m_curFrame.vehicles.table = m_vehicleTable;
 }
 
 void ObjectDetection::setPedsList() {
-    m_curFrame.peds.clear();
+    EntityTable &pedTable = resetTable(m_pedTable, m_curFrame.peds);
+    //Riders are only valid for the current frame
+    m_pedsInVehicles.clear();
     log("Setting peds list.");
-    const int ARR_SIZE = 1024;
-    Ped peds[ARR_SIZE];
-
-    Hash model;
     int classid;
 
-    int count = worldGetAllPeds(peds, ARR_SIZE);
+    int count = (int)m_pedSnapshot.size();
+    m_curFrame.pedCull = m_pedSnapshot.cullStats;
     for (int i = 0; i < count; i++) {
         bool isPedInV = false;
-        Vehicle vPedIsIn = -1;
-        if (PED::IS_PED_IN_ANY_VEHICLE(peds[i], TRUE)) {
-            vPedIsIn = PED::GET_VEHICLE_PED_IS_IN(peds[i], FALSE);
-            Hash vModel = ENTITY::GET_ENTITY_MODEL(vPedIsIn);
-
-            //Update bounding boxes/stencils for all bike type vehicles
-            if (VEHICLE::IS_THIS_MODEL_A_BIKE(vModel) ||
-                VEHICLE::IS_THIS_MODEL_A_BICYCLE(vModel) ||
-                VEHICLE::IS_THIS_MODEL_A_QUADBIKE(vModel)) {
-
+        Vehicle vPedIsIn = m_pedSnapshot.vehicleIn[i];
+        if (vPedIsIn != -1) {
+            //Update bounding boxes/stencils for all bike type vehicles (bike, bicycle, quadbike)
+            int vClass = s_modelCache.get(m_pedSnapshot.vehicleInModel[i]).classID;
+            if (vClass >= 1 && vClass <= 3) {
+                Ped pedID = m_pedSnapshot.ids[i];
                 if (m_pedsInVehicles.find(vPedIsIn) != m_pedsInVehicles.end()) {
                     log("Putting ped in a vehicle in list.", true);
-                    m_pedsInVehicles[vPedIsIn].push_back(peds[i]);
+                    m_pedsInVehicles[vPedIsIn].push_back(pedID);
                 }
                 else {
-                    m_pedsInVehicles.insert(std::pair<Vehicle, std::vector<Ped>>(vPedIsIn, { peds[i] }));
+                    m_pedsInVehicles.insert(std::pair<Vehicle, std::vector<Ped>>(vPedIsIn, { pedID }));
                 }
             }
             isPedInV = true; //Don't add peds in vehicles as unique objects!
         }
 
         std::string type = "Pedestrian";
-        if (PED::GET_PED_TYPE(peds[i]) == 28) {
+        if (m_pedSnapshot.pedType[i] == 28) {
             classid = 11; //animal
             type = "Misc";
         }
         else classid = PEDESTRIAN_CLASS_ID;
 
         if (RETAIN_ANIMALS || classid != 11) {
-            model = ENTITY::GET_ENTITY_MODEL(peds[i]);
-
             ObjEntity objEntity;
             bool nearbyVehicle = false;//Don't look if it is a nearby vehicle as we're collecting peds
-            bool success = getEntityVector(objEntity, peds[i], model, classid, type, type, isPedInV, vPedIsIn, nearbyVehicle);
+            bool success = getEntityVector(objEntity, m_pedSnapshot, i, classid, type, isPedInV, vPedIsIn, nearbyVehicle);
             if (success) {
-                if (m_curFrame.peds.find(objEntity.entityID) == m_curFrame.peds.end()) {
-                    m_curFrame.peds.insert(std::pair<int, ObjEntity>(objEntity.entityID, objEntity));
-                }
+                pedTable.insert(objEntity);
             }
         }
     }
+
+    //Grid for finding riders of bike type vehicles in setVehiclesList
+    m_pedGrid.clear();
+    for (int slot = 0; slot < pedTable.size(); ++slot) {
+        m_pedGrid.add(pedTable.ids[slot], pedTable.record(slot).location);
+    }
+    m_pedGrid.build();
+    m_curFrame.peds.table = m_pedTable;
 }
 
 void ObjectDetection::setFilenames() {
     //These are standard files
     m_imgFilename = getStandardFilename("image_2", ".png");
-    m_depthFilename = getStandardFilename("depth", ".bin");
+    m_depthFilename = getStandardFilename("depth", COMPRESS_DEPTH_BUFFER ? ".gdz" : ".bin");
     m_stencilFilename = getStandardFilename("stencil", ".raw");
     m_labelsFilename = getStandardFilename("label_2", ".txt");
     m_labelsAugFilename = getStandardFilename("label_aug_2", ".txt");
@@ -1656,8 +1570,9 @@ void ObjectDetection::setFilenames() {
 
     //TODO - Why are two seg images being printed (there are some minor differences in images it appears)
     m_segImgFilename = getStandardFilename("segImage", ".png");
-    m_instSegFilename = getStandardFilename("instSeg", ".png");
-    m_instSegImgFilename = getStandardFilename("instSegImage", ".png");
+    if (OUTPUT_INSTANCE_SEG_PNG) m_instSegFilename = getStandardFilename("instSeg", ".png");
+    if (OUTPUT_INSTANCE_SEG_IMAGE) m_instSegImgFilename = getStandardFilename("instSegImage", ".png");
+    if (INSTANCE_MASK_FORMAT != INSTANCE_MASK_NONE) m_instSegMasksFilename = getStandardFilename("instSegMasks", ".json");
 
     //These files are for relating object positions to each other
     if (GENERATE_SECONDARY_PERSPECTIVES) {
@@ -1681,6 +1596,8 @@ void ObjectDetection::setFilenames() {
     if (OUTPUT_STENCIL_IMAGE) m_stencilImgFilename = getStandardFilename("stencilImage", ".png");
     if (OUTPUT_OCCLUSION_IMAGE) m_occImgFilename = getStandardFilename("occlusionImage", ".png");
     if (OUTPUT_UNPROCESSED_LABELS) m_labelsUnprocessedFilename = getStandardFilename("labelsUnprocessed", ".txt");
+    if (OUTPUT_BINARY_LABELS) m_labelsBinFilename = getStandardFilename("label_bin", ".glb");
+    if (OUTPUT_WORLD_STATE) m_worldStateFilename = getStandardFilename("worldState", ".bin");
 }
 
 void ObjectDetection::setupLiDAR() {
@@ -1690,103 +1607,63 @@ void ObjectDetection::setupLiDAR() {
         //0.09f azimuth resolution
         //26.8 vertical fov (+2 degrees up to -24.8 degrees down)
         //0.420 vertical resolution
+        lidar.SetWorld(m_world);
         lidar.Init3DLiDAR_FOV(MAX_LIDAR_DIST, 90.0f, 0.09f, 26.9f, 0.420f, 2.0f);
         lidar.AttachLiDAR2Camera(camera, ped);
         lidar_initialized = true;
-        m_pDMPointClouds = (float *)malloc(s_camParams.width * s_camParams.height * FLOATS_PER_POINT * sizeof(float));
-        m_pDMImage = (uint16_t *)malloc(s_camParams.width * s_camParams.height * sizeof(uint16_t));
-        m_pStencilImage = (uint8_t *)malloc(s_camParams.width * s_camParams.height * sizeof(uint8_t));
-        m_pOcclusionImage = (uint8_t *)malloc(s_camParams.width * s_camParams.height * sizeof(uint8_t));
-        m_pUnusedStencilImage = (uint8_t *)malloc(s_camParams.width * s_camParams.height * sizeof(uint8_t));
-        
+
         //RGB Image needs 3 bytes per value
         m_stencilSegLength = s_camParams.width * s_camParams.height * 3 * sizeof(uint8_t);
         m_instanceSegLength = s_camParams.width * s_camParams.height * sizeof(uint32_t);
         m_instanceSegImgLength = s_camParams.width * s_camParams.height * 3 * sizeof(uint8_t);
+        m_instanceMasks.reset(s_camParams.width, s_camParams.height);
 
-        m_pStencilSeg = (uint8_t *)malloc(m_stencilSegLength);
-        m_pInstanceSeg = (uint32_t *)malloc(m_instanceSegLength);
-        m_pInstanceSegImg = (uint8_t *)malloc(m_instanceSegImgLength);
-        m_pGroundPointsImage = (uint8_t *)malloc(s_camParams.width * s_camParams.height * FLOATS_PER_POINT * sizeof(uint8_t));
+        size_t frameBytes = m_frameBuffers.init(s_camParams.width, s_camParams.height, lidar.getMaxPoints(), FRAMES_IN_FLIGHT);
+        bindFrameBuffers();
+        LOG_INFO("Frame buffers: " << FRAMES_IN_FLIGHT << " x " << s_camParams.width << "x" << s_camParams.height
+            << ", " << lidar.getMaxPoints() << " LiDAR points, " << frameBytes << " bytes (+" << lidar.bufferBytes()
+            << " LiDAR, " << frameBytes + lidar.bufferBytes() << " bytes resident)");
     }
 }
 
+//Points the frame buffers at the next set of the pool (buffers stay NULL until setupLiDAR initialises it).
+//The set comes back cleared, the previous frame's buffers are left as they were written.
+void ObjectDetection::bindFrameBuffers() {
+    if (!m_frameBuffers.isInit()) return;
+    m_instanceMasks.reset(s_camParams.width, s_camParams.height);
+    m_pFrameBuffers = &m_frameBuffers.next();
+    m_pDMPointClouds = m_pFrameBuffers->dmPointClouds.data();
+    m_pDMImage = m_pFrameBuffers->dmImage.data();
+    m_pStencilImage = m_pFrameBuffers->stencilImage.data();
+    m_pOcclusionImage = m_pFrameBuffers->occlusionImage.data();
+    m_pUnusedStencilImage = m_pFrameBuffers->unusedStencilImage.data();
+    m_pGroundPointsImage = m_pFrameBuffers->groundPointsImage.data();
+    m_pStencilSeg = m_pFrameBuffers->stencilSeg.data();
+    m_pInstanceSeg = m_pFrameBuffers->instanceSeg.data();
+    m_pInstanceSegImg = m_pFrameBuffers->instanceSegImg.data();
+}
+
 void ObjectDetection::collectLiDAR() {
+    BudgetScope budgetScope(m_frameBudget, BUDGET_STAGE_LIDAR);
     m_entitiesHit.clear();
     lidar.updateCurrentPosition(m_camForwardVector, m_camRightVector, m_camUpVector);
     float *pointCloud = lidar.GetPointClouds(pointCloudSize, &m_entitiesHit, lidar_param, m_pDepth, m_pInstanceSeg, m_vehicle);
 
     // Output point clouds dimensions
-    uint OUTPUT_POINTCLOUD_POINTS = 4;
-
-    // Create new arrays with the points as pointCloud will have all the offsets.
-    float* GTCarArray = new float[pointCloudSize * sizeof(float) * OUTPUT_POINTCLOUD_POINTS];
-    float* GTPedArray = new float[pointCloudSize * sizeof(float) * OUTPUT_POINTCLOUD_POINTS];
-    float* EntityArray = new float[pointCloudSize * sizeof(float) * OUTPUT_POINTCLOUD_POINTS];
-    float* ZeroIntensityArray = new float[pointCloudSize * sizeof(float) * OUTPUT_POINTCLOUD_POINTS];
-    float* RadialVelocityArray = new float[pointCloudSize * sizeof(float) * OUTPUT_POINTCLOUD_POINTS];
-    float* AbsSpeedArray = new float[pointCloudSize * sizeof(float) * OUTPUT_POINTCLOUD_POINTS];
-    float* MovingArray = new float[pointCloudSize * sizeof(float) * OUTPUT_POINTCLOUD_POINTS];
-
-    int i = 0, k=0;
-    while( i < (pointCloudSize * sizeof(float) * OUTPUT_POINTCLOUD_POINTS)) {
-
-        // Default output by PreSIL: intensity is the entity ID of each object
-        // *(p + 3)
-        *(EntityArray + i) = pointCloud[k];
-        *(EntityArray + i + 1) = pointCloud[k + 1];
-        *(EntityArray + i + 2) = pointCloud[k + 2];
-        *(EntityArray + i + 3) = pointCloud[k + 3];
-
-
-        // PC: Ideal dataset -> 'Car' labeled objects = 1, others = '0'
-        // *(p + 4)
-        *(GTCarArray + i) = pointCloud[k];
-        *(GTCarArray + i + 1) = pointCloud[k + 1];
-        *(GTCarArray + i + 2) = pointCloud[k + 2];
-        *(GTCarArray + i + 3) = pointCloud[k + 4];
-
-        // PC: Zero intensity dataset -> all points have 0 intensity
-        // *(p + 5)
-        *(ZeroIntensityArray + i) = pointCloud[k];
-        *(ZeroIntensityArray + i + 1) = pointCloud[k + 1];
-        *(ZeroIntensityArray + i + 2) = pointCloud[k + 2];
-        *(ZeroIntensityArray + i + 3) = pointCloud[k + 5];
-
-
-        // PC: Relative velocity dataset -> all points have relative velocity
-        // *(p + 6)
-        *(RadialVelocityArray + i) = pointCloud[k];
-        *(RadialVelocityArray + i + 1) = pointCloud[k + 1];
-        *(RadialVelocityArray + i + 2) = pointCloud[k + 2];
-        *(RadialVelocityArray + i + 3) = pointCloud[k + 6];
-
-        // PC: absolute speed point cloud -> all points have the absolute speed.
-        // *(p + 7)
-        *(AbsSpeedArray + i) = pointCloud[k];
-        *(AbsSpeedArray + i + 1) = pointCloud[k + 1];
-        *(AbsSpeedArray + i + 2) = pointCloud[k + 2];
-        *(AbsSpeedArray + i + 3) = pointCloud[k + 7];
-
-        // PC: 'object is moving -> all moving object points have 1.0 Boolean value, others 0.0.
-        // *(p + 8)
-        *(MovingArray + i) = pointCloud[k];
-        *(MovingArray + i + 1) = pointCloud[k + 1];
-        *(MovingArray + i + 2) = pointCloud[k + 2];
-        *(MovingArray + i + 3) = pointCloud[k + 8];
-
-        // PC: Ideal dataset -> 'Pedestrian' labeled objects = 1, others = '0'
-        // *(p + 9)
-        *(GTPedArray + i) = pointCloud[k];
-        *(GTPedArray + i + 1) = pointCloud[k + 1];
-        *(GTPedArray + i + 2) = pointCloud[k + 2];
-        *(GTPedArray + i + 3) = pointCloud[k + 9];
-
-
-
-        i += 4; //Update according to output pointclouds dimensions
-        k += 10; //Update according to  lidar.GetPointClouds() dimensions (FLOATS_PER_POINT)
-    }
+    uint OUTPUT_POINTCLOUD_POINTS = VELODYNE_FLOATS_PER_POINT;
+
+    // One array per velodyne_* folder, from the frame buffer pool (sized for the LiDAR).
+    // The entity layout is the frame ring's point cloud record, so it is repacked straight into the slot.
+    uint32_t entityBytes = OUTPUT_POINTCLOUD_POINTS * sizeof(float) * pointCloudSize;
+    float* ringPoints = m_frameRing.inFrame() ? (float*)m_frameRing.reserveRecord(FRAME_RECORD_POINT_CLOUD, entityBytes) : NULL;
+    m_pFrameBuffers->repackPointCloud(pointCloud, pointCloudSize, ringPoints);
+    float* GTCarArray = m_pFrameBuffers->velodyne[VELODYNE_GT_CAR].data();
+    float* GTPedArray = m_pFrameBuffers->velodyne[VELODYNE_GT_PED].data();
+    float* EntityArray = ringPoints ? ringPoints : m_pFrameBuffers->velodyne[VELODYNE_ENTITY].data();
+    float* ZeroIntensityArray = m_pFrameBuffers->velodyne[VELODYNE_ZERO_INTENSITY].data();
+    float* RadialVelocityArray = m_pFrameBuffers->velodyne[VELODYNE_RADIAL_VELOCITY].data();
+    float* AbsSpeedArray = m_pFrameBuffers->velodyne[VELODYNE_ABS_SPEED].data();
+    float* MovingArray = m_pFrameBuffers->velodyne[VELODYNE_MOVING].data();
 
     /* -------------------------- OUTPUT FILES -------------------------------------------------------*/
 
@@ -1885,25 +1762,18 @@ void ObjectDetection::collectLiDAR() {
             ++i;
         }
         std::string str = oss.str();
-        fprintf(f, str.c_str());
+        fputs(str.c_str(), f);
         fclose(f);
     }
 
-    if (OUTPUT_DEPTH_STATS) {
+    if (OUTPUT_DEPTH_STATS && m_frameBudget.quality().debugOutputs) {
         lidar.printDepthStats();
     }
 }
 
-void ObjectDetection::setStencilBuffer() {
-    log("About to set stencil buffer");
-    int size = s_camParams.width * s_camParams.height;
-
-    std::ofstream ofile(m_stencilFilename, std::ios::binary);
-    ofile.write((char*)m_pStencil, size);
-    ofile.close();
-
-    std::vector<int> stencilValues;
-    log("After writing stencil buffer");
+//Per pixel part of setStencilBuffer. SEPARATE_STENCILS also collects the stencil values to output separately.
+template <bool SEPARATE_STENCILS>
+void ObjectDetection::fillStencilImage(std::vector<int> &stencilValues) {
     for (int j = 0; j < s_camParams.height; ++j) {
         for (int i = 0; i < s_camParams.width; ++i) {
             uint8_t val = m_pStencil[j * s_camParams.width + i];
@@ -1919,7 +1789,7 @@ void ObjectDetection::setStencilBuffer() {
                 *p = val;
             }
 
-            if (OUTPUT_SEPARATE_STENCILS) {
+            if (SEPARATE_STENCILS) {
                 bool newValue = true;
                 if (ONLY_OUTPUT_UNKNOWN_STENCILS && std::find(KNOWN_STENCIL_TYPES.begin(), KNOWN_STENCIL_TYPES.end(), val) != KNOWN_STENCIL_TYPES.end()) {
                     newValue = false;
@@ -1933,8 +1803,23 @@ void ObjectDetection::setStencilBuffer() {
             }
         }
     }
+}
+
+void ObjectDetection::setStencilBuffer() {
+    log("About to set stencil buffer");
+    int size = s_camParams.width * s_camParams.height;
+
+    std::ofstream ofile(m_stencilFilename, std::ios::binary);
+    ofile.write((char*)m_pStencil, size);
+    ofile.close();
+
+    std::vector<int> stencilValues;
+    log("After writing stencil buffer");
+    if (OUTPUT_SEPARATE_STENCILS) fillStencilImage<true>(stencilValues);
+    else fillStencilImage<false>(stencilValues);
 
-    if (OUTPUT_STENCIL_IMAGE) {
+    if (OUTPUT_STENCIL_IMAGE && m_frameBudget.quality().debugOutputs) {
+        BudgetScope budgetScope(m_frameBudget, BUDGET_STAGE_DEBUG);
         log("Before saving stencil image");
         std::vector<std::uint8_t> ImageBuffer;
         lodepng::encode(ImageBuffer, (unsigned char*)m_pStencilImage, s_camParams.width, s_camParams.height, LCT_GREY, 8);
@@ -1959,9 +1844,8 @@ void ObjectDetection::setStencilBuffer() {
                 }
             }
 
-            std::string filename = baseFolder + "stencilImage" + "\\";
-            CreateDirectory(filename.c_str(), NULL);
-            filename.append("\\");
+            std::string filename = withSeparator(baseFolder + "stencilImage");
+            makeDirectory(filename);
             filename.append(instance_string);
             filename.append("-");
             filename.append(std::to_string(s));
@@ -1971,9 +1855,7 @@ void ObjectDetection::setStencilBuffer() {
             lodepng::save_file(ImageBuffer, filename);
 
             if (ONLY_OUTPUT_UNKNOWN_STENCILS) {
-                std::ostringstream oss;
-                oss << "***************************************unknown stencil type: " << s << " at index: " << instance_index << " with count: " << count;
-                log(oss.str(), true);
+                LOG_RATE_LIMITED(LOG_LEVEL_WARN, 1, "***************************************unknown stencil type: " << s << " at index: " << instance_index << " with count: " << count);
             }
         }
     }
@@ -1988,6 +1870,59 @@ void ObjectDetection::setStencilBuffer() {
     }
 }
 
+//Per pixel part of setDepthBuffer: ground pixel image (GROUND_PIXELS) and depth map point cloud/image (DM_POINTCLOUD)
+//Returns the number of depth map points
+template <bool GROUND_PIXELS, bool DM_POINTCLOUD>
+int ObjectDetection::fillDepthOutputs(int &nonzero) {
+    int pointCount = 0;
+    for (int j = 0; j < s_camParams.height; ++j) {
+        for (int i = 0; i < s_camParams.width; ++i) {
+            float ndc = m_pDepth[j * s_camParams.width + i];
+            if (ndc != 0) {
+                ++nonzero;
+            }
+            Vector3 relPos = depthToCamCoords(ndc, i, j);
+
+            if (GROUND_PIXELS) {
+                int s = m_pStencil[j * s_camParams.width + i];
+                bool groundPoint;
+                if (s == STENCIL_TYPE_SKY || s == STENCIL_TYPE_NPC || s == STENCIL_TYPE_OWNCAR ||
+                    s == STENCIL_TYPE_VEGETATION || s == STENCIL_TYPE_VEHICLE || s == STENCIL_TYPE_SELF) {
+                    groundPoint = false;
+                }
+                else {
+                    Vector3 worldPos = camToWorld(relPos, m_camForwardVector, m_camRightVector, m_camUpVector);
+                    float groundZ;
+                    //Note should always do +2 to ensure it hits the proper ground point
+                    m_world->getGroundZFor3dCoord(worldPos.x, worldPos.y, worldPos.z + 2, &(groundZ), 0);
+                    groundPoint = (worldPos.z - groundZ) < GROUND_POINT_MAX_DIST;
+                }
+                uint8_t pointVal = groundPoint ? 255 : 0;
+                m_pGroundPointsImage[j * s_camParams.width + i] = pointVal;
+            }
+
+            if (DM_POINTCLOUD) {
+                float distance = sqrt(vdist2(0, 0, 0, relPos.x, relPos.y, relPos.z));
+                if ((OUTPUT_FULL_DM_POINTCLOUD || distance <= MAX_LIDAR_DIST) && distance >= s_camParams.nearClip) {
+                    float* p = m_pDMPointClouds + (pointCount * 4);
+                    *p = relPos.y;
+                    *(p + 1) = -relPos.x;
+                    *(p + 2) = relPos.z;
+                    *(p + 3) = 0;
+                    pointCount++;
+                }
+
+                uint16_t* p = m_pDMImage + (j * s_camParams.width) + i;
+                float distClipped = 1 - std::min<float>(1.0f, (distance - s_camParams.nearClip) / (s_camParams.farClip - s_camParams.nearClip));
+                uint16_t num = (uint16_t)floor(distClipped * 65535);
+                uint16_t swapped = (num >> 8) | (num << 8);
+                *p = swapped;
+            }
+        }
+    }
+    return pointCount;
+}
+
 void ObjectDetection::setDepthBuffer(bool prevDepth) {
     int size = s_camParams.width * s_camParams.height;
     log("About to set depth buffer");
@@ -2001,60 +1936,24 @@ void ObjectDetection::setDepthBuffer(bool prevDepth) {
         depthPCFilename = m_depthPCFilenameU;
     }
 
-    std::ofstream ofile(m_depthFilename, std::ios::binary);
-    ofile.write((char*)m_pDepth, size * sizeof(float));
-    ofile.close();
+    if (COMPRESS_DEPTH_BUFFER) {
+        writeCompressedDepth();
+    }
+    else {
+        std::ofstream ofile(m_depthFilename, std::ios::binary);
+        ofile.write((char*)m_pDepth, size * sizeof(float));
+        ofile.close();
+    }
 
     int nonzero = 0;
-    if (OUTPUT_DM_POINTCLOUD || OUTPUT_GROUND_PIXELS) {
-        int pointCount = 0;
+    if ((OUTPUT_DM_POINTCLOUD || OUTPUT_GROUND_PIXELS) && m_frameBudget.quality().debugOutputs) {
+        BudgetScope budgetScope(m_frameBudget, BUDGET_STAGE_DEBUG);
         float maxDepth = 0;
         float minDepth = 1;
-        for (int j = 0; j < s_camParams.height; ++j) {
-            for (int i = 0; i < s_camParams.width; ++i) {
-                float ndc = m_pDepth[j * s_camParams.width + i];
-                if (ndc != 0) {
-                    ++nonzero;
-                }
-                Vector3 relPos = depthToCamCoords(ndc, i, j);
-
-                if (OUTPUT_GROUND_PIXELS) {
-                    int s = m_pStencil[j * s_camParams.width + i];
-                    bool groundPoint;
-                    if (s == STENCIL_TYPE_SKY || s == STENCIL_TYPE_NPC || s == STENCIL_TYPE_OWNCAR ||
-                        s == STENCIL_TYPE_VEGETATION || s == STENCIL_TYPE_VEHICLE || s == STENCIL_TYPE_SELF) {
-                        groundPoint = false;
-                    }
-                    else {
-                        Vector3 worldPos = camToWorld(relPos, m_camForwardVector, m_camRightVector, m_camUpVector);
-                        float groundZ;
-                        //Note should always do +2 to ensure it hits the proper ground point
-                        GAMEPLAY::GET_GROUND_Z_FOR_3D_COORD(worldPos.x, worldPos.y, worldPos.z + 2, &(groundZ), 0);
-                        groundPoint = (worldPos.z - groundZ) < GROUND_POINT_MAX_DIST;
-                    }
-                    uint8_t pointVal = groundPoint ? 255 : 0;
-                    m_pGroundPointsImage[j * s_camParams.width + i] = pointVal;
-                }
-
-                if (OUTPUT_DM_POINTCLOUD) {
-                    float distance = sqrt(SYSTEM::VDIST2(0, 0, 0, relPos.x, relPos.y, relPos.z));
-                    if ((OUTPUT_FULL_DM_POINTCLOUD || distance <= MAX_LIDAR_DIST) && distance >= s_camParams.nearClip) {
-                        float* p = m_pDMPointClouds + (pointCount * 4);
-                        *p = relPos.y;
-                        *(p + 1) = -relPos.x;
-                        *(p + 2) = relPos.z;
-                        *(p + 3) = 0;
-                        pointCount++;
-                    }
-
-                    uint16_t* p = m_pDMImage + (j * s_camParams.width) + i;
-                    float distClipped = 1 - std::min<float>(1.0f, (distance - s_camParams.nearClip) / (s_camParams.farClip - s_camParams.nearClip));
-                    uint16_t num = (uint16_t)floor(distClipped * 65535);
-                    uint16_t swapped = (num >> 8) | (num << 8);
-                    *p = swapped;
-                }
-            }
-        }
+        int pointCount;
+        if (OUTPUT_GROUND_PIXELS && OUTPUT_DM_POINTCLOUD) pointCount = fillDepthOutputs<true, true>(nonzero);
+        else if (OUTPUT_GROUND_PIXELS) pointCount = fillDepthOutputs<true, false>(nonzero);
+        else pointCount = fillDepthOutputs<false, true>(nonzero);
 
         if (OUTPUT_GROUND_PIXELS) {
             std::vector<std::uint8_t> ImageBuffer;
@@ -2063,12 +1962,9 @@ void ObjectDetection::setDepthBuffer(bool prevDepth) {
         }
         
         if (OUTPUT_DM_POINTCLOUD) {
-            std::ostringstream oss;
-            oss << "Min depth: " << minDepth << " max: " << maxDepth << " pointCount: " << pointCount <<
+            LOG_DEBUG("Min depth: " << minDepth << " max: " << maxDepth << " pointCount: " << pointCount <<
                 " height: " << s_camParams.height << " width: " << s_camParams.width << " size: " << size <<
-                "\n Nonzero depth values: " << nonzero;
-            std::string str = oss.str();
-            log(str);
+                "\n Nonzero depth values: " << nonzero);
 
             std::ofstream ofile1(depthPCFilename, std::ios::binary);
             ofile1.write((char*)m_pDMPointClouds, FLOATS_PER_POINT * sizeof(float) * pointCount);
@@ -2083,36 +1979,46 @@ void ObjectDetection::setDepthBuffer(bool prevDepth) {
     }
 }
 
-//ndc is Normalized Device Coordinates which is value received from depth buffer
-Vector3 ObjectDetection::depthToCamCoords(float ndc, float screenX, float screenY) {
-    float normScreenX = 2 * screenX / float(s_camParams.width - 1) - 1.0f;
-    float normScreenY = 2 * screenY / float(s_camParams.height - 1) - 1.0f;
-
-    float ncX = normScreenX * s_camParams.ncWidth / 2;
-    float ncY = normScreenY * s_camParams.ncHeight / 2;
-
-    //Distance to near clip (hypotenus)
-    float d2nc = sqrt(s_camParams.nearClip * s_camParams.nearClip + ncX * ncX + ncY * ncY);
-    float depth = d2nc / ndc;
-    if (ndc <= 0 || depth > s_camParams.farClip) {
-        depth = s_camParams.farClip;
+void ObjectDetection::writeCompressedDepth() {
+    std::vector<uint8_t> compressed;
+    DepthCompressionStats stats;
+    if (!compressDepthBuffer(m_pDepth, s_camParams.width, s_camParams.height, compressed,
+                             LOSSY_DEPTH_COMPRESSION, LOSSY_DEPTH_MAX_ERROR, LOSSY_DEPTH_REF_DIST, &stats)) {
+        log("Depth buffer compression failed", true);
+        return;
     }
 
-    float depthDivisor = (s_camParams.nearClip * depth) / (2 * s_camParams.farClip);
-    depth = depth / (1 + depthDivisor);
+    std::ofstream ofile(m_depthFilename, std::ios::binary);
+    ofile.write((char*)compressed.data(), compressed.size());
+    ofile.close();
 
-    //X is right, Y is forward, Z is up (GTA coordinate frame)
-    Vector3 unitVec;
-    unitVec.x = ncX / d2nc;
-    unitVec.y = s_camParams.nearClip / d2nc;
-    unitVec.z = -ncY / d2nc;
+    if (OUTPUT_DEPTH_COMPRESSION_STATS) {
+        //Decode again to time the replay path and make sure lossless output is exact
+        std::vector<float> decoded;
+        int width, height;
+        auto start = std::chrono::high_resolution_clock::now();
+        bool decodedOk = decompressDepthBuffer(compressed.data(), compressed.size(), decoded, width, height);
+        stats.decodeMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
 
-    Vector3 relPos;
-    relPos.x = unitVec.x * depth;
-    relPos.y = unitVec.y * depth;
-    relPos.z = unitVec.z * depth;
+        if (!decodedOk || (stats.bits == 32 && memcmp(decoded.data(), m_pDepth, stats.rawBytes) != 0)) {
+            LOG_INFO("***Depth buffer did not decode to the original at index: " << instance_index);
+        }
 
-    return relPos;
+        FILE* f = fopen(m_depthCompressionFile.c_str(), "a");
+        std::ostringstream oss;
+        oss << stats.rawBytes << " " << stats.compressedBytes << " " << stats.ratio() << " " << stats.bits << " " <<
+            stats.encodeMs << " " << stats.decodeMs << " " << instance_index;
+        if (collectTracking) {
+            oss << " " << series_index;
+        }
+        oss << "\n";
+        fputs(oss.str().c_str(), f);
+        fclose(f);
+    }
+}
+
+Vector3 ObjectDetection::depthToCamCoords(float ndc, float screenX, float screenY) {
+    return ::depthToCamCoords(s_camParams, ndc, screenX, screenY);
 }
 
 void ObjectDetection::increaseIndex() {
@@ -2129,17 +2035,17 @@ void ObjectDetection::increaseIndex() {
         ++series_index;
         trSeriesGap = true;
         trackFirstFrame.clear();
-
-        //update the string
-        char temp[] = "%04d";
-        char strComp[sizeof temp + 100];
-        sprintf(strComp, temp, series_index);
-        series_string = strComp;
+        //Track IDs restart with the series
+        m_trackExporters.clear();
     }
+    updateIndexStrings();
+}
 
-    char temp[] = "%06d";
-    char strComp[sizeof temp + 100];
-    sprintf(strComp, temp, instance_index);
+void ObjectDetection::updateIndexStrings() {
+    char strComp[32];
+    sprintf(strComp, "%04d", series_index);
+    series_string = strComp;
+    sprintf(strComp, "%06d", instance_index);
     instance_string = strComp;
 }
 
@@ -2150,7 +2056,7 @@ void ObjectDetection::setIndex() {
 
 //Camera intrinsics are focal length, and center in horizontal (x) and vertical (y)
 void ObjectDetection::calcCameraIntrinsics() {
-    float f = s_camParams.width / (2 * tan(HOR_CAM_FOV * PI / 360));
+    float f = focalLength(s_camParams.width);
     float cx = s_camParams.width / 2;
     float cy = s_camParams.height / 2;
 
@@ -2159,10 +2065,7 @@ void ObjectDetection::calcCameraIntrinsics() {
     intrinsics[2] = cy;
 
     if (DEBUG_LOGGING) {
-        std::ostringstream oss;
-        oss << "Focal length is: " << f;
-        std::string str = oss.str();
-        log(str);
+        LOG_DEBUG("Focal length is: " << f);
     }
 
     m_curFrame.focalLen = f;
@@ -2173,9 +2076,10 @@ void ObjectDetection::setFocalLength() {
     m_curFrame.focalLen = intrinsics[0];
 }
 
-std::string ObjectDetection::getStandardFilename(std::string subDir, std::string extension) {
+//Output directory of subDir (inside the perspective's directory for secondary perspectives), ends with a separator
+std::string ObjectDetection::getOutputDir(std::string subDir) {
     std::string filename = baseFolder;
-    CreateDirectory(filename.c_str(), NULL);
+    makeDirectory(filename);
 
     if (m_vPerspective != -1) {
         char temp[] = "%07d";
@@ -2183,22 +2087,24 @@ std::string ObjectDetection::getStandardFilename(std::string subDir, std::string
         sprintf(strComp, temp, m_vPerspective);
         std::string entityStr = strComp;
 
-        filename.append("alt_perspective");
-        filename.append("\\");
-        CreateDirectory(filename.c_str(), NULL);
-        filename.append(entityStr);
-        filename.append("\\");
-        CreateDirectory(filename.c_str(), NULL);
+        filename = withSeparator(filename + "alt_perspective");
+        makeDirectory(filename);
+        filename = withSeparator(filename + entityStr);
+        makeDirectory(filename);
     }
 
-    filename.append(subDir);
-    filename.append("\\");
-    CreateDirectory(filename.c_str(), NULL);
+    filename = withSeparator(filename + subDir);
+    makeDirectory(filename);
+    return filename;
+}
+
+std::string ObjectDetection::getStandardFilename(std::string subDir, std::string extension) {
+    std::string filename = getOutputDir(subDir);
     if (collectTracking) {
         filename.append(series_string);
-        CreateDirectory(filename.c_str(), NULL);
+        makeDirectory(filename);
+        filename += PATH_SEPARATOR;
     }
-    filename.append("\\");
     filename.append(instance_string);
     filename.append(extension);
     return filename;
@@ -2217,7 +2123,7 @@ void ObjectDetection::outputRealSpeed() {
         std::ostringstream oss;
         oss << m_trackDistErrorTotal << " " << m_trackDistErrorTotalVar << " " << avgSpeed << " " << avgDist;
         std::string str = oss.str();
-        fprintf(f, str.c_str());
+        fputs(str.c_str(), f);
         fprintf(f, "\n");
         fclose(f);
 
@@ -2234,7 +2140,7 @@ void ObjectDetection::outputRealSpeed() {
     if (instance_index == 0) {
         m_trackLastPos = s_camParams.pos;
         m_trackLastIndex = instance_index;
-        m_trackLastRealSpeed = ENTITY::GET_ENTITY_SPEED(m_vehicle) / 10;
+        m_trackLastRealSpeed = m_world->getEntitySpeed(m_vehicle) / 10;
         return;
     }
 
@@ -2257,15 +2163,15 @@ void ObjectDetection::outputRealSpeed() {
 
     //Update values
     //Average of speed at last frame and current frame
-    m_trackRealSpeed += (ENTITY::GET_ENTITY_SPEED(m_vehicle) / 10 + m_trackLastRealSpeed) / 2;
-    m_trackDist += sqrt(SYSTEM::VDIST2(s_camParams.pos.x, s_camParams.pos.y, s_camParams.pos.z, m_trackLastPos.x, m_trackLastPos.y, m_trackLastPos.z));
+    m_trackRealSpeed += (m_world->getEntitySpeed(m_vehicle) / 10 + m_trackLastRealSpeed) / 2;
+    m_trackDist += sqrt(vdist2(s_camParams.pos.x, s_camParams.pos.y, s_camParams.pos.z, m_trackLastPos.x, m_trackLastPos.y, m_trackLastPos.z));
     m_trackDistErrorTotal += m_trackDist - m_trackRealSpeed;
     m_trackDistErrorTotalVar += pow((m_trackDist - m_trackRealSpeed), 2);
     m_trackDistErrorTotalCount++;
 
     m_trackLastPos = s_camParams.pos;
     m_trackLastIndex = instance_index;
-    m_trackLastRealSpeed = ENTITY::GET_ENTITY_SPEED(m_vehicle) / 10;
+    m_trackLastRealSpeed = m_world->getEntitySpeed(m_vehicle) / 10;
 }
 
 void ObjectDetection::setCamParams(float* forwardVec, float* rightVec, float* upVec) {
@@ -2275,11 +2181,11 @@ void ObjectDetection::setCamParams(float* forwardVec, float* rightVec, float* up
         s_camParams.farClip = 10001.5;// 800;// CAM::_0xDFC8CBC606FDB0FC(); //CAM::GET_CAM_FAR_CLIP(camera);
         s_camParams.fov = 59;// CAM::GET_GAMEPLAY_CAM_FOV();//CAM::GET_CAM_FOV(camera);
         s_camParams.ncHeight = 2 * s_camParams.nearClip * tan(s_camParams.fov / 2. * (PI / 180.)); // field of view is returned vertically
-        s_camParams.ncWidth = s_camParams.ncHeight * GRAPHICS::_GET_SCREEN_ASPECT_RATIO(false);
+        s_camParams.ncWidth = s_camParams.ncHeight * m_world->getScreenAspectRatio(false);
         s_camParams.init = true;
     }
 
-    ENTITY::GET_ENTITY_MATRIX(m_vehicle, &m_camForwardVector, &m_camRightVector, &m_camUpVector, &s_camParams.pos);
+    m_world->getEntityMatrix(m_vehicle, &m_camForwardVector, &m_camRightVector, &m_camUpVector, &s_camParams.pos);
 
     if (forwardVec) {
         m_camForwardVector.x = forwardVec[0];
@@ -2296,14 +2202,14 @@ void ObjectDetection::setCamParams(float* forwardVec, float* rightVec, float* up
         }
     }
     else {
-        ENTITY::GET_ENTITY_MATRIX(m_vehicle, &m_camForwardVector, &m_camRightVector, &m_camUpVector, &currentPos);
+        m_world->getEntityMatrix(m_vehicle, &m_camForwardVector, &m_camRightVector, &m_camUpVector, &currentPos);
     }
 
     //These values change frame to frame
     //Camera functions do not work in eve. Need to use vehicle and offsets.
     //Recordings need to always have the camera aligned with the vehicle for export to be aligned properly.
     if (!m_eve) {
-        s_camParams.theta = ENTITY::GET_ENTITY_ROTATION(m_vehicle, 0); //CAM::GET_GAMEPLAY_CAM_ROT(0); //CAM::GET_CAM_ROT(camera, 0);
+        s_camParams.theta = m_world->getEntityRotation(m_vehicle, 0); //CAM::GET_GAMEPLAY_CAM_ROT(0); //CAM::GET_CAM_ROT(camera, 0);
     }
     //s_camParams.pos = currentPos;// CAM::GET_GAMEPLAY_CAM_COORD();// CAM::GET_CAM_COORD(camera);
     //Use vehicleForwardVector since it corresponds to vehicle forwardVector
@@ -2311,32 +2217,26 @@ void ObjectDetection::setCamParams(float* forwardVec, float* rightVec, float* up
     s_camParams.pos.y = s_camParams.pos.y + CAM_OFFSET_FORWARD * vehicleForwardVector.y + CAM_OFFSET_UP * vehicleUpVector.y;
     s_camParams.pos.z = s_camParams.pos.z + CAM_OFFSET_FORWARD * vehicleForwardVector.z + CAM_OFFSET_UP * vehicleUpVector.z;
 
-    Vector3 theta = CAM::GET_CAM_ROT(camera, 0);
-    Vector3 pos1 = CAM::GET_CAM_COORD(camera);
-    Vector3 rotation = ENTITY::GET_ENTITY_ROTATION(m_vehicle, 0);
-
-    //For optimizing 3d to 2d and unit vector to 2d calculations
-    s_camParams.eigenPos = Eigen::Vector3f(s_camParams.pos.x, s_camParams.pos.y, s_camParams.pos.z);
-    s_camParams.eigenRot = Eigen::Vector3f(s_camParams.theta.x, s_camParams.theta.y, s_camParams.theta.z);
-    s_camParams.eigenTheta = (PI / 180.0) * s_camParams.eigenRot;
-    s_camParams.eigenCamDir = rotate(WORLD_NORTH, s_camParams.eigenTheta);
-    s_camParams.eigenCamUp = rotate(WORLD_UP, s_camParams.eigenTheta);
-    s_camParams.eigenCamEast = rotate(WORLD_EAST, s_camParams.eigenTheta);
-    s_camParams.eigenClipPlaneCenter = s_camParams.eigenPos + s_camParams.nearClip * s_camParams.eigenCamDir;
-    s_camParams.eigenCameraCenter = -s_camParams.nearClip * s_camParams.eigenCamDir;
+    updateCamEigen();
 
-    std::ostringstream oss1;
-    oss1 << "\ns_camParams.pos X: " << s_camParams.pos.x << " Y: " << s_camParams.pos.y << " Z: " << s_camParams.pos.z <<
+    //The rendering camera and vehicle rotation are only queried when debug logging is on
+    if (!s_logger.enabled(LOG_LEVEL_DEBUG)) return;
+    Vector3 theta = m_world->getCamRot(camera, 0);
+    Vector3 pos1 = m_world->getCamCoord(camera);
+    Vector3 rotation = m_world->getEntityRotation(m_vehicle, 0);
+    LOG_DEBUG("\ns_camParams.pos X: " << s_camParams.pos.x << " Y: " << s_camParams.pos.y << " Z: " << s_camParams.pos.z <<
         "\nvehicle.pos X: " << currentPos.x << " Y: " << currentPos.y << " Z: " << currentPos.z <<
         "\npos1 - rendering cam X: " << pos1.x << " Y: " << pos1.y << " Z: " << pos1.z <<
         "\nfar: " << s_camParams.farClip << " nearClip: " << s_camParams.nearClip << " fov: " << s_camParams.fov <<
         "\nrotation gameplay: " << s_camParams.theta.x << " Y: " << s_camParams.theta.y << " Z: " << s_camParams.theta.z <<
         "\nrotation rendering: " << theta.x << " Y: " << theta.y << " Z: " << theta.z <<
         "\nrotation vehicle: " << rotation.x << " Y: " << rotation.y << " Z: " << rotation.z <<
-        "\n AspectRatio: " << GRAPHICS::_GET_SCREEN_ASPECT_RATIO(false) <<
-        "\nforwardVector: " << vehicleForwardVector.x << " Y: " << vehicleForwardVector.y << " Z: " << vehicleForwardVector.z;
-    std::string str1 = oss1.str();
-    log(str1);
+        "\n AspectRatio: " << m_world->getScreenAspectRatio(false) <<
+        "\nforwardVector: " << vehicleForwardVector.x << " Y: " << vehicleForwardVector.y << " Z: " << vehicleForwardVector.z);
+}
+
+void ObjectDetection::updateCamEigen() {
+    ::updateCamEigen(s_camParams);
 }
 
 void ObjectDetection::printSegImage() {
@@ -2371,7 +2271,7 @@ void ObjectDetection::printSegImage() {
         oss << " " << series_index;
     }
     std::string str = oss.str();
-    fprintf(f, str.c_str());
+    fputs(str.c_str(), f);
     fprintf(f, "\n");
     fclose(f);
 
@@ -2379,162 +2279,162 @@ void ObjectDetection::printSegImage() {
     lodepng::encode(ImageBuffer, (unsigned char*)m_pStencilSeg, s_camParams.width, s_camParams.height, LCT_RGB, 8);
     lodepng::save_file(ImageBuffer, m_segImgFilename);
 
-    //Print instance segmented image
-    cv::Mat tempMat(cv::Size(s_camParams.width, s_camParams.height), CV_32SC1, m_pInstanceSeg);
-    imwrite(m_instSegFilename, tempMat);
-    tempMat.release();
-
-
-    //Create and print out instance seg image in colour for visualization
-    for (int j = 0; j < s_camParams.height; ++j) {
-        for (int i = 0; i < s_camParams.width; ++i) {
-            //RGB image is 3 bytes per pixel
-            int idx = j * s_camParams.width + i;
-            int segIdx = 3 * idx;
-            int entityID = m_pInstanceSeg[idx];
+    //Per-entity masks collected in addPointToSegImages
+    if (INSTANCE_MASK_FORMAT != INSTANCE_MASK_NONE) {
+        std::string masks = m_instanceMasks.toJson(INSTANCE_MASK_FORMAT, m_pInstanceSeg, instance_index);
+        FILE* fMasks = fopen(m_instSegMasksFilename.c_str(), "w");
+        fputs(masks.c_str(), fMasks);
+        fclose(fMasks);
+    }
 
-            int newVal = 47 * entityID; //Just to produce unique but different colours
-            int red = (newVal + 13 * entityID) % 255;
-            int green = (newVal / 255) % 255;
-            int blue = newVal % 255;
-            uint8_t* p = m_pInstanceSegImg + segIdx;
-            *p = red;
-            *(p + 1) = green;
-            *(p + 2) = blue;
+    //Print instance segmented image
+    //8 bit greyscale with the entity IDs saturated at 255 (as the OpenCV writer did)
+    if (OUTPUT_INSTANCE_SEG_PNG) {
+        std::vector<uint8_t> grey(s_camParams.width * s_camParams.height);
+        for (size_t idx = 0; idx < grey.size(); ++idx) {
+            grey[idx] = (uint8_t)std::min(std::max((int)m_pInstanceSeg[idx], 0), 255);
         }
+        std::vector<std::uint8_t> pngBuffer;
+        lodepng::encode(pngBuffer, grey.data(), s_camParams.width, s_camParams.height, LCT_GREY, 8);
+        lodepng::save_file(pngBuffer, m_instSegFilename);
     }
 
-    cv::Mat colorImg(cv::Size(s_camParams.width, s_camParams.height), CV_8UC3, m_pInstanceSegImg);
-    log("About to print seg image3", true);
-    imwrite(m_instSegImgFilename, colorImg);
-    colorImg.release();
+    //Create and print out instance seg image in colour for visualization
+    if (OUTPUT_INSTANCE_SEG_IMAGE && m_frameBudget.quality().debugOutputs) {
+        BudgetScope budgetScope(m_frameBudget, BUDGET_STAGE_DEBUG);
+        for (int j = 0; j < s_camParams.height; ++j) {
+            for (int i = 0; i < s_camParams.width; ++i) {
+                //RGB image is 3 bytes per pixel
+                int idx = j * s_camParams.width + i;
+                int segIdx = 3 * idx;
+                int entityID = m_pInstanceSeg[idx];
+
+                int newVal = 47 * entityID; //Just to produce unique but different colours
+                int red = (newVal + 13 * entityID) % 255;
+                int green = (newVal / 255) % 255;
+                int blue = newVal % 255;
+                //Same file as the BGR OpenCV writer produced
+                uint8_t* p = m_pInstanceSegImg + segIdx;
+                *p = blue;
+                *(p + 1) = green;
+                *(p + 2) = red;
+            }
+        }
 
-    //Clear all maps and seg image arrays
-    memset(m_pStencilSeg, 0, m_stencilSegLength);
-    memset(m_pInstanceSeg, 0, m_instanceSegLength);
-    memset(m_pInstanceSegImg, 0, m_instanceSegImgLength);
+        log("About to print seg image3", true);
+        std::vector<std::uint8_t> pngBuffer;
+        lodepng::encode(pngBuffer, m_pInstanceSegImg, s_camParams.width, s_camParams.height, LCT_RGB, 8);
+        lodepng::save_file(pngBuffer, m_instSegImgFilename);
+    }
 }
 
 void ObjectDetection::initVehicleLookup() {
-    if (!m_vLookupInit) {
-        std::string translationFile = std::string(getenv("DEEPGTAV_DIR")) + "\\ObjectDet\\vehicle_labels.csv";
-        std::ifstream inFile(translationFile);
-        std::string line;
-        log("Translation file:", true);
-        log(translationFile, true);
-        while (std::getline(inFile, line)) // read whole line into line
-        {
-            std::istringstream iss(line); // string stream
-            std::string model;
-            std::string vehicleType;
-            std::getline(iss, model, ','); // read first part up to comma, ignore the comma
-            std::string before = model;
-            model.erase(remove_if(model.begin(), model.end(), [](char c) { return !isalpha(c); }), model.end());
-            iss >> vehicleType; // read the second part
-            m_vLookup.insert(std::pair< std::string, std::string>(model, vehicleType));
-
-            //Modelstrings seem to be missing last few letters on occasion (this should fix that)
-            if (model.size() >= 2) {
-                model = model.substr(0, model.size() - 1);
-                m_vLookup.insert(std::pair< std::string, std::string>(model, vehicleType));
-            }
-            if (model.size() >= 2) {
-                model = model.substr(0, model.size() - 1);
-                m_vLookup.insert(std::pair< std::string, std::string>(model, vehicleType));
-            }
-            if (model.size() >= 2) {
-                model = model.substr(0, model.size() - 1);
-                m_vLookup.insert(std::pair< std::string, std::string>(model, vehicleType));
-            }
-        }
-        m_vLookupInit = true;
-    }
+    //The vehicle type table is compiled in (VehicleTypeTable.h), only the optional override file is read
+    const char* dir = getenv("DEEPGTAV_DIR");
+    if (dir) s_modelCache.loadOverrides(withSeparator(dir) + "ObjectDet" + PATH_SEPARATOR + "vehicle_labels_override.csv");
 }
 
 void ObjectDetection::outputOcclusion() {
     if (OUTPUT_OCCLUSION_IMAGE) {
-        std::vector<std::uint8_t> ImageBuffer;
-        lodepng::encode(ImageBuffer, (unsigned char*)m_pOcclusionImage, s_camParams.width, s_camParams.height, LCT_GREY, 8);
-        lodepng::save_file(ImageBuffer, m_occImgFilename);
-        memset(m_pOcclusionImage, 0, s_camParams.width * s_camParams.height);
+        if (m_frameBudget.quality().debugOutputs) {
+            BudgetScope budgetScope(m_frameBudget, BUDGET_STAGE_DEBUG);
+            std::vector<std::uint8_t> ImageBuffer;
+            lodepng::encode(ImageBuffer, (unsigned char*)m_pOcclusionImage, s_camParams.width, s_camParams.height, LCT_GREY, 8);
+            lodepng::save_file(ImageBuffer, m_occImgFilename);
+        }
     }
 }
 
 void ObjectDetection::outputUnusedStencilPixels() {
     if (OUTPUT_UNUSED_PIXELS_IMAGE) {
-        std::vector<std::uint8_t> ImageBuffer;
-        lodepng::encode(ImageBuffer, (unsigned char*)m_pUnusedStencilImage, s_camParams.width, s_camParams.height, LCT_GREY, 8);
-        lodepng::save_file(ImageBuffer, m_unusedPixelsFilename);
-        memset(m_pUnusedStencilImage, 0, s_camParams.width * s_camParams.height);
+        if (m_frameBudget.quality().debugOutputs) {
+            BudgetScope budgetScope(m_frameBudget, BUDGET_STAGE_DEBUG);
+            std::vector<std::uint8_t> ImageBuffer;
+            lodepng::encode(ImageBuffer, (unsigned char*)m_pUnusedStencilImage, s_camParams.width, s_camParams.height, LCT_GREY, 8);
+            lodepng::save_file(ImageBuffer, m_unusedPixelsFilename);
+        }
     }
 }
 
-void ObjectDetection::exportEntity(ObjEntity e, std::ostringstream& oss, bool unprocessed, bool augmented,
-                                    bool checkbbox2d, const int &maxDist, const int &min2DPoints, const int &min3DPoints) {
-    //Skip peds in vehicles except for augmented labels (since they can be specified as peds in vehicles)
-    if (e.isPedInV && !augmented) {
-        return;
-    }
-
-    BBox2D b = e.bbox2d;
-    if (unprocessed) b = e.bbox2dUnprocessed;
-
-    if (checkbbox2d) {
-        if ((int)b.left >= s_camParams.width || (int)b.right == 0 || (int)b.bottom == 0 || (int)b.top >= s_camParams.height) return;
-        if ((int)b.left == (int)b.right || (int)b.top == (int)b.bottom) return;
-    }
+bool ObjectDetection::bbox2DInImage(const BBox2D &b) {
+    if ((int)b.left >= s_camParams.width || (int)b.right == 0 || (int)b.bottom == 0 || (int)b.top >= s_camParams.height) return false;
+    if ((int)b.left == (int)b.right || (int)b.top == (int)b.bottom) return false;
+    return true;
+}
 
+bool ObjectDetection::entityPassesLabelFilters(const ObjEntity &e, const int &maxDist, const int &min2DPoints) {
     if (maxDist != -1) {
-        if (e.distance > float(maxDist)) return;
+        if (e.distance > float(maxDist)) return false;
 
         //HAS_ENTITY_CLEAR_LOS_TO_ENTITY is from vehicle, NOT camera perspective
         //pointsHit misses some objects
         //hasLOSToEntity retrieves from camera perspective however 3D bboxes are larger than object
-        if (ENTITY::IS_ENTITY_OCCLUDED(e.entityID) &&
-            !ENTITY::HAS_ENTITY_CLEAR_LOS_TO_ENTITY(m_vehicle, e.entityID, 19) &&
+        if (m_world->isEntityOccluded(e.entityID) &&
+            !m_world->hasEntityClearLosToEntity(m_vehicle, e.entityID, 19) &&
             e.pointsHit3D <= 0) {
             log("Occluded and no points.", true);
 
             Vector3 upVector, rightVector, forwardVector, position; //Vehicle position
-            ENTITY::GET_ENTITY_MATRIX(e.entityID, &forwardVector, &rightVector, &upVector, &position);
+            m_world->getEntityMatrix(e.entityID, &forwardVector, &rightVector, &upVector, &position);
             if (!hasLOSToEntity(e.entityID, e.location, e.dim, forwardVector, rightVector, upVector)) {
                 log("Occluded and no points2.", true);
-                return;
+                return false;
             }
         }
     }
     if (min2DPoints != -1) {
         if (e.pointsHit2D < min2DPoints) {
             log("pointsHit2D failed.", true);
-            return;
+            return false;
         }
     }
+    return true;
+}
 
-    oss << e.objType << " " << e.truncation << " " << e.occlusion << " " << e.alpha << " " <<
-        (int)b.left << " " << (int)b.top << " " <<
-        (int)b.right << " " << (int)b.bottom << " " <<
-        e.height << " " << e.width << " " << e.length << " " <<
-        e.location.x << " " << e.location.y << " " << e.location.z << " " <<
-        e.rotation_y;
+//Writes label_2, labelsUnprocessed and label_aug_2 lines in one pass over the entities
+void ObjectDetection::exportEntities(const EntityTableView &entities) {
+    if (!entities.table) return;
+    const EntityTable &table = *entities.table;
 
-    if (augmented) {
-        int vPedIsIn = e.isPedInV ? e.vPedIsIn : 0;
-        oss << " " << e.entityID << " " << e.pointsHit2D << " " << e.pointsHit3D << " " << e.speed << " "
-            << e.roll << " " << e.pitch << " " << e.modelString << " " << vPedIsIn << " " << e.entity_velocity_vector.x << " " << e.entity_velocity_vector.y 
-            << " " << e.entity_velocity_vector.z << " " << e.own_vehicle_velocity_vector.x << " " << e.own_vehicle_velocity_vector.y << " " 
-            << e.own_vehicle_velocity_vector.z  << " " << e.entity_world_coordinates.x << " " << e.entity_world_coordinates.y << " "
-            << e.entity_world_coordinates.z << " " << e.player_world_coordinates.x << " " << e.player_world_coordinates.y << " " << e.player_world_coordinates.z 
-            << " " << e.entity_velocity_vector_camcoords.x << " " << e.entity_velocity_vector_camcoords.y << " " << e.entity_velocity_vector_camcoords.z
-            << " " << e.own_vehicle_velocity_vector_camcoords.x << " " << e.own_vehicle_velocity_vector_camcoords.y << " " << e.own_vehicle_velocity_vector_camcoords.z;
+    //Labels stay in entity ID order (tables are in the order the game lists entities)
+    m_exportOrder.clear();
+    for (int slot = 0; slot < table.size(); ++slot) {
+        m_exportOrder.push_back(slot);
     }
-    oss << "\n";
-}
+    std::sort(m_exportOrder.begin(), m_exportOrder.end(), [&table](int a, int b) { return table.ids[a] < table.ids[b]; });
 
-void ObjectDetection::exportEntities(EntityMap entMap, std::ostringstream& oss, bool unprocessed, bool augmented, bool checkbbox2d, const int &maxDist, const int &min2DPoints, const int &min3DPoints) {
-    for (EntityMap::const_iterator it = entMap.begin(); it != entMap.end(); ++it)
+    ObjEntity &e = m_exportEntity;
+    for (int slot : m_exportOrder)
     {
-        ObjEntity entity = it->second;
-        exportEntity(entity, oss, unprocessed, augmented, checkbbox2d, maxDist, min2DPoints, min3DPoints);
+        table.entity(slot, e);
+
+        //Augmented files also export objects at any distance, with no 3D or 2D points
+        m_labelAugWriter.appendEntity(e, e.bbox2d, true);
+
+        //Skip peds in vehicles except for augmented labels (since they can be specified as peds in vehicles)
+        uint32_t flags = 0;
+        if (!e.isPedInV) {
+            bool inImage = bbox2DInImage(e.bbox2d);
+            bool inImageUnprocessed = (OUTPUT_UNPROCESSED_LABELS || OUTPUT_BINARY_LABELS) && bbox2DInImage(e.bbox2dUnprocessed);
+
+            //Occlusion checks call natives so they are only done once for both label files
+            if ((inImage || inImageUnprocessed) && entityPassesLabelFilters(e, OBJECT_MAX_DIST, 1)) {
+                if (inImage) {
+                    m_labelWriter.appendEntity(e, e.bbox2d, false);
+                    if (m_tracks) m_tracks->addEntity(e);
+                    flags |= BINARY_LABEL_IN_LABEL_2;
+                }
+                if (inImageUnprocessed) {
+                    if (OUTPUT_UNPROCESSED_LABELS) m_labelUnprocessedWriter.appendEntity(e, e.bbox2dUnprocessed, false);
+                    flags |= BINARY_LABEL_IN_UNPROCESSED;
+                }
+            }
+        }
+
+        if (OUTPUT_BINARY_LABELS) {
+            m_binaryLabels.emplace_back();
+            fillBinaryLabel(e, flags, m_binaryLabels.back());
+        }
     }
 }
 
@@ -2549,21 +2449,16 @@ void ObjectDetection::exportPosition() {
         << m_curFrame.upVec.x << " " << m_curFrame.upVec.y << " " << m_curFrame.upVec.z;
 
     std::string str = oss.str();
-    fprintf(f, str.c_str());
+    fputs(str.c_str(), f);
     fclose(f);
 }
 
 void ObjectDetection::exportEgoObject(ObjEntity vPerspective) {
-    FILE* f = fopen(m_egoObjectFilename.c_str(), "w");
-    std::ostringstream oss;
-
-    vPerspective.speed = ENTITY::GET_ENTITY_SPEED(vPerspective.entityID);
+    vPerspective.speed = m_world->getEntitySpeed(vPerspective.entityID);
 
-    exportEntity(vPerspective, oss, false, true, false);
-
-    std::string str = oss.str();
-    fprintf(f, str.c_str());
-    fclose(f);
+    LabelWriter writer;
+    writer.appendEntity(vPerspective, vPerspective.bbox2d, true);
+    writer.writeFile(m_egoObjectFilename);
 }
 
 void ObjectDetection::exportCalib() {
@@ -2581,47 +2476,62 @@ void ObjectDetection::exportCalib() {
         "Tr_imu_to_velo: 1 0 0 0 0 1 0 0 0 0 1 0";
 
     std::string str = oss.str();
-    fprintf(f, str.c_str());
+    fputs(str.c_str(), f);
     fclose(f);
 }
 
-void ObjectDetection::exportDetections(FrameObjectInfo fObjInfo, ObjEntity* vPerspective) {
-    if (collectTracking) {
-        //TODO
+void ObjectDetection::exportDetections(const FrameObjectInfo &fObjInfo, ObjEntity* vPerspective) {
+    STAGE_SCOPE(STAGE_EXPORT_DETECTIONS);
+    BudgetScope budgetScope(m_frameBudget, BUDGET_STAGE_EXPORT_DETECTIONS);
+    m_tracks = NULL;
+    if (collectTracking && OUTPUT_TRACKING_LABELS) {
+        std::unique_ptr<TrackExporter> &tracks = m_trackExporters[m_vPerspective];
+        if (!tracks) {
+            tracks.reset(new TrackExporter());
+            tracks->open(getOutputDir("label_02") + series_string + ".txt", getOutputDir("mot") + series_string + ".txt");
+        }
+        if (tracks->isOpen()) {
+            m_tracks = tracks.get();
+            m_tracks->beginFrame(instance_index);
+        }
     }
-    FILE* f = fopen(m_labelsFilename.c_str(), "w");
-    std::ostringstream oss;
-
-    exportEntities(fObjInfo.vehicles, oss, false, false, true, OBJECT_MAX_DIST, 1, 1);
-    exportEntities(fObjInfo.peds, oss, false, false, true, OBJECT_MAX_DIST, 1, 1);
-
-    std::string str = oss.str();
-    fprintf(f, str.c_str());
-    fclose(f);
-
-    if (OUTPUT_UNPROCESSED_LABELS) {
-        f = fopen(m_labelsUnprocessedFilename.c_str(), "w");
-        std::ostringstream oss1;
-
-        exportEntities(fObjInfo.vehicles, oss1, true, false, true, OBJECT_MAX_DIST, 1, 1);
-        exportEntities(fObjInfo.peds, oss1, true, false, true, OBJECT_MAX_DIST, 1, 1);
-
-        std::string str1 = oss1.str();
-        fprintf(f, str1.c_str());
-        fclose(f);
+    m_labelWriter.clear();
+    m_labelUnprocessedWriter.clear();
+    m_labelAugWriter.clear();
+    m_binaryLabels.clear();
+
+    exportEntities(fObjInfo.vehicles);
+    exportEntities(fObjInfo.peds);
+    if (m_tracks) m_tracks->endFrame();
+
+    m_labelWriter.writeFile(m_labelsFilename);
+    if (OUTPUT_UNPROCESSED_LABELS) m_labelUnprocessedWriter.writeFile(m_labelsUnprocessedFilename);
+    m_labelAugWriter.writeFile(m_labelsAugFilename);
+
+    if (OUTPUT_BINARY_LABELS) {
+        BinaryLabelHeader header;
+        header.magic = BINARY_LABEL_MAGIC;
+        header.version = BINARY_LABEL_VERSION;
+        header.recordSize = sizeof(BinaryLabelRecord);
+        header.count = (uint32_t)m_binaryLabels.size();
+        header.instanceIndex = fObjInfo.instanceIdx;
+        header.seriesIndex = fObjInfo.seriesIdx;
+        header.timeHours = fObjInfo.timeHours;
+        header.focalLen = fObjInfo.focalLen;
+        header.speed = fObjInfo.speed;
+        header.yawRate = fObjInfo.yawRate;
+        header.imageWidth = s_camParams.width;
+        header.imageHeight = s_camParams.height;
+        writeBinaryLabels(m_labelsBinFilename, header, m_binaryLabels);
+    }
+
+    //Labels are the last record of a frame
+    if (m_frameRing.inFrame()) {
+        const std::string& labels = m_labelWriter.str();
+        m_frameRing.addRecord(FRAME_RECORD_LABELS, labels.data(), (uint32_t)labels.size());
+        m_frameRing.publishFrame();
     }
 
-    f = fopen(m_labelsAugFilename.c_str(), "w");
-    std::ostringstream oss2;
-
-    //Augmented files also exports objects at any distance, with no 3D or 2D points
-    exportEntities(fObjInfo.vehicles, oss2, false, true, false);
-    exportEntities(fObjInfo.peds, oss2, false, true, false);
-
-    std::string str2 = oss2.str();
-    fprintf(f, str2.c_str());
-    fclose(f);
-
     exportCalib();
 
     if (GENERATE_SECONDARY_PERSPECTIVES) {
@@ -2636,12 +2546,21 @@ void ObjectDetection::exportDetections(FrameObjectInfo fObjInfo, ObjEntity* vPer
 }
 
 void ObjectDetection::exportImage(BYTE* data, std::string filename) {
-    cv::Mat tempMat(cv::Size(s_camParams.width, s_camParams.height), CV_8UC3, data);
+    STAGE_SCOPE(STAGE_EXPORT_IMAGE);
+    BudgetScope budgetScope(m_frameBudget, BUDGET_STAGE_EXPORT_IMAGE);
     if (filename.empty()) {
         filename = m_imgFilename;
     }
-    cv::imwrite(filename, tempMat);
-    tempMat.release();
+    //The captured image is BGR
+    std::vector<uint8_t> rgb(3 * s_camParams.width * s_camParams.height);
+    for (size_t idx = 0; idx < rgb.size(); idx += 3) {
+        rgb[idx] = data[idx + 2];
+        rgb[idx + 1] = data[idx + 1];
+        rgb[idx + 2] = data[idx];
+    }
+    std::vector<std::uint8_t> pngBuffer;
+    lodepng::encode(pngBuffer, rgb.data(), s_camParams.width, s_camParams.height, LCT_RGB, 8);
+    lodepng::save_file(pngBuffer, filename);
 }
 
 Vector3 ObjectDetection::getGroundPoint(Vector3 point, Vector3 yVectorCam, Vector3 xVectorCam, Vector3 zVectorCam) {
@@ -2658,7 +2577,7 @@ Vector3 ObjectDetection::getGroundPoint(Vector3 point, Vector3 yVectorCam, Vecto
 
     //Obtain groundz at world position
     float groundZ;
-    GAMEPLAY::GET_GROUND_Z_FOR_3D_COORD(worldpoint.x, worldpoint.y, worldpoint.z, &(groundZ), 0);
+    m_world->getGroundZFor3dCoord(worldpoint.x, worldpoint.y, worldpoint.z, &(groundZ), 0);
     worldpoint.z = groundZ;
 
     worldpoint.x -= s_camParams.pos.x;
@@ -2671,10 +2590,11 @@ Vector3 ObjectDetection::getGroundPoint(Vector3 point, Vector3 yVectorCam, Vecto
 }
 
 void ObjectDetection::setGroundPlanePoints() {
+    BudgetScope budgetScope(m_frameBudget, BUDGET_STAGE_GROUND);
     //Distance to ground is ~1.73
     //See CAR_CENTER_OFFSET_UP
     /*float groundZ;
-    GAMEPLAY::GET_GROUND_Z_FOR_3D_COORD(s_camParams.pos.x, s_camParams.pos.y, s_camParams.pos.z, &(groundZ), 0);
+    m_world->getGroundZFor3dCoord(s_camParams.pos.x, s_camParams.pos.y, s_camParams.pos.z, &(groundZ), 0);
     float groundDiff = s_camParams.pos.z - groundZ;
     std::ostringstream osst;
     osst << "Distance to ground: " << groundDiff;
@@ -2712,7 +2632,7 @@ void ObjectDetection::setGroundPlanePoints() {
         oss << relPoint.y << ", " << relPoint.x << ", " << relPoint.z << "\n";
     }
     std::string str = oss.str();
-    fprintf(f, str.c_str());
+    fputs(str.c_str(), f);
     fclose(f);
 
     //**********************Creating ground point grid****************************************
@@ -2721,7 +2641,7 @@ void ObjectDetection::setGroundPlanePoints() {
     FILE* f2 = fopen(filename2.c_str(), "w");
     std::ostringstream oss2;
 
-    int pointInterval = 2; //Distance between ground points (approximately in metres - game coordinates)
+    int pointInterval = m_frameBudget.quality().groundGridInterval; //Distance between ground points (approximately in metres - game coordinates)
     for (int x = -MAX_LIDAR_DIST; x <= MAX_LIDAR_DIST; x += pointInterval) {
         for (int y = 0; y <= MAX_LIDAR_DIST; y += pointInterval) {
             Vector3 point = createVec3(x, y, 0.0f);
@@ -2733,12 +2653,14 @@ void ObjectDetection::setGroundPlanePoints() {
     }
 
     std::string str2 = oss2.str();
-    fprintf(f2, str2.c_str());
+    fputs(str2.c_str(), f2);
     fclose(f2);
 }
 
 Vector3 ObjectDetection::getVehicleDims(Entity e, Hash model, Vector3 &min, Vector3 &max) {
-    GAMEPLAY::GET_MODEL_DIMENSIONS(model, &min, &max);
+    const ModelInfo &info = s_modelCache.get(model);
+    min = info.min;
+    max = info.max;
 
     //Calculate size
     Vector3 dim;
@@ -2753,10 +2675,10 @@ Vector3 ObjectDetection::getVehicleDims(Entity e, Hash model, Vector3 &min, Vect
 void ObjectDetection::checkEntity(Vehicle p, WorldObject e, Vector3 pPos, std::ostringstream& oss) {
     if (p != e.e) {
         Vector3 forwardVector, rightVector, upVector, position;
-        ENTITY::GET_ENTITY_MATRIX(e.e, &forwardVector, &rightVector, &upVector, &position); //Blue or red pill
-        float distance = sqrt(SYSTEM::VDIST2(pPos.x, pPos.y, pPos.z, position.x, position.y, position.z));
+        m_world->getEntityMatrix(e.e, &forwardVector, &rightVector, &upVector, &position); //Blue or red pill
+        float distance = sqrt(vdist2(pPos.x, pPos.y, pPos.z, position.x, position.y, position.z));
         if (distance < 120) {
-            bool losToCentre = ENTITY::HAS_ENTITY_CLEAR_LOS_TO_ENTITY(p, e.e, 19);
+            bool losToCentre = m_world->hasEntityClearLosToEntity(p, e.e, 19);
 
             Vector3 min, max;
             Vector3 dim = getVehicleDims(e.e, e.model, min, max);
@@ -2804,27 +2726,3 @@ SubsetInfo ObjectDetection::getObjectInfoSubset(Vector3 position, Vector3 forwar
 
     return s;
 }
-
-
-
-void ObjectDetection::TrailersOnFrameID(std::vector<int>& TrailerArray) {
-    const int ARR_SIZE = 1024;
-    Vehicle vehicles[ARR_SIZE];
-
-    int count = worldGetAllVehicles(vehicles, ARR_SIZE);
-    for (int i = 0; i < count; i++) {
-        if (vehicles[i] == m_ownVehicle) continue; //Don't process perspective car!
-
-        Hash model = ENTITY::GET_ENTITY_MODEL(vehicles[i]);
-        std::string modelString = VEHICLE::GET_DISPLAY_NAME_FROM_VEHICLE_MODEL(model);
-
-        //List of trailers to be considered for towing purposes
-        std::list<std::string> list_of_trailers = { "TRAILERLARGE", "TRAILER", "DOCKTRAILER","TR2","TANKER","TRAILERL","ARMYTRAILER","TR3","TRAILERS3"};
-        std::list<std::string>::iterator it;
-        it = std::find(list_of_trailers.begin(), list_of_trailers.end(), modelString);
-        if (it != list_of_trailers.end()) //It's a car
-        {
-            TrailerArray.push_back(vehicles[i]);
-        }
-    }
-}
@@ -4,11 +4,22 @@
 #include <ctime>
 
 #include "LiDAR.h"
+#include "World.h"
 #include "Functions.h"
 #include "CamParams.h"
 #include "FrameObjectInfo.h"
-#include <opencv2\opencv.hpp>
-#include <boost/shared_ptr.hpp>
+#include "EntityTable.h"
+#include "EntityState.h"
+#include "TrackExport.h"
+#include "InstanceMasks.h"
+#include "FrameRing.h"
+#include "FrameBufferPool.h"
+#include "FrameBudget.h"
+#include "LabelWriter.h"
+#include "EntitySnapshot.h"
+#include "EntityLabel.h"
+#include "WorldState.h"
+#include "PedSpatialHash.h"
 
 
 //#define DEBUG 1
@@ -44,13 +55,14 @@ public:
 private:
     FrameObjectInfo m_curFrame;
     bool m_initialized = false;
+    IWorld* m_world = defaultWorld();
     bool m_eve = false;
 
-    Vehicle m_vehicle = NULL;
-    Vehicle m_ownVehicle = NULL;
-    Player player = NULL;
-    Ped ped = NULL;
-    Cam camera = NULL;
+    Vehicle m_vehicle = 0;
+    Vehicle m_ownVehicle = 0;
+    Player player = 0;
+    Ped ped = 0;
+    Cam camera = 0;
     Vector3 dir;
 
     float x, y, z;
@@ -96,6 +108,10 @@ private:
     //Perspective variables
     int m_vPerspective = -1;//Entity ID of perspective vehicle (-1 if self)
 
+    //Owns the buffers below, a set is bound to them at the start of each frame (see bindFrameBuffers)
+    FrameBufferPool m_frameBuffers;
+    FrameBufferSet* m_pFrameBuffers = NULL;
+
     //Depth Map variables
     float* m_pDepth = NULL;
     uint8_t* m_pStencil = NULL;
@@ -109,11 +125,22 @@ private:
     int m_instanceSegLength = 0;
     uint8_t* m_pInstanceSegImg = NULL;
     int m_instanceSegImgLength = 0;
+    InstanceMaskSet m_instanceMasks;
     uint8_t* m_pOcclusionImage = NULL;
     uint8_t* m_pUnusedStencilImage = NULL;
     uint8_t* m_pGroundPointsImage = NULL;
 
-    cv::Mat m_depthMat = cv::Mat::zeros(cv::Size(s_camParams.width, s_camParams.height), CV_32FC1);
+    //Label buffers are reused between frames
+    LabelWriter m_labelWriter;
+    LabelWriter m_labelUnprocessedWriter;
+    LabelWriter m_labelAugWriter;
+    std::vector<BinaryLabelRecord> m_binaryLabels;
+
+    //Quality levels of live capture (USE_FRAME_BUDGET), full quality when not open
+    FrameBudget m_frameBudget;
+
+    //Live transport for consumers which don't want to wait for files (PUBLISH_FRAME_RING)
+    FrameRingProducer m_frameRing;
 
     std::string m_imgFilename;
     std::string m_depthFilename;
@@ -128,11 +155,14 @@ private:
     std::string m_labelsFilename;
     std::string m_labelsUnprocessedFilename;
     std::string m_labelsAugFilename;
+    std::string m_labelsBinFilename;
     std::string m_groundPointsFilename;
     std::string m_instSegFilename;
     std::string m_instSegImgFilename;
+    std::string m_instSegMasksFilename;
     std::string m_posFilename;
     std::string m_egoObjectFilename;
+    std::string m_worldStateFilename;
 
     std::string m_veloFilenameU;
     std::string m_depthPCFilenameU;
@@ -152,6 +182,9 @@ private:
 
     //For tracking: first frame in a series that an entity appears
     std::unordered_map<int, int> trackFirstFrame;
+    //Tracking ground truth of the current series, per perspective (-1 is the ego vehicle)
+    std::unordered_map<int, std::unique_ptr<TrackExporter>> m_trackExporters;
+    TrackExporter* m_tracks = NULL;//Exporter of the frame being exported
     //For calculating real speed
     Vector3 m_trackLastPos;
     float m_trackRealSpeed;
@@ -165,25 +198,44 @@ private:
     int m_trackLastSeqIndex = 0;
     std::string m_timeTrackFile;
     std::string m_usedPixelFile;
+    std::string m_depthCompressionFile;
 
     //Camera intrinsic parameters
     float intrinsics[3];
 
-    //bool m_vLookupInit = false;
-    //std::unordered_map<std::string, std::string> m_vLookup; //Vehicle lookup
-
     std::unordered_map<Vehicle, std::vector<Ped>> m_pedsInVehicles;
+    PedSpatialHash m_pedGrid;
+    std::vector<int> m_pedGridHits;
+
+    //Native entity state gathered once per frame (see EntitySnapshot.h)
+    EgoSnapshot m_egoSnapshot;
+    EntitySnapshot m_vehicleSnapshot;
+    EntitySnapshot m_pedSnapshot;
+
+    //Vehicles and peds of the current frame (m_curFrame holds views of them)
+    std::shared_ptr<EntityTable> m_vehicleTable;
+    std::shared_ptr<EntityTable> m_pedTable;
+    std::vector<int> m_exportOrder;//Slots in entity ID order
+    ObjEntity m_exportEntity;//Reused so the label strings keep their buffers
+    //Entity geometry kept across frames
+    EntityStateStore m_entityState;
+    EntityGeometry m_entityGeometry;//Scratch geometry when REUSE_ENTITY_STATE is off
+    //Camera and capture vehicle state the entity labels are computed from, set once per frame in setEntityLists
+    LabelFrameState m_labelFrame;
 
     //Map for tracking which entities are possible for each point which is in multiple 3D boxes
-    std::unordered_map<int, std::vector<ObjEntity*>> m_overlappingPoints;
+    std::unordered_map<int, std::vector<EntityRef>> m_overlappingPoints;
 
 public:
-    void initCollection(UINT camWidth, UINT camHeight, bool exportEVE = true, int startIndex = 0);
+    //world defaults to the game (defaultWorld)
+    void initCollection(UINT camWidth, UINT camHeight, bool exportEVE = true, int startIndex = 0, IWorld* world = NULL);
+    //Offline replay of captured frames into exportDir (see replayFrame). world answers the queries the
+    //world state does not hold (e.g. a RecordedWorld loaded with the same frame).
+    void initReplay(UINT camWidth, UINT camHeight, const std::string &exportDir, IWorld* world, bool tracking = false);
     void setCamParams(float* forwardVec = NULL, float* rightVec = NULL, float* upVec = NULL);
     void setOwnVehicleObject();
 
-    bool m_vLookupInit = false;
-    std::unordered_map<std::string, std::string> m_vLookup; //Vehicle lookup
+    //Loads vehicle_labels_override.csv into the shared model cache (s_modelCache)
     void initVehicleLookup();
     
 
@@ -193,10 +245,12 @@ public:
     bool m_prevDepth = false;
 
     FrameObjectInfo generateMessage(float* pDepth, uint8_t* pStencil, int entityID = -1);
-    void exportDetections(FrameObjectInfo fObjInfo, ObjEntity* vPerspective = NULL);
+    FrameObjectInfo replayFrame(float* pDepth, uint8_t* pStencil, const WorldStateFrame &state);
+    void exportDetections(const FrameObjectInfo &fObjInfo, ObjEntity* vPerspective = NULL);
     void exportImage(BYTE* data, std::string filename = "");
     void increaseIndex();
     std::string getStandardFilename(std::string subDir, std::string extension);
+    std::string getOutputDir(std::string subDir);
 
     int instance_index = 0;
     int series_index = 0;
@@ -218,62 +272,84 @@ public:
     ObjEntity m_ownVehicleObj;
 
 private:
+    void initOutput();
+    void setOwnVehicleObject(Hash model);
+    void snapshotWorld();
+    void setEntityLists();
+    void processFrame();
+    void recordWorldState();
+    void restoreWorldState(const WorldStateFrame &state);
+    void updateIndexStrings();
+    void updateCamEigen();
     void setVehiclesList();
     void setPedsList();
+    //Clears a table for a new frame, replacing it if a view from an earlier frame still holds it
+    EntityTable& resetTable(std::shared_ptr<EntityTable> &table, EntityTableView &view);
     void setSpeed();
     void setYawRate();
     void setTime();
     void setupLiDAR();
+    void bindFrameBuffers();
     void collectLiDAR();
     void setIndex();
     void calcCameraIntrinsics();
     void setFocalLength();
-    bool getEntityVector(ObjEntity &entity, int entityID, Hash model, int classid, std::string type, std::string modelString, bool isPedInV, Vehicle vPedIsIn, bool &nearbyVehicle);
+    void setEgoSnapshot();
+    bool sphereInFrustum(const Vector3 &position, float radius);
+    void snapshotEntities(const int* ids, int count, bool vehicles, EntitySnapshot &snap);
+    bool getEntityVector(ObjEntity &entity, const EntitySnapshot &snap, int idx, int classid, std::string type, bool isPedInV, Vehicle vPedIsIn, bool &nearbyVehicle);
+    const EntityGeometry& updateEntityGeometry(const EntitySnapshot &snap, int idx, int classid);
     void setPosition();
-    Vector3 correctOffcenter(Vector3 position, Vector3 min, Vector3 max, Vector3 forwardVector, Vector3 rightVector, Vector3 upVector, Vector3 &offcenter);
     float observationAngle(Vector3 position);
     void drawVectorFromPosition(Vector3 vector, int blue, int green);
     Vector3 depthToCamCoords(float depth, float screenX, float screenY);
     void outputRealSpeed();
     void setStencilBuffer();
+    //Per pixel loops with the settings they test as template parameters (picked once per frame)
+    template <bool SEPARATE_STENCILS>
+    void fillStencilImage(std::vector<int> &stencilValues);
+    template <bool GROUND_PIXELS, bool DM_POINTCLOUD>
+    int fillDepthOutputs(int &nonzero);
+    void writeCompressedDepth();
     void setFilenames();
 
     BBox2D BBox2DFrom3DObject(Vector3 position, Vector3 dim, Vector3 forwardVector, Vector3 rightVector, Vector3 upVector, bool &success, float &truncation);
-    bool in3DBox(Vector3 point, Vector3 objPos, Vector3 dim, Vector3 yVector, Vector3 xVector, Vector3 zVector);
-    bool in3DBox(ObjEntity *e, Vector3 point, bool &upperHalf);
-    bool in2DBoxUnprocessed(const int &i, const int &j, ObjEntity* e);
-    bool checkDirection(Vector3 unit, Vector3 point, Vector3 min, Vector3 max);
     //Process pixel instance segmentations with two different methods
     //2D uses only 2D segmentation techniques whereas 3D uses depth buffer
     //Depth buffer hits vehicle windows whereas stencil buffer does not
     void processSegmentation2D();
     void processSegmentation3D();
-    std::vector<ObjEntity*> pointInside3DEntities(const Vector3 &worldPos, EntityMap* eMap, const bool &checkUpperVehicle, const uint8_t &stencilVal);
+    std::vector<EntityRef> pointInside3DEntities(const Vector3 &worldPos, EntityTable* table, const bool &checkUpperVehicle, const uint8_t &stencilVal);
     void processOverlappingPoints();
-    void setEntityBBoxParameters(ObjEntity *e);
+    void floodFill(std::vector<int> &mask, int seed, int val, std::vector<int> &stack);
+    //OVERLAPPING_POINTS: PROCESS_OVERLAPPING_POINTS (picked once per frame in processSegmentation3D)
+    template <bool OVERLAPPING_POINTS>
+    void segmentStencilPixels3D(const Vector3 &xVectorCam, const Vector3 &yVectorCam, const Vector3 &zVectorCam);
+    template <bool OVERLAPPING_POINTS>
     void processStencilPixel3D(const uint8_t &stencilVal, const int &j, const int &i, const Vector3 &xVectorCam, const Vector3 &yVectorCam, const Vector3 &zVectorCam);
-    void addSegmentedPoint3D(int i, int j, ObjEntity *e);
+    void addSegmentedPoint3D(int i, int j, EntityRef e);
     void addPointToSegImages(int i, int j, int entityID);
     void printSegImage();
 
     void update3DPointsHit();
-    void update3DPointsHit(ObjEntity* e);
+    void update3DPointsHit(int entityID, EntityRecord &e);
 
     void processOcclusion();
-    void processOcclusionForEntity(ObjEntity *e, const Vector3 &xVectorCam, const Vector3 &yVectorCam, const Vector3 &zVectorCam);
+    void processOcclusionForEntity(EntityTable &table, int slot, const Vector3 &xVectorCam, const Vector3 &yVectorCam, const Vector3 &zVectorCam);
 
-    void getRollAndPitch(Vector3 rightVector, Vector3 forwardVector, Vector3 upVector, float &pitch, float &roll);
+    void getRollAndPitch(Vector3 rightVector, Vector3 forwardVector, float &pitch, float &roll);
 
     bool hasLOSToEntity(Entity entityID, Vector3 position, Vector3 dim, Vector3 forwardVector, Vector3 rightVector, Vector3 upVector, bool useOrigin = false, Vector3 origin = createVec3(0,0,0));
 
     //void initVehicleLookup();
-    bool isPointOccluding(Vector3 worldPos, ObjEntity* e);
+    bool isPointOccluding(const Vector3 &worldPos, const EntityBox &box, const Vector3 &objWorldPos);
     void outputOcclusion();
     void outputUnusedStencilPixels();
 
     //Export functions
-    void exportEntity(ObjEntity e, std::ostringstream& oss, bool unprocessed, bool augmented, bool checkbbox2d = true, const int &maxDist = -1, const int &min2DPoints = -1, const int &min3DPoints = -1);
-    void exportEntities(EntityMap entMap, std::ostringstream& oss, bool unprocessed = false, bool augmented = false, bool checkbbox2d = true, const int &maxDist = -1, const int &min2DPoints = -1, const int &min3DPoints = -1);
+    bool bbox2DInImage(const BBox2D &b);
+    bool entityPassesLabelFilters(const ObjEntity &e, const int &maxDist = -1, const int &min2DPoints = -1);
+    void exportEntities(const EntityTableView &entities);
     void exportCalib();
     void exportPosition();
     void exportEgoObject(ObjEntity vPerspective);
@@ -286,5 +362,4 @@ private:
     void checkEntity(Vehicle p, WorldObject e, Vector3 pPos, std::ostringstream& oss);
     SubsetInfo getObjectInfoSubset(Vector3 position, Vector3 forwardVector, Vector3 dim);
     Vector3 getVehicleDims(Entity e, Hash model, Vector3 &min, Vector3 &max);
-    void TrailersOnFrameID(std::vector<int>& TrailerArray);
 };
\ No newline at end of file
@@ -0,0 +1,15 @@
+#include "OutputPaths.h"
+#include <filesystem>
+
+bool makeDirectory(const std::string& dir) {
+    std::error_code ec;
+    std::filesystem::create_directory(std::filesystem::path(dir), ec);
+    return !ec;
+}
+
+std::string withSeparator(std::string dir) {
+    if (!dir.empty() && dir.back() != '\\' && dir.back() != '/') {
+        dir += PATH_SEPARATOR;
+    }
+    return dir;
+}
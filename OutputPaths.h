@@ -0,0 +1,17 @@
+#pragma once
+
+#include <string>
+
+//Export directory handling without the Win32 API, so headless runs write the same layout as the plugin.
+//Paths are built with the native separator (backslash on Windows as before).
+
+#ifdef _WIN32
+const char PATH_SEPARATOR = '\\';
+#else
+const char PATH_SEPARATOR = '/';
+#endif
+
+//Creates a single directory level. An existing directory is not an error (as CreateDirectory was used).
+bool makeDirectory(const std::string& dir);
+//dir with a trailing separator (either '/' or '\\' counts as one)
+std::string withSeparator(std::string dir);
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "CoreTypes.h"
+#include <vector>
+#include <algorithm>
+#include <stdint.h>
+#include <math.h>
+
+//Uniform grid over the horizontal KITTI plane (x/z) holding the peds of one frame.
+//Entries are kept sorted by cell so the storage is reused between frames.
+class PedSpatialHash {
+public:
+    struct Entry {
+        int64_t cell;
+        int entityID;
+        float x;
+        float y;
+        float z;
+
+        bool operator<(const Entry& other) const {
+            return cell < other.cell || (cell == other.cell && entityID < other.entityID);
+        }
+    };
+
+    explicit PedSpatialHash(float cellSize = 0.5f) : m_cellSize(cellSize) {}
+
+    void clear() { m_entries.clear(); }
+
+    void add(int entityID, const Vector3& kittiPos) {
+        Entry e;
+        e.cell = cellKey(cellCoord(kittiPos.x), cellCoord(kittiPos.z));
+        e.entityID = entityID;
+        e.x = kittiPos.x;
+        e.y = kittiPos.y;
+        e.z = kittiPos.z;
+        m_entries.push_back(e);
+    }
+
+    //Call after all peds are added
+    void build() { std::sort(m_entries.begin(), m_entries.end()); }
+
+    //Entity IDs (ascending) of peds with horizontal distance < horizDist and
+    //ped.y - kittiPos.y <= maxVertDist (KITTI y points down)
+    void query(const Vector3& kittiPos, float horizDist, float maxVertDist, std::vector<int>& out) const {
+        out.clear();
+        int cx = cellCoord(kittiPos.x);
+        int cz = cellCoord(kittiPos.z);
+        int reach = (int)ceil(horizDist / m_cellSize);
+        float horizDist2 = horizDist * horizDist;
+
+        for (int dx = -reach; dx <= reach; ++dx) {
+            for (int dz = -reach; dz <= reach; ++dz) {
+                Entry probe;
+                probe.cell = cellKey(cx + dx, cz + dz);
+                probe.entityID = INT32_MIN;
+                for (auto it = std::lower_bound(m_entries.begin(), m_entries.end(), probe);
+                     it != m_entries.end() && it->cell == probe.cell; ++it) {
+                    float ddx = it->x - kittiPos.x;
+                    float ddz = it->z - kittiPos.z;
+                    if (ddx * ddx + ddz * ddz < horizDist2 && it->y - kittiPos.y <= maxVertDist) {
+                        out.push_back(it->entityID);
+                    }
+                }
+            }
+        }
+        //Ascending IDs, the order riders were found in before the grid
+        std::sort(out.begin(), out.end());
+    }
+
+    size_t size() const { return m_entries.size(); }
+
+private:
+    int cellCoord(float v) const { return (int)floor(v / m_cellSize); }
+    static int64_t cellKey(int cx, int cz) { return ((int64_t)cx << 32) | (uint32_t)cz; }
+
+    float m_cellSize;
+    std::vector<Entry> m_entries;
+};
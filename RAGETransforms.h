@@ -2,7 +2,7 @@
 #include <Eigen/LU>
 #include "Constants.h"
 #include "CamParams.h"
-#include "..\ObjectDetIncludes.h"
+#include "CoreTypes.h"
 #include "Functions.h"
 
 #pragma once
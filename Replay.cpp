@@ -0,0 +1,113 @@
+#include "Replay.h"
+#include "DepthCompression.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string.h>
+
+namespace fs = std::filesystem;
+
+static bool readFile(const fs::path& path, std::vector<uint8_t>& data) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+    data.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    return true;
+}
+
+bool ReplaySession::open(const std::string& inputDir, int shard, int shardCount) {
+    m_inputDir = inputDir;
+    m_frames.clear();
+    fs::path stateDir = fs::path(inputDir) / "worldState";
+    std::error_code ec;
+    if (!fs::is_directory(stateDir, ec)) return false;
+
+    m_tracking = false;
+    std::vector<std::string> all;
+    for (const fs::directory_entry& entry : fs::recursive_directory_iterator(stateDir, ec)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".bin") {
+            all.push_back(entry.path().string());
+            //Tracking collections keep each series in its own directory
+            if (entry.path().parent_path() != stateDir) m_tracking = true;
+        }
+    }
+    //Names are zero padded so this is series then frame order
+    std::sort(all.begin(), all.end());
+
+    if (shardCount < 1) shardCount = 1;
+    if (m_tracking) {
+        //Whole series per shard: tracks, the entity state and the per-series track files
+        //(label_02/<series>.txt, mot/<series>.txt) need every frame of a series in one process
+        int series = -1;
+        fs::path seriesDir;
+        for (const std::string& frame : all) {
+            fs::path dir = fs::path(frame).parent_path();
+            if (series < 0 || dir != seriesDir) {
+                ++series;
+                seriesDir = dir;
+            }
+            if (series % shardCount == shard) m_frames.push_back(frame);
+        }
+    }
+    else {
+        //Contiguous blocks so consecutive frames stay together for the entity state
+        for (size_t k = 0; k < all.size(); ++k) {
+            if ((int)(k * shardCount / all.size()) == shard) m_frames.push_back(all[k]);
+        }
+    }
+    return true;
+}
+
+int ReplaySession::run(ObjectDetection& detection, const std::string& outputDir) {
+    int replayed = 0;
+    for (const std::string& frame : m_frames) {
+        if (replayed == 0) {
+            //The first frame decides the image size for the whole collection
+            WorldStateFrame state;
+            if (!readWorldState(frame, state)) continue;
+            detection.initReplay(state.width, state.height, outputDir, &m_world, m_tracking);
+        }
+        if (replay(detection, frame)) {
+            ++replayed;
+        }
+        else {
+            log("Failed to replay frame: " + frame, true);
+        }
+    }
+    return replayed;
+}
+
+bool ReplaySession::replay(ObjectDetection& detection, const std::string& worldStateFile) {
+    if (!m_world.load(worldStateFile)) return false;
+    const WorldStateFrame& state = m_world.frame();
+    if (state.width != s_camParams.width || state.height != s_camParams.height) return false;
+
+    //Same relative path (series directory and frame name) under depth and stencil
+    fs::path rel = fs::path(worldStateFile).lexically_relative(fs::path(m_inputDir) / "worldState");
+    rel.replace_extension();
+    if (!loadDepth((fs::path(m_inputDir) / "depth" / rel).string(), state.width, state.height)) return false;
+    if (!loadStencil((fs::path(m_inputDir) / "stencil" / rel).string(), state.width, state.height)) return false;
+
+    FrameObjectInfo frame = detection.replayFrame(m_depth.data(), m_stencil.data(), state);
+    detection.exportDetections(frame);
+    return true;
+}
+
+bool ReplaySession::loadDepth(const std::string& basePath, int width, int height) {
+    std::vector<uint8_t> data;
+    if (readFile(basePath + ".gdz", data)) {
+        int w, h;
+        return decompressDepthBuffer(data.data(), data.size(), m_depth, w, h) && w == width && h == height;
+    }
+    if (!readFile(basePath + ".bin", data)) return false;
+    size_t pixels = (size_t)width * height;
+    if (data.size() != pixels * sizeof(float)) return false;
+    m_depth.resize(pixels);
+    memcpy(m_depth.data(), data.data(), data.size());
+    return true;
+}
+
+bool ReplaySession::loadStencil(const std::string& basePath, int width, int height) {
+    if (!readFile(basePath + ".raw", m_stencil)) return false;
+    return m_stencil.size() == (size_t)width * height;
+}
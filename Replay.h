@@ -0,0 +1,36 @@
+#pragma once
+
+#include "ObjectDetection.h"
+#include "SceneWorld.h"
+#include <string>
+#include <vector>
+
+//Offline replay of a captured collection: every frame with a worldState/*.bin is rebuilt from its
+//depth (depth/*.gdz or depth/*.bin), stencil (stencil/*.raw) and world state, then run through
+//segmentation, occlusion, LiDAR sampling and export again into another directory.
+//Queries the world state does not answer directly (ground heights, raycasts, LOS) go to a RecordedWorld of the frame.
+//Frames can be split across processes with shard/shardCount (ObjectDetection uses globals, so one session per process):
+//tracking collections by series directory, others in contiguous blocks of frames.
+//See ReplayMain.cpp for the command line tool.
+class ReplaySession {
+public:
+    //inputDir is the export folder of a collection (the one holding depth, stencil and worldState)
+    bool open(const std::string& inputDir, int shard = 0, int shardCount = 1);
+    size_t frameCount() const { return m_frames.size(); }
+
+    //Replays and exports every frame of this shard. Returns the number of frames replayed.
+    int run(ObjectDetection& detection, const std::string& outputDir);
+    //Loads and replays one frame (path of its world state file)
+    bool replay(ObjectDetection& detection, const std::string& worldStateFile);
+
+private:
+    bool loadDepth(const std::string& basePath, int width, int height);
+    bool loadStencil(const std::string& basePath, int width, int height);
+
+    RecordedWorld m_world;
+    std::string m_inputDir;
+    std::vector<std::string> m_frames;//World state files in frame order
+    std::vector<float> m_depth;
+    std::vector<uint8_t> m_stencil;
+    bool m_tracking = false;
+};
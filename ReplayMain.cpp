@@ -0,0 +1,32 @@
+#include "Replay.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <memory>
+
+//Command line replay of a captured collection (see ReplaySession)
+//  deepgtav_replay <input dir> <output dir> [<shard> <shard count>]
+//Settings are read from DEEPGTAV_SETTINGS (or DeepGTAVSettings.ini in the working directory) as in the plugin.
+int main(int argc, char** argv) {
+    if (argc != 3 && argc != 5) {
+        fprintf(stderr, "Usage: %s <input dir> <output dir> [<shard> <shard count>]\n", argv[0]);
+        return 2;
+    }
+    int shard = argc == 5 ? atoi(argv[3]) : 0;
+    int shardCount = argc == 5 ? atoi(argv[4]) : 1;
+    if (shardCount < 1 || shard < 0 || shard >= shardCount) {
+        fprintf(stderr, "Shard must be in [0, shard count)\n");
+        return 2;
+    }
+
+    ReplaySession session;
+    if (!session.open(argv[1], shard, shardCount)) {
+        fprintf(stderr, "No worldState directory in %s\n", argv[1]);
+        return 1;
+    }
+
+    //ObjectDetection holds the per-frame buffers and tables, keep it off the stack
+    std::unique_ptr<ObjectDetection> detection(new ObjectDetection());
+    int replayed = session.run(*detection, argv[2]);
+    printf("Replayed %d of %zu frames\n", replayed, session.frameCount());
+    return replayed == (int)session.frameCount() ? 0 : 1;
+}
@@ -0,0 +1,600 @@
+#include "SceneWorld.h"
+#include "Constants.h"
+#include "GeometryCore.h"
+#include <algorithm>
+#include <math.h>
+#include <random>
+
+namespace {
+
+const Hash SYNTH_CAR_MODEL = 0x53594E43;//"SYNC"
+const Hash SYNTH_PED_MODEL = 0x53594E50;//"SYNP"
+const float STOPPED_SPEED = 0.1f;
+const float GROUND_SAMPLE_RANGE = 25.0f;
+const float RENDER_RANGE = 300.0f;
+
+//Stencil types written by render (see ObjectDetection.cpp)
+const uint8_t RENDER_STENCIL_GROUND = 0;
+const uint8_t RENDER_STENCIL_NPC = 1;
+const uint8_t RENDER_STENCIL_VEHICLE = 2;
+const uint8_t RENDER_STENCIL_SKY = 7;
+
+Vector3 vec3(float x, float y, float z) {
+    Vector3 v;
+    v.x = x;
+    v.y = y;
+    v.z = z;
+    return v;
+}
+
+float dot(const Vector3& a, const Vector3& b) {
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+//Rotation (degrees, order 2) from the entity matrix, as GET_ENTITY_ROTATION returns it
+Vector3 rotationFromMatrix(const Vector3& forward, const Vector3& right) {
+    float pitch = atan2(forward.z, sqrt(forward.x * forward.x + forward.y * forward.y)) * 180 / PI;
+    float roll = atan2(-right.z, sqrt(right.x * right.x + right.y * right.y)) * 180 / PI;
+    float yaw = atan2(-forward.x, forward.y) * 180 / PI;
+    return vec3(pitch, roll, yaw);
+}
+
+}
+
+Cam SceneWorld::getRenderingCam() {
+    return 1;
+}
+
+Vector3 SceneWorld::getCamCoord(Cam /*cam*/) {
+    return m_frame.camPos;
+}
+
+Vector3 SceneWorld::getCamRot(Cam /*cam*/, int /*rotationOrder*/) {
+    return m_frame.camTheta;
+}
+
+const SceneWorld::SceneRef* SceneWorld::find(Entity entity) const {
+    auto found = m_entities.find(entity);
+    return found != m_entities.end() ? &found->second : NULL;
+}
+
+Entity SceneWorld::getEntityAttachedTo(Entity entity) {
+    const SceneRef* ref = find(entity);
+    return ref && ref->vehicle ? m_frame.vehicles.attachedTo[ref->idx] : 0;
+}
+
+void SceneWorld::getEntityMatrix(Entity entity, Vector3* forwardVector, Vector3* rightVector, Vector3* upVector, Vector3* position) {
+    //The player ped rides in the capture vehicle
+    if (isCaptureVehicle(entity)) {
+        *forwardVector = m_frame.vehicleForward;
+        *rightVector = m_frame.vehicleRight;
+        *upVector = m_frame.vehicleUp;
+        *position = m_frame.vehiclePos;
+        return;
+    }
+    const SceneRef* ref = find(entity);
+    if (!ref) {
+        *forwardVector = *rightVector = *upVector = *position = vec3(0, 0, 0);
+        return;
+    }
+    const EntitySnapshot& snap = snapshot(*ref);
+    *forwardVector = snap.forward[ref->idx];
+    *rightVector = snap.right[ref->idx];
+    *upVector = snap.up[ref->idx];
+    *position = snap.position[ref->idx];
+}
+
+Hash SceneWorld::getEntityModel(Entity entity) {
+    const SceneRef* ref = find(entity);
+    if (ref) return snapshot(*ref).models[ref->idx];
+    if (entity == m_frame.ownVehicle) return m_frame.ownVehicleModel;
+    auto found = m_vehicleInModels.find(entity);
+    return found != m_vehicleInModels.end() ? found->second : 0;
+}
+
+void SceneWorld::getEntityQuaternion(Entity entity, float* x, float* y, float* z, float* w) {
+    Vector3 forward, right, up, position;
+    getEntityMatrix(entity, &forward, &right, &up, &position);
+
+    //Columns of the rotation are the entity's right, forward and up axes
+    float m00 = right.x, m01 = forward.x, m02 = up.x;
+    float m10 = right.y, m11 = forward.y, m12 = up.y;
+    float m20 = right.z, m21 = forward.z, m22 = up.z;
+    float trace = m00 + m11 + m22;
+    if (trace > 0) {
+        float s = sqrt(trace + 1.0f) * 2;
+        *w = 0.25f * s;
+        *x = (m21 - m12) / s;
+        *y = (m02 - m20) / s;
+        *z = (m10 - m01) / s;
+    }
+    else if (m00 > m11 && m00 > m22) {
+        float s = sqrt(1.0f + m00 - m11 - m22) * 2;
+        *w = (m21 - m12) / s;
+        *x = 0.25f * s;
+        *y = (m01 + m10) / s;
+        *z = (m02 + m20) / s;
+    }
+    else if (m11 > m22) {
+        float s = sqrt(1.0f + m11 - m00 - m22) * 2;
+        *w = (m02 - m20) / s;
+        *x = (m01 + m10) / s;
+        *y = 0.25f * s;
+        *z = (m12 + m21) / s;
+    }
+    else {
+        float s = sqrt(1.0f + m22 - m00 - m11) * 2;
+        *w = (m10 - m01) / s;
+        *x = (m02 + m20) / s;
+        *y = (m12 + m21) / s;
+        *z = 0.25f * s;
+    }
+}
+
+Vector3 SceneWorld::getEntityRotation(Entity entity, int /*rotationOrder*/) {
+    //Outside eve the recorded camera rotation is the capture vehicle's rotation
+    if (isCaptureVehicle(entity) && !m_frame.eve) return m_frame.camTheta;
+    Vector3 forward, right, up, position;
+    getEntityMatrix(entity, &forward, &right, &up, &position);
+    return rotationFromMatrix(forward, right);
+}
+
+Vector3 SceneWorld::getEntityRotationVelocity(Entity entity) {
+    if (isCaptureVehicle(entity)) return vec3(0, 0, m_frame.yawRate * PI / 180.0);
+    return vec3(0, 0, 0);
+}
+
+float SceneWorld::getEntitySpeed(Entity entity) {
+    if (isCaptureVehicle(entity)) return m_frame.speed;
+    const SceneRef* ref = find(entity);
+    return ref ? snapshot(*ref).speed[ref->idx] : 0;
+}
+
+//World velocities, which is what the pipeline asks for (relative = false)
+Vector3 SceneWorld::getEntitySpeedVector(Entity entity, BOOL /*relative*/) {
+    if (entity == m_frame.ownVehicle || entity == SCENE_PLAYER_PED) return m_frame.ego.velocity;
+    const SceneRef* ref = find(entity);
+    return ref ? snapshot(*ref).speedVector[ref->idx] : vec3(0, 0, 0);
+}
+
+Vector3 SceneWorld::getOffsetFromEntityInWorldCoords(Entity entity, float offsetX, float offsetY, float offsetZ) {
+    Vector3 forward, right, up, position;
+    getEntityMatrix(entity, &forward, &right, &up, &position);
+    return vec3(position.x + offsetX * right.x + offsetY * forward.x + offsetZ * up.x,
+        position.y + offsetX * right.y + offsetY * forward.y + offsetZ * up.y,
+        position.z + offsetX * right.z + offsetY * forward.z + offsetZ * up.z);
+}
+
+bool SceneWorld::entityPosition(Entity entity, Vector3& position) {
+    if (!isCaptureVehicle(entity) && !find(entity)) return false;
+    Vector3 forward, right, up;
+    getEntityMatrix(entity, &forward, &right, &up, &position);
+    return true;
+}
+
+BOOL SceneWorld::hasEntityClearLosToEntity(Entity entity1, Entity entity2, int /*traceType*/) {
+    Vector3 from, to;
+    if (!entityPosition(entity1, from) || !entityPosition(entity2, to)) return FALSE;
+    float t;
+    Vector3 normal;
+    Entity hit;
+    return !traceSegment(from, to, entity1, entity2, t, normal, hit);
+}
+
+BOOL SceneWorld::isEntityAPed(Entity entity) {
+    if (entity == SCENE_PLAYER_PED) return TRUE;
+    const SceneRef* ref = find(entity);
+    return ref && !ref->vehicle;
+}
+
+BOOL SceneWorld::isEntityAVehicle(Entity entity) {
+    if (entity == m_frame.vehicle || entity == m_frame.ownVehicle) return TRUE;
+    const SceneRef* ref = find(entity);
+    return ref && ref->vehicle;
+}
+
+BOOL SceneWorld::isEntityOccluded(Entity entity) {
+    Vector3 position;
+    if (!entityPosition(entity, position)) return TRUE;
+    float t;
+    Vector3 normal;
+    Entity hit;
+    return traceSegment(m_frame.camPos, position, entity, SCENE_PLAYER_PED, t, normal, hit);
+}
+
+BOOL SceneWorld::isEntityOnScreen(Entity entity) {
+    const SceneRef* ref = find(entity);
+    return ref && snapshot(*ref).onScreen[ref->idx];
+}
+
+BOOL SceneWorld::getGroundZFor3dCoord(float x, float y, float /*z*/, float* groundZ, BOOL /*unk*/) {
+    float best = GROUND_SAMPLE_RANGE * GROUND_SAMPLE_RANGE;
+    *groundZ = m_egoGroundZ;
+    for (const Vector3& sample : m_groundSamples) {
+        float d = (sample.x - x) * (sample.x - x) + (sample.y - y) * (sample.y - y);
+        if (d < best) {
+            best = d;
+            *groundZ = sample.z;
+        }
+    }
+    return TRUE;
+}
+
+float SceneWorld::getHeadingFromVector2d(float dx, float dy) {
+    return headingFromVector2d(dx, dy);
+}
+
+float SceneWorld::getScreenAspectRatio(BOOL /*b*/) {
+    return m_frame.height > 0 ? (float)m_frame.width / m_frame.height : 16.0f / 9.0f;
+}
+
+BOOL SceneWorld::world3dToScreen2d(float worldX, float worldY, float worldZ, float* screenX, float* screenY) {
+    Eigen::Vector2f screen = get_2d_from_3d(Eigen::Vector3f(worldX, worldY, worldZ));
+    *screenX = screen.x();
+    *screenY = screen.y();
+    return screen.x() >= 0 && screen.x() <= 1 && screen.y() >= 0 && screen.y() <= 1;
+}
+
+int SceneWorld::getPedType(Ped ped) {
+    const SceneRef* ref = find(ped);
+    return ref && !ref->vehicle ? m_frame.peds.pedType[ref->idx] : 0;
+}
+
+Vehicle SceneWorld::getVehiclePedIsIn(Ped ped, BOOL /*lastVehicle*/) {
+    if (ped == SCENE_PLAYER_PED) return m_frame.ownVehicle;
+    const SceneRef* ref = find(ped);
+    if (!ref || ref->vehicle) return 0;
+    return std::max(m_frame.peds.vehicleIn[ref->idx], 0);
+}
+
+BOOL SceneWorld::isPedInAnyVehicle(Ped ped, BOOL /*atGetIn*/) {
+    if (ped == SCENE_PLAYER_PED) return m_frame.ownVehicle != 0;
+    const SceneRef* ref = find(ped);
+    return ref && !ref->vehicle && m_frame.peds.vehicleIn[ref->idx] != -1;
+}
+
+BOOL SceneWorld::isPedStopped(Ped ped) {
+    return getEntitySpeed(ped) < STOPPED_SPEED;
+}
+
+//Only the driver seat is recorded
+BOOL SceneWorld::isVehicleSeatFree(Vehicle vehicle, int /*seatIndex*/) {
+    const SceneRef* ref = find(vehicle);
+    return !ref || !ref->vehicle || m_frame.vehicles.driverSeatFree[ref->idx];
+}
+
+BOOL SceneWorld::isVehicleStopped(Vehicle vehicle) {
+    return getEntitySpeed(vehicle) < STOPPED_SPEED;
+}
+
+void SceneWorld::getModelDimensions(Hash model, Vector3* minimum, Vector3* maximum) {
+    auto found = m_models.find(model);
+    *minimum = found != m_models.end() ? found->second->min : vec3(0, 0, 0);
+    *maximum = found != m_models.end() ? found->second->max : vec3(0, 0, 0);
+}
+
+const char* SceneWorld::getDisplayNameFromVehicleModel(Hash model) {
+    //The game returns CARNOTFOUND for models which are not vehicles
+    auto found = m_models.find(model);
+    return found != m_models.end() ? found->second->displayName.c_str() : "CARNOTFOUND";
+}
+
+int SceneWorld::modelClass(Hash model) const {
+    auto found = m_models.find(model);
+    return found != m_models.end() ? found->second->classID : 9;
+}
+
+bool SceneWorld::traceSegment(const Vector3& start, const Vector3& end, Entity ignore1, Entity ignore2, float& t, Vector3& normal, Entity& entity) const {
+    //The player ped is not in the snapshots, ignoring it means ignoring the capture vehicle
+    if (ignore1 == SCENE_PLAYER_PED) ignore1 = m_frame.vehicle;
+    if (ignore2 == SCENE_PLAYER_PED) ignore2 = m_frame.vehicle;
+
+    Vector3 dir = vec3(end.x - start.x, end.y - start.y, end.z - start.z);
+    bool hit = false;
+    t = 1.0f;
+
+    //Flat ground at the capture vehicle
+    if (dir.z < 0 && start.z > m_egoGroundZ) {
+        float tg = (m_egoGroundZ - start.z) / dir.z;
+        if (tg <= t) {
+            hit = true;
+            t = tg;
+            normal = vec3(0, 0, 1);
+            entity = 0;
+        }
+    }
+
+    for (const EntitySnapshot* snap : { &m_frame.vehicles, &m_frame.peds }) {
+        for (size_t k = 0; k < snap->size(); ++k) {
+            int id = snap->ids[k];
+            if (id == ignore1 || id == ignore2) continue;
+            const ModelInfo* info = s_modelCache.find(snap->models[k]);
+            if (!info) continue;
+
+            //Slab test in the entity frame (x right, y forward, z up)
+            const Vector3 axes[3] = { snap->right[k], snap->forward[k], snap->up[k] };
+            const float mins[3] = { info->min.x, info->min.y, info->min.z };
+            const float maxs[3] = { info->max.x, info->max.y, info->max.z };
+            Vector3 rel = vec3(start.x - snap->position[k].x, start.y - snap->position[k].y, start.z - snap->position[k].z);
+            float tEnter = -1e30f, tExit = 1e30f;
+            int enterAxis = -1;
+            float enterSign = 0;
+            bool miss = false;
+            for (int a = 0; a < 3 && !miss; ++a) {
+                float o = dot(rel, axes[a]);
+                float d = dot(dir, axes[a]);
+                if (fabs(d) < 1e-8f) {
+                    miss = o < mins[a] || o > maxs[a];
+                    continue;
+                }
+                float t0 = (mins[a] - o) / d;
+                float t1 = (maxs[a] - o) / d;
+                float sign = -1;
+                if (t0 > t1) {
+                    std::swap(t0, t1);
+                    sign = 1;
+                }
+                if (t0 > tEnter) {
+                    tEnter = t0;
+                    enterAxis = a;
+                    enterSign = sign;
+                }
+                tExit = std::min(tExit, t1);
+                miss = tEnter > tExit;
+            }
+            //Segments starting inside a box (e.g. the camera on the capture vehicle) do not hit it
+            if (miss || enterAxis < 0 || tEnter < 0 || tEnter > t) continue;
+
+            hit = true;
+            t = tEnter;
+            const Vector3& axis = axes[enterAxis];
+            normal = vec3(enterSign * axis.x, enterSign * axis.y, enterSign * axis.z);
+            entity = id;
+        }
+    }
+    return hit;
+}
+
+int SceneWorld::castRayPointToPoint(float x1, float y1, float z1, float x2, float y2, float z2, int /*flags*/, Entity ignore, int /*p8*/) {
+    int handle = m_nextRay++;
+    if (m_nextRay <= 0) m_nextRay = 1;
+
+    RayResult& ray = m_rays[handle % RAY_SLOTS];
+    Vector3 start = vec3(x1, y1, z1);
+    float t;
+    ray.entity = 0;
+    ray.normal = vec3(0, 0, 0);
+    ray.hit = traceSegment(start, vec3(x2, y2, z2), ignore, ignore, t, ray.normal, ray.entity);
+    ray.end = ray.hit ? vec3(x1 + t * (x2 - x1), y1 + t * (y2 - y1), z1 + t * (z2 - z1)) : vec3(0, 0, 0);
+    return handle;
+}
+
+int SceneWorld::getRaycastResult(int rayHandle, BOOL* hit, Vector3* endCoords, Vector3* surfaceNormal, Entity* entityHit) {
+    const RayResult& ray = m_rays[rayHandle % RAY_SLOTS];
+    *hit = ray.hit;
+    *endCoords = ray.end;
+    *surfaceNormal = ray.normal;
+    *entityHit = ray.entity;
+    //Results are ready immediately
+    return 2;
+}
+
+int SceneWorld::getAllVehicles(int* arr, int arrSize) {
+    int count = std::min((int)m_frame.vehicles.size(), arrSize);
+    std::copy(m_frame.vehicles.ids.begin(), m_frame.vehicles.ids.begin() + count, arr);
+    return count;
+}
+
+int SceneWorld::getAllPeds(int* arr, int arrSize) {
+    int count = std::min((int)m_frame.peds.size(), arrSize);
+    std::copy(m_frame.peds.ids.begin(), m_frame.peds.ids.begin() + count, arr);
+    return count;
+}
+
+void SceneWorld::indexFrame() {
+    m_entities.clear();
+    m_vehicleInModels.clear();
+    m_models.clear();
+    m_groundSamples.clear();
+
+    for (const RecordedModel& m : m_frame.models) {
+        m_models[m.model] = &m.info;
+    }
+
+    for (size_t k = 0; k < m_frame.vehicles.size(); ++k) {
+        m_entities[m_frame.vehicles.ids[k]] = SceneRef{ true, (int)k };
+        const ModelInfo* info = s_modelCache.find(m_frame.vehicles.models[k]);
+        if (info) {
+            const Vector3& p = m_frame.vehicles.position[k];
+            m_groundSamples.push_back(vec3(p.x, p.y, p.z + info->min.z));
+        }
+    }
+    for (size_t k = 0; k < m_frame.peds.size(); ++k) {
+        m_entities[m_frame.peds.ids[k]] = SceneRef{ false, (int)k };
+        if (m_frame.peds.inRange[k]) {
+            const Vector3& p = m_frame.peds.position[k];
+            m_groundSamples.push_back(vec3(p.x, p.y, m_frame.peds.groundZ[k]));
+        }
+        if (m_frame.peds.vehicleIn[k] > 0) {
+            m_vehicleInModels[m_frame.peds.vehicleIn[k]] = m_frame.peds.vehicleInModel[k];
+        }
+    }
+
+    const ModelInfo* own = s_modelCache.find(m_frame.ownVehicleModel);
+    m_egoGroundZ = m_frame.vehiclePos.z + (own ? own->min.z : 0);
+    m_groundSamples.push_back(vec3(m_frame.vehiclePos.x, m_frame.vehiclePos.y, m_egoGroundZ));
+}
+
+bool RecordedWorld::load(const std::string& worldStateFile) {
+    WorldStateFrame state;
+    if (!readWorldState(worldStateFile, state)) return false;
+    m_frame = std::move(state);
+    for (const RecordedModel& m : m_frame.models) {
+        s_modelCache.add(m.model, m.info);
+    }
+    indexFrame();
+    return true;
+}
+
+SyntheticWorld::SyntheticWorld(int width, int height, int vehicleCount, int pedCount, uint32_t seed) {
+    m_frame.width = width;
+    m_frame.height = height;
+    m_frame.nearClip = 0.15f;
+    m_frame.farClip = 10001.5f;
+    m_frame.fov = 59;
+    m_frame.ncHeight = 2 * m_frame.nearClip * tan(m_frame.fov / 2. * (PI / 180.));
+    m_frame.ncWidth = m_frame.ncHeight * width / height;
+    m_frame.vehicle = 1;
+    m_frame.ownVehicle = 1;
+    m_frame.ownVehicleModel = SYNTH_CAR_MODEL;
+    m_frame.timeHours = 12;
+    seedModels();
+
+    //Ego lane is x = 0. Oncoming traffic at x = -3.5, same direction at 3.5 and 7, pavements at +-10.
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> along(-150, 150);
+    std::uniform_real_distribution<float> carSpeed(8, 16);
+    std::uniform_real_distribution<float> walkSpeed(0.8f, 1.8f);
+    const float lanes[] = { -3.5f, 3.5f, 7.0f };
+    for (int k = 0; k < vehicleCount; ++k) {
+        float x = lanes[k % 3];
+        float speed = carSpeed(rng);
+        m_vehicles.push_back(Mover{ 100 + k, x, along(rng), x < 0 ? -speed : speed });
+    }
+    for (int k = 0; k < pedCount; ++k) {
+        float speed = walkSpeed(rng);
+        m_peds.push_back(Mover{ 10000 + k, k % 2 ? 10.0f : -10.0f, along(rng), k % 4 < 2 ? speed : -speed });
+    }
+    buildFrame();
+}
+
+void SyntheticWorld::seedModels() {
+    ModelInfo car;
+    car.min = vec3(-0.95f, -2.3f, -0.6f);
+    car.max = vec3(0.95f, 2.3f, 0.9f);
+    car.radius = sqrt(0.95f * 0.95f + 2.3f * 2.3f + 0.9f * 0.9f);
+    car.classID = 0;
+    car.displayName = "SYNTHCAR";
+    car.lookupName = "synthcar";
+    car.vehicleType = VEHICLE_TYPE_CAR;
+    car.inLookup = true;
+    car.type = VEHICLE_TYPE_NAMES[VEHICLE_TYPE_CAR];
+    car.isTrailer = false;
+    s_modelCache.add(SYNTH_CAR_MODEL, car);
+
+    ModelInfo ped;
+    ped.min = vec3(-0.3f, -0.3f, -1.0f);
+    ped.max = vec3(0.3f, 0.3f, 0.8f);
+    ped.radius = sqrt(0.3f * 0.3f + 0.3f * 0.3f + 1.0f * 1.0f);
+    ped.classID = 9;
+    ped.displayName = "SYNTHPED";
+    ped.lookupName = "synthped";
+    ped.vehicleType = VEHICLE_TYPE_UNKNOWN;
+    ped.inLookup = false;
+    ped.type = "Unknown";
+    ped.isTrailer = false;
+    s_modelCache.add(SYNTH_PED_MODEL, ped);
+}
+
+void SyntheticWorld::step(float dt) {
+    m_time += dt;
+    m_egoY += m_egoSpeed * dt;
+    //Traffic is kept within 150m of the capture vehicle
+    for (std::vector<Mover>* movers : { &m_vehicles, &m_peds }) {
+        for (Mover& m : *movers) {
+            m.y += m.speed * dt;
+            if (m.y - m_egoY > 150) m.y -= 300;
+            else if (m.y - m_egoY < -150) m.y += 300;
+        }
+    }
+    buildFrame();
+}
+
+void SyntheticWorld::buildFrame() {
+    const Vector3 north = vec3(0, 1, 0), south = vec3(0, -1, 0);
+    const Vector3 east = vec3(1, 0, 0), west = vec3(-1, 0, 0);
+    const Vector3 up = vec3(0, 0, 1);
+
+    m_frame.vehicleForward = north;
+    m_frame.vehicleRight = east;
+    m_frame.vehicleUp = up;
+    m_frame.vehiclePos = vec3(0, m_egoY, 0.6f);
+    m_frame.kittiWorldPos = vec3(0, m_egoY, 0);
+    m_frame.camPos = vec3(0, m_egoY + CAM_OFFSET_FORWARD, 0.6f + CAM_OFFSET_UP);
+    m_frame.camTheta = vec3(0, 0, 0);
+    m_frame.camForward = north;
+    m_frame.camRight = east;
+    m_frame.camUp = up;
+    m_frame.heading = atan2(north.y, north.x);
+    m_frame.roll = 0;
+    m_frame.pitch = 0;
+    m_frame.speed = m_egoSpeed;
+    m_frame.yawRate = 0;
+    m_frame.ego.velocity = vec3(0, m_egoSpeed, 0);
+    m_frame.ego.worldCoords = m_frame.vehiclePos;
+
+    float tanV = tan(m_frame.fov / 2. * (PI / 180.));
+    float tanH = tanV * m_frame.width / m_frame.height;
+    auto fill = [&](EntitySnapshot& snap, const std::vector<Mover>& movers, Hash model, float originZ, bool vehicles) {
+        snap.resize(movers.size());
+        for (size_t k = 0; k < movers.size(); ++k) {
+            const Mover& m = movers[k];
+            bool northbound = m.speed >= 0;
+            snap.ids[k] = m.id;
+            snap.models[k] = model;
+            snap.forward[k] = northbound ? north : south;
+            snap.right[k] = northbound ? east : west;
+            snap.up[k] = up;
+            snap.position[k] = vec3(m.x, m.y, originZ);
+            Vector3 rel = vec3(m.x - m_frame.camPos.x, m.y - m_frame.camPos.y, originZ - m_frame.camPos.z);
+            snap.distance[k] = sqrt(dot(rel, rel));
+            bool onScreen = rel.y > 0 && fabs(rel.x) < rel.y * tanH && fabs(rel.z) < rel.y * tanV;
+            snap.cullTier[k] = onScreen ? CULL_TIER_FULL : CULL_TIER_AUGMENT;
+            snap.inRange[k] = 1;
+            snap.onScreen[k] = onScreen;
+            snap.pedType[k] = vehicles ? 0 : 4;
+            snap.speed[k] = fabs(m.speed);
+            snap.speedVector[k] = vec3(0, m.speed, 0);
+            snap.worldCoords[k] = snap.position[k];
+        }
+    };
+    fill(m_frame.vehicles, m_vehicles, SYNTH_CAR_MODEL, 0.6f, true);
+    fill(m_frame.peds, m_peds, SYNTH_PED_MODEL, 1.0f, false);
+
+    m_frame.models.clear();
+    m_frame.models.push_back(RecordedModel{ SYNTH_CAR_MODEL, *s_modelCache.find(SYNTH_CAR_MODEL) });
+    m_frame.models.push_back(RecordedModel{ SYNTH_PED_MODEL, *s_modelCache.find(SYNTH_PED_MODEL) });
+    indexFrame();
+}
+
+void SyntheticWorld::render(std::vector<float>& depth, std::vector<uint8_t>& stencil) const {
+    const WorldStateFrame& f = m_frame;
+    depth.assign((size_t)f.width * f.height, 0);
+    stencil.assign((size_t)f.width * f.height, RENDER_STENCIL_SKY);
+
+    for (int j = 0; j < f.height; ++j) {
+        for (int i = 0; i < f.width; ++i) {
+            //Ray through the pixel on the near clip plane, as depthToCamCoords unprojects it
+            float ncX = (2 * i / float(f.width - 1) - 1.0f) * f.ncWidth / 2;
+            float ncY = (2 * j / float(f.height - 1) - 1.0f) * f.ncHeight / 2;
+            float d2nc = sqrt(f.nearClip * f.nearClip + ncX * ncX + ncY * ncY);
+            Vector3 dir = vec3((ncX * f.camRight.x + f.nearClip * f.camForward.x - ncY * f.camUp.x) / d2nc,
+                (ncX * f.camRight.y + f.nearClip * f.camForward.y - ncY * f.camUp.y) / d2nc,
+                (ncX * f.camRight.z + f.nearClip * f.camForward.z - ncY * f.camUp.z) / d2nc);
+            Vector3 end = vec3(f.camPos.x + RENDER_RANGE * dir.x, f.camPos.y + RENDER_RANGE * dir.y, f.camPos.z + RENDER_RANGE * dir.z);
+
+            float t;
+            Vector3 normal;
+            Entity entity;
+            if (!traceSegment(f.camPos, end, f.vehicle, f.vehicle, t, normal, entity)) continue;
+
+            //Inverse of the depth correction in depthToCamCoords
+            float distance = t * RENDER_RANGE;
+            float bufferDepth = distance / (1 - f.nearClip * distance / (2 * f.farClip));
+            size_t idx = (size_t)j * f.width + i;
+            depth[idx] = d2nc / bufferDepth;
+            const SceneRef* ref = entity ? find(entity) : NULL;
+            stencil[idx] = !ref ? RENDER_STENCIL_GROUND : ref->vehicle ? RENDER_STENCIL_VEHICLE : RENDER_STENCIL_NPC;
+        }
+    }
+}
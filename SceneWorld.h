@@ -0,0 +1,156 @@
+#pragma once
+
+#include "World.h"
+#include "WorldState.h"
+#include <stdint.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+//Player ped of a scene. It sits in the capture vehicle (frame().ownVehicle).
+const int SCENE_PLAYER_PED = 0x7FFFFFF0;
+
+//World answered from a WorldStateFrame instead of the game.
+//Entity queries come from the vehicle/ped snapshots, the capture vehicle from the frame fields.
+//What the frame does not hold is approximated:
+//  ground height    nearest recorded sample (ped ground heights, vehicle bottoms), then the capture vehicle's ground
+//  raycasts/LOS     entity boxes (model dimensions) and a flat ground plane at the capture vehicle's ground
+//  stopped          speed under 0.1 m/s
+//  models           the frame's recorded model infos, unknown models are an unknown class with empty bounds
+//  drawing          ignored
+class SceneWorld : public IWorld {
+public:
+    const WorldStateFrame& frame() const { return m_frame; }
+
+    Cam getRenderingCam() override;
+    Vector3 getCamCoord(Cam cam) override;
+    Vector3 getCamRot(Cam cam, int rotationOrder) override;
+
+    Entity getEntityAttachedTo(Entity entity) override;
+    void getEntityMatrix(Entity entity, Vector3* forwardVector, Vector3* rightVector, Vector3* upVector, Vector3* position) override;
+    Hash getEntityModel(Entity entity) override;
+    void getEntityQuaternion(Entity entity, float* x, float* y, float* z, float* w) override;
+    Vector3 getEntityRotation(Entity entity, int rotationOrder) override;
+    Vector3 getEntityRotationVelocity(Entity entity) override;
+    float getEntitySpeed(Entity entity) override;
+    Vector3 getEntitySpeedVector(Entity entity, BOOL relative) override;
+    Vector3 getOffsetFromEntityInWorldCoords(Entity entity, float offsetX, float offsetY, float offsetZ) override;
+    BOOL hasEntityClearLosToEntity(Entity entity1, Entity entity2, int traceType) override;
+    BOOL isEntityAPed(Entity entity) override;
+    BOOL isEntityAVehicle(Entity entity) override;
+    BOOL isEntityOccluded(Entity entity) override;
+    BOOL isEntityOnScreen(Entity entity) override;
+
+    BOOL getGroundZFor3dCoord(float x, float y, float z, float* groundZ, BOOL unk) override;
+    float getHeadingFromVector2d(float dx, float dy) override;
+    void getModelDimensions(Hash model, Vector3* minimum, Vector3* maximum) override;
+
+    void drawLine(float, float, float, float, float, float, int, int, int, int) override {}
+    float getScreenAspectRatio(BOOL b) override;
+    BOOL world3dToScreen2d(float worldX, float worldY, float worldZ, float* screenX, float* screenY) override;
+
+    int getPedType(Ped ped) override;
+    Vehicle getVehiclePedIsIn(Ped ped, BOOL lastVehicle) override;
+    BOOL isPedInAnyVehicle(Ped ped, BOOL atGetIn) override;
+    BOOL isPedStopped(Ped ped) override;
+    Ped playerPedId() override { return SCENE_PLAYER_PED; }
+
+    int getClockHours() override { return m_frame.timeHours; }
+
+    BOOL isVehicleSeatFree(Vehicle vehicle, int seatIndex) override;
+    BOOL isVehicleStopped(Vehicle vehicle) override;
+    const char* getDisplayNameFromVehicleModel(Hash model) override;
+    BOOL isThisModelACar(Hash model) override { return modelClass(model) == 0; }
+    BOOL isThisModelABike(Hash model) override { return modelClass(model) == 1; }
+    BOOL isThisModelABicycle(Hash model) override { return modelClass(model) == 2; }
+    BOOL isThisModelAQuadbike(Hash model) override { return modelClass(model) == 3; }
+    BOOL isThisModelABoat(Hash model) override { return modelClass(model) == 4; }
+    BOOL isThisModelAPlane(Hash model) override { return modelClass(model) == 5; }
+    BOOL isThisModelAHeli(Hash model) override { return modelClass(model) == 6; }
+    BOOL isThisModelATrain(Hash model) override { return modelClass(model) == 7; }
+    BOOL isThisModelASubmersible(Hash model) override { return modelClass(model) == 8; }
+
+    int castRayPointToPoint(float x1, float y1, float z1, float x2, float y2, float z2, int flags, Entity ignore, int p8) override;
+    int getRaycastResult(int rayHandle, BOOL* hit, Vector3* endCoords, Vector3* surfaceNormal, Entity* entityHit) override;
+
+    int getAllVehicles(int* arr, int arrSize) override;
+    int getAllPeds(int* arr, int arrSize) override;
+
+protected:
+    //Rebuilds the entity lookup and ground samples. Call after m_frame changes (model infos must be in s_modelCache).
+    void indexFrame();
+
+    WorldStateFrame m_frame;
+
+    struct SceneRef {
+        bool vehicle;
+        int idx;
+    };
+    const SceneRef* find(Entity entity) const;
+    //Nearest box or ground hit on the segment from start to end (fraction along it in t)
+    bool traceSegment(const Vector3& start, const Vector3& end, Entity ignore1, Entity ignore2, float& t, Vector3& normal, Entity& entity) const;
+
+private:
+    struct RayResult {
+        bool hit;
+        Vector3 end;
+        Vector3 normal;
+        Entity entity;
+    };
+
+    const EntitySnapshot& snapshot(const SceneRef& ref) const { return ref.vehicle ? m_frame.vehicles : m_frame.peds; }
+    bool isCaptureVehicle(Entity entity) const { return entity == SCENE_PLAYER_PED || entity == m_frame.vehicle; }
+    //Position of an entity, false if it is not in the scene
+    bool entityPosition(Entity entity, Vector3& position);
+    //Recorded class of a model (9 if the frame does not have it)
+    int modelClass(Hash model) const;
+
+    std::unordered_map<int, SceneRef> m_entities;
+    std::unordered_map<int, Hash> m_vehicleInModels;//Vehicles only known from the peds in them
+    std::unordered_map<Hash, const ModelInfo*> m_models;//Into m_frame.models
+    std::vector<Vector3> m_groundSamples;
+    float m_egoGroundZ = 0;
+
+    static const int RAY_SLOTS = 64;
+    RayResult m_rays[RAY_SLOTS];
+    int m_nextRay = 1;
+};
+
+//Replays recorded world states (worldState/*.bin) through the same queries the live collection made
+class RecordedWorld final : public SceneWorld {
+public:
+    //Also seeds s_modelCache with the recorded model infos
+    bool load(const std::string& worldStateFile);
+};
+
+//Procedural scene for benchmarks and for running the pipeline without the game: the capture vehicle drives
+//north on a straight road with traffic in the neighbouring lanes and pedestrians on both pavements.
+//render traces depth and stencil buffers for the frame (entity boxes on a flat ground plane).
+class SyntheticWorld final : public SceneWorld {
+public:
+    SyntheticWorld(int width, int height, int vehicleCount = 40, int pedCount = 20, uint32_t seed = 1);
+
+    //Advances the scene by dt seconds
+    void step(float dt = 0.1f);
+
+    //Depth as the game's depth buffer holds it (NDC, see depthToCamCoords) and the stencil types of the hits.
+    //Pixels which hit nothing within 300m are sky.
+    void render(std::vector<float>& depth, std::vector<uint8_t>& stencil) const;
+
+private:
+    void seedModels();
+    void buildFrame();
+
+    struct Mover {
+        int id;
+        float x;
+        float y;
+        float speed;
+    };
+
+    std::vector<Mover> m_vehicles;
+    std::vector<Mover> m_peds;
+    float m_egoY = 0;
+    float m_egoSpeed = 12.0f;
+    float m_time = 0;
+};
@@ -0,0 +1,190 @@
+#include "Settings.h"
+#include <Eigen/Core>
+#include "Constants.h"
+#include "InstanceMasks.h"
+#include "Logger.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <fstream>
+
+//Every runtime setting with its default (declared and documented in Constants.h)
+#define DEEPGTAV_SETTINGS(X) \
+    X(bool, SAME_TIME_OF_DAY, true) \
+    X(bool, DRIVE_SPEC_AREA, true) \
+    X(bool, START_SPEC_AREA, true) \
+    X(bool, GENERATE_2D_POINTMAP, false) \
+    X(bool, OUTPUT_RAYCAST_POINTS, false) \
+    X(bool, USE_RAYCASTING, false) \
+    X(bool, OUTPUT_DM_POINTCLOUD, false) \
+    X(bool, OUTPUT_FULL_DM_POINTCLOUD, false) \
+    X(bool, OUTPUT_OFFSET_POINTCLOUDS, false) \
+    X(bool, RETAIN_ANIMALS, true) \
+    X(bool, OUTPUT_OCCLUSION_IMAGE, false) \
+    X(bool, OUTPUT_UNUSED_PIXELS_IMAGE, false) \
+    X(bool, OBTAIN_RAY_POINTS_HIT, false) \
+    X(bool, OUTPUT_ADJUSTED_POINTS, false) \
+    X(bool, CORRECT_2D_POINTS_BEHIND_CAMERA, false) \
+    X(bool, LIDAR_GAUSSIAN_NOISE, false) \
+    X(double, DEPTH_NOISE_STDDEV, 0.006) \
+    X(double, DEPTH_NOISE_MEAN, 0.0) \
+    X(bool, PROCESS_PEDS_ON_BIKES, true) \
+    X(bool, TESTING_PEDS_ON_BIKES, true) \
+    X(bool, OUTPUT_DEPTH_STATS, false) \
+    X(float, GROUND_POINT_MAX_DIST, 0.1) \
+    X(bool, OUTPUT_GROUND_PIXELS, false) \
+    X(bool, OUTPUT_SEPARATE_STENCILS, true) \
+    X(bool, OUTPUT_STENCIL_IMAGE, false) \
+    X(bool, ONLY_OUTPUT_UNKNOWN_STENCILS, true) \
+    X(bool, GENERATE_SECONDARY_PERSPECTIVES, false) \
+    X(int, SECONDARY_PERSPECTIVE_RANGE, 100) \
+    X(bool, ONLY_OCCUPIED_VEHICLES, true) \
+    X(bool, TRUPERCEPT_SCENARIO, false) \
+    X(bool, OUTPUT_SELF_LOCATION, true) \
+    X(bool, OUTPUT_UNPROCESSED_LABELS, false) \
+    X(bool, OUTPUT_BINARY_LABELS, false) \
+    X(bool, PROCESS_OVERLAPPING_POINTS, false) \
+    X(bool, MERGE_TRAILER_SEGMENTATION, false) \
+    X(bool, AUGMENT_ALL_VEHICLES_IN_RANGE, true) \
+    X(bool, ENABLE_ENTITY_CULLING, true) \
+    X(bool, OUTPUT_CULL_STATS, false) \
+    X(bool, REUSE_ENTITY_STATE, true) \
+    X(float, ENTITY_POSE_EPSILON, 0.001f) \
+    X(bool, OUTPUT_ENTITY_STATE_STATS, false) \
+    X(bool, OUTPUT_TRACKING_LABELS, true) \
+    X(int, TRACK_EVICT_FRAMES, 10) \
+    X(bool, OUTPUT_WORLD_STATE, false) \
+    X(bool, COMPRESS_DEPTH_BUFFER, true) \
+    X(bool, LOSSY_DEPTH_COMPRESSION, false) \
+    X(float, LOSSY_DEPTH_MAX_ERROR, 0.01f) \
+    X(float, LOSSY_DEPTH_REF_DIST, MAX_LIDAR_DIST) \
+    X(bool, OUTPUT_DEPTH_COMPRESSION_STATS, false) \
+    X(int, INSTANCE_MASK_FORMAT, INSTANCE_MASK_RLE) \
+    X(bool, OUTPUT_INSTANCE_SEG_PNG, false) \
+    X(bool, OUTPUT_INSTANCE_SEG_IMAGE, false) \
+    X(bool, PUBLISH_FRAME_RING, false) \
+    X(int, FRAME_RING_SLOTS, 4) \
+    X(int, FRAME_RING_EXTRA_BYTES, 8 * 1024 * 1024) \
+    X(int, FRAMES_IN_FLIGHT, 1) \
+    X(bool, USE_FRAME_BUDGET, false) \
+    X(float, FRAME_BUDGET_MS, 100.0f)
+
+#define DEFINE_SETTING(type, name, value) type name = value;
+DEEPGTAV_SETTINGS(DEFINE_SETTING)
+
+namespace {
+
+enum SettingType { SETTING_BOOL, SETTING_INT, SETTING_FLOAT, SETTING_DOUBLE };
+
+struct SettingEntry {
+    const char* name;
+    SettingType type;
+    void* value;
+};
+
+SettingType settingType(bool*) { return SETTING_BOOL; }
+SettingType settingType(int*) { return SETTING_INT; }
+SettingType settingType(float*) { return SETTING_FLOAT; }
+SettingType settingType(double*) { return SETTING_DOUBLE; }
+
+#define SETTING_ENTRY(type, name, value) { #name, settingType(&name), &name },
+const SettingEntry SETTINGS[] = {
+    DEEPGTAV_SETTINGS(SETTING_ENTRY)
+};
+
+const SettingEntry* findSetting(const std::string& name) {
+    for (const SettingEntry& s : SETTINGS) {
+        if (name == s.name) return &s;
+    }
+    return NULL;
+}
+
+std::string trim(const std::string& s) {
+    size_t start = s.find_first_not_of(" \t\r");
+    if (start == std::string::npos) return "";
+    size_t end = s.find_last_not_of(" \t\r");
+    return s.substr(start, end - start + 1);
+}
+
+bool parseValue(const SettingEntry& s, const std::string& text) {
+    char* end = NULL;
+    switch (s.type) {
+    case SETTING_BOOL:
+        if (text == "true" || text == "1") *(bool*)s.value = true;
+        else if (text == "false" || text == "0") *(bool*)s.value = false;
+        else return false;
+        return true;
+    case SETTING_INT: {
+        long v = strtol(text.c_str(), &end, 0);
+        if (*end != '\0') return false;
+        *(int*)s.value = (int)v;
+        return true;
+    }
+    case SETTING_FLOAT:
+    case SETTING_DOUBLE: {
+        double v = strtod(text.c_str(), &end);
+        if (*end != '\0' && !(*end == 'f' && end[1] == '\0')) return false;
+        if (s.type == SETTING_FLOAT) *(float*)s.value = (float)v;
+        else *(double*)s.value = v;
+        return true;
+    }
+    }
+    return false;
+}
+
+}
+
+std::string settingsFile() {
+    const char* path = getenv("DEEPGTAV_SETTINGS");
+    return path ? path : "DeepGTAVSettings.ini";
+}
+
+bool loadSettings(const std::string& file) {
+    std::ifstream in(file);
+    if (!in) {
+        LOG_INFO("No settings file at " << file << ", using the defaults");
+        return false;
+    }
+
+    std::string line;
+    int lineNumber = 0;
+    int applied = 0;
+    while (std::getline(in, line)) {
+        ++lineNumber;
+        size_t comment = std::min(line.find('#'), line.find("//"));
+        if (comment != std::string::npos) line.resize(comment);
+        line = trim(line);
+        if (line.empty()) continue;
+
+        size_t eq = line.find('=');
+        std::string name = trim(line.substr(0, eq));
+        const SettingEntry* s = eq == std::string::npos ? NULL : findSetting(name);
+        if (!s) {
+            LOG_WARN(file << ":" << lineNumber << ": unknown setting '" << name << "'");
+            continue;
+        }
+        if (!parseValue(*s, trim(line.substr(eq + 1)))) {
+            LOG_WARN(file << ":" << lineNumber << ": bad value for " << name);
+            continue;
+        }
+        ++applied;
+    }
+    LOG_INFO("Loaded " << applied << " settings from " << file);
+    return true;
+}
+
+bool writeSettings(const std::string& file) {
+    FILE* f = fopen(file.c_str(), "w");
+    if (!f) return false;
+    for (const SettingEntry& s : SETTINGS) {
+        switch (s.type) {
+        case SETTING_BOOL: fprintf(f, "%s = %s\n", s.name, *(bool*)s.value ? "true" : "false"); break;
+        case SETTING_INT: fprintf(f, "%s = %d\n", s.name, *(int*)s.value); break;
+        case SETTING_FLOAT: fprintf(f, "%s = %.9g\n", s.name, *(float*)s.value); break;
+        case SETTING_DOUBLE: fprintf(f, "%s = %.17g\n", s.name, *(double*)s.value); break;
+        }
+    }
+    fclose(f);
+    return true;
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <string>
+
+//Runtime values of the feature switches declared in Constants.h, so dataset variants don't need a rebuild.
+//The settings file has one NAME = value per line, with the names used in Constants.h. Bools are true/false (or 1/0).
+//Everything after # or // is a comment and settings which aren't in the file keep their defaults.
+//
+//    OUTPUT_DM_POINTCLOUD = true
+//    USE_RAYCASTING = false   # depth map LiDAR
+//
+//Settings are loaded once at initCollection/initReplay. Loops that test them per pixel or per LiDAR beam pick
+//a template instantiation once (per LiDAR init or per frame) instead, see LiDAR::allocateBuffers and
+//ObjectDetection::fillStencilImage/fillDepthOutputs.
+
+//DEEPGTAV_SETTINGS if set, DeepGTAVSettings.ini in the working directory otherwise
+std::string settingsFile();
+//Returns false if the file could not be opened (the current values are kept)
+bool loadSettings(const std::string& file);
+//Writes the current values in the settings file format
+bool writeSettings(const std::string& file);
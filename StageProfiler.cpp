@@ -0,0 +1,118 @@
+#include "StageProfiler.h"
+
+#ifdef PROFILE_STAGES
+
+#include <algorithm>
+
+StageProfiler s_stageProfiler;
+
+static const char* const STAGE_NAMES[STAGE_COUNT] = {
+    "generateMessage",
+    "setPosition",
+    "setEgoSnapshot",
+    "outputRealSpeed",
+    "setDepthAndStencil",
+    "frameRing",
+    "snapshotWorld",
+    "setPedsList",
+    "setVehiclesList",
+    "speed/yawRate/time",
+    "recordWorldState",
+    "setFocalLength",
+    "processSegmentation2D",
+    "processSegmentation3D",
+    "processOcclusion",
+    "collectLiDAR",
+    "update3DPointsHit",
+    "printSegImage",
+    "outputOcclusion",
+    "outputUnusedStencilPixels",
+    "setGroundPlanePoints",
+    "exportDetections",
+    "exportImage",
+};
+
+StageProfiler::StageProfiler() {
+    m_epoch = std::chrono::steady_clock::now();
+    m_current.frame = -1;
+    resetCurrent();
+}
+
+StageProfiler::~StageProfiler() {
+    endFrame();
+    if (m_percentileFile) fclose(m_percentileFile);
+    if (m_traceFile) {
+        fputs("\n]\n", m_traceFile);
+        fclose(m_traceFile);
+    }
+}
+
+bool StageProfiler::open(const std::string& percentileFile, const std::string& traceFile) {
+    if (m_percentileFile) return true;
+    m_percentileFile = fopen(percentileFile.c_str(), "w");
+    if (!m_percentileFile) return false;
+    fprintf(m_percentileFile, "frame,stage,frames,p50_ms,p90_ms,p99_ms,max_ms\n");
+    m_traceFile = fopen(traceFile.c_str(), "w");
+    if (m_traceFile) fputs("[", m_traceFile);
+    return true;
+}
+
+void StageProfiler::beginFrame(int frame) {
+    endFrame();
+    m_current.frame = frame;
+}
+
+void StageProfiler::endFrame() {
+    if (m_current.frame >= 0) {
+        for (int s = 0; s < STAGE_COUNT; ++s) {
+            m_window[m_windowPos][s] = m_current.totalUs[s];
+        }
+        m_windowPos = (m_windowPos + 1) % STAGE_WINDOW;
+        m_windowCount = std::min(m_windowCount + 1, STAGE_WINDOW);
+
+        writeTrace();
+        if (++m_framesSinceReport >= STAGE_REPORT_INTERVAL) {
+            writePercentiles();
+            m_framesSinceReport = 0;
+        }
+    }
+    m_current.frame = -1;
+    resetCurrent();
+}
+
+void StageProfiler::resetCurrent() {
+    for (int s = 0; s < STAGE_COUNT; ++s) {
+        m_current.totalUs[s] = 0.0;
+    }
+    m_current.eventCount = 0;
+}
+
+void StageProfiler::writeTrace() {
+    if (!m_traceFile) return;
+    for (int k = 0; k < m_current.eventCount; ++k) {
+        const StageEvent& e = m_current.events[k];
+        fprintf(m_traceFile, "%s\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.1f,\"dur\":%.1f,\"args\":{\"frame\":%d}}",
+            m_firstTraceEvent ? "" : ",", STAGE_NAMES[e.stage], e.startUs, e.durUs, m_current.frame);
+        m_firstTraceEvent = false;
+    }
+    fflush(m_traceFile);
+}
+
+void StageProfiler::writePercentiles() {
+    if (!m_percentileFile) return;
+    double values[STAGE_WINDOW];
+    for (int s = 0; s < STAGE_COUNT; ++s) {
+        for (int k = 0; k < m_windowCount; ++k) {
+            values[k] = m_window[k][s];
+        }
+        std::sort(values, values + m_windowCount);
+        //Nearest rank
+        auto pct = [&](double p) { return values[std::min(m_windowCount - 1, (int)(p * m_windowCount))] / 1000.0; };
+        if (values[m_windowCount - 1] == 0.0) continue;
+        fprintf(m_percentileFile, "%d,%s,%d,%.3f,%.3f,%.3f,%.3f\n", m_current.frame, STAGE_NAMES[s], m_windowCount,
+            pct(0.5), pct(0.9), pct(0.99), values[m_windowCount - 1] / 1000.0);
+    }
+    fflush(m_percentileFile);
+}
+
+#endif
@@ -0,0 +1,129 @@
+#pragma once
+
+//Wall time of each stage of generateMessage (and of exportDetections/exportImage), per frame
+//Only built when PROFILE_STAGES is defined. Otherwise the macros below expand to the bare statement and there is no cost at all.
+//
+//    TIMED_STAGE(STAGE_OCCLUSION, processOcclusion());   times one statement
+//    STAGE_SCOPE(STAGE_EXPORT_IMAGE);                    times the rest of the enclosing block
+//
+//A frame is recorded into a fixed record (no locks, no allocation) and written when the next frame begins:
+//  StageTimes.csv   every STAGE_REPORT_INTERVAL frames, p50/p90/p99/max of each stage over the last STAGE_WINDOW frames
+//  StageTrace.json  every timed stage as a Chrome trace event (chrome://tracing or ui.perfetto.dev)
+
+enum StageId {
+    STAGE_GENERATE_MESSAGE,
+    STAGE_SET_POSITION,
+    STAGE_EGO_SNAPSHOT,
+    STAGE_REAL_SPEED,
+    STAGE_DEPTH_STENCIL,
+    STAGE_FRAME_RING,
+    STAGE_SNAPSHOT_WORLD,
+    STAGE_PEDS_LIST,
+    STAGE_VEHICLES_LIST,
+    STAGE_FRAME_VALUES,
+    STAGE_RECORD_WORLD_STATE,
+    STAGE_FOCAL_LENGTH,
+    STAGE_SEGMENTATION_2D,
+    STAGE_SEGMENTATION_3D,
+    STAGE_OCCLUSION,
+    STAGE_COLLECT_LIDAR,
+    STAGE_POINTS_HIT,
+    STAGE_SEG_IMAGE,
+    STAGE_OUTPUT_OCCLUSION,
+    STAGE_UNUSED_STENCIL,
+    STAGE_GROUND_PLANE,
+    STAGE_EXPORT_DETECTIONS,
+    STAGE_EXPORT_IMAGE,
+    STAGE_COUNT
+};
+
+#ifdef PROFILE_STAGES
+
+#include <stdint.h>
+#include <stdio.h>
+#include <chrono>
+#include <string>
+
+const int STAGE_WINDOW = 300;
+const int STAGE_REPORT_INTERVAL = 100;
+//Trace events kept per frame, later ones are only counted in the totals
+const int STAGE_MAX_EVENTS = 64;
+
+struct StageEvent {
+    StageId stage;
+    double startUs;
+    double durUs;
+};
+
+struct StageFrameRecord {
+    int frame;
+    double totalUs[STAGE_COUNT];
+    int eventCount;
+    StageEvent events[STAGE_MAX_EVENTS];
+};
+
+class StageProfiler {
+public:
+    StageProfiler();
+    ~StageProfiler();
+
+    bool open(const std::string& percentileFile, const std::string& traceFile);
+
+    //Writes the previous frame (if any) and starts recording frame
+    void beginFrame(int frame);
+    //Writes and resets the record without starting a new frame
+    void endFrame();
+
+    double nowUs() const {
+        return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - m_epoch).count();
+    }
+    void record(StageId stage, double startUs, double durUs) {
+        m_current.totalUs[stage] += durUs;
+        if (m_current.eventCount < STAGE_MAX_EVENTS) {
+            m_current.events[m_current.eventCount++] = { stage, startUs, durUs };
+        }
+    }
+
+private:
+    void resetCurrent();
+    void writeTrace();
+    void writePercentiles();
+
+    FILE* m_percentileFile = NULL;
+    FILE* m_traceFile = NULL;
+    bool m_firstTraceEvent = true;
+    std::chrono::steady_clock::time_point m_epoch;
+
+    StageFrameRecord m_current;
+    //Ring of per-stage totals of the last STAGE_WINDOW frames
+    double m_window[STAGE_WINDOW][STAGE_COUNT];
+    int m_windowPos = 0;
+    int m_windowCount = 0;
+    int m_framesSinceReport = 0;
+};
+
+extern StageProfiler s_stageProfiler;
+
+class StageTimer {
+public:
+    StageTimer(StageId stage) : m_stage(stage), m_startUs(s_stageProfiler.nowUs()) {}
+    ~StageTimer() {
+        s_stageProfiler.record(m_stage, m_startUs, s_stageProfiler.nowUs() - m_startUs);
+    }
+
+private:
+    StageId m_stage;
+    double m_startUs;
+};
+
+#define STAGE_TIMER_NAME2(line) stageTimer##line
+#define STAGE_TIMER_NAME(line) STAGE_TIMER_NAME2(line)
+#define STAGE_SCOPE(stage) StageTimer STAGE_TIMER_NAME(__LINE__)(stage)
+#define TIMED_STAGE(stage, statement) do { StageTimer stageTimer(stage); statement; } while (0)
+
+#else
+
+#define STAGE_SCOPE(stage)
+#define TIMED_STAGE(stage, statement) statement
+
+#endif
@@ -0,0 +1,56 @@
+#include "TrackExport.h"
+
+TrackExporter::~TrackExporter() {
+    if (m_kittiFile) fclose(m_kittiFile);
+    if (m_motFile) fclose(m_motFile);
+}
+
+bool TrackExporter::open(const std::string& kittiFile, const std::string& motFile) {
+    m_kittiFile = fopen(kittiFile.c_str(), "w");
+    m_motFile = fopen(motFile.c_str(), "w");
+    if (!m_kittiFile || !m_motFile) {
+        if (m_kittiFile) fclose(m_kittiFile);
+        if (m_motFile) fclose(m_motFile);
+        m_kittiFile = NULL;
+        m_motFile = NULL;
+        return false;
+    }
+    return true;
+}
+
+void TrackExporter::beginFrame(int frame) {
+    m_frame = frame;
+    m_kitti.clear();
+    m_mot.clear();
+}
+
+void TrackExporter::addEntity(const ObjEntity& e) {
+    auto found = m_tracks.find(e.entityID);
+    if (found == m_tracks.end()) {
+        found = m_tracks.insert(std::pair<int, Track>(e.entityID, { m_nextTrackID++, m_frame })).first;
+    }
+    found->second.lastFrame = m_frame;
+
+    m_kitti.appendTrack(m_frame, found->second.trackID, e, e.bbox2d);
+    m_mot.appendMot(m_frame, found->second.trackID, e, e.bbox2d);
+}
+
+void TrackExporter::endFrame() {
+    if (m_kittiFile) {
+        fwrite(m_kitti.str().data(), 1, m_kitti.str().size(), m_kittiFile);
+        fflush(m_kittiFile);
+    }
+    if (m_motFile) {
+        fwrite(m_mot.str().data(), 1, m_mot.str().size(), m_motFile);
+        fflush(m_motFile);
+    }
+
+    for (auto it = m_tracks.begin(); it != m_tracks.end();) {
+        if (m_frame - it->second.lastFrame > TRACK_EVICT_FRAMES) {
+            it = m_tracks.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "GeometryCore.h"
+#include "FrameObjectInfo.h"
+#include "LabelWriter.h"
+#include <stdio.h>
+#include <string>
+#include <unordered_map>
+
+//Tracking ground truth for one series, appended frame by frame:
+//KITTI tracking (label_02/<series>.txt, plus the velocity in camera coordinates) and MOTChallenge (mot/<series>.txt).
+//Track IDs start at 0 for each series. An entity unseen for TRACK_EVICT_FRAMES frames loses its track,
+//so memory only grows with the number of live tracks.
+class TrackExporter {
+public:
+    ~TrackExporter();
+
+    bool open(const std::string& kittiFile, const std::string& motFile);
+    bool isOpen() const { return m_kittiFile != NULL; }
+
+    void beginFrame(int frame);
+    void addEntity(const ObjEntity& e);
+    //Appends the frame to both files and evicts ended tracks
+    void endFrame();
+
+    size_t activeTracks() const { return m_tracks.size(); }
+
+private:
+    struct Track {
+        int trackID;
+        int lastFrame;
+    };
+
+    std::unordered_map<int, Track> m_tracks;//entityID -> track
+    int m_nextTrackID = 0;
+    int m_frame = 0;
+
+    FILE* m_kittiFile = NULL;
+    FILE* m_motFile = NULL;
+    LabelWriter m_kitti;
+    LabelWriter m_mot;
+};
@@ -0,0 +1,1980 @@
+#pragma once
+
+//Generated by gen_vehicle_types.py from vehicle_labels.csv, do not edit.
+//529 rows, 529 model hashes, 363 names, 965 clipped names
+
+#include <stdint.h>
+#include <string_view>
+
+enum VehicleType : uint8_t {
+    VEHICLE_TYPE_UNKNOWN,
+    VEHICLE_TYPE_CAR,
+    VEHICLE_TYPE_CYCLIST,
+    VEHICLE_TYPE_MISC,
+    VEHICLE_TYPE_TRAM,
+    VEHICLE_TYPE_TRUCK,
+    VEHICLE_TYPE_VAN,
+};
+
+constexpr const char* VEHICLE_TYPE_NAMES[] = { "Unknown", "Car", "Cyclist", "Misc", "Tram", "Truck", "Van" };
+
+struct VehicleModelEntry {
+    uint32_t model;
+    VehicleType type;
+};
+
+struct VehicleNameEntry {
+    const char* name;
+    VehicleType type;
+};
+
+constexpr uint32_t vtMix(uint32_t key, uint32_t seed) {
+    uint32_t h = key ^ (seed * 0x9E3779B9u);
+    h ^= h >> 16;
+    h *= 0x85EBCA6Bu;
+    h ^= h >> 13;
+    h *= 0xC2B2AE35u;
+    h ^= h >> 16;
+    return h;
+}
+
+//FNV-1a
+constexpr uint32_t vtHashName(std::string_view name) {
+    uint32_t h = 2166136261u;
+    for (char c : name) {
+        h ^= (uint8_t)c;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+constexpr uint32_t VT_MODEL_TABLE_SEEDS[] = {
+    6, 19, 104, 1, 1, 2, 2, 10, 18, 2, 117, 1, 12, 39, 4, 56,
+    0, 14, 14, 14, 63, 2, 1, 118, 310, 38, 60, 9, 46, 27, 44, 10,
+    409, 15, 2, 1, 17, 9, 94, 738, 5, 33, 5, 1, 2, 26, 46, 62,
+    12, 97, 11, 2, 62, 2, 20, 29, 9, 54, 3, 5, 1, 2, 118, 11,
+    9, 5, 65, 390, 76, 99, 832, 13, 58, 27, 18, 64, 153, 232, 5, 73,
+    136, 73, 6, 709, 135, 281, 7, 301, 2, 1133, 79, 218, 1, 40, 8, 727,
+    70, 77, 165, 130, 82, 10, 48, 469, 10, 2, 165, 1667, 779, 117, 48, 29,
+    60, 1117, 100, 130, 9359, 92, 202, 574, 236, 6, 184, 773, 3, 123, 546, 89,
+    2, 3613, 3, 7, 1,
+};
+constexpr VehicleModelEntry VT_MODEL_TABLE[] = {
+    { 0xDA5819A3, VEHICLE_TYPE_CAR },
+    { 0x8612B64B, VEHICLE_TYPE_CAR },
+    { 0xC2974024, VEHICLE_TYPE_MISC },
+    { 0x4008EABB, VEHICLE_TYPE_VAN },
+    { 0xCFCA3668, VEHICLE_TYPE_CAR },
+    { 0x4BA4E8DC, VEHICLE_TYPE_CAR },
+    { 0xBC993509, VEHICLE_TYPE_CAR },
+    { 0x831A21D5, VEHICLE_TYPE_CAR },
+    { 0x2DB8D1AA, VEHICLE_TYPE_CAR },
+    { 0x04CE68AC, VEHICLE_TYPE_CAR },
+    { 0xC8B9F861, VEHICLE_TYPE_CAR },
+    { 0x73B1C3CB, VEHICLE_TYPE_VAN },
+    { 0x7CAB34D0, VEHICLE_TYPE_MISC },
+    { 0xAFBB2CA4, VEHICLE_TYPE_CAR },
+    { 0xDE3D9D22, VEHICLE_TYPE_CAR },
+    { 0xE7D2A16E, VEHICLE_TYPE_MISC },
+    { 0x22EDDC30, VEHICLE_TYPE_MISC },
+    { 0x25C5AF13, VEHICLE_TYPE_CAR },
+    { 0xDCBCBE48, VEHICLE_TYPE_CAR },
+    { 0x30FF0190, VEHICLE_TYPE_MISC },
+    { 0xCBB2BE0E, VEHICLE_TYPE_MISC },
+    { 0x0DF381E5, VEHICLE_TYPE_CAR },
+    { 0x9734F3EA, VEHICLE_TYPE_CAR },
+    { 0xA960B13E, VEHICLE_TYPE_MISC },
+    { 0x2EA68690, VEHICLE_TYPE_MISC },
+    { 0x0BD303B8, VEHICLE_TYPE_CAR },
+    { 0x4131F378, VEHICLE_TYPE_CAR },
+    { 0x5C27AA11, VEHICLE_TYPE_MISC },
+    { 0x0E512E79, VEHICLE_TYPE_MISC },
+    { 0xC6D4FCF6, VEHICLE_TYPE_MISC },
+    { 0x142E0DC3, VEHICLE_TYPE_CAR },
+    { 0x19DD9ED1, VEHICLE_TYPE_CAR },
+    { 0x9DAE1398, VEHICLE_TYPE_MISC },
+    { 0x4339CD69, VEHICLE_TYPE_CYCLIST },
+    { 0x13B57D8A, VEHICLE_TYPE_CAR },
+    { 0x30D3F6D8, VEHICLE_TYPE_CAR },
+    { 0x2C75F0DD, VEHICLE_TYPE_MISC },
+    { 0xFF22D208, VEHICLE_TYPE_CAR },
+    { 0x690A4153, VEHICLE_TYPE_CAR },
+    { 0x782A236D, VEHICLE_TYPE_MISC },
+    { 0x34DD8AA1, VEHICLE_TYPE_CAR },
+    { 0xDCBC1C3B, VEHICLE_TYPE_CAR },
+    { 0xEE6024BC, VEHICLE_TYPE_CAR },
+    { 0xD138A6BB, VEHICLE_TYPE_TRUCK },
+    { 0x33C9E158, VEHICLE_TYPE_TRAM },
+    { 0x9441D8D5, VEHICLE_TYPE_CAR },
+    { 0x79FBB0C5, VEHICLE_TYPE_CAR },
+    { 0x9114EADA, VEHICLE_TYPE_CAR },
+    { 0x72935408, VEHICLE_TYPE_CAR },
+    { 0x86618EDA, VEHICLE_TYPE_CAR },
+    { 0x50732C82, VEHICLE_TYPE_CAR },
+    { 0x7BBDBE95, VEHICLE_TYPE_CAR },
+    { 0x82E499FA, VEHICLE_TYPE_CAR },
+    { 0x17420102, VEHICLE_TYPE_MISC },
+    { 0x33B47F96, VEHICLE_TYPE_MISC },
+    { 0x711D4738, VEHICLE_TYPE_MISC },
+    { 0x0DF7DE53, VEHICLE_TYPE_VAN },
+    { 0x1ABA13B5, VEHICLE_TYPE_CYCLIST },
+    { 0x6FF0F727, VEHICLE_TYPE_CAR },
+    { 0xFE141DA6, VEHICLE_TYPE_VAN },
+    { 0x17DF5EC2, VEHICLE_TYPE_MISC },
+    { 0x69F06B57, VEHICLE_TYPE_CAR },
+    { 0x7836CE2F, VEHICLE_TYPE_CAR },
+    { 0xF1B44F44, VEHICLE_TYPE_MISC },
+    { 0xCA495705, VEHICLE_TYPE_MISC },
+    { 0xB2A716A3, VEHICLE_TYPE_CAR },
+    { 0x2C509634, VEHICLE_TYPE_MISC },
+    { 0x4662BCBB, VEHICLE_TYPE_CAR },
+    { 0xB79C1BF5, VEHICLE_TYPE_MISC },
+    { 0x5A82F9AE, VEHICLE_TYPE_VAN },
+    { 0x437CF2A0, VEHICLE_TYPE_CAR },
+    { 0x707E63A4, VEHICLE_TYPE_CAR },
+    { 0xB7D9F7F1, VEHICLE_TYPE_CAR },
+    { 0x3F119114, VEHICLE_TYPE_MISC },
+    { 0x00FDFFB0, VEHICLE_TYPE_CAR },
+    { 0x779F23AA, VEHICLE_TYPE_CAR },
+    { 0x2560B2FC, VEHICLE_TYPE_CAR },
+    { 0x6D19CCBC, VEHICLE_TYPE_CAR },
+    { 0xE2E7D4AB, VEHICLE_TYPE_MISC },
+    { 0x5E4327C8, VEHICLE_TYPE_CAR },
+    { 0x05283265, VEHICLE_TYPE_MISC },
+    { 0xBF1691E0, VEHICLE_TYPE_CAR },
+    { 0x36DCFF98, VEHICLE_TYPE_MISC },
+    { 0x58E49664, VEHICLE_TYPE_MISC },
+    { 0x3D961290, VEHICLE_TYPE_MISC },
+    { 0x706E2B40, VEHICLE_TYPE_CAR },
+    { 0xC9CEAF06, VEHICLE_TYPE_MISC },
+    { 0x28B67ACA, VEHICLE_TYPE_CAR },
+    { 0x2B7F9DE3, VEHICLE_TYPE_CAR },
+    { 0x44623884, VEHICLE_TYPE_MISC },
+    { 0xC1632BEB, VEHICLE_TYPE_TRUCK },
+    { 0x49863E9C, VEHICLE_TYPE_VAN },
+    { 0x77934CEE, VEHICLE_TYPE_MISC },
+    { 0x6210CBB0, VEHICLE_TYPE_CAR },
+    { 0xDB20A373, VEHICLE_TYPE_MISC },
+    { 0x3412AE2D, VEHICLE_TYPE_CAR },
+    { 0xE33A477B, VEHICLE_TYPE_CAR },
+    { 0xB8E2AE18, VEHICLE_TYPE_CAR },
+    { 0x81794C70, VEHICLE_TYPE_MISC },
+    { 0x47BBCF2E, VEHICLE_TYPE_CAR },
+    { 0xEF2295C9, VEHICLE_TYPE_MISC },
+    { 0x97E55D11, VEHICLE_TYPE_MISC },
+    { 0xCABD11E8, VEHICLE_TYPE_MISC },
+    { 0x58B3979C, VEHICLE_TYPE_CAR },
+    { 0x806B9CC3, VEHICLE_TYPE_MISC },
+    { 0x34E6BF6B, VEHICLE_TYPE_VAN },
+    { 0xBD1B39C3, VEHICLE_TYPE_CAR },
+    { 0x1149422F, VEHICLE_TYPE_MISC },
+    { 0x679450AF, VEHICLE_TYPE_CAR },
+    { 0x6A59902D, VEHICLE_TYPE_MISC },
+    { 0x83051506, VEHICLE_TYPE_CAR },
+    { 0x36B4A8A9, VEHICLE_TYPE_CAR },
+    { 0x6A4BD8F6, VEHICLE_TYPE_MISC },
+    { 0xC3DDFDCE, VEHICLE_TYPE_CAR },
+    { 0x48CECED3, VEHICLE_TYPE_CAR },
+    { 0xA09E15FD, VEHICLE_TYPE_MISC },
+    { 0x9AE6DDA1, VEHICLE_TYPE_CAR },
+    { 0x6CBD1D6D, VEHICLE_TYPE_MISC },
+    { 0x7B7E56F0, VEHICLE_TYPE_CAR },
+    { 0xB8081009, VEHICLE_TYPE_MISC },
+    { 0x9F4B77BE, VEHICLE_TYPE_CAR },
+    { 0x59A9E570, VEHICLE_TYPE_CAR },
+    { 0x7B8AB45F, VEHICLE_TYPE_CAR },
+    { 0xCD935EF9, VEHICLE_TYPE_MISC },
+    { 0xB1D80E06, VEHICLE_TYPE_CAR },
+    { 0x11AA0E14, VEHICLE_TYPE_CAR },
+    { 0x9C5E5644, VEHICLE_TYPE_MISC },
+    { 0xB779A091, VEHICLE_TYPE_CAR },
+    { 0xE6401328, VEHICLE_TYPE_CAR },
+    { 0xD9927FE3, VEHICLE_TYPE_MISC },
+    { 0xB822A1AA, VEHICLE_TYPE_VAN },
+    { 0xC7824E5E, VEHICLE_TYPE_TRUCK },
+    { 0x21EEE87D, VEHICLE_TYPE_TRUCK },
+    { 0x81E38F7F, VEHICLE_TYPE_MISC },
+    { 0xFAAD85EE, VEHICLE_TYPE_CAR },
+    { 0x27B4E6B0, VEHICLE_TYPE_CAR },
+    { 0x8CF5CAE1, VEHICLE_TYPE_CAR },
+    { 0x42F2ED16, VEHICLE_TYPE_CAR },
+    { 0x067BC037, VEHICLE_TYPE_CAR },
+    { 0x14D69010, VEHICLE_TYPE_CAR },
+    { 0xEB298297, VEHICLE_TYPE_MISC },
+    { 0x97FA4F36, VEHICLE_TYPE_CAR },
+    { 0x02E19879, VEHICLE_TYPE_TRUCK },
+    { 0x00675ED7, VEHICLE_TYPE_MISC },
+    { 0x866BCE26, VEHICLE_TYPE_CAR },
+    { 0x6D6F8F43, VEHICLE_TYPE_MISC },
+    { 0x1BF8D381, VEHICLE_TYPE_CAR },
+    { 0xB802DD46, VEHICLE_TYPE_CAR },
+    { 0xF9300CC5, VEHICLE_TYPE_MISC },
+    { 0x8548036D, VEHICLE_TYPE_MISC },
+    { 0x174CB172, VEHICLE_TYPE_MISC },
+    { 0xF8DE29A8, VEHICLE_TYPE_CAR },
+    { 0xECC96C3F, VEHICLE_TYPE_CAR },
+    { 0xCEEA3F4B, VEHICLE_TYPE_TRUCK },
+    { 0x1044926F, VEHICLE_TYPE_CAR },
+    { 0xD46F4737, VEHICLE_TYPE_MISC },
+    { 0x6827CF72, VEHICLE_TYPE_VAN },
+    { 0x8E9254FB, VEHICLE_TYPE_CAR },
+    { 0x2B6DC64A, VEHICLE_TYPE_CAR },
+    { 0x50B0215A, VEHICLE_TYPE_TRUCK },
+    { 0x3DA47243, VEHICLE_TYPE_CAR },
+    { 0x2DFF622F, VEHICLE_TYPE_MISC },
+    { 0x16E478C1, VEHICLE_TYPE_CAR },
+    { 0xF683EACA, VEHICLE_TYPE_MISC },
+    { 0xF21B33BE, VEHICLE_TYPE_VAN },
+    { 0x3AF8C345, VEHICLE_TYPE_CAR },
+    { 0x4019CB4C, VEHICLE_TYPE_MISC },
+    { 0x171C92C4, VEHICLE_TYPE_VAN },
+    { 0x8B13F083, VEHICLE_TYPE_CAR },
+    { 0x1C534995, VEHICLE_TYPE_TRUCK },
+    { 0xD577C962, VEHICLE_TYPE_TRUCK },
+    { 0x31F0B376, VEHICLE_TYPE_MISC },
+    { 0xB52B5113, VEHICLE_TYPE_CAR },
+    { 0x98171BD3, VEHICLE_TYPE_CAR },
+    { 0x877358AD, VEHICLE_TYPE_CAR },
+    { 0x50D4D19F, VEHICLE_TYPE_CAR },
+    { 0xB5FCF74E, VEHICLE_TYPE_CAR },
+    { 0xD36A4B44, VEHICLE_TYPE_CAR },
+    { 0xAC4E93C9, VEHICLE_TYPE_MISC },
+    { 0x6E8A4D8A, VEHICLE_TYPE_MISC },
+    { 0x11F76C14, VEHICLE_TYPE_MISC },
+    { 0xC1E908D2, VEHICLE_TYPE_CAR },
+    { 0x1BB290BC, VEHICLE_TYPE_CAR },
+    { 0x16219B3D, VEHICLE_TYPE_CAR },
+    { 0xC9E8FF76, VEHICLE_TYPE_CAR },
+    { 0xAF62F6B2, VEHICLE_TYPE_MISC },
+    { 0x432EA949, VEHICLE_TYPE_CAR },
+    { 0x4BFCF28B, VEHICLE_TYPE_CAR },
+    { 0x1F3D44B5, VEHICLE_TYPE_MISC },
+    { 0xC3FBA120, VEHICLE_TYPE_MISC },
+    { 0x3FC5D440, VEHICLE_TYPE_CAR },
+    { 0x1FD5D1FC, VEHICLE_TYPE_CAR },
+    { 0x5BFA5C4B, VEHICLE_TYPE_MISC },
+    { 0x94204D89, VEHICLE_TYPE_CAR },
+    { 0x2F03547B, VEHICLE_TYPE_MISC },
+    { 0xE5BA6858, VEHICLE_TYPE_MISC },
+    { 0x132D5A1A, VEHICLE_TYPE_CAR },
+    { 0xA31CB573, VEHICLE_TYPE_CAR },
+    { 0xB12314E0, VEHICLE_TYPE_VAN },
+    { 0xA0438767, VEHICLE_TYPE_MISC },
+    { 0x6882FA73, VEHICLE_TYPE_MISC },
+    { 0x8A63C7B9, VEHICLE_TYPE_CAR },
+    { 0x59E0FBF3, VEHICLE_TYPE_CAR },
+    { 0x8911B9F5, VEHICLE_TYPE_CAR },
+    { 0xCEC6B9B7, VEHICLE_TYPE_CAR },
+    { 0x60A7EA10, VEHICLE_TYPE_MISC },
+    { 0xB79F589E, VEHICLE_TYPE_MISC },
+    { 0x36848602, VEHICLE_TYPE_CAR },
+    { 0x322CF98F, VEHICLE_TYPE_CAR },
+    { 0x2C634FBD, VEHICLE_TYPE_MISC },
+    { 0x3D29CD2B, VEHICLE_TYPE_CAR },
+    { 0xEDD516C6, VEHICLE_TYPE_CAR },
+    { 0xAF599F01, VEHICLE_TYPE_MISC },
+    { 0x462FE277, VEHICLE_TYPE_CAR },
+    { 0xF79A00F7, VEHICLE_TYPE_MISC },
+    { 0x0D4E5F4D, VEHICLE_TYPE_CAR },
+    { 0x185484E1, VEHICLE_TYPE_CAR },
+    { 0x7F2153DF, VEHICLE_TYPE_CAR },
+    { 0xA774B5A6, VEHICLE_TYPE_CAR },
+    { 0x250B0C5E, VEHICLE_TYPE_MISC },
+    { 0xB9CB3B69, VEHICLE_TYPE_CAR },
+    { 0xB9210FD0, VEHICLE_TYPE_CAR },
+    { 0xED762D49, VEHICLE_TYPE_MISC },
+    { 0x25676EAF, VEHICLE_TYPE_MISC },
+    { 0xDB6B4924, VEHICLE_TYPE_MISC },
+    { 0x153E1B0A, VEHICLE_TYPE_MISC },
+    { 0x35ED670B, VEHICLE_TYPE_TRUCK },
+    { 0x25CBE2E2, VEHICLE_TYPE_CAR },
+    { 0x9628879C, VEHICLE_TYPE_CAR },
+    { 0x362CAC6D, VEHICLE_TYPE_MISC },
+    { 0x368B8E7C, VEHICLE_TYPE_CAR },
+    { 0x0DC60D2B, VEHICLE_TYPE_MISC },
+    { 0xF4E1AA15, VEHICLE_TYPE_CYCLIST },
+    { 0xB1D95DA0, VEHICLE_TYPE_CAR },
+    { 0x206D1B68, VEHICLE_TYPE_CAR },
+    { 0x4543B74D, VEHICLE_TYPE_CAR },
+    { 0x0E2C013E, VEHICLE_TYPE_CAR },
+    { 0x5D0AAC8F, VEHICLE_TYPE_MISC },
+    { 0x9F05F101, VEHICLE_TYPE_CAR },
+    { 0x353B561D, VEHICLE_TYPE_CAR },
+    { 0x38408341, VEHICLE_TYPE_CAR },
+    { 0xDE05FB87, VEHICLE_TYPE_MISC },
+    { 0xE82AE656, VEHICLE_TYPE_MISC },
+    { 0x9B909C94, VEHICLE_TYPE_CAR },
+    { 0x7B47A6A7, VEHICLE_TYPE_CAR },
+    { 0x829A3C44, VEHICLE_TYPE_TRUCK },
+    { 0x00ABB0C0, VEHICLE_TYPE_MISC },
+    { 0x6D6C1A21, VEHICLE_TYPE_CAR },
+    { 0x84718D34, VEHICLE_TYPE_TRUCK },
+    { 0x15F27762, VEHICLE_TYPE_MISC },
+    { 0x825A9F4C, VEHICLE_TYPE_VAN },
+    { 0xB2CF7250, VEHICLE_TYPE_MISC },
+    { 0xAC33179C, VEHICLE_TYPE_CAR },
+    { 0x2E5AFD37, VEHICLE_TYPE_CAR },
+    { 0x2C33B46E, VEHICLE_TYPE_CAR },
+    { 0xCEB28249, VEHICLE_TYPE_CAR },
+    { 0x0AFD22A6, VEHICLE_TYPE_MISC },
+    { 0xDC434E51, VEHICLE_TYPE_CAR },
+    { 0x0612F4B6, VEHICLE_TYPE_CAR },
+    { 0x08852855, VEHICLE_TYPE_CAR },
+    { 0x58E316C7, VEHICLE_TYPE_MISC },
+    { 0x097E5533, VEHICLE_TYPE_CAR },
+    { 0x1ED0A534, VEHICLE_TYPE_VAN },
+    { 0x6FACDF31, VEHICLE_TYPE_MISC },
+    { 0x86FE0B60, VEHICLE_TYPE_CAR },
+    { 0x3AF76F4A, VEHICLE_TYPE_CAR },
+    { 0x047A6BC1, VEHICLE_TYPE_CAR },
+    { 0x2C2C2324, VEHICLE_TYPE_MISC },
+    { 0x86CF7CDD, VEHICLE_TYPE_CAR },
+    { 0xEB70965F, VEHICLE_TYPE_CAR },
+    { 0x4C80EB0E, VEHICLE_TYPE_TRUCK },
+    { 0x31ADBBFC, VEHICLE_TYPE_CAR },
+    { 0xB6410173, VEHICLE_TYPE_CAR },
+    { 0x2EC385FE, VEHICLE_TYPE_CAR },
+    { 0x7B406EFB, VEHICLE_TYPE_CAR },
+    { 0x809AA4CB, VEHICLE_TYPE_TRUCK },
+    { 0x32B91AE8, VEHICLE_TYPE_VAN },
+    { 0xCA62927A, VEHICLE_TYPE_CAR },
+    { 0x95F4C618, VEHICLE_TYPE_CAR },
+    { 0x1DC0BA53, VEHICLE_TYPE_CAR },
+    { 0x2EF89E46, VEHICLE_TYPE_MISC },
+    { 0xA5325278, VEHICLE_TYPE_MISC },
+    { 0xAED64A63, VEHICLE_TYPE_CAR },
+    { 0xF0C2A91F, VEHICLE_TYPE_MISC },
+    { 0xD7278283, VEHICLE_TYPE_CAR },
+    { 0x3D8FA25C, VEHICLE_TYPE_CAR },
+    { 0x6322B39A, VEHICLE_TYPE_CAR },
+    { 0x7A61B330, VEHICLE_TYPE_TRUCK },
+    { 0xA7F873E0, VEHICLE_TYPE_CAR },
+    { 0x187D938D, VEHICLE_TYPE_CAR },
+    { 0x9E6B14D6, VEHICLE_TYPE_MISC },
+    { 0x05852838, VEHICLE_TYPE_CAR },
+    { 0x29B0DA97, VEHICLE_TYPE_CAR },
+    { 0xD37B7976, VEHICLE_TYPE_CAR },
+    { 0xD2D5E00E, VEHICLE_TYPE_MISC },
+    { 0x794CB30C, VEHICLE_TYPE_MISC },
+    { 0x9A5B1DCC, VEHICLE_TYPE_TRUCK },
+    { 0x8CB29A14, VEHICLE_TYPE_CAR },
+    { 0x3D6AAA9B, VEHICLE_TYPE_MISC },
+    { 0x9CF21E0F, VEHICLE_TYPE_CAR },
+    { 0x5502626C, VEHICLE_TYPE_CAR },
+    { 0xD9A8BEF3, VEHICLE_TYPE_CAR },
+    { 0x0239E390, VEHICLE_TYPE_CAR },
+    { 0x82CAC433, VEHICLE_TYPE_MISC },
+    { 0x89907379, VEHICLE_TYPE_MISC },
+    { 0x61D6BA8C, VEHICLE_TYPE_MISC },
+    { 0x113E94AC, VEHICLE_TYPE_CAR },
+    { 0xA7CE1BC5, VEHICLE_TYPE_CAR },
+    { 0x43779C54, VEHICLE_TYPE_CYCLIST },
+    { 0x72435A19, VEHICLE_TYPE_TRUCK },
+    { 0xFDEFAEC3, VEHICLE_TYPE_MISC },
+    { 0x3EAB5555, VEHICLE_TYPE_CAR },
+    { 0x2B26F456, VEHICLE_TYPE_CAR },
+    { 0x72934BE4, VEHICLE_TYPE_CAR },
+    { 0x2AE524A8, VEHICLE_TYPE_CAR },
+    { 0x66B4FC45, VEHICLE_TYPE_CAR },
+    { 0x71CB2FFB, VEHICLE_TYPE_CAR },
+    { 0xEDC6F847, VEHICLE_TYPE_TRUCK },
+    { 0x58CF185C, VEHICLE_TYPE_CAR },
+    { 0x806EFBEE, VEHICLE_TYPE_MISC },
+    { 0xCFCFEB3B, VEHICLE_TYPE_CAR },
+    { 0x8C2BD0DC, VEHICLE_TYPE_CAR },
+    { 0xB3206692, VEHICLE_TYPE_CAR },
+    { 0xE9805550, VEHICLE_TYPE_CAR },
+    { 0x400F5147, VEHICLE_TYPE_CAR },
+    { 0xC397F748, VEHICLE_TYPE_CAR },
+    { 0x9D0450CA, VEHICLE_TYPE_MISC },
+    { 0x56590FE9, VEHICLE_TYPE_MISC },
+    { 0xF337AB36, VEHICLE_TYPE_VAN },
+    { 0xC575DF11, VEHICLE_TYPE_CAR },
+    { 0x0BBA2261, VEHICLE_TYPE_CAR },
+    { 0xEBC24DF2, VEHICLE_TYPE_MISC },
+    { 0x92EF6E04, VEHICLE_TYPE_CAR },
+    { 0x7DE35E7D, VEHICLE_TYPE_TRUCK },
+    { 0x403820E8, VEHICLE_TYPE_MISC },
+    { 0x84F42E51, VEHICLE_TYPE_CAR },
+    { 0xCADD5D2D, VEHICLE_TYPE_MISC },
+    { 0xC3D7C72B, VEHICLE_TYPE_MISC },
+    { 0x432AA566, VEHICLE_TYPE_CAR },
+    { 0xFCFCB68B, VEHICLE_TYPE_MISC },
+    { 0x8FB66F9B, VEHICLE_TYPE_CAR },
+    { 0xCD93A7DB, VEHICLE_TYPE_VAN },
+    { 0xC6C3242D, VEHICLE_TYPE_MISC },
+    { 0x3CC7F596, VEHICLE_TYPE_MISC },
+    { 0x1D06D681, VEHICLE_TYPE_CAR },
+    { 0x898ECCEA, VEHICLE_TYPE_VAN },
+    { 0x767164D6, VEHICLE_TYPE_CAR },
+    { 0xC703DB5F, VEHICLE_TYPE_CAR },
+    { 0x843B73DE, VEHICLE_TYPE_MISC },
+    { 0x34B7390F, VEHICLE_TYPE_CAR },
+    { 0xCE6B35A4, VEHICLE_TYPE_CAR },
+    { 0xD1ABB666, VEHICLE_TYPE_MISC },
+    { 0x5C55CB39, VEHICLE_TYPE_CAR },
+    { 0x67B3F020, VEHICLE_TYPE_CAR },
+    { 0xBCDE91F0, VEHICLE_TYPE_CAR },
+    { 0xD227BDBB, VEHICLE_TYPE_MISC },
+    { 0xDBA9DBFC, VEHICLE_TYPE_MISC },
+    { 0xEC8F7094, VEHICLE_TYPE_CAR },
+    { 0xE823FB48, VEHICLE_TYPE_CYCLIST },
+    { 0xED62BFA9, VEHICLE_TYPE_CAR },
+    { 0x5B42A5C4, VEHICLE_TYPE_CAR },
+    { 0x1A7FCEFA, VEHICLE_TYPE_MISC },
+    { 0x9BAA707C, VEHICLE_TYPE_CAR },
+    { 0xD0EB2BE5, VEHICLE_TYPE_CAR },
+    { 0xE62B361B, VEHICLE_TYPE_CAR },
+    { 0xDFF0594C, VEHICLE_TYPE_MISC },
+    { 0x09D80F93, VEHICLE_TYPE_MISC },
+    { 0xBC32A33B, VEHICLE_TYPE_CAR },
+    { 0x57F682AF, VEHICLE_TYPE_CAR },
+    { 0xAE2BFE94, VEHICLE_TYPE_CAR },
+    { 0xF92AEC4D, VEHICLE_TYPE_CAR },
+    { 0x28AD20E1, VEHICLE_TYPE_VAN },
+    { 0xA1355F67, VEHICLE_TYPE_MISC },
+    { 0x07405E08, VEHICLE_TYPE_VAN },
+    { 0x7F5C91F1, VEHICLE_TYPE_CAR },
+    { 0x698521E3, VEHICLE_TYPE_CAR },
+    { 0x1F3766E3, VEHICLE_TYPE_CAR },
+    { 0xFB133A17, VEHICLE_TYPE_MISC },
+    { 0x920016F1, VEHICLE_TYPE_MISC },
+    { 0x761E2AD3, VEHICLE_TYPE_MISC },
+    { 0xCE23D3BF, VEHICLE_TYPE_CYCLIST },
+    { 0xDA288376, VEHICLE_TYPE_MISC },
+    { 0x3FD5AA2F, VEHICLE_TYPE_MISC },
+    { 0x404B6381, VEHICLE_TYPE_CAR },
+    { 0xA8E38B01, VEHICLE_TYPE_CAR },
+    { 0x39F9C898, VEHICLE_TYPE_CAR },
+    { 0x9D96B45B, VEHICLE_TYPE_CAR },
+    { 0x744CA80D, VEHICLE_TYPE_VAN },
+    { 0x2BEC3CBE, VEHICLE_TYPE_CAR },
+    { 0xE18195B2, VEHICLE_TYPE_CAR },
+    { 0x967620BE, VEHICLE_TYPE_MISC },
+    { 0xED7EADA4, VEHICLE_TYPE_CAR },
+    { 0x8125BCF9, VEHICLE_TYPE_MISC },
+    { 0xDBF2D57A, VEHICLE_TYPE_CAR },
+    { 0x107F392C, VEHICLE_TYPE_MISC },
+    { 0x2A54C47D, VEHICLE_TYPE_MISC },
+    { 0x7074F39D, VEHICLE_TYPE_MISC },
+    { 0xD876DBE2, VEHICLE_TYPE_CAR },
+    { 0xE80F67EE, VEHICLE_TYPE_CAR },
+    { 0xDAC67112, VEHICLE_TYPE_CAR },
+    { 0x742E9AC0, VEHICLE_TYPE_MISC },
+    { 0x1C09CF5E, VEHICLE_TYPE_CAR },
+    { 0x5993F939, VEHICLE_TYPE_MISC },
+    { 0x26321E67, VEHICLE_TYPE_MISC },
+    { 0x4B6C568A, VEHICLE_TYPE_MISC },
+    { 0xA1DA3C91, VEHICLE_TYPE_MISC },
+    { 0xE882E5F6, VEHICLE_TYPE_CAR },
+    { 0x7BE032C6, VEHICLE_TYPE_MISC },
+    { 0xD756460C, VEHICLE_TYPE_CAR },
+    { 0xBE819C63, VEHICLE_TYPE_VAN },
+    { 0x03E5F6B8, VEHICLE_TYPE_CAR },
+    { 0x29FCD3E4, VEHICLE_TYPE_CAR },
+    { 0x7B8297C5, VEHICLE_TYPE_CAR },
+    { 0x78BC1A3C, VEHICLE_TYPE_MISC },
+    { 0x506434F6, VEHICLE_TYPE_CAR },
+    { 0x2189D250, VEHICLE_TYPE_MISC },
+    { 0x94DA98EF, VEHICLE_TYPE_CAR },
+    { 0x9DC66994, VEHICLE_TYPE_CAR },
+    { 0x8FC3AADC, VEHICLE_TYPE_CAR },
+    { 0xA46462F7, VEHICLE_TYPE_CAR },
+    { 0x7397224C, VEHICLE_TYPE_CAR },
+    { 0xF8D48E7A, VEHICLE_TYPE_VAN },
+    { 0x264D9262, VEHICLE_TYPE_MISC },
+    { 0x81A9CDDF, VEHICLE_TYPE_CAR },
+    { 0x360A438E, VEHICLE_TYPE_CAR },
+    { 0x710A2B9B, VEHICLE_TYPE_CAR },
+    { 0x53174EEF, VEHICLE_TYPE_MISC },
+    { 0x9C669788, VEHICLE_TYPE_MISC },
+    { 0x961AFEF7, VEHICLE_TYPE_CAR },
+    { 0x4FB1A214, VEHICLE_TYPE_CAR },
+    { 0x1517D4D9, VEHICLE_TYPE_MISC },
+    { 0xBE0E6126, VEHICLE_TYPE_CAR },
+    { 0x2BC345D1, VEHICLE_TYPE_CAR },
+    { 0xB820ED5E, VEHICLE_TYPE_CAR },
+    { 0x34B82784, VEHICLE_TYPE_MISC },
+    { 0xE8A8BDA8, VEHICLE_TYPE_CAR },
+    { 0x97398A4B, VEHICLE_TYPE_CAR },
+    { 0xFD231729, VEHICLE_TYPE_MISC },
+    { 0xB328B188, VEHICLE_TYPE_MISC },
+    { 0xC1AE4D16, VEHICLE_TYPE_CAR },
+    { 0xA7EDE74D, VEHICLE_TYPE_CAR },
+    { 0x1FD824AF, VEHICLE_TYPE_CAR },
+    { 0x73920F8E, VEHICLE_TYPE_TRUCK },
+    { 0x32B29A4B, VEHICLE_TYPE_CAR },
+    { 0xD1AD4937, VEHICLE_TYPE_CAR },
+    { 0xC1CE1183, VEHICLE_TYPE_MISC },
+    { 0xB2FE5CF9, VEHICLE_TYPE_CAR },
+    { 0x94B395C5, VEHICLE_TYPE_CAR },
+    { 0x8FD54EBB, VEHICLE_TYPE_MISC },
+    { 0x4992196C, VEHICLE_TYPE_CAR },
+    { 0xCB0E7CD9, VEHICLE_TYPE_CAR },
+    { 0x41B77FA4, VEHICLE_TYPE_CAR },
+    { 0xA3FC0F4D, VEHICLE_TYPE_CAR },
+    { 0x8D4B7A8A, VEHICLE_TYPE_CAR },
+    { 0xB44F0582, VEHICLE_TYPE_MISC },
+    { 0xD7C56D39, VEHICLE_TYPE_MISC },
+    { 0xA7FF33F5, VEHICLE_TYPE_MISC },
+    { 0x85E8E76B, VEHICLE_TYPE_CAR },
+    { 0xDB4388E4, VEHICLE_TYPE_MISC },
+    { 0xC96B73D9, VEHICLE_TYPE_CAR },
+    { 0xA29D6D10, VEHICLE_TYPE_CAR },
+    { 0x72A4C31E, VEHICLE_TYPE_CAR },
+    { 0x64430650, VEHICLE_TYPE_CAR },
+    { 0x33581161, VEHICLE_TYPE_MISC },
+    { 0x7E8F677F, VEHICLE_TYPE_CAR },
+    { 0x7341576B, VEHICLE_TYPE_CAR },
+    { 0x0D4EA603, VEHICLE_TYPE_CAR },
+    { 0x63ABADE7, VEHICLE_TYPE_MISC },
+    { 0xC0240885, VEHICLE_TYPE_CAR },
+    { 0x885F3671, VEHICLE_TYPE_TRUCK },
+    { 0xB6846A55, VEHICLE_TYPE_CAR },
+    { 0xAC5DF515, VEHICLE_TYPE_CAR },
+    { 0x1F52A43F, VEHICLE_TYPE_CAR },
+    { 0xF7004C86, VEHICLE_TYPE_MISC },
+    { 0xCFB3870C, VEHICLE_TYPE_CAR },
+    { 0x810369E2, VEHICLE_TYPE_MISC },
+    { 0xF26CEFF9, VEHICLE_TYPE_CAR },
+    { 0x1CBDC10B, VEHICLE_TYPE_CAR },
+    { 0x8E08EC82, VEHICLE_TYPE_TRUCK },
+    { 0x6ABDF65E, VEHICLE_TYPE_MISC },
+    { 0xC07107EE, VEHICLE_TYPE_MISC },
+    { 0xB39B0AE6, VEHICLE_TYPE_MISC },
+    { 0x71FA16EA, VEHICLE_TYPE_CAR },
+    { 0x3822BDFE, VEHICLE_TYPE_CAR },
+    { 0x562A97BD, VEHICLE_TYPE_MISC },
+    { 0xFFB15B5E, VEHICLE_TYPE_CAR },
+    { 0x1B38E955, VEHICLE_TYPE_CAR },
+    { 0x9CFFFC56, VEHICLE_TYPE_CAR },
+    { 0xE5A2D6C6, VEHICLE_TYPE_VAN },
+    { 0x45D56ADA, VEHICLE_TYPE_VAN },
+    { 0x8F0E3594, VEHICLE_TYPE_CAR },
+    { 0x3DEE5EDA, VEHICLE_TYPE_CAR },
+    { 0xA988D3A2, VEHICLE_TYPE_CAR },
+    { 0xAB7EC4DF, VEHICLE_TYPE_CAR },
+    { 0x27939C72, VEHICLE_TYPE_MISC },
+    { 0x9A9FD3DF, VEHICLE_TYPE_VAN },
+    { 0x14D22159, VEHICLE_TYPE_CAR },
+    { 0x381E10BD, VEHICLE_TYPE_CAR },
+    { 0xF77ADE32, VEHICLE_TYPE_CAR },
+    { 0xBB6B404F, VEHICLE_TYPE_CAR },
+    { 0x51D83328, VEHICLE_TYPE_CAR },
+    { 0x3E48BF23, VEHICLE_TYPE_MISC },
+    { 0x5C23AF9B, VEHICLE_TYPE_CAR },
+    { 0x9C429B6A, VEHICLE_TYPE_MISC },
+    { 0x39DA2754, VEHICLE_TYPE_CAR },
+    { 0xF7889559, VEHICLE_TYPE_CAR },
+    { 0xAA699BB6, VEHICLE_TYPE_CAR },
+    { 0x0350D1AB, VEHICLE_TYPE_MISC },
+    { 0xD99E62C2, VEHICLE_TYPE_VAN },
+    { 0x39D6779E, VEHICLE_TYPE_MISC },
+    { 0x4FF77E37, VEHICLE_TYPE_MISC },
+    { 0x1A144F2A, VEHICLE_TYPE_MISC },
+    { 0x0A90ED5C, VEHICLE_TYPE_TRUCK },
+    { 0x2D3BD401, VEHICLE_TYPE_CAR },
+    { 0xFEFD644F, VEHICLE_TYPE_CAR },
+    { 0xB67597EC, VEHICLE_TYPE_CYCLIST },
+    { 0xCB44B1CA, VEHICLE_TYPE_MISC },
+    { 0xE644E480, VEHICLE_TYPE_CAR },
+    { 0x95466BDB, VEHICLE_TYPE_CAR },
+    { 0x81634188, VEHICLE_TYPE_CAR },
+    { 0x6FD95F68, VEHICLE_TYPE_VAN },
+    { 0x42BC5E19, VEHICLE_TYPE_CAR },
+    { 0x2A72BEAB, VEHICLE_TYPE_MISC },
+    { 0x9229E4EB, VEHICLE_TYPE_MISC },
+    { 0x18F25AC7, VEHICLE_TYPE_CAR },
+    { 0x3C4E2113, VEHICLE_TYPE_CAR },
+    { 0x39D6E83F, VEHICLE_TYPE_MISC },
+    { 0xE2504942, VEHICLE_TYPE_CAR },
+    { 0x779B4F2D, VEHICLE_TYPE_CAR },
+};
+
+constexpr uint32_t VT_NAME_TABLE_SEEDS[] = {
+    4, 25, 1, 294, 17, 48, 1, 10, 37, 17, 62, 315, 8, 2, 1, 30,
+    43, 43, 15, 29, 519, 81, 30, 1, 61, 1, 5, 63, 10, 13, 8, 217,
+    1, 68, 29, 2, 54, 16, 51, 4, 829, 1, 34, 28, 300, 749, 0, 92,
+    269, 41, 258, 2, 216, 25, 71, 14, 1, 497, 71, 8, 50, 9, 1424, 203,
+    28, 184, 37, 1, 433, 48, 268, 156, 109, 297, 126, 315, 145, 803, 505, 1,
+    1, 83, 75, 1, 5, 161, 40, 92, 242, 418, 7,
+};
+constexpr VehicleNameEntry VT_NAME_TABLE[] = {
+    { "camper", VEHICLE_TYPE_VAN },
+    { "stunt", VEHICLE_TYPE_MISC },
+    { "tvtrailer", VEHICLE_TYPE_MISC },
+    { "volatus", VEHICLE_TYPE_MISC },
+    { "cargobob", VEHICLE_TYPE_MISC },
+    { "miljet", VEHICLE_TYPE_MISC },
+    { "futo", VEHICLE_TYPE_CAR },
+    { "peyote", VEHICLE_TYPE_CAR },
+    { "policeb", VEHICLE_TYPE_MISC },
+    { "mammatus", VEHICLE_TYPE_MISC },
+    { "dloader", VEHICLE_TYPE_CAR },
+    { "zion", VEHICLE_TYPE_CAR },
+    { "rhapsody", VEHICLE_TYPE_CAR },
+    { "tourbus", VEHICLE_TYPE_VAN },
+    { "guardian", VEHICLE_TYPE_VAN },
+    { "gresley", VEHICLE_TYPE_CAR },
+    { "specter", VEHICLE_TYPE_CAR },
+    { "penetrator", VEHICLE_TYPE_CAR },
+    { "blazer", VEHICLE_TYPE_MISC },
+    { "swift", VEHICLE_TYPE_MISC },
+    { "vindicator", VEHICLE_TYPE_MISC },
+    { "predator", VEHICLE_TYPE_MISC },
+    { "freightgrain", VEHICLE_TYPE_MISC },
+    { "buccaneer", VEHICLE_TYPE_CAR },
+    { "turismo", VEHICLE_TYPE_CAR },
+    { "intruder", VEHICLE_TYPE_CAR },
+    { "schwarze", VEHICLE_TYPE_CAR },
+    { "airtug", VEHICLE_TYPE_MISC },
+    { "sovereign", VEHICLE_TYPE_MISC },
+    { "firetruk", VEHICLE_TYPE_TRUCK },
+    { "boattrailer", VEHICLE_TYPE_MISC },
+    { "tractor", VEHICLE_TYPE_MISC },
+    { "airbus", VEHICLE_TYPE_TRUCK },
+    { "technical", VEHICLE_TYPE_CAR },
+    { "rallytruck", VEHICLE_TYPE_TRUCK },
+    { "ripley", VEHICLE_TYPE_MISC },
+    { "lguard", VEHICLE_TYPE_CAR },
+    { "sadler", VEHICLE_TYPE_CAR },
+    { "ingot", VEHICLE_TYPE_CAR },
+    { "hakuchou", VEHICLE_TYPE_MISC },
+    { "coquette", VEHICLE_TYPE_CAR },
+    { "chimera", VEHICLE_TYPE_MISC },
+    { "surge", VEHICLE_TYPE_CAR },
+    { "ruston", VEHICLE_TYPE_CAR },
+    { "emperor", VEHICLE_TYPE_CAR },
+    { "graintrailer", VEHICLE_TYPE_MISC },
+    { "faction", VEHICLE_TYPE_CAR },
+    { "bfinjection", VEHICLE_TYPE_CAR },
+    { "dilettante", VEHICLE_TYPE_CAR },
+    { "landstalker", VEHICLE_TYPE_CAR },
+    { "verlierer", VEHICLE_TYPE_CAR },
+    { "f", VEHICLE_TYPE_CAR },
+    { "tempesta", VEHICLE_TYPE_CAR },
+    { "patriot", VEHICLE_TYPE_CAR },
+    { "minivan", VEHICLE_TYPE_CAR },
+    { "dodo", VEHICLE_TYPE_MISC },
+    { "barracks", VEHICLE_TYPE_TRUCK },
+    { "nightblade", VEHICLE_TYPE_MISC },
+    { "regina", VEHICLE_TYPE_CAR },
+    { "trailersmall", VEHICLE_TYPE_MISC },
+    { "apc", VEHICLE_TYPE_MISC },
+    { "police", VEHICLE_TYPE_CAR },
+    { "marshall", VEHICLE_TYPE_VAN },
+    { "fbi", VEHICLE_TYPE_CAR },
+    { "tyrus", VEHICLE_TYPE_CAR },
+    { "rapidgt", VEHICLE_TYPE_CAR },
+    { "polmav", VEHICLE_TYPE_MISC },
+    { "casco", VEHICLE_TYPE_CAR },
+    { "sabregt", VEHICLE_TYPE_CAR },
+    { "lectro", VEHICLE_TYPE_MISC },
+    { "rancherxl", VEHICLE_TYPE_CAR },
+    { "nimbus", VEHICLE_TYPE_MISC },
+    { "utillitruck", VEHICLE_TYPE_VAN },
+    { "vigero", VEHICLE_TYPE_CAR },
+    { "phantom", VEHICLE_TYPE_TRUCK },
+    { "sultanrs", VEHICLE_TYPE_CAR },
+    { "mule", VEHICLE_TYPE_TRUCK },
+    { "pcj", VEHICLE_TYPE_MISC },
+    { "proptrailer", VEHICLE_TYPE_MISC },
+    { "buffalo", VEHICLE_TYPE_CAR },
+    { "vestra", VEHICLE_TYPE_MISC },
+    { "dominato", VEHICLE_TYPE_CAR },
+    { "stinger", VEHICLE_TYPE_CAR },
+    { "brawler", VEHICLE_TYPE_CAR },
+    { "cuban", VEHICLE_TYPE_MISC },
+    { "ztype", VEHICLE_TYPE_CAR },
+    { "tr", VEHICLE_TYPE_MISC },
+    { "submers", VEHICLE_TYPE_MISC },
+    { "oppressor", VEHICLE_TYPE_MISC },
+    { "xls", VEHICLE_TYPE_CAR },
+    { "seven", VEHICLE_TYPE_CAR },
+    { "hauler", VEHICLE_TYPE_VAN },
+    { "cheetah", VEHICLE_TYPE_CAR },
+    { "dump", VEHICLE_TYPE_MISC },
+    { "moonbeam", VEHICLE_TYPE_CAR },
+    { "carboniz", VEHICLE_TYPE_CAR },
+    { "jetmax", VEHICLE_TYPE_MISC },
+    { "cablecar", VEHICLE_TYPE_MISC },
+    { "furoregt", VEHICLE_TYPE_CAR },
+    { "primo", VEHICLE_TYPE_CAR },
+    { "schafter", VEHICLE_TYPE_CAR },
+    { "picador", VEHICLE_TYPE_CAR },
+    { "omnis", VEHICLE_TYPE_CAR },
+    { "bifta", VEHICLE_TYPE_MISC },
+    { "ardent", VEHICLE_TYPE_CAR },
+    { "cogcabrio", VEHICLE_TYPE_CAR },
+    { "valkyrie", VEHICLE_TYPE_MISC },
+    { "hydra", VEHICLE_TYPE_MISC },
+    { "defiler", VEHICLE_TYPE_MISC },
+    { "sentinel", VEHICLE_TYPE_CAR },
+    { "huntley", VEHICLE_TYPE_CAR },
+    { "duster", VEHICLE_TYPE_MISC },
+    { "panto", VEHICLE_TYPE_CAR },
+    { "trash", VEHICLE_TYPE_TRUCK },
+    { "entityxf", VEHICLE_TYPE_CAR },
+    { "rubble", VEHICLE_TYPE_TRUCK },
+    { "bjxl", VEHICLE_TYPE_CAR },
+    { "pony", VEHICLE_TYPE_CAR },
+    { "asterope", VEHICLE_TYPE_CAR },
+    { "squalo", VEHICLE_TYPE_MISC },
+    { "gargoyle", VEHICLE_TYPE_MISC },
+    { "forklift", VEHICLE_TYPE_MISC },
+    { "thrust", VEHICLE_TYPE_MISC },
+    { "submersible", VEHICLE_TYPE_MISC },
+    { "lurcher", VEHICLE_TYPE_CAR },
+    { "packer", VEHICLE_TYPE_TRUCK },
+    { "phoenix", VEHICLE_TYPE_CAR },
+    { "handler", VEHICLE_TYPE_MISC },
+    { "tropos", VEHICLE_TYPE_CAR },
+    { "granger", VEHICLE_TYPE_CAR },
+    { "gburrito", VEHICLE_TYPE_CAR },
+    { "manchez", VEHICLE_TYPE_MISC },
+    { "roosevelt", VEHICLE_TYPE_CAR },
+    { "bullet", VEHICLE_TYPE_CAR },
+    { "wolfsbane", VEHICLE_TYPE_MISC },
+    { "coach", VEHICLE_TYPE_TRUCK },
+    { "metrotrain", VEHICLE_TYPE_TRAM },
+    { "oracle", VEHICLE_TYPE_CAR },
+    { "italigtb", VEHICLE_TYPE_CAR },
+    { "vagner", VEHICLE_TYPE_CAR },
+    { "tailgater", VEHICLE_TYPE_CAR },
+    { "rhino", VEHICLE_TYPE_MISC },
+    { "baller", VEHICLE_TYPE_CAR },
+    { "halftrack", VEHICLE_TYPE_VAN },
+    { "nero", VEHICLE_TYPE_CAR },
+    { "carbonrs", VEHICLE_TYPE_MISC },
+    { "policeold", VEHICLE_TYPE_CAR },
+    { "freightcont", VEHICLE_TYPE_MISC },
+    { "skylift", VEHICLE_TYPE_MISC },
+    { "fugitive", VEHICLE_TYPE_CAR },
+    { "bestiagts", VEHICLE_TYPE_CAR },
+    { "docktug", VEHICLE_TYPE_MISC },
+    { "warrener", VEHICLE_TYPE_CAR },
+    { "sanctus", VEHICLE_TYPE_MISC },
+    { "towtruck", VEHICLE_TYPE_VAN },
+    { "annhil", VEHICLE_TYPE_MISC },
+    { "superd", VEHICLE_TYPE_CAR },
+    { "feltzer", VEHICLE_TYPE_CAR },
+    { "turismor", VEHICLE_TYPE_CAR },
+    { "bobcatxl", VEHICLE_TYPE_CAR },
+    { "esskey", VEHICLE_TYPE_MISC },
+    { "mesa", VEHICLE_TYPE_CAR },
+    { "chino", VEHICLE_TYPE_CAR },
+    { "trailerlogs", VEHICLE_TYPE_MISC },
+    { "brioso", VEHICLE_TYPE_CAR },
+    { "cliffhanger", VEHICLE_TYPE_MISC },
+    { "bulldozer", VEHICLE_TYPE_MISC },
+    { "fusilade", VEHICLE_TYPE_CAR },
+    { "crusader", VEHICLE_TYPE_CAR },
+    { "furore", VEHICLE_TYPE_CAR },
+    { "freight", VEHICLE_TYPE_MISC },
+    { "double", VEHICLE_TYPE_MISC },
+    { "speeder", VEHICLE_TYPE_MISC },
+    { "nightshade", VEHICLE_TYPE_CAR },
+    { "stratum", VEHICLE_TYPE_CAR },
+    { "riot", VEHICLE_TYPE_VAN },
+    { "ruffian", VEHICLE_TYPE_MISC },
+    { "nemesis", VEHICLE_TYPE_MISC },
+    { "avarus", VEHICLE_TYPE_MISC },
+    { "shamal", VEHICLE_TYPE_MISC },
+    { "armytanker", VEHICLE_TYPE_MISC },
+    { "dinghy", VEHICLE_TYPE_MISC },
+    { "t", VEHICLE_TYPE_CAR },
+    { "sheava", VEHICLE_TYPE_CAR },
+    { "reaper", VEHICLE_TYPE_CAR },
+    { "tiptruck", VEHICLE_TYPE_TRUCK },
+    { "limo", VEHICLE_TYPE_CAR },
+    { "schwarzer", VEHICLE_TYPE_CAR },
+    { "ruiner", VEHICLE_TYPE_CAR },
+    { "diablous", VEHICLE_TYPE_MISC },
+    { "raptor", VEHICLE_TYPE_MISC },
+    { "gauntlet", VEHICLE_TYPE_CAR },
+    { "pfister", VEHICLE_TYPE_CAR },
+    { "glendale", VEHICLE_TYPE_CAR },
+    { "bulldoze", VEHICLE_TYPE_MISC },
+    { "tug", VEHICLE_TYPE_MISC },
+    { "tribike", VEHICLE_TYPE_CYCLIST },
+    { "paradise", VEHICLE_TYPE_CAR },
+    { "trflat", VEHICLE_TYPE_MISC },
+    { "blade", VEHICLE_TYPE_CAR },
+    { "vortex", VEHICLE_TYPE_MISC },
+    { "seminole", VEHICLE_TYPE_CAR },
+    { "stretch", VEHICLE_TYPE_CAR },
+    { "taxi", VEHICLE_TYPE_CAR },
+    { "lynx", VEHICLE_TYPE_CAR },
+    { "jackal", VEHICLE_TYPE_CAR },
+    { "sheriff", VEHICLE_TYPE_CAR },
+    { "dilettan", VEHICLE_TYPE_CAR },
+    { "prototipo", VEHICLE_TYPE_CAR },
+    { "enduro", VEHICLE_TYPE_MISC },
+    { "speedo", VEHICLE_TYPE_CAR },
+    { "blimp", VEHICLE_TYPE_MISC },
+    { "hexer", VEHICLE_TYPE_MISC },
+    { "dukes", VEHICLE_TYPE_CAR },
+    { "surano", VEHICLE_TYPE_CAR },
+    { "radi", VEHICLE_TYPE_CAR },
+    { "benson", VEHICLE_TYPE_TRUCK },
+    { "gp", VEHICLE_TYPE_CAR },
+    { "mixer", VEHICLE_TYPE_TRUCK },
+    { "manana", VEHICLE_TYPE_CAR },
+    { "titan", VEHICLE_TYPE_MISC },
+    { "monroe", VEHICLE_TYPE_CAR },
+    { "zombieb", VEHICLE_TYPE_MISC },
+    { "pranger", VEHICLE_TYPE_CAR },
+    { "zentorno", VEHICLE_TYPE_CAR },
+    { "cog", VEHICLE_TYPE_CAR },
+    { "tampa", VEHICLE_TYPE_CAR },
+    { "biff", VEHICLE_TYPE_VAN },
+    { "xa", VEHICLE_TYPE_CAR },
+    { "romero", VEHICLE_TYPE_CAR },
+    { "felon", VEHICLE_TYPE_CAR },
+    { "alpha", VEHICLE_TYPE_CAR },
+    { "exemplar", VEHICLE_TYPE_CAR },
+    { "sultan", VEHICLE_TYPE_CAR },
+    { "tornado", VEHICLE_TYPE_CAR },
+    { "insurgent", VEHICLE_TYPE_CAR },
+    { "osiris", VEHICLE_TYPE_CAR },
+    { "taco", VEHICLE_TYPE_VAN },
+    { "elegy", VEHICLE_TYPE_CAR },
+    { "rumpo", VEHICLE_TYPE_CAR },
+    { "btype", VEHICLE_TYPE_CAR },
+    { "brickade", VEHICLE_TYPE_TRUCK },
+    { "toro", VEHICLE_TYPE_MISC },
+    { "stanier", VEHICLE_TYPE_CAR },
+    { "ambulance", VEHICLE_TYPE_VAN },
+    { "policet", VEHICLE_TYPE_CAR },
+    { "pbus", VEHICLE_TYPE_TRUCK },
+    { "utiltruck", VEHICLE_TYPE_VAN },
+    { "trailerlarge", VEHICLE_TYPE_MISC },
+    { "seashark", VEHICLE_TYPE_MISC },
+    { "surfer", VEHICLE_TYPE_CAR },
+    { "armytrailer", VEHICLE_TYPE_MISC },
+    { "trailer", VEHICLE_TYPE_MISC },
+    { "mamba", VEHICLE_TYPE_CAR },
+    { "lazer", VEHICLE_TYPE_MISC },
+    { "trophytruck", VEHICLE_TYPE_CAR },
+    { "rentalbus", VEHICLE_TYPE_VAN },
+    { "penumbra", VEHICLE_TYPE_CAR },
+    { "faggio", VEHICLE_TYPE_MISC },
+    { "wastelander", VEHICLE_TYPE_TRUCK },
+    { "caddy", VEHICLE_TYPE_MISC },
+    { "khamelion", VEHICLE_TYPE_CAR },
+    { "rentbus", VEHICLE_TYPE_VAN },
+    { "voltic", VEHICLE_TYPE_CAR },
+    { "leb", VEHICLE_TYPE_CAR },
+    { "innovation", VEHICLE_TYPE_MISC },
+    { "contender", VEHICLE_TYPE_CAR },
+    { "sandking", VEHICLE_TYPE_CAR },
+    { "dune", VEHICLE_TYPE_CAR },
+    { "fork", VEHICLE_TYPE_MISC },
+    { "cutter", VEHICLE_TYPE_MISC },
+    { "jet", VEHICLE_TYPE_MISC },
+    { "rebel", VEHICLE_TYPE_CAR },
+    { "sanchez", VEHICLE_TYPE_MISC },
+    { "asea", VEHICLE_TYPE_CAR },
+    { "premier", VEHICLE_TYPE_CAR },
+    { "maverick", VEHICLE_TYPE_MISC },
+    { "ratbike", VEHICLE_TYPE_MISC },
+    { "stingergt", VEHICLE_TYPE_CAR },
+    { "slamvan", VEHICLE_TYPE_CAR },
+    { "stalion", VEHICLE_TYPE_CAR },
+    { "vacca", VEHICLE_TYPE_CAR },
+    { "flatbed", VEHICLE_TYPE_TRUCK },
+    { "bf", VEHICLE_TYPE_MISC },
+    { "velum", VEHICLE_TYPE_MISC },
+    { "windsor", VEHICLE_TYPE_CAR },
+    { "trailers", VEHICLE_TYPE_MISC },
+    { "baletrailer", VEHICLE_TYPE_MISC },
+    { "pigalle", VEHICLE_TYPE_CAR },
+    { "besra", VEHICLE_TYPE_MISC },
+    { "docktrailer", VEHICLE_TYPE_MISC },
+    { "jester", VEHICLE_TYPE_CAR },
+    { "buzzard", VEHICLE_TYPE_MISC },
+    { "mower", VEHICLE_TYPE_MISC },
+    { "frogger", VEHICLE_TYPE_MISC },
+    { "serrano", VEHICLE_TYPE_CAR },
+    { "banshee", VEHICLE_TYPE_CAR },
+    { "tankercar", VEHICLE_TYPE_MISC },
+    { "fixter", VEHICLE_TYPE_CYCLIST },
+    { "bodhi", VEHICLE_TYPE_CAR },
+    { "suntrap", VEHICLE_TYPE_MISC },
+    { "raketrailer", VEHICLE_TYPE_MISC },
+    { "massacro", VEHICLE_TYPE_CAR },
+    { "tropic", VEHICLE_TYPE_MISC },
+    { "tanker", VEHICLE_TYPE_MISC },
+    { "daemon", VEHICLE_TYPE_MISC },
+    { "shotaro", VEHICLE_TYPE_MISC },
+    { "voodoo", VEHICLE_TYPE_CAR },
+    { "hotknife", VEHICLE_TYPE_CAR },
+    { "cognoscenti", VEHICLE_TYPE_CAR },
+    { "virgo", VEHICLE_TYPE_CAR },
+    { "prairie", VEHICLE_TYPE_CAR },
+    { "zombiea", VEHICLE_TYPE_MISC },
+    { "fcr", VEHICLE_TYPE_MISC },
+    { "stockade", VEHICLE_TYPE_VAN },
+    { "freighttrailer", VEHICLE_TYPE_MISC },
+    { "bmx", VEHICLE_TYPE_CYCLIST },
+    { "cruiser", VEHICLE_TYPE_CYCLIST },
+    { "rocoto", VEHICLE_TYPE_CAR },
+    { "monster", VEHICLE_TYPE_VAN },
+    { "bati", VEHICLE_TYPE_MISC },
+    { "cavalcade", VEHICLE_TYPE_CAR },
+    { "journey", VEHICLE_TYPE_VAN },
+    { "washington", VEHICLE_TYPE_CAR },
+    { "luxor", VEHICLE_TYPE_MISC },
+    { "bus", VEHICLE_TYPE_TRUCK },
+    { "scrap", VEHICLE_TYPE_VAN },
+    { "rloader", VEHICLE_TYPE_CAR },
+    { "landstal", VEHICLE_TYPE_CAR },
+    { "infernus", VEHICLE_TYPE_CAR },
+    { "scorcher", VEHICLE_TYPE_CYCLIST },
+    { "supervolito", VEHICLE_TYPE_MISC },
+    { "issi", VEHICLE_TYPE_CAR },
+    { "adder", VEHICLE_TYPE_CAR },
+    { "cavcade", VEHICLE_TYPE_CAR },
+    { "marquis", VEHICLE_TYPE_MISC },
+    { "burrito", VEHICLE_TYPE_CAR },
+    { "vader", VEHICLE_TYPE_MISC },
+    { "bison", VEHICLE_TYPE_CAR },
+    { "kuruma", VEHICLE_TYPE_CAR },
+    { "cargoplane", VEHICLE_TYPE_MISC },
+    { "fmj", VEHICLE_TYPE_CAR },
+    { "jb", VEHICLE_TYPE_CAR },
+    { "youga", VEHICLE_TYPE_CAR },
+    { "carbonizzare", VEHICLE_TYPE_CAR },
+    { "annihilator", VEHICLE_TYPE_MISC },
+    { "savage", VEHICLE_TYPE_MISC },
+    { "habanero", VEHICLE_TYPE_CAR },
+    { "torero", VEHICLE_TYPE_CAR },
+    { "fq", VEHICLE_TYPE_CAR },
+    { "comet", VEHICLE_TYPE_CAR },
+    { "blista", VEHICLE_TYPE_CAR },
+    { "kalahari", VEHICLE_TYPE_CAR },
+    { "pounder", VEHICLE_TYPE_TRUCK },
+    { "nightshark", VEHICLE_TYPE_CAR },
+    { "dubsta", VEHICLE_TYPE_CAR },
+    { "freightcar", VEHICLE_TYPE_MISC },
+    { "astrope", VEHICLE_TYPE_CAR },
+    { "akuma", VEHICLE_TYPE_MISC },
+    { "bagger", VEHICLE_TYPE_MISC },
+    { "boxville", VEHICLE_TYPE_VAN },
+    { "dominator", VEHICLE_TYPE_CAR },
+    { "ninef", VEHICLE_TYPE_CAR },
+};
+
+constexpr uint32_t VT_CLIPPED_TABLE_SEEDS[] = {
+    366, 1, 28, 130, 28, 11, 52, 4, 22, 43, 29, 10, 19, 5, 209, 6,
+    0, 33, 65, 189, 68, 0, 8, 5, 45, 68, 3, 4, 5, 74, 1, 9,
+    4, 40, 10, 468, 44, 162, 72, 68, 80, 2, 204, 4, 42, 244, 28, 128,
+    3, 190, 2, 1, 1, 276, 9, 61, 814, 58, 8, 5, 7, 44, 4, 6,
+    141, 54, 0, 2, 4, 100, 7, 41, 1, 2, 9, 708, 4, 2, 26, 12,
+    83, 11, 4, 54, 34, 5, 13, 836, 128, 8, 52, 38, 15, 115, 2, 242,
+    0, 3, 572, 106, 279, 24, 1, 10, 122, 1, 139, 6, 129, 15, 3, 13,
+    423, 8, 16, 76, 3, 4, 81, 420, 10, 85, 27, 3, 3, 63, 831, 56,
+    1, 3, 13, 66, 93, 29, 459, 5, 2, 16, 72, 58, 20, 3, 288, 6,
+    659, 283, 441, 454, 21, 13, 12, 911, 22, 2, 5, 21, 450, 2, 271, 60,
+    0, 2, 2, 37, 23, 72, 1117, 56, 2521, 947, 214, 569, 2, 99, 269, 132,
+    1509, 271, 140, 257, 97, 327, 293, 234, 24, 23, 596, 189, 95, 70, 5, 1057,
+    55, 420, 1, 205, 9, 5, 1212, 8, 771, 668, 78, 42, 13, 189, 1, 7,
+    2, 129, 2, 3, 23, 81, 2382, 13, 57, 863, 423, 1319, 1792, 479, 80, 18,
+    325, 18, 285, 9, 1, 4, 4619, 2, 50, 3, 19, 181, 5, 54, 150, 8,
+    174, 244,
+};
+constexpr VehicleNameEntry VT_CLIPPED_TABLE[] = {
+    { "proptrai", VEHICLE_TYPE_MISC },
+    { "buffal", VEHICLE_TYPE_CAR },
+    { "boxvi", VEHICLE_TYPE_VAN },
+    { "zomb", VEHICLE_TYPE_MISC },
+    { "pa", VEHICLE_TYPE_CAR },
+    { "duke", VEHICLE_TYPE_CAR },
+    { "halftra", VEHICLE_TYPE_VAN },
+    { "ruine", VEHICLE_TYPE_CAR },
+    { "fm", VEHICLE_TYPE_CAR },
+    { "subme", VEHICLE_TYPE_MISC },
+    { "fut", VEHICLE_TYPE_CAR },
+    { "tornad", VEHICLE_TYPE_CAR },
+    { "trailerl", VEHICLE_TYPE_MISC },
+    { "freightgra", VEHICLE_TYPE_MISC },
+    { "jetm", VEHICLE_TYPE_MISC },
+    { "rentb", VEHICLE_TYPE_VAN },
+    { "cam", VEHICLE_TYPE_VAN },
+    { "dockt", VEHICLE_TYPE_MISC },
+    { "rallytruc", VEHICLE_TYPE_TRUCK },
+    { "bulle", VEHICLE_TYPE_CAR },
+    { "mons", VEHICLE_TYPE_VAN },
+    { "fugit", VEHICLE_TYPE_CAR },
+    { "ava", VEHICLE_TYPE_MISC },
+    { "pac", VEHICLE_TYPE_TRUCK },
+    { "ra", VEHICLE_TYPE_CAR },
+    { "fact", VEHICLE_TYPE_CAR },
+    { "seash", VEHICLE_TYPE_MISC },
+    { "journ", VEHICLE_TYPE_VAN },
+    { "bt", VEHICLE_TYPE_CAR },
+    { "lurche", VEHICLE_TYPE_CAR },
+    { "emper", VEHICLE_TYPE_CAR },
+    { "shama", VEHICLE_TYPE_MISC },
+    { "zombie", VEHICLE_TYPE_MISC },
+    { "tailgat", VEHICLE_TYPE_CAR },
+    { "trailersm", VEHICLE_TYPE_MISC },
+    { "seasha", VEHICLE_TYPE_MISC },
+    { "zty", VEHICLE_TYPE_CAR },
+    { "ambula", VEHICLE_TYPE_VAN },
+    { "monro", VEHICLE_TYPE_CAR },
+    { "coque", VEHICLE_TYPE_CAR },
+    { "graintrail", VEHICLE_TYPE_MISC },
+    { "armytan", VEHICLE_TYPE_MISC },
+    { "stun", VEHICLE_TYPE_MISC },
+    { "rio", VEHICLE_TYPE_VAN },
+    { "armytank", VEHICLE_TYPE_MISC },
+    { "technic", VEHICLE_TYPE_CAR },
+    { "nim", VEHICLE_TYPE_MISC },
+    { "osiri", VEHICLE_TYPE_CAR },
+    { "peyo", VEHICLE_TYPE_CAR },
+    { "orac", VEHICLE_TYPE_CAR },
+    { "shea", VEHICLE_TYPE_CAR },
+    { "seminol", VEHICLE_TYPE_CAR },
+    { "surg", VEHICLE_TYPE_CAR },
+    { "halftr", VEHICLE_TYPE_VAN },
+    { "duste", VEHICLE_TYPE_MISC },
+    { "docktu", VEHICLE_TYPE_MISC },
+    { "pb", VEHICLE_TYPE_TRUCK },
+    { "submersibl", VEHICLE_TYPE_MISC },
+    { "cu", VEHICLE_TYPE_MISC },
+    { "cadd", VEHICLE_TYPE_MISC },
+    { "lux", VEHICLE_TYPE_MISC },
+    { "la", VEHICLE_TYPE_MISC },
+    { "mowe", VEHICLE_TYPE_MISC },
+    { "sav", VEHICLE_TYPE_MISC },
+    { "ing", VEHICLE_TYPE_CAR },
+    { "cavalc", VEHICLE_TYPE_CAR },
+    { "mana", VEHICLE_TYPE_CAR },
+    { "bri", VEHICLE_TYPE_CAR },
+    { "suntra", VEHICLE_TYPE_MISC },
+    { "hotkni", VEHICLE_TYPE_CAR },
+    { "nemes", VEHICLE_TYPE_MISC },
+    { "aku", VEHICLE_TYPE_MISC },
+    { "lands", VEHICLE_TYPE_CAR },
+    { "volat", VEHICLE_TYPE_MISC },
+    { "essk", VEHICLE_TYPE_MISC },
+    { "trailerlar", VEHICLE_TYPE_MISC },
+    { "rome", VEHICLE_TYPE_CAR },
+    { "polma", VEHICLE_TYPE_MISC },
+    { "sult", VEHICLE_TYPE_CAR },
+    { "gburrit", VEHICLE_TYPE_CAR },
+    { "vood", VEHICLE_TYPE_CAR },
+    { "do", VEHICLE_TYPE_MISC },
+    { "cas", VEHICLE_TYPE_CAR },
+    { "po", VEHICLE_TYPE_CAR },
+    { "m", VEHICLE_TYPE_CAR },
+    { "ben", VEHICLE_TYPE_TRUCK },
+    { "doub", VEHICLE_TYPE_MISC },
+    { "stali", VEHICLE_TYPE_CAR },
+    { "tempes", VEHICLE_TYPE_CAR },
+    { "rallytru", VEHICLE_TYPE_TRUCK },
+    { "vort", VEHICLE_TYPE_MISC },
+    { "sandkin", VEHICLE_TYPE_CAR },
+    { "mu", VEHICLE_TYPE_TRUCK },
+    { "ni", VEHICLE_TYPE_CAR },
+    { "dum", VEHICLE_TYPE_MISC },
+    { "ta", VEHICLE_TYPE_VAN },
+    { "kalaha", VEHICLE_TYPE_CAR },
+    { "gargoy", VEHICLE_TYPE_MISC },
+    { "boxvill", VEHICLE_TYPE_VAN },
+    { "supe", VEHICLE_TYPE_CAR },
+    { "burrit", VEHICLE_TYPE_CAR },
+    { "voo", VEHICLE_TYPE_CAR },
+    { "italigt", VEHICLE_TYPE_CAR },
+    { "roosevel", VEHICLE_TYPE_CAR },
+    { "trfl", VEHICLE_TYPE_MISC },
+    { "brick", VEHICLE_TYPE_TRUCK },
+    { "factio", VEHICLE_TYPE_CAR },
+    { "cheet", VEHICLE_TYPE_CAR },
+    { "stock", VEHICLE_TYPE_VAN },
+    { "flat", VEHICLE_TYPE_TRUCK },
+    { "rentalbu", VEHICLE_TYPE_VAN },
+    { "feltze", VEHICLE_TYPE_CAR },
+    { "empe", VEHICLE_TYPE_CAR },
+    { "washing", VEHICLE_TYPE_CAR },
+    { "boattraile", VEHICLE_TYPE_MISC },
+    { "utillitruc", VEHICLE_TYPE_VAN },
+    { "x", VEHICLE_TYPE_CAR },
+    { "sanct", VEHICLE_TYPE_MISC },
+    { "contende", VEHICLE_TYPE_CAR },
+    { "carbonr", VEHICLE_TYPE_MISC },
+    { "wolfsb", VEHICLE_TYPE_MISC },
+    { "strat", VEHICLE_TYPE_CAR },
+    { "itali", VEHICLE_TYPE_CAR },
+    { "rub", VEHICLE_TYPE_TRUCK },
+    { "rapto", VEHICLE_TYPE_MISC },
+    { "halftrac", VEHICLE_TYPE_VAN },
+    { "ba", VEHICLE_TYPE_MISC },
+    { "dilettant", VEHICLE_TYPE_CAR },
+    { "tvtraile", VEHICLE_TYPE_MISC },
+    { "techni", VEHICLE_TYPE_CAR },
+    { "tore", VEHICLE_TYPE_CAR },
+    { "gres", VEHICLE_TYPE_CAR },
+    { "vige", VEHICLE_TYPE_CAR },
+    { "ann", VEHICLE_TYPE_MISC },
+    { "she", VEHICLE_TYPE_CAR },
+    { "tiptru", VEHICLE_TYPE_TRUCK },
+    { "hotknif", VEHICLE_TYPE_CAR },
+    { "ratb", VEHICLE_TYPE_MISC },
+    { "phanto", VEHICLE_TYPE_TRUCK },
+    { "miniva", VEHICLE_TYPE_CAR },
+    { "suntr", VEHICLE_TYPE_MISC },
+    { "flatb", VEHICLE_TYPE_TRUCK },
+    { "crusa", VEHICLE_TYPE_CAR },
+    { "blaz", VEHICLE_TYPE_MISC },
+    { "dloa", VEHICLE_TYPE_CAR },
+    { "polic", VEHICLE_TYPE_CAR },
+    { "dub", VEHICLE_TYPE_CAR },
+    { "chee", VEHICLE_TYPE_CAR },
+    { "prair", VEHICLE_TYPE_CAR },
+    { "rental", VEHICLE_TYPE_VAN },
+    { "in", VEHICLE_TYPE_CAR },
+    { "sadle", VEHICLE_TYPE_CAR },
+    { "squ", VEHICLE_TYPE_MISC },
+    { "spect", VEHICLE_TYPE_CAR },
+    { "omni", VEHICLE_TYPE_CAR },
+    { "cuba", VEHICLE_TYPE_MISC },
+    { "stocka", VEHICLE_TYPE_VAN },
+    { "torer", VEHICLE_TYPE_CAR },
+    { "cablec", VEHICLE_TYPE_MISC },
+    { "blad", VEHICLE_TYPE_CAR },
+    { "bfinjectio", VEHICLE_TYPE_CAR },
+    { "ve", VEHICLE_TYPE_MISC },
+    { "ambulan", VEHICLE_TYPE_VAN },
+    { "sultanr", VEHICLE_TYPE_CAR },
+    { "stockad", VEHICLE_TYPE_VAN },
+    { "prototi", VEHICLE_TYPE_CAR },
+    { "vindica", VEHICLE_TYPE_MISC },
+    { "pound", VEHICLE_TYPE_TRUCK },
+    { "hexe", VEHICLE_TYPE_MISC },
+    { "besr", VEHICLE_TYPE_MISC },
+    { "crusade", VEHICLE_TYPE_CAR },
+    { "trib", VEHICLE_TYPE_CYCLIST },
+    { "prototip", VEHICLE_TYPE_CAR },
+    { "dingh", VEHICLE_TYPE_MISC },
+    { "carbonizzar", VEHICLE_TYPE_CAR },
+    { "diabl", VEHICLE_TYPE_MISC },
+    { "cogcabri", VEHICLE_TYPE_CAR },
+    { "va", VEHICLE_TYPE_MISC },
+    { "tra", VEHICLE_TYPE_TRUCK },
+    { "bo", VEHICLE_TYPE_CAR },
+    { "sherif", VEHICLE_TYPE_CAR },
+    { "reb", VEHICLE_TYPE_CAR },
+    { "turism", VEHICLE_TYPE_CAR },
+    { "frei", VEHICLE_TYPE_MISC },
+    { "rusto", VEHICLE_TYPE_CAR },
+    { "fag", VEHICLE_TYPE_MISC },
+    { "towtr", VEHICLE_TYPE_VAN },
+    { "hakuc", VEHICLE_TYPE_MISC },
+    { "intrude", VEHICLE_TYPE_CAR },
+    { "prem", VEHICLE_TYPE_CAR },
+    { "cargob", VEHICLE_TYPE_MISC },
+    { "daem", VEHICLE_TYPE_MISC },
+    { "scorch", VEHICLE_TYPE_CYCLIST },
+    { "bfinjecti", VEHICLE_TYPE_CAR },
+    { "coa", VEHICLE_TYPE_TRUCK },
+    { "chime", VEHICLE_TYPE_MISC },
+    { "bulld", VEHICLE_TYPE_MISC },
+    { "rh", VEHICLE_TYPE_MISC },
+    { "vade", VEHICLE_TYPE_MISC },
+    { "nightbla", VEHICLE_TYPE_MISC },
+    { "fugiti", VEHICLE_TYPE_CAR },
+    { "li", VEHICLE_TYPE_CAR },
+    { "wasteland", VEHICLE_TYPE_TRUCK },
+    { "duk", VEHICLE_TYPE_CAR },
+    { "sur", VEHICLE_TYPE_CAR },
+    { "oracl", VEHICLE_TYPE_CAR },
+    { "n", VEHICLE_TYPE_CAR },
+    { "semin", VEHICLE_TYPE_CAR },
+    { "metrotrai", VEHICLE_TYPE_TRAM },
+    { "vindicat", VEHICLE_TYPE_MISC },
+    { "infer", VEHICLE_TYPE_CAR },
+    { "rum", VEHICLE_TYPE_CAR },
+    { "kurum", VEHICLE_TYPE_CAR },
+    { "insurg", VEHICLE_TYPE_CAR },
+    { "du", VEHICLE_TYPE_CAR },
+    { "blaze", VEHICLE_TYPE_MISC },
+    { "towtruc", VEHICLE_TYPE_VAN },
+    { "om", VEHICLE_TYPE_CAR },
+    { "pfis", VEHICLE_TYPE_CAR },
+    { "schaft", VEHICLE_TYPE_CAR },
+    { "tank", VEHICLE_TYPE_MISC },
+    { "chimer", VEHICLE_TYPE_MISC },
+    { "penumbr", VEHICLE_TYPE_CAR },
+    { "boxvil", VEHICLE_TYPE_VAN },
+    { "stret", VEHICLE_TYPE_CAR },
+    { "he", VEHICLE_TYPE_MISC },
+    { "stra", VEHICLE_TYPE_CAR },
+    { "fusilad", VEHICLE_TYPE_CAR },
+    { "raketraile", VEHICLE_TYPE_MISC },
+    { "bl", VEHICLE_TYPE_MISC },
+    { "technica", VEHICLE_TYPE_CAR },
+    { "mil", VEHICLE_TYPE_MISC },
+    { "utillitru", VEHICLE_TYPE_VAN },
+    { "washingto", VEHICLE_TYPE_CAR },
+    { "buffa", VEHICLE_TYPE_CAR },
+    { "kalah", VEHICLE_TYPE_CAR },
+    { "ele", VEHICLE_TYPE_CAR },
+    { "brios", VEHICLE_TYPE_CAR },
+    { "mi", VEHICLE_TYPE_TRUCK },
+    { "aster", VEHICLE_TYPE_CAR },
+    { "marq", VEHICLE_TYPE_MISC },
+    { "nightblad", VEHICLE_TYPE_MISC },
+    { "frogge", VEHICLE_TYPE_MISC },
+    { "innovatio", VEHICLE_TYPE_MISC },
+    { "vag", VEHICLE_TYPE_CAR },
+    { "tropo", VEHICLE_TYPE_CAR },
+    { "sandk", VEHICLE_TYPE_CAR },
+    { "nightshar", VEHICLE_TYPE_CAR },
+    { "ad", VEHICLE_TYPE_CAR },
+    { "landst", VEHICLE_TYPE_CAR },
+    { "stingerg", VEHICLE_TYPE_CAR },
+    { "ne", VEHICLE_TYPE_CAR },
+    { "se", VEHICLE_TYPE_CAR },
+    { "miniv", VEHICLE_TYPE_CAR },
+    { "cutte", VEHICLE_TYPE_MISC },
+    { "innovati", VEHICLE_TYPE_MISC },
+    { "docktrail", VEHICLE_TYPE_MISC },
+    { "dus", VEHICLE_TYPE_MISC },
+    { "crui", VEHICLE_TYPE_CYCLIST },
+    { "me", VEHICLE_TYPE_CAR },
+    { "viger", VEHICLE_TYPE_CAR },
+    { "baletrai", VEHICLE_TYPE_MISC },
+    { "pc", VEHICLE_TYPE_MISC },
+    { "cruis", VEHICLE_TYPE_CYCLIST },
+    { "trailerlarg", VEHICLE_TYPE_MISC },
+    { "grange", VEHICLE_TYPE_CAR },
+    { "carbo", VEHICLE_TYPE_CAR },
+    { "brio", VEHICLE_TYPE_CAR },
+    { "re", VEHICLE_TYPE_CAR },
+    { "stalio", VEHICLE_TYPE_CAR },
+    { "ess", VEHICLE_TYPE_MISC },
+    { "roco", VEHICLE_TYPE_CAR },
+    { "lectr", VEHICLE_TYPE_MISC },
+    { "volt", VEHICLE_TYPE_CAR },
+    { "coac", VEHICLE_TYPE_TRUCK },
+    { "sura", VEHICLE_TYPE_CAR },
+    { "hydr", VEHICLE_TYPE_MISC },
+    { "baletrail", VEHICLE_TYPE_MISC },
+    { "ase", VEHICLE_TYPE_CAR },
+    { "rad", VEHICLE_TYPE_CAR },
+    { "freigh", VEHICLE_TYPE_MISC },
+    { "bodh", VEHICLE_TYPE_CAR },
+    { "metrotra", VEHICLE_TYPE_TRAM },
+    { "sentine", VEHICLE_TYPE_CAR },
+    { "haul", VEHICLE_TYPE_VAN },
+    { "trailersma", VEHICLE_TYPE_MISC },
+    { "sup", VEHICLE_TYPE_CAR },
+    { "is", VEHICLE_TYPE_CAR },
+    { "bli", VEHICLE_TYPE_CAR },
+    { "stan", VEHICLE_TYPE_CAR },
+    { "haule", VEHICLE_TYPE_VAN },
+    { "monst", VEHICLE_TYPE_VAN },
+    { "cutt", VEHICLE_TYPE_MISC },
+    { "stretc", VEHICLE_TYPE_CAR },
+    { "flatbe", VEHICLE_TYPE_TRUCK },
+    { "manche", VEHICLE_TYPE_MISC },
+    { "asterop", VEHICLE_TYPE_CAR },
+    { "freightc", VEHICLE_TYPE_MISC },
+    { "stinge", VEHICLE_TYPE_CAR },
+    { "tourbu", VEHICLE_TYPE_VAN },
+    { "khameli", VEHICLE_TYPE_CAR },
+    { "sc", VEHICLE_TYPE_VAN },
+    { "coquet", VEHICLE_TYPE_CAR },
+    { "thru", VEHICLE_TYPE_MISC },
+    { "khamel", VEHICLE_TYPE_CAR },
+    { "gargoyl", VEHICLE_TYPE_MISC },
+    { "laz", VEHICLE_TYPE_MISC },
+    { "trop", VEHICLE_TYPE_MISC },
+    { "speede", VEHICLE_TYPE_MISC },
+    { "nimbu", VEHICLE_TYPE_MISC },
+    { "trf", VEHICLE_TYPE_MISC },
+    { "airt", VEHICLE_TYPE_MISC },
+    { "rapt", VEHICLE_TYPE_MISC },
+    { "pounde", VEHICLE_TYPE_TRUCK },
+    { "tribi", VEHICLE_TYPE_CYCLIST },
+    { "marqui", VEHICLE_TYPE_MISC },
+    { "slamv", VEHICLE_TYPE_CAR },
+    { "rapi", VEHICLE_TYPE_CAR },
+    { "casc", VEHICLE_TYPE_CAR },
+    { "rancherx", VEHICLE_TYPE_CAR },
+    { "domin", VEHICLE_TYPE_CAR },
+    { "stu", VEHICLE_TYPE_MISC },
+    { "oppresso", VEHICLE_TYPE_MISC },
+    { "ruin", VEHICLE_TYPE_CAR },
+    { "trophytr", VEHICLE_TYPE_CAR },
+    { "sunt", VEHICLE_TYPE_MISC },
+    { "annihilato", VEHICLE_TYPE_MISC },
+    { "to", VEHICLE_TYPE_MISC },
+    { "hakuch", VEHICLE_TYPE_MISC },
+    { "pon", VEHICLE_TYPE_CAR },
+    { "fe", VEHICLE_TYPE_CAR },
+    { "tu", VEHICLE_TYPE_MISC },
+    { "blis", VEHICLE_TYPE_CAR },
+    { "mixe", VEHICLE_TYPE_TRUCK },
+    { "exempla", VEHICLE_TYPE_CAR },
+    { "pfiste", VEHICLE_TYPE_CAR },
+    { "marsh", VEHICLE_TYPE_VAN },
+    { "mo", VEHICLE_TYPE_MISC },
+    { "stratu", VEHICLE_TYPE_CAR },
+    { "tit", VEHICLE_TYPE_MISC },
+    { "pant", VEHICLE_TYPE_CAR },
+    { "landsta", VEHICLE_TYPE_CAR },
+    { "sheav", VEHICLE_TYPE_CAR },
+    { "mes", VEHICLE_TYPE_CAR },
+    { "blist", VEHICLE_TYPE_CAR },
+    { "valkyr", VEHICLE_TYPE_MISC },
+    { "tracto", VEHICLE_TYPE_MISC },
+    { "milj", VEHICLE_TYPE_MISC },
+    { "tempest", VEHICLE_TYPE_CAR },
+    { "sabr", VEHICLE_TYPE_CAR },
+    { "dubs", VEHICLE_TYPE_CAR },
+    { "daemo", VEHICLE_TYPE_MISC },
+    { "gburr", VEHICLE_TYPE_CAR },
+    { "mamb", VEHICLE_TYPE_CAR },
+    { "gran", VEHICLE_TYPE_CAR },
+    { "rhapsod", VEHICLE_TYPE_CAR },
+    { "neme", VEHICLE_TYPE_MISC },
+    { "habaner", VEHICLE_TYPE_CAR },
+    { "tor", VEHICLE_TYPE_MISC },
+    { "bestia", VEHICLE_TYPE_CAR },
+    { "rhaps", VEHICLE_TYPE_CAR },
+    { "squal", VEHICLE_TYPE_MISC },
+    { "jack", VEHICLE_TYPE_CAR },
+    { "zio", VEHICLE_TYPE_CAR },
+    { "rus", VEHICLE_TYPE_CAR },
+    { "vorte", VEHICLE_TYPE_MISC },
+    { "gaunt", VEHICLE_TYPE_CAR },
+    { "surfe", VEHICLE_TYPE_CAR },
+    { "cavcad", VEHICLE_TYPE_CAR },
+    { "carboni", VEHICLE_TYPE_CAR },
+    { "monr", VEHICLE_TYPE_CAR },
+    { "boattrail", VEHICLE_TYPE_MISC },
+    { "freightca", VEHICLE_TYPE_MISC },
+    { "verliere", VEHICLE_TYPE_CAR },
+    { "freightgrai", VEHICLE_TYPE_MISC },
+    { "hy", VEHICLE_TYPE_MISC },
+    { "monste", VEHICLE_TYPE_VAN },
+    { "supervol", VEHICLE_TYPE_MISC },
+    { "tyr", VEHICLE_TYPE_CAR },
+    { "rentalb", VEHICLE_TYPE_VAN },
+    { "rea", VEHICLE_TYPE_CAR },
+    { "huntle", VEHICLE_TYPE_CAR },
+    { "schwar", VEHICLE_TYPE_CAR },
+    { "boattrai", VEHICLE_TYPE_MISC },
+    { "moonb", VEHICLE_TYPE_CAR },
+    { "zombi", VEHICLE_TYPE_MISC },
+    { "semino", VEHICLE_TYPE_CAR },
+    { "tvtrail", VEHICLE_TYPE_MISC },
+    { "astr", VEHICLE_TYPE_CAR },
+    { "hand", VEHICLE_TYPE_MISC },
+    { "bty", VEHICLE_TYPE_CAR },
+    { "tailgate", VEHICLE_TYPE_CAR },
+    { "pran", VEHICLE_TYPE_CAR },
+    { "sovereig", VEHICLE_TYPE_MISC },
+    { "warre", VEHICLE_TYPE_CAR },
+    { "annhi", VEHICLE_TYPE_MISC },
+    { "swif", VEHICLE_TYPE_MISC },
+    { "bis", VEHICLE_TYPE_CAR },
+    { "rapid", VEHICLE_TYPE_CAR },
+    { "trfla", VEHICLE_TYPE_MISC },
+    { "voodo", VEHICLE_TYPE_CAR },
+    { "furo", VEHICLE_TYPE_CAR },
+    { "senti", VEHICLE_TYPE_CAR },
+    { "stre", VEHICLE_TYPE_CAR },
+    { "gauntl", VEHICLE_TYPE_CAR },
+    { "phoeni", VEHICLE_TYPE_CAR },
+    { "towtru", VEHICLE_TYPE_VAN },
+    { "tankerca", VEHICLE_TYPE_MISC },
+    { "com", VEHICLE_TYPE_CAR },
+    { "cognosce", VEHICLE_TYPE_CAR },
+    { "raketrail", VEHICLE_TYPE_MISC },
+    { "cub", VEHICLE_TYPE_MISC },
+    { "ruffia", VEHICLE_TYPE_MISC },
+    { "innovat", VEHICLE_TYPE_MISC },
+    { "supervolit", VEHICLE_TYPE_MISC },
+    { "intru", VEHICLE_TYPE_CAR },
+    { "rhin", VEHICLE_TYPE_MISC },
+    { "infern", VEHICLE_TYPE_CAR },
+    { "reap", VEHICLE_TYPE_CAR },
+    { "maveric", VEHICLE_TYPE_MISC },
+    { "j", VEHICLE_TYPE_CAR },
+    { "dominat", VEHICLE_TYPE_CAR },
+    { "valkyri", VEHICLE_TYPE_MISC },
+    { "zento", VEHICLE_TYPE_CAR },
+    { "ruff", VEHICLE_TYPE_MISC },
+    { "avar", VEHICLE_TYPE_MISC },
+    { "pol", VEHICLE_TYPE_CAR },
+    { "fix", VEHICLE_TYPE_CYCLIST },
+    { "annihila", VEHICLE_TYPE_MISC },
+    { "serran", VEHICLE_TYPE_CAR },
+    { "bfinject", VEHICLE_TYPE_CAR },
+    { "skyli", VEHICLE_TYPE_MISC },
+    { "cliffhang", VEHICLE_TYPE_MISC },
+    { "cavalca", VEHICLE_TYPE_CAR },
+    { "cavc", VEHICLE_TYPE_CAR },
+    { "schwa", VEHICLE_TYPE_CAR },
+    { "premi", VEHICLE_TYPE_CAR },
+    { "airtu", VEHICLE_TYPE_MISC },
+    { "vad", VEHICLE_TYPE_MISC },
+    { "feltz", VEHICLE_TYPE_CAR },
+    { "rallytr", VEHICLE_TYPE_TRUCK },
+    { "jeste", VEHICLE_TYPE_CAR },
+    { "faggi", VEHICLE_TYPE_MISC },
+    { "swi", VEHICLE_TYPE_MISC },
+    { "insurgen", VEHICLE_TYPE_CAR },
+    { "ding", VEHICLE_TYPE_MISC },
+    { "rhi", VEHICLE_TYPE_MISC },
+    { "freighttraile", VEHICLE_TYPE_MISC },
+    { "fusil", VEHICLE_TYPE_CAR },
+    { "vest", VEHICLE_TYPE_MISC },
+    { "bjx", VEHICLE_TYPE_CAR },
+    { "cargoplan", VEHICLE_TYPE_MISC },
+    { "rom", VEHICLE_TYPE_CAR },
+    { "entity", VEHICLE_TYPE_CAR },
+    { "sul", VEHICLE_TYPE_CAR },
+    { "subm", VEHICLE_TYPE_MISC },
+    { "rentbu", VEHICLE_TYPE_VAN },
+    { "warrene", VEHICLE_TYPE_CAR },
+    { "fur", VEHICLE_TYPE_CAR },
+    { "warren", VEHICLE_TYPE_CAR },
+    { "utiltru", VEHICLE_TYPE_VAN },
+    { "pbu", VEHICLE_TYPE_TRUCK },
+    { "tailga", VEHICLE_TYPE_CAR },
+    { "maver", VEHICLE_TYPE_MISC },
+    { "marshal", VEHICLE_TYPE_VAN },
+    { "exempl", VEHICLE_TYPE_CAR },
+    { "sandki", VEHICLE_TYPE_CAR },
+    { "skylif", VEHICLE_TYPE_MISC },
+    { "rload", VEHICLE_TYPE_CAR },
+    { "frogg", VEHICLE_TYPE_MISC },
+    { "bu", VEHICLE_TYPE_TRUCK },
+    { "osi", VEHICLE_TYPE_CAR },
+    { "virg", VEHICLE_TYPE_CAR },
+    { "submersib", VEHICLE_TYPE_MISC },
+    { "for", VEHICLE_TYPE_MISC },
+    { "buccane", VEHICLE_TYPE_CAR },
+    { "freighttrai", VEHICLE_TYPE_MISC },
+    { "manan", VEHICLE_TYPE_CAR },
+    { "frog", VEHICLE_TYPE_MISC },
+    { "cliffhan", VEHICLE_TYPE_MISC },
+    { "st", VEHICLE_TYPE_MISC },
+    { "r", VEHICLE_TYPE_CAR },
+    { "pfist", VEHICLE_TYPE_CAR },
+    { "docktrai", VEHICLE_TYPE_MISC },
+    { "vestr", VEHICLE_TYPE_MISC },
+    { "trophytru", VEHICLE_TYPE_CAR },
+    { "bat", VEHICLE_TYPE_MISC },
+    { "vacc", VEHICLE_TYPE_CAR },
+    { "endur", VEHICLE_TYPE_MISC },
+    { "packe", VEHICLE_TYPE_TRUCK },
+    { "defile", VEHICLE_TYPE_MISC },
+    { "braw", VEHICLE_TYPE_CAR },
+    { "serra", VEHICLE_TYPE_CAR },
+    { "cut", VEHICLE_TYPE_MISC },
+    { "parad", VEHICLE_TYPE_CAR },
+    { "be", VEHICLE_TYPE_MISC },
+    { "mix", VEHICLE_TYPE_TRUCK },
+    { "alp", VEHICLE_TYPE_CAR },
+    { "rui", VEHICLE_TYPE_CAR },
+    { "sanch", VEHICLE_TYPE_MISC },
+    { "surf", VEHICLE_TYPE_CAR },
+    { "cliffhange", VEHICLE_TYPE_MISC },
+    { "dilett", VEHICLE_TYPE_CAR },
+    { "tyru", VEHICLE_TYPE_CAR },
+    { "cogcabr", VEHICLE_TYPE_CAR },
+    { "conten", VEHICLE_TYPE_CAR },
+    { "dod", VEHICLE_TYPE_MISC },
+    { "gauntle", VEHICLE_TYPE_CAR },
+    { "handle", VEHICLE_TYPE_MISC },
+    { "ty", VEHICLE_TYPE_CAR },
+    { "dock", VEHICLE_TYPE_MISC },
+    { "mammatu", VEHICLE_TYPE_MISC },
+    { "osir", VEHICLE_TYPE_CAR },
+    { "dae", VEHICLE_TYPE_MISC },
+    { "sanc", VEHICLE_TYPE_MISC },
+    { "rap", VEHICLE_TYPE_MISC },
+    { "b", VEHICLE_TYPE_TRUCK },
+    { "nine", VEHICLE_TYPE_CAR },
+    { "iss", VEHICLE_TYPE_CAR },
+    { "policeo", VEHICLE_TYPE_CAR },
+    { "traile", VEHICLE_TYPE_MISC },
+    { "tvtrai", VEHICLE_TYPE_MISC },
+    { "camp", VEHICLE_TYPE_VAN },
+    { "scorc", VEHICLE_TYPE_CYCLIST },
+    { "predato", VEHICLE_TYPE_MISC },
+    { "cognoscent", VEHICLE_TYPE_CAR },
+    { "cargopl", VEHICLE_TYPE_MISC },
+    { "kalahar", VEHICLE_TYPE_CAR },
+    { "volti", VEHICLE_TYPE_CAR },
+    { "dloade", VEHICLE_TYPE_CAR },
+    { "lgu", VEHICLE_TYPE_CAR },
+    { "schafte", VEHICLE_TYPE_CAR },
+    { "pri", VEHICLE_TYPE_CAR },
+    { "sting", VEHICLE_TYPE_CAR },
+    { "bod", VEHICLE_TYPE_CAR },
+    { "blim", VEHICLE_TYPE_MISC },
+    { "tro", VEHICLE_TYPE_MISC },
+    { "bj", VEHICLE_TYPE_CAR },
+    { "poun", VEHICLE_TYPE_TRUCK },
+    { "metrotr", VEHICLE_TYPE_TRAM },
+    { "ruffi", VEHICLE_TYPE_MISC },
+    { "ca", VEHICLE_TYPE_MISC },
+    { "windso", VEHICLE_TYPE_CAR },
+    { "torn", VEHICLE_TYPE_CAR },
+    { "infernu", VEHICLE_TYPE_CAR },
+    { "cad", VEHICLE_TYPE_MISC },
+    { "nightshad", VEHICLE_TYPE_CAR },
+    { "burri", VEHICLE_TYPE_CAR },
+    { "seve", VEHICLE_TYPE_CAR },
+    { "sentin", VEHICLE_TYPE_CAR },
+    { "adde", VEHICLE_TYPE_CAR },
+    { "tiptr", VEHICLE_TYPE_TRUCK },
+    { "velu", VEHICLE_TYPE_MISC },
+    { "lguar", VEHICLE_TYPE_CAR },
+    { "come", VEHICLE_TYPE_CAR },
+    { "supervoli", VEHICLE_TYPE_MISC },
+    { "pack", VEHICLE_TYPE_TRUCK },
+    { "rocot", VEHICLE_TYPE_CAR },
+    { "i", VEHICLE_TYPE_CAR },
+    { "vindicato", VEHICLE_TYPE_MISC },
+    { "freightco", VEHICLE_TYPE_MISC },
+    { "lu", VEHICLE_TYPE_MISC },
+    { "air", VEHICLE_TYPE_TRUCK },
+    { "esske", VEHICLE_TYPE_MISC },
+    { "balle", VEHICLE_TYPE_CAR },
+    { "verlier", VEHICLE_TYPE_CAR },
+    { "nightsh", VEHICLE_TYPE_CAR },
+    { "trophytruc", VEHICLE_TYPE_CAR },
+    { "trailerla", VEHICLE_TYPE_MISC },
+    { "turis", VEHICLE_TYPE_CAR },
+    { "ztyp", VEHICLE_TYPE_CAR },
+    { "hyd", VEHICLE_TYPE_MISC },
+    { "paradis", VEHICLE_TYPE_CAR },
+    { "pigal", VEHICLE_TYPE_CAR },
+    { "regi", VEHICLE_TYPE_CAR },
+    { "chi", VEHICLE_TYPE_CAR },
+    { "glendal", VEHICLE_TYPE_CAR },
+    { "airbu", VEHICLE_TYPE_TRUCK },
+    { "diablou", VEHICLE_TYPE_MISC },
+    { "ak", VEHICLE_TYPE_MISC },
+    { "trai", VEHICLE_TYPE_MISC },
+    { "rebe", VEHICLE_TYPE_CAR },
+    { "z", VEHICLE_TYPE_CAR },
+    { "trac", VEHICLE_TYPE_MISC },
+    { "vor", VEHICLE_TYPE_MISC },
+    { "bift", VEHICLE_TYPE_MISC },
+    { "bag", VEHICLE_TYPE_MISC },
+    { "rubb", VEHICLE_TYPE_TRUCK },
+    { "je", VEHICLE_TYPE_MISC },
+    { "moonbe", VEHICLE_TYPE_CAR },
+    { "banshe", VEHICLE_TYPE_CAR },
+    { "polm", VEHICLE_TYPE_MISC },
+    { "patr", VEHICLE_TYPE_CAR },
+    { "cable", VEHICLE_TYPE_MISC },
+    { "sanche", VEHICLE_TYPE_MISC },
+    { "hau", VEHICLE_TYPE_VAN },
+    { "landstalke", VEHICLE_TYPE_CAR },
+    { "spec", VEHICLE_TYPE_CAR },
+    { "barrack", VEHICLE_TYPE_TRUCK },
+    { "chim", VEHICLE_TYPE_MISC },
+    { "penumb", VEHICLE_TYPE_CAR },
+    { "biso", VEHICLE_TYPE_CAR },
+    { "shot", VEHICLE_TYPE_MISC },
+    { "tanke", VEHICLE_TYPE_MISC },
+    { "bobcatx", VEHICLE_TYPE_CAR },
+    { "cognoscen", VEHICLE_TYPE_CAR },
+    { "ripl", VEHICLE_TYPE_MISC },
+    { "specte", VEHICLE_TYPE_CAR },
+    { "cruise", VEHICLE_TYPE_CYCLIST },
+    { "dload", VEHICLE_TYPE_CAR },
+    { "rent", VEHICLE_TYPE_VAN },
+    { "baletraile", VEHICLE_TYPE_MISC },
+    { "sham", VEHICLE_TYPE_MISC },
+    { "sev", VEHICLE_TYPE_CAR },
+    { "bal", VEHICLE_TYPE_CAR },
+    { "as", VEHICLE_TYPE_CAR },
+    { "slamva", VEHICLE_TYPE_CAR },
+    { "nightsha", VEHICLE_TYPE_CAR },
+    { "phoen", VEHICLE_TYPE_CAR },
+    { "dubst", VEHICLE_TYPE_CAR },
+    { "p", VEHICLE_TYPE_TRUCK },
+    { "ambulanc", VEHICLE_TYPE_VAN },
+    { "sabreg", VEHICLE_TYPE_CAR },
+    { "alph", VEHICLE_TYPE_CAR },
+    { "cargobo", VEHICLE_TYPE_MISC },
+    { "poli", VEHICLE_TYPE_CAR },
+    { "rooseve", VEHICLE_TYPE_CAR },
+    { "rloade", VEHICLE_TYPE_CAR },
+    { "firetr", VEHICLE_TYPE_TRUCK },
+    { "pr", VEHICLE_TYPE_CAR },
+    { "cheeta", VEHICLE_TYPE_CAR },
+    { "washingt", VEHICLE_TYPE_CAR },
+    { "din", VEHICLE_TYPE_MISC },
+    { "landstalk", VEHICLE_TYPE_CAR },
+    { "utiltr", VEHICLE_TYPE_VAN },
+    { "doubl", VEHICLE_TYPE_MISC },
+    { "furoreg", VEHICLE_TYPE_CAR },
+    { "vig", VEHICLE_TYPE_CAR },
+    { "ma", VEHICLE_TYPE_CAR },
+    { "fel", VEHICLE_TYPE_CAR },
+    { "hakucho", VEHICLE_TYPE_MISC },
+    { "prang", VEHICLE_TYPE_CAR },
+    { "cavalcad", VEHICLE_TYPE_CAR },
+    { "graintrai", VEHICLE_TYPE_MISC },
+    { "entityx", VEHICLE_TYPE_CAR },
+    { "scorche", VEHICLE_TYPE_CYCLIST },
+    { "carbon", VEHICLE_TYPE_CAR },
+    { "bestiag", VEHICLE_TYPE_CAR },
+    { "contend", VEHICLE_TYPE_CAR },
+    { "marqu", VEHICLE_TYPE_MISC },
+    { "fb", VEHICLE_TYPE_CAR },
+    { "exemp", VEHICLE_TYPE_CAR },
+    { "phan", VEHICLE_TYPE_TRUCK },
+    { "dilet", VEHICLE_TYPE_CAR },
+    { "zi", VEHICLE_TYPE_CAR },
+    { "pey", VEHICLE_TYPE_CAR },
+    { "laze", VEHICLE_TYPE_MISC },
+    { "penetrato", VEHICLE_TYPE_CAR },
+    { "paradi", VEHICLE_TYPE_CAR },
+    { "wastelan", VEHICLE_TYPE_TRUCK },
+    { "volatu", VEHICLE_TYPE_MISC },
+    { "submersi", VEHICLE_TYPE_MISC },
+    { "massacr", VEHICLE_TYPE_CAR },
+    { "peyot", VEHICLE_TYPE_CAR },
+    { "graintraile", VEHICLE_TYPE_MISC },
+    { "crusad", VEHICLE_TYPE_CAR },
+    { "add", VEHICLE_TYPE_CAR },
+    { "zt", VEHICLE_TYPE_CAR },
+    { "carbonizz", VEHICLE_TYPE_CAR },
+    { "omn", VEHICLE_TYPE_CAR },
+    { "ch", VEHICLE_TYPE_CAR },
+    { "yo", VEHICLE_TYPE_CAR },
+    { "vagne", VEHICLE_TYPE_CAR },
+    { "buff", VEHICLE_TYPE_CAR },
+    { "mam", VEHICLE_TYPE_CAR },
+    { "rapidg", VEHICLE_TYPE_CAR },
+    { "forklif", VEHICLE_TYPE_MISC },
+    { "ri", VEHICLE_TYPE_VAN },
+    { "jetma", VEHICLE_TYPE_MISC },
+    { "armytanke", VEHICLE_TYPE_MISC },
+    { "tita", VEHICLE_TYPE_MISC },
+    { "benso", VEHICLE_TYPE_TRUCK },
+    { "youg", VEHICLE_TYPE_CAR },
+    { "mow", VEHICLE_TYPE_MISC },
+    { "schwarz", VEHICLE_TYPE_CAR },
+    { "hunt", VEHICLE_TYPE_CAR },
+    { "cargo", VEHICLE_TYPE_MISC },
+    { "guardia", VEHICLE_TYPE_VAN },
+    { "schaf", VEHICLE_TYPE_CAR },
+    { "wind", VEHICLE_TYPE_CAR },
+    { "bif", VEHICLE_TYPE_VAN },
+    { "sw", VEHICLE_TYPE_MISC },
+    { "stal", VEHICLE_TYPE_CAR },
+    { "endu", VEHICLE_TYPE_MISC },
+    { "campe", VEHICLE_TYPE_VAN },
+    { "soverei", VEHICLE_TYPE_MISC },
+    { "reape", VEHICLE_TYPE_CAR },
+    { "policeol", VEHICLE_TYPE_CAR },
+    { "massa", VEHICLE_TYPE_CAR },
+    { "kuru", VEHICLE_TYPE_CAR },
+    { "vel", VEHICLE_TYPE_MISC },
+    { "phant", VEHICLE_TYPE_TRUCK },
+    { "felo", VEHICLE_TYPE_CAR },
+    { "rust", VEHICLE_TYPE_CAR },
+    { "ru", VEHICLE_TYPE_CAR },
+    { "you", VEHICLE_TYPE_CAR },
+    { "gargo", VEHICLE_TYPE_MISC },
+    { "docktraile", VEHICLE_TYPE_MISC },
+    { "armytrail", VEHICLE_TYPE_MISC },
+    { "cavca", VEHICLE_TYPE_CAR },
+    { "freightcon", VEHICLE_TYPE_MISC },
+    { "armytrai", VEHICLE_TYPE_MISC },
+    { "vi", VEHICLE_TYPE_CAR },
+    { "btyp", VEHICLE_TYPE_CAR },
+    { "rip", VEHICLE_TYPE_MISC },
+    { "wolfsba", VEHICLE_TYPE_MISC },
+    { "ly", VEHICLE_TYPE_CAR },
+    { "italig", VEHICLE_TYPE_CAR },
+    { "rancher", VEHICLE_TYPE_CAR },
+    { "picado", VEHICLE_TYPE_CAR },
+    { "jac", VEHICLE_TYPE_CAR },
+    { "manch", VEHICLE_TYPE_MISC },
+    { "bans", VEHICLE_TYPE_CAR },
+    { "ves", VEHICLE_TYPE_MISC },
+    { "rump", VEHICLE_TYPE_CAR },
+    { "prange", VEHICLE_TYPE_CAR },
+    { "tempe", VEHICLE_TYPE_CAR },
+    { "ap", VEHICLE_TYPE_MISC },
+    { "rubbl", VEHICLE_TYPE_TRUCK },
+    { "thrus", VEHICLE_TYPE_MISC },
+    { "le", VEHICLE_TYPE_CAR },
+    { "oppress", VEHICLE_TYPE_MISC },
+    { "phoe", VEHICLE_TYPE_CAR },
+    { "penetrat", VEHICLE_TYPE_CAR },
+    { "buccanee", VEHICLE_TYPE_CAR },
+    { "kur", VEHICLE_TYPE_CAR },
+    { "proptrail", VEHICLE_TYPE_MISC },
+    { "thr", VEHICLE_TYPE_MISC },
+    { "habane", VEHICLE_TYPE_CAR },
+    { "bricka", VEHICLE_TYPE_TRUCK },
+    { "spee", VEHICLE_TYPE_CAR },
+    { "armytraile", VEHICLE_TYPE_MISC },
+    { "buzzar", VEHICLE_TYPE_MISC },
+    { "fusila", VEHICLE_TYPE_CAR },
+    { "domina", VEHICLE_TYPE_CAR },
+    { "sabre", VEHICLE_TYPE_CAR },
+    { "trailersmal", VEHICLE_TYPE_MISC },
+    { "bobcat", VEHICLE_TYPE_CAR },
+    { "bagg", VEHICLE_TYPE_MISC },
+    { "hex", VEHICLE_TYPE_MISC },
+    { "lim", VEHICLE_TYPE_CAR },
+    { "maveri", VEHICLE_TYPE_MISC },
+    { "patri", VEHICLE_TYPE_CAR },
+    { "tankerc", VEHICLE_TYPE_MISC },
+    { "prai", VEHICLE_TYPE_CAR },
+    { "bla", VEHICLE_TYPE_MISC },
+    { "ball", VEHICLE_TYPE_CAR },
+    { "tras", VEHICLE_TYPE_TRUCK },
+    { "bi", VEHICLE_TYPE_VAN },
+    { "jacka", VEHICLE_TYPE_CAR },
+    { "penetra", VEHICLE_TYPE_CAR },
+    { "massac", VEHICLE_TYPE_CAR },
+    { "g", VEHICLE_TYPE_CAR },
+    { "proptraile", VEHICLE_TYPE_MISC },
+    { "fixte", VEHICLE_TYPE_CYCLIST },
+    { "handl", VEHICLE_TYPE_MISC },
+    { "roosev", VEHICLE_TYPE_CAR },
+    { "journe", VEHICLE_TYPE_VAN },
+    { "nin", VEHICLE_TYPE_CAR },
+    { "chin", VEHICLE_TYPE_CAR },
+    { "akum", VEHICLE_TYPE_MISC },
+    { "defil", VEHICLE_TYPE_MISC },
+    { "reg", VEHICLE_TYPE_CAR },
+    { "tropi", VEHICLE_TYPE_MISC },
+    { "lurch", VEHICLE_TYPE_CAR },
+    { "bens", VEHICLE_TYPE_TRUCK },
+    { "buzz", VEHICLE_TYPE_MISC },
+    { "super", VEHICLE_TYPE_CAR },
+    { "shotar", VEHICLE_TYPE_MISC },
+    { "grang", VEHICLE_TYPE_CAR },
+    { "cogcab", VEHICLE_TYPE_CAR },
+    { "khamelio", VEHICLE_TYPE_CAR },
+    { "bes", VEHICLE_TYPE_MISC },
+    { "dun", VEHICLE_TYPE_CAR },
+    { "insurge", VEHICLE_TYPE_CAR },
+    { "premie", VEHICLE_TYPE_CAR },
+    { "buccan", VEHICLE_TYPE_CAR },
+    { "picad", VEHICLE_TYPE_CAR },
+    { "tan", VEHICLE_TYPE_MISC },
+    { "vol", VEHICLE_TYPE_CAR },
+    { "manc", VEHICLE_TYPE_MISC },
+    { "penum", VEHICLE_TYPE_CAR },
+    { "fixt", VEHICLE_TYPE_CYCLIST },
+    { "entit", VEHICLE_TYPE_CAR },
+    { "cableca", VEHICLE_TYPE_MISC },
+    { "arde", VEHICLE_TYPE_CAR },
+    { "man", VEHICLE_TYPE_CAR },
+    { "forkli", VEHICLE_TYPE_MISC },
+    { "nightbl", VEHICLE_TYPE_MISC },
+    { "ratbik", VEHICLE_TYPE_MISC },
+    { "fo", VEHICLE_TYPE_MISC },
+    { "rloa", VEHICLE_TYPE_CAR },
+    { "pan", VEHICLE_TYPE_CAR },
+    { "astrop", VEHICLE_TYPE_CAR },
+    { "lec", VEHICLE_TYPE_MISC },
+    { "skyl", VEHICLE_TYPE_MISC },
+    { "lect", VEHICLE_TYPE_MISC },
+    { "pica", VEHICLE_TYPE_CAR },
+    { "burr", VEHICLE_TYPE_CAR },
+    { "tribik", VEHICLE_TYPE_CYCLIST },
+    { "glenda", VEHICLE_TYPE_CAR },
+    { "sher", VEHICLE_TYPE_CAR },
+    { "bm", VEHICLE_TYPE_CYCLIST },
+    { "zentorn", VEHICLE_TYPE_CAR },
+    { "regin", VEHICLE_TYPE_CAR },
+    { "ora", VEHICLE_TYPE_CAR },
+    { "gburri", VEHICLE_TYPE_CAR },
+    { "mul", VEHICLE_TYPE_TRUCK },
+    { "spe", VEHICLE_TYPE_CAR },
+    { "bulldoz", VEHICLE_TYPE_MISC },
+    { "annh", VEHICLE_TYPE_MISC },
+    { "haban", VEHICLE_TYPE_CAR },
+    { "el", VEHICLE_TYPE_CAR },
+    { "luxo", VEHICLE_TYPE_MISC },
+    { "scra", VEHICLE_TYPE_VAN },
+    { "firet", VEHICLE_TYPE_TRUCK },
+    { "turi", VEHICLE_TYPE_CAR },
+    { "ard", VEHICLE_TYPE_CAR },
+    { "lyn", VEHICLE_TYPE_CAR },
+    { "su", VEHICLE_TYPE_CAR },
+    { "lgua", VEHICLE_TYPE_CAR },
+    { "sad", VEHICLE_TYPE_CAR },
+    { "roc", VEHICLE_TYPE_CAR },
+    { "speed", VEHICLE_TYPE_CAR },
+    { "serr", VEHICLE_TYPE_CAR },
+    { "l", VEHICLE_TYPE_CAR },
+    { "glend", VEHICLE_TYPE_CAR },
+    { "carbonizza", VEHICLE_TYPE_CAR },
+    { "brawle", VEHICLE_TYPE_CAR },
+    { "furor", VEHICLE_TYPE_CAR },
+    { "wolfsban", VEHICLE_TYPE_MISC },
+    { "tract", VEHICLE_TYPE_MISC },
+    { "fc", VEHICLE_TYPE_MISC },
+    { "sadl", VEHICLE_TYPE_CAR },
+    { "lurc", VEHICLE_TYPE_CAR },
+    { "sovere", VEHICLE_TYPE_MISC },
+    { "forkl", VEHICLE_TYPE_MISC },
+    { "freightgr", VEHICLE_TYPE_MISC },
+    { "tax", VEHICLE_TYPE_CAR },
+    { "cargopla", VEHICLE_TYPE_MISC },
+    { "sheri", VEHICLE_TYPE_CAR },
+    { "suran", VEHICLE_TYPE_CAR },
+    { "patrio", VEHICLE_TYPE_CAR },
+    { "astero", VEHICLE_TYPE_CAR },
+    { "wastelande", VEHICLE_TYPE_TRUCK },
+    { "shota", VEHICLE_TYPE_MISC },
+    { "buzza", VEHICLE_TYPE_MISC },
+    { "ingo", VEHICLE_TYPE_CAR },
+    { "diablo", VEHICLE_TYPE_MISC },
+    { "xl", VEHICLE_TYPE_CAR },
+    { "bobca", VEHICLE_TYPE_CAR },
+    { "bansh", VEHICLE_TYPE_CAR },
+    { "felt", VEHICLE_TYPE_CAR },
+    { "coquett", VEHICLE_TYPE_CAR },
+    { "facti", VEHICLE_TYPE_CAR },
+    { "ti", VEHICLE_TYPE_MISC },
+    { "jour", VEHICLE_TYPE_VAN },
+    { "hotkn", VEHICLE_TYPE_CAR },
+    { "trailerlog", VEHICLE_TYPE_MISC },
+    { "eleg", VEHICLE_TYPE_CAR },
+    { "bull", VEHICLE_TYPE_CAR },
+    { "scr", VEHICLE_TYPE_VAN },
+    { "nimb", VEHICLE_TYPE_MISC },
+    { "ranche", VEHICLE_TYPE_CAR },
+    { "fu", VEHICLE_TYPE_CAR },
+    { "a", VEHICLE_TYPE_CAR },
+    { "trailerlo", VEHICLE_TYPE_MISC },
+    { "huntl", VEHICLE_TYPE_CAR },
+    { "stin", VEHICLE_TYPE_CAR },
+    { "freighttrail", VEHICLE_TYPE_MISC },
+    { "sulta", VEHICLE_TYPE_CAR },
+    { "ner", VEHICLE_TYPE_CAR },
+    { "brickad", VEHICLE_TYPE_TRUCK },
+    { "vola", VEHICLE_TYPE_MISC },
+    { "stanie", VEHICLE_TYPE_CAR },
+    { "bul", VEHICLE_TYPE_CAR },
+    { "fagg", VEHICLE_TYPE_MISC },
+    { "winds", VEHICLE_TYPE_CAR },
+    { "gresle", VEHICLE_TYPE_CAR },
+    { "mon", VEHICLE_TYPE_CAR },
+    { "savag", VEHICLE_TYPE_MISC },
+    { "end", VEHICLE_TYPE_MISC },
+    { "predat", VEHICLE_TYPE_MISC },
+    { "sanctu", VEHICLE_TYPE_MISC },
+    { "arden", VEHICLE_TYPE_CAR },
+    { "pigall", VEHICLE_TYPE_CAR },
+    { "vac", VEHICLE_TYPE_CAR },
+    { "vagn", VEHICLE_TYPE_CAR },
+    { "diletta", VEHICLE_TYPE_CAR },
+    { "bestiagt", VEHICLE_TYPE_CAR },
+    { "nemesi", VEHICLE_TYPE_MISC },
+    { "verlie", VEHICLE_TYPE_CAR },
+    { "mini", VEHICLE_TYPE_CAR },
+    { "sava", VEHICLE_TYPE_MISC },
+    { "co", VEHICLE_TYPE_TRUCK },
+    { "preda", VEHICLE_TYPE_MISC },
+    { "valky", VEHICLE_TYPE_MISC },
+    { "brawl", VEHICLE_TYPE_CAR },
+    { "vir", VEHICLE_TYPE_CAR },
+    { "trail", VEHICLE_TYPE_MISC },
+    { "empero", VEHICLE_TYPE_CAR },
+    { "airb", VEHICLE_TYPE_TRUCK },
+    { "tour", VEHICLE_TYPE_VAN },
+    { "fugitiv", VEHICLE_TYPE_CAR },
+    { "utillitr", VEHICLE_TYPE_VAN },
+    { "al", VEHICLE_TYPE_CAR },
+    { "marsha", VEHICLE_TYPE_VAN },
+    { "riple", VEHICLE_TYPE_MISC },
+    { "raketrai", VEHICLE_TYPE_MISC },
+    { "jest", VEHICLE_TYPE_CAR },
+    { "mamma", VEHICLE_TYPE_MISC },
+    { "sha", VEHICLE_TYPE_MISC },
+    { "prairi", VEHICLE_TYPE_CAR },
+    { "guardi", VEHICLE_TYPE_VAN },
+    { "bulldo", VEHICLE_TYPE_MISC },
+    { "intrud", VEHICLE_TYPE_CAR },
+    { "astro", VEHICLE_TYPE_CAR },
+    { "tourb", VEHICLE_TYPE_VAN },
+    { "bagge", VEHICLE_TYPE_MISC },
+    { "submer", VEHICLE_TYPE_MISC },
+    { "squa", VEHICLE_TYPE_MISC },
+    { "milje", VEHICLE_TYPE_MISC },
+    { "utiltruc", VEHICLE_TYPE_VAN },
+    { "barra", VEHICLE_TYPE_TRUCK },
+    { "defi", VEHICLE_TYPE_MISC },
+    { "romer", VEHICLE_TYPE_CAR },
+    { "gresl", VEHICLE_TYPE_CAR },
+    { "torna", VEHICLE_TYPE_CAR },
+    { "moonbea", VEHICLE_TYPE_CAR },
+    { "protot", VEHICLE_TYPE_CAR },
+    { "zentor", VEHICLE_TYPE_CAR },
+    { "tam", VEHICLE_TYPE_CAR },
+    { "freig", VEHICLE_TYPE_MISC },
+    { "tiptruc", VEHICLE_TYPE_TRUCK },
+    { "prim", VEHICLE_TYPE_CAR },
+    { "slam", VEHICLE_TYPE_CAR },
+    { "c", VEHICLE_TYPE_CAR },
+    { "ratbi", VEHICLE_TYPE_MISC },
+    { "firetru", VEHICLE_TYPE_TRUCK },
+    { "dou", VEHICLE_TYPE_MISC },
+    { "seashar", VEHICLE_TYPE_MISC },
+    { "tac", VEHICLE_TYPE_VAN },
+    { "mammat", VEHICLE_TYPE_MISC },
+    { "oppres", VEHICLE_TYPE_MISC },
+    { "d", VEHICLE_TYPE_CAR },
+    { "piga", VEHICLE_TYPE_CAR },
+    { "barrac", VEHICLE_TYPE_TRUCK },
+    { "avaru", VEHICLE_TYPE_MISC },
+    { "stani", VEHICLE_TYPE_CAR },
+    { "annihilat", VEHICLE_TYPE_MISC },
+    { "tamp", VEHICLE_TYPE_CAR },
+    { "rhapso", VEHICLE_TYPE_CAR },
+    { "guard", VEHICLE_TYPE_VAN },
+    { "jes", VEHICLE_TYPE_CAR },
+    { "dust", VEHICLE_TYPE_MISC },
+};
+
+template <size_t S, size_t N>
+constexpr VehicleType vtFindModel(const uint32_t (&seeds)[S], const VehicleModelEntry (&table)[N], uint32_t model) {
+    const VehicleModelEntry& e = table[vtMix(model, seeds[vtMix(model, 0) % S]) % N];
+    return e.model == model ? e.type : VEHICLE_TYPE_UNKNOWN;
+}
+
+template <size_t S, size_t N>
+constexpr VehicleType vtFindName(const uint32_t (&seeds)[S], const VehicleNameEntry (&table)[N], std::string_view name) {
+    uint32_t h = vtHashName(name);
+    const VehicleNameEntry& e = table[vtMix(h, seeds[vtMix(h, 0) % S]) % N];
+    return name == e.name ? e.type : VEHICLE_TYPE_UNKNOWN;
+}
+
+//Model hash as returned by GET_ENTITY_MODEL
+constexpr VehicleType vehicleTypeFromModel(uint32_t model) {
+    return vtFindModel(VT_MODEL_TABLE_SEEDS, VT_MODEL_TABLE, model);
+}
+
+//Lowercase letters of the display name. Exact names are tried before clipped ones.
+constexpr VehicleType vehicleTypeFromName(std::string_view name) {
+    VehicleType type = vtFindName(VT_NAME_TABLE_SEEDS, VT_NAME_TABLE, name);
+    if (type != VEHICLE_TYPE_UNKNOWN) return type;
+    return vtFindName(VT_CLIPPED_TABLE_SEEDS, VT_CLIPPED_TABLE, name);
+}
+
+static_assert(vehicleTypeFromModel(0x3D8FA25C) == VEHICLE_TYPE_CAR, "Vehicle type table is broken");
+static_assert(vehicleTypeFromName("ninef") == VEHICLE_TYPE_CAR, "Vehicle type table is broken");
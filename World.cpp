@@ -0,0 +1,184 @@
+#include "World.h"
+#include "NativeProfiler.h"
+
+LiveWorld s_liveWorld;
+
+Cam LiveWorld::getRenderingCam() {
+    return NATIVE(CAM::GET_RENDERING_CAM)();
+}
+
+Vector3 LiveWorld::getCamCoord(Cam cam) {
+    return NATIVE(CAM::GET_CAM_COORD)(cam);
+}
+
+Vector3 LiveWorld::getCamRot(Cam cam, int rotationOrder) {
+    return NATIVE(CAM::GET_CAM_ROT)(cam, rotationOrder);
+}
+
+Entity LiveWorld::getEntityAttachedTo(Entity entity) {
+    return NATIVE(ENTITY::GET_ENTITY_ATTACHED_TO)(entity);
+}
+
+void LiveWorld::getEntityMatrix(Entity entity, Vector3* forwardVector, Vector3* rightVector, Vector3* upVector, Vector3* position) {
+    NATIVE(ENTITY::GET_ENTITY_MATRIX)(entity, forwardVector, rightVector, upVector, position);
+}
+
+Hash LiveWorld::getEntityModel(Entity entity) {
+    return NATIVE(ENTITY::GET_ENTITY_MODEL)(entity);
+}
+
+void LiveWorld::getEntityQuaternion(Entity entity, float* x, float* y, float* z, float* w) {
+    NATIVE(ENTITY::GET_ENTITY_QUATERNION)(entity, x, y, z, w);
+}
+
+Vector3 LiveWorld::getEntityRotation(Entity entity, int rotationOrder) {
+    return NATIVE(ENTITY::GET_ENTITY_ROTATION)(entity, rotationOrder);
+}
+
+Vector3 LiveWorld::getEntityRotationVelocity(Entity entity) {
+    return NATIVE(ENTITY::GET_ENTITY_ROTATION_VELOCITY)(entity);
+}
+
+float LiveWorld::getEntitySpeed(Entity entity) {
+    return NATIVE(ENTITY::GET_ENTITY_SPEED)(entity);
+}
+
+Vector3 LiveWorld::getEntitySpeedVector(Entity entity, BOOL relative) {
+    return NATIVE(ENTITY::GET_ENTITY_SPEED_VECTOR)(entity, relative);
+}
+
+Vector3 LiveWorld::getOffsetFromEntityInWorldCoords(Entity entity, float offsetX, float offsetY, float offsetZ) {
+    return NATIVE(ENTITY::GET_OFFSET_FROM_ENTITY_IN_WORLD_COORDS)(entity, offsetX, offsetY, offsetZ);
+}
+
+BOOL LiveWorld::hasEntityClearLosToEntity(Entity entity1, Entity entity2, int traceType) {
+    return NATIVE(ENTITY::HAS_ENTITY_CLEAR_LOS_TO_ENTITY)(entity1, entity2, traceType);
+}
+
+BOOL LiveWorld::isEntityAPed(Entity entity) {
+    return NATIVE(ENTITY::IS_ENTITY_A_PED)(entity);
+}
+
+BOOL LiveWorld::isEntityAVehicle(Entity entity) {
+    return NATIVE(ENTITY::IS_ENTITY_A_VEHICLE)(entity);
+}
+
+BOOL LiveWorld::isEntityOccluded(Entity entity) {
+    return NATIVE(ENTITY::IS_ENTITY_OCCLUDED)(entity);
+}
+
+BOOL LiveWorld::isEntityOnScreen(Entity entity) {
+    return NATIVE(ENTITY::IS_ENTITY_ON_SCREEN)(entity);
+}
+
+BOOL LiveWorld::getGroundZFor3dCoord(float x, float y, float z, float* groundZ, BOOL unk) {
+    return NATIVE(GAMEPLAY::GET_GROUND_Z_FOR_3D_COORD)(x, y, z, groundZ, unk);
+}
+
+float LiveWorld::getHeadingFromVector2d(float dx, float dy) {
+    return NATIVE(GAMEPLAY::GET_HEADING_FROM_VECTOR_2D)(dx, dy);
+}
+
+void LiveWorld::getModelDimensions(Hash model, Vector3* minimum, Vector3* maximum) {
+    NATIVE(GAMEPLAY::GET_MODEL_DIMENSIONS)(model, minimum, maximum);
+}
+
+void LiveWorld::drawLine(float x1, float y1, float z1, float x2, float y2, float z2, int r, int g, int b, int a) {
+    NATIVE(GRAPHICS::DRAW_LINE)(x1, y1, z1, x2, y2, z2, r, g, b, a);
+}
+
+float LiveWorld::getScreenAspectRatio(BOOL b) {
+    return NATIVE(GRAPHICS::_GET_SCREEN_ASPECT_RATIO)(b);
+}
+
+BOOL LiveWorld::world3dToScreen2d(float worldX, float worldY, float worldZ, float* screenX, float* screenY) {
+    return NATIVE(GRAPHICS::_WORLD3D_TO_SCREEN2D)(worldX, worldY, worldZ, screenX, screenY);
+}
+
+int LiveWorld::getPedType(Ped ped) {
+    return NATIVE(PED::GET_PED_TYPE)(ped);
+}
+
+Vehicle LiveWorld::getVehiclePedIsIn(Ped ped, BOOL lastVehicle) {
+    return NATIVE(PED::GET_VEHICLE_PED_IS_IN)(ped, lastVehicle);
+}
+
+BOOL LiveWorld::isPedInAnyVehicle(Ped ped, BOOL atGetIn) {
+    return NATIVE(PED::IS_PED_IN_ANY_VEHICLE)(ped, atGetIn);
+}
+
+BOOL LiveWorld::isPedStopped(Ped ped) {
+    return NATIVE(PED::IS_PED_STOPPED)(ped);
+}
+
+Ped LiveWorld::playerPedId() {
+    return NATIVE(PLAYER::PLAYER_PED_ID)();
+}
+
+int LiveWorld::getClockHours() {
+    return NATIVE(TIME::GET_CLOCK_HOURS)();
+}
+
+BOOL LiveWorld::isVehicleSeatFree(Vehicle vehicle, int seatIndex) {
+    return NATIVE(VEHICLE::IS_VEHICLE_SEAT_FREE)(vehicle, seatIndex);
+}
+
+BOOL LiveWorld::isVehicleStopped(Vehicle vehicle) {
+    return NATIVE(VEHICLE::IS_VEHICLE_STOPPED)(vehicle);
+}
+
+const char* LiveWorld::getDisplayNameFromVehicleModel(Hash model) {
+    return NATIVE(VEHICLE::GET_DISPLAY_NAME_FROM_VEHICLE_MODEL)(model);
+}
+
+BOOL LiveWorld::isThisModelACar(Hash model) {
+    return NATIVE(VEHICLE::IS_THIS_MODEL_A_CAR)(model);
+}
+
+BOOL LiveWorld::isThisModelABike(Hash model) {
+    return NATIVE(VEHICLE::IS_THIS_MODEL_A_BIKE)(model);
+}
+
+BOOL LiveWorld::isThisModelABicycle(Hash model) {
+    return NATIVE(VEHICLE::IS_THIS_MODEL_A_BICYCLE)(model);
+}
+
+BOOL LiveWorld::isThisModelAQuadbike(Hash model) {
+    return NATIVE(VEHICLE::IS_THIS_MODEL_A_QUADBIKE)(model);
+}
+
+BOOL LiveWorld::isThisModelABoat(Hash model) {
+    return NATIVE(VEHICLE::IS_THIS_MODEL_A_BOAT)(model);
+}
+
+BOOL LiveWorld::isThisModelAPlane(Hash model) {
+    return NATIVE(VEHICLE::IS_THIS_MODEL_A_PLANE)(model);
+}
+
+BOOL LiveWorld::isThisModelAHeli(Hash model) {
+    return NATIVE(VEHICLE::IS_THIS_MODEL_A_HELI)(model);
+}
+
+BOOL LiveWorld::isThisModelATrain(Hash model) {
+    return NATIVE(VEHICLE::IS_THIS_MODEL_A_TRAIN)(model);
+}
+
+BOOL LiveWorld::isThisModelASubmersible(Hash model) {
+    return NATIVE(VEHICLE::_IS_THIS_MODEL_A_SUBMERSIBLE)(model);
+}
+
+int LiveWorld::castRayPointToPoint(float x1, float y1, float z1, float x2, float y2, float z2, int flags, Entity ignore, int p8) {
+    return NATIVE(WORLDPROBE::_CAST_RAY_POINT_TO_POINT)(x1, y1, z1, x2, y2, z2, flags, ignore, p8);
+}
+
+int LiveWorld::getRaycastResult(int rayHandle, BOOL* hit, Vector3* endCoords, Vector3* surfaceNormal, Entity* entityHit) {
+    return NATIVE(WORLDPROBE::_GET_RAYCAST_RESULT)(rayHandle, hit, endCoords, surfaceNormal, entityHit);
+}
+
+int LiveWorld::getAllVehicles(int* arr, int arrSize) {
+    return NATIVE(worldGetAllVehicles)(arr, arrSize);
+}
+
+int LiveWorld::getAllPeds(int* arr, int arrSize) {
+    return NATIVE(worldGetAllPeds)(arr, arrSize);
+}
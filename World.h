@@ -0,0 +1,150 @@
+#pragma once
+
+#include "CoreTypes.h"
+#include <stddef.h>
+
+//Every game query made by ObjectDetection, LiDAR and ModelInfoCache, one method per native (same arguments and results).
+//Pure math natives (VDIST2) are computed inline instead (GeometryCore.h).
+//The world is chosen at initCollection/initReplay:
+//  LiveWorld      ScriptHook natives (the default)
+//  RecordedWorld  answers from a recorded world state (worldState/*.bin, see SceneWorld.h)
+//  SyntheticWorld procedural scene for benchmarks and runs without the game (see SceneWorld.h)
+//The pipeline holds an IWorld*, so every query is a virtual call. BM_worldQueries in deepgtav_bench compares the
+//per-entity query sequence through IWorld* with direct calls on the final type.
+class IWorld {
+public:
+    virtual ~IWorld() {}
+
+    //CAM
+    virtual Cam getRenderingCam() = 0;
+    virtual Vector3 getCamCoord(Cam cam) = 0;
+    virtual Vector3 getCamRot(Cam cam, int rotationOrder) = 0;
+
+    //ENTITY
+    virtual Entity getEntityAttachedTo(Entity entity) = 0;
+    virtual void getEntityMatrix(Entity entity, Vector3* forwardVector, Vector3* rightVector, Vector3* upVector, Vector3* position) = 0;
+    virtual Hash getEntityModel(Entity entity) = 0;
+    virtual void getEntityQuaternion(Entity entity, float* x, float* y, float* z, float* w) = 0;
+    virtual Vector3 getEntityRotation(Entity entity, int rotationOrder) = 0;
+    virtual Vector3 getEntityRotationVelocity(Entity entity) = 0;
+    virtual float getEntitySpeed(Entity entity) = 0;
+    virtual Vector3 getEntitySpeedVector(Entity entity, BOOL relative) = 0;
+    virtual Vector3 getOffsetFromEntityInWorldCoords(Entity entity, float offsetX, float offsetY, float offsetZ) = 0;
+    virtual BOOL hasEntityClearLosToEntity(Entity entity1, Entity entity2, int traceType) = 0;
+    virtual BOOL isEntityAPed(Entity entity) = 0;
+    virtual BOOL isEntityAVehicle(Entity entity) = 0;
+    virtual BOOL isEntityOccluded(Entity entity) = 0;
+    virtual BOOL isEntityOnScreen(Entity entity) = 0;
+
+    //GAMEPLAY
+    virtual BOOL getGroundZFor3dCoord(float x, float y, float z, float* groundZ, BOOL unk) = 0;
+    virtual float getHeadingFromVector2d(float dx, float dy) = 0;
+    virtual void getModelDimensions(Hash model, Vector3* minimum, Vector3* maximum) = 0;
+
+    //GRAPHICS
+    virtual void drawLine(float x1, float y1, float z1, float x2, float y2, float z2, int r, int g, int b, int a) = 0;
+    virtual float getScreenAspectRatio(BOOL b) = 0;
+    virtual BOOL world3dToScreen2d(float worldX, float worldY, float worldZ, float* screenX, float* screenY) = 0;
+
+    //PED, PLAYER
+    virtual int getPedType(Ped ped) = 0;
+    virtual Vehicle getVehiclePedIsIn(Ped ped, BOOL lastVehicle) = 0;
+    virtual BOOL isPedInAnyVehicle(Ped ped, BOOL atGetIn) = 0;
+    virtual BOOL isPedStopped(Ped ped) = 0;
+    virtual Ped playerPedId() = 0;
+
+    //TIME
+    virtual int getClockHours() = 0;
+
+    //VEHICLE
+    virtual BOOL isVehicleSeatFree(Vehicle vehicle, int seatIndex) = 0;
+    virtual BOOL isVehicleStopped(Vehicle vehicle) = 0;
+    virtual const char* getDisplayNameFromVehicleModel(Hash model) = 0;
+    virtual BOOL isThisModelACar(Hash model) = 0;
+    virtual BOOL isThisModelABike(Hash model) = 0;
+    virtual BOOL isThisModelABicycle(Hash model) = 0;
+    virtual BOOL isThisModelAQuadbike(Hash model) = 0;
+    virtual BOOL isThisModelABoat(Hash model) = 0;
+    virtual BOOL isThisModelAPlane(Hash model) = 0;
+    virtual BOOL isThisModelAHeli(Hash model) = 0;
+    virtual BOOL isThisModelATrain(Hash model) = 0;
+    virtual BOOL isThisModelASubmersible(Hash model) = 0;
+
+    //WORLDPROBE
+    virtual int castRayPointToPoint(float x1, float y1, float z1, float x2, float y2, float z2, int flags, Entity ignore, int p8) = 0;
+    virtual int getRaycastResult(int rayHandle, BOOL* hit, Vector3* endCoords, Vector3* surfaceNormal, Entity* entityHit) = 0;
+
+    //ScriptHook pools
+    virtual int getAllVehicles(int* arr, int arrSize) = 0;
+    virtual int getAllPeds(int* arr, int arrSize) = 0;
+};
+
+class LiveWorld final : public IWorld {
+public:
+    Cam getRenderingCam() override;
+    Vector3 getCamCoord(Cam cam) override;
+    Vector3 getCamRot(Cam cam, int rotationOrder) override;
+
+    Entity getEntityAttachedTo(Entity entity) override;
+    void getEntityMatrix(Entity entity, Vector3* forwardVector, Vector3* rightVector, Vector3* upVector, Vector3* position) override;
+    Hash getEntityModel(Entity entity) override;
+    void getEntityQuaternion(Entity entity, float* x, float* y, float* z, float* w) override;
+    Vector3 getEntityRotation(Entity entity, int rotationOrder) override;
+    Vector3 getEntityRotationVelocity(Entity entity) override;
+    float getEntitySpeed(Entity entity) override;
+    Vector3 getEntitySpeedVector(Entity entity, BOOL relative) override;
+    Vector3 getOffsetFromEntityInWorldCoords(Entity entity, float offsetX, float offsetY, float offsetZ) override;
+    BOOL hasEntityClearLosToEntity(Entity entity1, Entity entity2, int traceType) override;
+    BOOL isEntityAPed(Entity entity) override;
+    BOOL isEntityAVehicle(Entity entity) override;
+    BOOL isEntityOccluded(Entity entity) override;
+    BOOL isEntityOnScreen(Entity entity) override;
+
+    BOOL getGroundZFor3dCoord(float x, float y, float z, float* groundZ, BOOL unk) override;
+    float getHeadingFromVector2d(float dx, float dy) override;
+    void getModelDimensions(Hash model, Vector3* minimum, Vector3* maximum) override;
+
+    void drawLine(float x1, float y1, float z1, float x2, float y2, float z2, int r, int g, int b, int a) override;
+    float getScreenAspectRatio(BOOL b) override;
+    BOOL world3dToScreen2d(float worldX, float worldY, float worldZ, float* screenX, float* screenY) override;
+
+    int getPedType(Ped ped) override;
+    Vehicle getVehiclePedIsIn(Ped ped, BOOL lastVehicle) override;
+    BOOL isPedInAnyVehicle(Ped ped, BOOL atGetIn) override;
+    BOOL isPedStopped(Ped ped) override;
+    Ped playerPedId() override;
+
+    int getClockHours() override;
+
+    BOOL isVehicleSeatFree(Vehicle vehicle, int seatIndex) override;
+    BOOL isVehicleStopped(Vehicle vehicle) override;
+    const char* getDisplayNameFromVehicleModel(Hash model) override;
+    BOOL isThisModelACar(Hash model) override;
+    BOOL isThisModelABike(Hash model) override;
+    BOOL isThisModelABicycle(Hash model) override;
+    BOOL isThisModelAQuadbike(Hash model) override;
+    BOOL isThisModelABoat(Hash model) override;
+    BOOL isThisModelAPlane(Hash model) override;
+    BOOL isThisModelAHeli(Hash model) override;
+    BOOL isThisModelATrain(Hash model) override;
+    BOOL isThisModelASubmersible(Hash model) override;
+
+    int castRayPointToPoint(float x1, float y1, float z1, float x2, float y2, float z2, int flags, Entity ignore, int p8) override;
+    int getRaycastResult(int rayHandle, BOOL* hit, Vector3* endCoords, Vector3* surfaceNormal, Entity* entityHit) override;
+
+    int getAllVehicles(int* arr, int arrSize) override;
+    int getAllPeds(int* arr, int arrSize) override;
+};
+
+#ifndef DEEPGTAV_HEADLESS
+extern LiveWorld s_liveWorld;
+#endif
+
+//Used when no world is given (initCollection, LiDAR, ModelInfoCache). Headless builds have no game to fall back to.
+inline IWorld* defaultWorld() {
+#ifdef DEEPGTAV_HEADLESS
+    return NULL;
+#else
+    return &s_liveWorld;
+#endif
+}
@@ -0,0 +1,221 @@
+#include "WorldState.h"
+#include <stdio.h>
+#include <string.h>
+
+namespace {
+
+class StateWriter {
+public:
+    template <typename T>
+    void pod(const T& v) {
+        const uint8_t* p = (const uint8_t*)&v;
+        m_data.insert(m_data.end(), p, p + sizeof(T));
+    }
+    void vec(const Vector3& v) {
+        pod(v.x);
+        pod(v.y);
+        pod(v.z);
+    }
+    void str(const std::string& s) {
+        pod((uint32_t)s.size());
+        m_data.insert(m_data.end(), s.begin(), s.end());
+    }
+    template <typename T>
+    void array(const std::vector<T>& v) {
+        for (const T& x : v) pod(x);
+    }
+    void array(const std::vector<Vector3>& v) {
+        for (const Vector3& x : v) vec(x);
+    }
+    const std::vector<uint8_t>& data() const { return m_data; }
+
+private:
+    std::vector<uint8_t> m_data;
+};
+
+class StateReader {
+public:
+    StateReader(const std::vector<uint8_t>& data) : m_data(data) {}
+
+    template <typename T>
+    void pod(T& v) {
+        if (!take(sizeof(T))) return;
+        memcpy(&v, m_data.data() + m_pos - sizeof(T), sizeof(T));
+    }
+    void vec(Vector3& v) {
+        pod(v.x);
+        pod(v.y);
+        pod(v.z);
+    }
+    void str(std::string& s) {
+        uint32_t n = 0;
+        pod(n);
+        if (!take(n)) return;
+        s.assign((const char*)m_data.data() + m_pos - n, n);
+    }
+    template <typename T>
+    void array(std::vector<T>& v) {
+        for (T& x : v) pod(x);
+    }
+    void array(std::vector<Vector3>& v) {
+        for (Vector3& x : v) vec(x);
+    }
+    bool ok() const { return m_ok; }
+
+private:
+    bool take(size_t n) {
+        if (!m_ok || m_pos + n > m_data.size()) {
+            m_ok = false;
+            return false;
+        }
+        m_pos += n;
+        return true;
+    }
+
+    const std::vector<uint8_t>& m_data;
+    size_t m_pos = 0;
+    bool m_ok = true;
+};
+
+//Field order is shared by reading and writing so the two cannot drift apart
+template <typename IO, typename Snap>
+void serialiseSnapshot(IO& io, Snap& snap) {
+    io.array(snap.ids);
+    io.array(snap.models);
+    io.array(snap.forward);
+    io.array(snap.right);
+    io.array(snap.up);
+    io.array(snap.position);
+    io.array(snap.distance);
+    io.array(snap.cullTier);
+    io.array(snap.inRange);
+    io.array(snap.onScreen);
+    io.array(snap.driverSeatFree);
+    io.array(snap.attachedTo);
+    io.array(snap.vehicleIn);
+    io.array(snap.vehicleInModel);
+    io.array(snap.groundZ);
+    io.array(snap.pedType);
+    io.array(snap.speed);
+    io.array(snap.speedVector);
+    io.array(snap.worldCoords);
+    io.pod(snap.cullStats.full);
+    io.pod(snap.cullStats.augment);
+    io.pod(snap.cullStats.skipped);
+}
+
+template <typename IO, typename Info>
+void serialiseModelInfo(IO& io, Info& info) {
+    io.vec(info.min);
+    io.vec(info.max);
+    io.pod(info.radius);
+    io.pod(info.classID);
+    io.str(info.displayName);
+    io.str(info.lookupName);
+    io.pod(info.vehicleType);
+    io.pod(info.inLookup);
+    io.str(info.type);
+    io.pod(info.isTrailer);
+}
+
+template <typename IO, typename State>
+void serialiseFrame(IO& io, State& state) {
+    io.pod(state.instanceIndex);
+    io.pod(state.seriesIndex);
+    io.pod(state.width);
+    io.pod(state.height);
+    io.pod(state.eve);
+
+    io.pod(state.nearClip);
+    io.pod(state.farClip);
+    io.pod(state.fov);
+    io.pod(state.ncWidth);
+    io.pod(state.ncHeight);
+    io.vec(state.camPos);
+    io.vec(state.camTheta);
+    io.vec(state.camForward);
+    io.vec(state.camRight);
+    io.vec(state.camUp);
+
+    io.pod(state.vehicle);
+    io.pod(state.ownVehicle);
+    io.pod(state.ownVehicleModel);
+    io.vec(state.vehicleForward);
+    io.vec(state.vehicleRight);
+    io.vec(state.vehicleUp);
+    io.vec(state.vehiclePos);
+    io.vec(state.kittiWorldPos);
+    io.pod(state.heading);
+    io.pod(state.roll);
+    io.pod(state.pitch);
+    io.pod(state.speed);
+    io.pod(state.yawRate);
+    io.pod(state.timeHours);
+    io.vec(state.ego.velocity);
+    io.vec(state.ego.worldCoords);
+}
+
+}
+
+bool writeWorldState(const std::string& filename, const WorldStateFrame& state) {
+    StateWriter w;
+    w.pod(WORLD_STATE_MAGIC);
+    w.pod(WORLD_STATE_VERSION);
+    serialiseFrame(w, state);
+
+    w.pod((uint32_t)state.vehicles.size());
+    serialiseSnapshot(w, state.vehicles);
+    w.pod((uint32_t)state.peds.size());
+    serialiseSnapshot(w, state.peds);
+
+    w.pod((uint32_t)state.models.size());
+    for (const RecordedModel& m : state.models) {
+        w.pod(m.model);
+        serialiseModelInfo(w, m.info);
+    }
+
+    FILE* f = fopen(filename.c_str(), "wb");
+    if (!f) return false;
+    bool ok = fwrite(w.data().data(), 1, w.data().size(), f) == w.data().size();
+    fclose(f);
+    return ok;
+}
+
+bool readWorldState(const std::string& filename, WorldStateFrame& state) {
+    FILE* f = fopen(filename.c_str(), "rb");
+    if (!f) return false;
+    std::vector<uint8_t> data;
+    uint8_t buf[65536];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) {
+        data.insert(data.end(), buf, buf + n);
+    }
+    fclose(f);
+
+    StateReader r(data);
+    uint32_t magic = 0, version = 0;
+    r.pod(magic);
+    r.pod(version);
+    if (!r.ok() || magic != WORLD_STATE_MAGIC || version != WORLD_STATE_VERSION) return false;
+    serialiseFrame(r, state);
+
+    //Counts are checked against the file size before resizing so a corrupt count can't allocate gigabytes
+    uint32_t count = 0;
+    r.pod(count);
+    if (!r.ok() || count > data.size()) return false;
+    state.vehicles.resize(count);
+    serialiseSnapshot(r, state.vehicles);
+    r.pod(count);
+    if (!r.ok() || count > data.size()) return false;
+    state.peds.resize(count);
+    serialiseSnapshot(r, state.peds);
+
+    r.pod(count);
+    if (!r.ok() || count > data.size()) return false;
+    state.models.resize(count);
+    for (RecordedModel& m : state.models) {
+        r.pod(m.model);
+        serialiseModelInfo(r, m.info);
+    }
+    return r.ok();
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "CoreTypes.h"
+#include <Eigen/Core>
+#include "CamParams.h"
+#include "Functions.h"
+#include "EntitySnapshot.h"
+#include "ModelInfoCache.h"
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+//Game state of one captured frame (worldState/*.bin), written next to the depth and stencil dumps.
+//Holds everything generateMessage reads from the game before the per-pixel passes: camera, capture vehicle,
+//the vehicle and ped snapshots and the metadata of every model in them. ObjectDetection::replayFrame
+//restores it so segmentation, occlusion, LiDAR and export can be rerun from disk.
+//Vector3 is stored as 3 floats (no ScriptHook padding), everything little-endian.
+
+const uint32_t WORLD_STATE_MAGIC = 0x53574447;//"GDWS" little-endian
+const uint32_t WORLD_STATE_VERSION = 1;
+
+struct RecordedModel {
+    Hash model;
+    ModelInfo info;
+};
+
+struct WorldStateFrame {
+    int instanceIndex = 0;
+    int seriesIndex = 0;
+    int width = 0;
+    int height = 0;
+    bool eve = false;
+
+    //Camera (s_camParams and the camera basis)
+    float nearClip = 0;
+    float farClip = 0;
+    float fov = 0;
+    float ncWidth = 0;
+    float ncHeight = 0;
+    Vector3 camPos;
+    Vector3 camTheta;
+    Vector3 camForward;
+    Vector3 camRight;
+    Vector3 camUp;
+
+    //Capture vehicle, and the frame values derived from it
+    int vehicle = 0;
+    int ownVehicle = 0;
+    Hash ownVehicleModel = 0;
+    Vector3 vehicleForward;
+    Vector3 vehicleRight;
+    Vector3 vehicleUp;
+    Vector3 vehiclePos;
+    Vector3 kittiWorldPos;
+    float heading = 0;
+    float roll = 0;
+    float pitch = 0;
+    float speed = 0;
+    float yawRate = 0;
+    int timeHours = 0;
+    EgoSnapshot ego;
+
+    EntitySnapshot vehicles;
+    EntitySnapshot peds;
+    std::vector<RecordedModel> models;
+};
+
+bool writeWorldState(const std::string& filename, const WorldStateFrame& state);
+//Returns false if the file is missing, truncated or from another version
+bool readWorldState(const std::string& filename, WorldStateFrame& state);
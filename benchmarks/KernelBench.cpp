@@ -0,0 +1,536 @@
+#include <benchmark/benchmark.h>
+#include "DepthCompression.h"
+#include "FrameBufferPool.h"
+#include "FrameObjectInfo.h"
+#include "Functions.h"
+#include "GeometryCore.h"
+#include "InstanceMasks.h"
+#include "SceneWorld.h"
+#include "PedSpatialHash.h"
+#include "WorldState.h"
+#include "lodepng.h"
+#include <stdlib.h>
+#include <string.h>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+//Kernels that run once per pixel or LiDAR point of every frame, and the depth buffer compression, on a rendered
+//synthetic scene (the depth compression also on a captured collection, see recordedDepth). Each of these takes the image width and height as arguments and processes the whole frame per
+//iteration. The rider search takes the number of peds in the scene.
+
+namespace {
+
+Vector3 vec3(float x, float y, float z) {
+    Vector3 v;
+    v.x = x;
+    v.y = y;
+    v.z = z;
+    return v;
+}
+
+struct Frame {
+    std::unique_ptr<SyntheticWorld> world;
+    CamParams cam;
+    Vector3 camForward;
+    Vector3 camRight;
+    Vector3 camUp;
+    std::vector<float> depth;
+    std::vector<uint8_t> stencil;
+
+    //Per pixel, from depthToCamCoords
+    std::vector<Vector3> relPos;
+    std::vector<Vector3> worldPos;
+    std::vector<Eigen::Vector3f> eigenPos;
+    //Entity ID per pixel (0 for ground and sky)
+    std::vector<int> entityIDs;
+
+    //Car 12m ahead of the camera and its box
+    ObjEntity car;
+    EntityBox box;
+
+    //One LiDAR point per pixel (FLOATS_PER_POINT floats each)
+    std::vector<float> pointCloud;
+};
+
+const Frame& frame(int width, int height) {
+    static std::map<std::pair<int, int>, std::unique_ptr<Frame>> s_frames;
+    std::unique_ptr<Frame>& f = s_frames[std::make_pair(width, height)];
+    if (f) return *f;
+
+    f.reset(new Frame());
+    f->world.reset(new SyntheticWorld(width, height));
+    f->world->render(f->depth, f->stencil);
+
+    const WorldStateFrame& state = f->world->frame();
+    CamParams& cam = f->cam;
+    cam.init = true;
+    cam.width = width;
+    cam.height = height;
+    cam.nearClip = state.nearClip;
+    cam.farClip = state.farClip;
+    cam.fov = state.fov;
+    cam.ncWidth = state.ncWidth;
+    cam.ncHeight = state.ncHeight;
+    cam.pos = state.camPos;
+    cam.theta = state.camTheta;
+    updateCamEigen(cam);
+    f->camForward = state.camForward;
+    f->camRight = state.camRight;
+    f->camUp = state.camUp;
+    //camToWorld and get_2d_from_3d use the global camera
+    s_camParams = cam;
+
+    size_t pixels = (size_t)width * height;
+    f->relPos.resize(pixels);
+    f->worldPos.resize(pixels);
+    f->eigenPos.resize(pixels);
+    f->entityIDs.resize(pixels);
+    f->pointCloud.assign(pixels * FLOATS_PER_POINT, 0.0f);
+    for (int j = 0; j < height; ++j) {
+        for (int i = 0; i < width; ++i) {
+            size_t idx = (size_t)j * width + i;
+            Vector3 rel = depthToCamCoords(cam, f->depth[idx], (float)i, (float)j);
+            Vector3 world = camToWorld(rel, f->camForward, f->camRight, f->camUp);
+            f->relPos[idx] = rel;
+            f->worldPos[idx] = world;
+            f->eigenPos[idx] = Eigen::Vector3f(world.x, world.y, world.z);
+            //Ground (0) and sky (7) have no entity, a few IDs per stencil type across the image otherwise
+            f->entityIDs[idx] = f->stencil[idx] == 0 || f->stencil[idx] == 7 ? 0 : 1 + f->stencil[idx] * 64 + i * 8 / width;
+
+            float* p = f->pointCloud.data() + idx * FLOATS_PER_POINT;
+            p[0] = rel.x;
+            p[1] = rel.y;
+            p[2] = rel.z;
+            for (int k = 3; k < FLOATS_PER_POINT; ++k) {
+                p[k] = (float)(f->entityIDs[idx] + k);
+            }
+        }
+    }
+
+    ObjEntity& car = f->car;
+    car.worldPos = vec3(state.camPos.x + 12 * state.camForward.x, state.camPos.y + 12 * state.camForward.y, state.camPos.z - 1.5f);
+    car.dim = vec3(0.95f, 2.3f, 0.75f);
+    car.xVector = state.camRight;
+    car.yVector = state.camForward;
+    car.zVector = vec3(0, 0, 1);
+    setEntityBBoxParameters(car, f->box);
+    return *f;
+}
+
+void pixelCounters(benchmark::State& state) {
+    state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(1));
+}
+
+void BM_depthToCamCoords(benchmark::State& state) {
+    const Frame& f = frame((int)state.range(0), (int)state.range(1));
+    for (auto _ : state) {
+        for (int j = 0; j < f.cam.height; ++j) {
+            for (int i = 0; i < f.cam.width; ++i) {
+                Vector3 rel = depthToCamCoords(f.cam, f.depth[(size_t)j * f.cam.width + i], (float)i, (float)j);
+                benchmark::DoNotOptimize(rel);
+            }
+        }
+    }
+    pixelCounters(state);
+}
+
+void BM_convertCoordinateSystem(benchmark::State& state) {
+    const Frame& f = frame((int)state.range(0), (int)state.range(1));
+    for (auto _ : state) {
+        for (const Vector3& rel : f.relPos) {
+            Vector3 world = convertCoordinateSystem(rel, f.camForward, f.camRight, f.camUp);
+            benchmark::DoNotOptimize(world);
+        }
+    }
+    pixelCounters(state);
+}
+
+void BM_in3DBox(benchmark::State& state) {
+    const Frame& f = frame((int)state.range(0), (int)state.range(1));
+    for (auto _ : state) {
+        for (const Vector3& point : f.worldPos) {
+            bool inBox = in3DBox(point, f.car.worldPos, f.car.dim, f.car.yVector, f.car.xVector, f.car.zVector);
+            benchmark::DoNotOptimize(inBox);
+        }
+    }
+    pixelCounters(state);
+}
+
+void BM_in3DBoxPrecomputed(benchmark::State& state) {
+    const Frame& f = frame((int)state.range(0), (int)state.range(1));
+    for (auto _ : state) {
+        for (const Vector3& point : f.worldPos) {
+            bool upperHalf;
+            bool inBox = in3DBox(f.box, point, upperHalf);
+            benchmark::DoNotOptimize(inBox);
+            benchmark::DoNotOptimize(upperHalf);
+        }
+    }
+    pixelCounters(state);
+}
+
+void BM_checkDirection(benchmark::State& state) {
+    const Frame& f = frame((int)state.range(0), (int)state.range(1));
+    for (auto _ : state) {
+        for (const Vector3& point : f.worldPos) {
+            bool inside = checkDirection(f.box.u, point, f.box.rearBotLeft, f.box.frontBotLeft);
+            benchmark::DoNotOptimize(inside);
+        }
+    }
+    pixelCounters(state);
+}
+
+void BM_projectToScreen(benchmark::State& state) {
+    const Frame& f = frame((int)state.range(0), (int)state.range(1));
+    for (auto _ : state) {
+        for (const Eigen::Vector3f& vertex : f.eigenPos) {
+            Eigen::Vector2f screen = projectToScreen(f.cam, vertex);
+            benchmark::DoNotOptimize(screen);
+        }
+    }
+    pixelCounters(state);
+}
+
+void BM_get_2d_from_3d(benchmark::State& state) {
+    const Frame& f = frame((int)state.range(0), (int)state.range(1));
+    s_camParams = f.cam;
+    for (auto _ : state) {
+        for (const Eigen::Vector3f& vertex : f.eigenPos) {
+            Eigen::Vector2f screen = get_2d_from_3d(vertex);
+            benchmark::DoNotOptimize(screen);
+        }
+    }
+    pixelCounters(state);
+}
+
+//LiDAR::getDepthFromScreenPos without the optional noise, one lookup per pixel (off centre so it interpolates)
+void BM_getDepthFromScreenPos(benchmark::State& state) {
+    const Frame& f = frame((int)state.range(0), (int)state.range(1));
+    for (auto _ : state) {
+        for (int j = 0; j < f.cam.height; ++j) {
+            float screenY = (j + 0.25f) / f.cam.height;
+            for (int i = 0; i < f.cam.width; ++i) {
+                float depth = depthFromScreenPos(f.cam, f.depth.data(), (i + 0.25f) / f.cam.width, screenY);
+                benchmark::DoNotOptimize(depth);
+            }
+        }
+    }
+    pixelCounters(state);
+}
+
+void BM_addPointToSegImages(benchmark::State& state) {
+    const Frame& f = frame((int)state.range(0), (int)state.range(1));
+    int width = f.cam.width;
+    size_t pixels = (size_t)width * f.cam.height;
+    std::vector<uint32_t> instanceSeg(pixels);
+    std::vector<uint8_t> stencilSeg(pixels * 3);
+    InstanceMaskSet masks;
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::fill(instanceSeg.begin(), instanceSeg.end(), 0);
+        std::fill(stencilSeg.begin(), stencilSeg.end(), 0);
+        masks.reset(width, f.cam.height);
+        state.ResumeTiming();
+
+        for (int j = 0; j < f.cam.height; ++j) {
+            for (int i = 0; i < width; ++i) {
+                int entityID = f.entityIDs[(size_t)j * width + i];
+                if (entityID != 0) addPointToSegImages(instanceSeg.data(), stencilSeg.data(), &masks, width, i, j, entityID);
+            }
+        }
+        benchmark::ClobberMemory();
+    }
+    pixelCounters(state);
+}
+
+//The RGB segmentation image as printSegImage writes it
+void BM_lodepngEncode(benchmark::State& state) {
+    const Frame& f = frame((int)state.range(0), (int)state.range(1));
+    int width = f.cam.width;
+    size_t pixels = (size_t)width * f.cam.height;
+    std::vector<uint32_t> instanceSeg(pixels);
+    std::vector<uint8_t> stencilSeg(pixels * 3);
+    for (int j = 0; j < f.cam.height; ++j) {
+        for (int i = 0; i < width; ++i) {
+            int entityID = f.entityIDs[(size_t)j * width + i];
+            if (entityID != 0) addPointToSegImages(instanceSeg.data(), stencilSeg.data(), NULL, width, i, j, entityID);
+        }
+    }
+
+    std::vector<unsigned char> png;
+    for (auto _ : state) {
+        png.clear();
+        lodepng::encode(png, stencilSeg.data(), width, f.cam.height, LCT_RGB, 8);
+        benchmark::DoNotOptimize(png.data());
+    }
+    pixelCounters(state);
+    state.counters["png_bytes"] = (double)png.size();
+}
+
+//collectLiDAR split of the LiDAR points into the velodyne_* outputs, with one point per pixel
+void BM_repackPointCloud(benchmark::State& state) {
+    const Frame& f = frame((int)state.range(0), (int)state.range(1));
+    int points = (int)(f.pointCloud.size() / FLOATS_PER_POINT);
+    FrameBufferPool pool;
+    pool.init(1, 1, points, 1);
+    FrameBufferSet& buffers = pool.next();
+    for (auto _ : state) {
+        buffers.repackPointCloud(f.pointCloud.data(), points);
+        benchmark::ClobberMemory();
+    }
+    pixelCounters(state);
+}
+
+//depth/*.gdz encode (COMPRESS_DEPTH_BUFFER) with the compression ratio, lossless and lossy (LOSSY_DEPTH_COMPRESSION)
+void compressDepth(benchmark::State& state, bool lossy) {
+    const Frame& f = frame((int)state.range(0), (int)state.range(1));
+    std::vector<uint8_t> compressed;
+    DepthCompressionStats stats;
+    for (auto _ : state) {
+        compressDepthBuffer(f.depth.data(), f.cam.width, f.cam.height, compressed, lossy, 0.01f, MAX_LIDAR_DIST, &stats);
+        benchmark::DoNotOptimize(compressed.data());
+    }
+    pixelCounters(state);
+    state.SetBytesProcessed(state.iterations() * stats.rawBytes);
+    state.counters["ratio"] = stats.ratio();
+    state.counters["bits"] = stats.bits;
+}
+
+void BM_compressDepthBuffer(benchmark::State& state) {
+    compressDepth(state, false);
+}
+
+void BM_compressDepthBufferLossy(benchmark::State& state) {
+    compressDepth(state, true);
+}
+
+//Replay side of depth/*.gdz
+void BM_decompressDepthBuffer(benchmark::State& state) {
+    const Frame& f = frame((int)state.range(0), (int)state.range(1));
+    std::vector<uint8_t> compressed;
+    compressDepthBuffer(f.depth.data(), f.cam.width, f.cam.height, compressed);
+    std::vector<float> decoded;
+    for (auto _ : state) {
+        int width, height;
+        decompressDepthBuffer(compressed.data(), compressed.size(), decoded, width, height);
+        benchmark::DoNotOptimize(decoded.data());
+    }
+    pixelCounters(state);
+    state.SetBytesProcessed(state.iterations() * f.depth.size() * sizeof(float));
+}
+
+//Depth frames of a captured collection: DEEPGTAV_BENCH_CAPTURE, or the golden corpus (tests/golden) if it is not set.
+//Every frame with a world state, from depth/*.gdz or the raw depth/*.bin.
+struct RecordedDepth {
+    std::string dir;
+    std::vector<std::vector<float>> frames;
+    std::vector<std::pair<int, int>> sizes;
+};
+
+const RecordedDepth& recordedDepth() {
+    static std::unique_ptr<RecordedDepth> s_depth;
+    if (s_depth) return *s_depth;
+    s_depth.reset(new RecordedDepth());
+
+    namespace fs = std::filesystem;
+    const char* capture = getenv("DEEPGTAV_BENCH_CAPTURE");
+    s_depth->dir = capture ? capture : DEEPGTAV_GOLDEN_CAPTURE;
+    fs::path stateDir = fs::path(s_depth->dir) / "worldState";
+    std::error_code ec;
+    for (const fs::directory_entry& entry : fs::recursive_directory_iterator(stateDir, ec)) {
+        WorldStateFrame state;
+        if (entry.path().extension() != ".bin" || !readWorldState(entry.path().string(), state)) continue;
+        fs::path base = fs::path(s_depth->dir) / "depth" / fs::relative(entry.path(), stateDir).replace_extension();
+
+        std::vector<float> depth((size_t)state.width * state.height);
+        int width, height;
+        float* decoded = loadCompressedDepth(base.string() + ".gdz", width, height);
+        if (decoded) {
+            if (width == state.width && height == state.height) memcpy(depth.data(), decoded, depth.size() * sizeof(float));
+            free(decoded);
+            if (width != state.width || height != state.height) continue;
+        }
+        else {
+            std::ifstream in(base.string() + ".bin", std::ios::binary);
+            if (!in.read((char*)depth.data(), depth.size() * sizeof(float))) continue;
+        }
+        s_depth->frames.push_back(std::move(depth));
+        s_depth->sizes.push_back(std::make_pair(state.width, state.height));
+    }
+    return *s_depth;
+}
+
+//Lossless encode of every recorded frame per iteration, with the ratio over the capture
+void BM_compressRecordedDepth(benchmark::State& state) {
+    const RecordedDepth& r = recordedDepth();
+    if (r.frames.empty()) {
+        state.SkipWithError(("No depth frames with a world state in " + r.dir).c_str());
+        return;
+    }
+    std::vector<uint8_t> compressed;
+    size_t rawBytes = 0;
+    size_t compressedBytes = 0;
+    for (auto _ : state) {
+        rawBytes = 0;
+        compressedBytes = 0;
+        for (size_t k = 0; k < r.frames.size(); ++k) {
+            DepthCompressionStats stats;
+            compressDepthBuffer(r.frames[k].data(), r.sizes[k].first, r.sizes[k].second, compressed, false, 0.01f, MAX_LIDAR_DIST, &stats);
+            rawBytes += stats.rawBytes;
+            compressedBytes += stats.compressedBytes;
+            benchmark::DoNotOptimize(compressed.data());
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * rawBytes);
+    state.counters["ratio"] = compressedBytes == 0 ? 0 : (double)rawBytes / (double)compressedBytes;
+    state.counters["frames"] = (double)r.frames.size();
+    state.SetLabel(r.dir);
+}
+
+//Per-entity queries of snapshotEntities and getEntityVector for every vehicle and ped of a synthetic scene. The two
+//variants only differ in how the world is called: through IWorld* as the pipeline does, or directly on the final type.
+template <class World>
+void worldQueries(benchmark::State& state, World* world, const std::vector<int>& entities) {
+    for (auto _ : state) {
+        for (int entity : entities) {
+            Vector3 forward, right, up, position, min, max;
+            Hash model = world->getEntityModel(entity);
+            world->getEntityMatrix(entity, &forward, &right, &up, &position);
+            world->getModelDimensions(model, &min, &max);
+            BOOL onScreen = world->isEntityOnScreen(entity);
+            float speed = world->getEntitySpeed(entity);
+            Vector3 velocity = world->getEntitySpeedVector(entity, false);
+            Entity attached = world->getEntityAttachedTo(entity);
+            BOOL ped = world->isEntityAPed(entity);
+            benchmark::DoNotOptimize(onScreen + attached + ped + speed + velocity.x + max.x);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * entities.size());
+}
+
+const std::vector<int>& sceneEntities(SyntheticWorld& world) {
+    static std::vector<int> s_entities;
+    if (s_entities.empty()) {
+        s_entities.resize(1024);
+        int vehicles = world.getAllVehicles(s_entities.data(), 512);
+        int peds = world.getAllPeds(s_entities.data() + vehicles, 512);
+        s_entities.resize(vehicles + peds);
+    }
+    return s_entities;
+}
+
+SyntheticWorld& queryWorld() {
+    static SyntheticWorld s_world(1280, 720, 200, 100);
+    return s_world;
+}
+
+void BM_worldQueries(benchmark::State& state) {
+    SyntheticWorld& world = queryWorld();
+    if (state.range(0)) {
+        IWorld* base = &world;
+        //Hide the dynamic type so the calls stay virtual
+        benchmark::DoNotOptimize(base);
+        worldQueries(state, base, sceneEntities(world));
+    }
+    else {
+        worldQueries(state, &world, sceneEntities(world));
+    }
+    state.SetLabel(state.range(0) ? "IWorld*" : "SyntheticWorld*");
+}
+
+//Crowded scene for the rider search of setVehiclesList: peds spread over 60m x 60m in front of the camera
+//and one bike type vehicle per 8 peds, every other one under a ped
+struct Crowd {
+    std::vector<Vector3> peds;
+    std::vector<Vector3> bikes;
+};
+
+Crowd crowd(int pedCount) {
+    Crowd c;
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> across(-30.0f, 30.0f);
+    std::uniform_real_distribution<float> ahead(2.0f, 62.0f);
+    for (int k = 0; k < pedCount; ++k) {
+        c.peds.push_back(vec3(across(rng), 1.7f, ahead(rng)));
+    }
+    for (int k = 0; k < pedCount / 8; ++k) {
+        Vector3 bike = (k % 2 == 0) ? c.peds[k * 8] : vec3(across(rng), 1.7f, ahead(rng));
+        bike.y += 0.3f;
+        c.bikes.push_back(bike);
+    }
+    return c;
+}
+
+void BM_pedSpatialHash(benchmark::State& state) {
+    Crowd c = crowd((int)state.range(0));
+    PedSpatialHash grid;
+    std::vector<int> hits;
+    for (auto _ : state) {
+        grid.clear();
+        for (size_t k = 0; k < c.peds.size(); ++k) {
+            grid.add((int)k, c.peds[k]);
+        }
+        grid.build();
+        for (const Vector3& bike : c.bikes) {
+            grid.query(bike, 0.5f, 2.0f, hits);
+            benchmark::DoNotOptimize(hits.data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * c.bikes.size());
+}
+
+//Every ped against every bike, as setVehiclesList searched before the grid
+void BM_pedLinearScan(benchmark::State& state) {
+    Crowd c = crowd((int)state.range(0));
+    std::vector<int> hits;
+    for (auto _ : state) {
+        for (const Vector3& bike : c.bikes) {
+            hits.clear();
+            for (size_t k = 0; k < c.peds.size(); ++k) {
+                const Vector3& ped = c.peds[k];
+                float dx = ped.x - bike.x;
+                float dz = ped.z - bike.z;
+                if (dx * dx + dz * dz < 0.25f && ped.y - bike.y <= 2.0f) hits.push_back((int)k);
+            }
+            benchmark::DoNotOptimize(hits.data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * c.bikes.size());
+}
+
+void crowdSizes(benchmark::internal::Benchmark* b) {
+    b->Arg(100)->Arg(500)->Arg(2000)->Unit(benchmark::kMicrosecond);
+}
+
+void resolutions(benchmark::internal::Benchmark* b) {
+    b->Args({ 1280, 720 })->Args({ 1920, 1080 })->Args({ 2560, 1440 })->Unit(benchmark::kMillisecond);
+}
+
+}
+
+BENCHMARK(BM_depthToCamCoords)->Apply(resolutions);
+BENCHMARK(BM_convertCoordinateSystem)->Apply(resolutions);
+BENCHMARK(BM_in3DBox)->Apply(resolutions);
+BENCHMARK(BM_in3DBoxPrecomputed)->Apply(resolutions);
+BENCHMARK(BM_checkDirection)->Apply(resolutions);
+BENCHMARK(BM_projectToScreen)->Apply(resolutions);
+BENCHMARK(BM_get_2d_from_3d)->Apply(resolutions);
+BENCHMARK(BM_getDepthFromScreenPos)->Apply(resolutions);
+BENCHMARK(BM_addPointToSegImages)->Apply(resolutions);
+BENCHMARK(BM_lodepngEncode)->Apply(resolutions);
+BENCHMARK(BM_repackPointCloud)->Apply(resolutions);
+BENCHMARK(BM_compressDepthBuffer)->Apply(resolutions);
+BENCHMARK(BM_compressDepthBufferLossy)->Apply(resolutions);
+BENCHMARK(BM_decompressDepthBuffer)->Apply(resolutions);
+BENCHMARK(BM_compressRecordedDepth)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_worldQueries)->ArgName("virtual")->Arg(1)->Arg(0)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_pedSpatialHash)->Apply(crowdSizes);
+BENCHMARK(BM_pedLinearScan)->Apply(crowdSizes);
+
+BENCHMARK_MAIN();
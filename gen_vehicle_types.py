@@ -0,0 +1,237 @@
+#!/usr/bin/env python3
+"""Compiles vehicle_labels.csv into VehicleTypeTable.h.
+
+The header holds three constexpr perfect-hash tables (CHD, hash-and-displace):
+  - model hash (joaat of the model name, what GET_ENTITY_MODEL returns) -> type
+  - lookup name (lowercase letters of the display name) -> type
+  - clipped names: the lookup name with its last 1-3 letters removed -> type
+    (display names are sometimes missing their last few letters)
+
+Exact names always win over clipped names. When rows collide the first one
+in the csv wins, as with the old runtime tables.
+
+Usage: python gen_vehicle_types.py [vehicle_labels.csv] [VehicleTypeTable.h]
+"""
+
+import sys
+
+MAX_CLIPPED = 3
+TYPES = ["Unknown", "Car", "Cyclist", "Misc", "Tram", "Truck", "Van"]
+MASK = 0xFFFFFFFF
+
+
+def joaat(s):
+    h = 0
+    for c in s.lower().encode():
+        h = (h + c) & MASK
+        h = (h + (h << 10)) & MASK
+        h ^= h >> 6
+    h = (h + (h << 3)) & MASK
+    h ^= h >> 11
+    h = (h + (h << 15)) & MASK
+    return h
+
+
+# Must match vtMix / vtHashName in the generated header
+def mix(key, seed):
+    h = (key ^ (seed * 0x9E3779B9)) & MASK
+    h ^= h >> 16
+    h = (h * 0x85EBCA6B) & MASK
+    h ^= h >> 13
+    h = (h * 0xC2B2AE35) & MASK
+    h ^= h >> 16
+    return h
+
+
+def hash_name(name):
+    h = 2166136261
+    for c in name.encode():
+        h ^= c
+        h = (h * 16777619) & MASK
+    return h
+
+
+def lookup_name(model):
+    return "".join(c for c in model.lower() if c.isalpha())
+
+
+def build_chd(keys):
+    """Returns (seeds, slots) so key k lives at slots[mix(k, seeds[mix(k, 0) % len(seeds)]) % len(slots)]."""
+    n = len(keys)
+    if n == 0:
+        return [0], [None]
+    r = max(1, (n + 3) // 4)
+    buckets = [[] for _ in range(r)]
+    for k in keys:
+        buckets[mix(k, 0) % r].append(k)
+
+    seeds = [0] * r
+    slots = [None] * n
+    for b in sorted(range(r), key=lambda b: -len(buckets[b])):
+        if not buckets[b]:
+            continue
+        d = 1
+        while True:
+            pos = [mix(k, d) % n for k in buckets[b]]
+            if len(set(pos)) == len(pos) and all(slots[p] is None for p in pos):
+                break
+            d += 1
+        seeds[b] = d
+        for k, p in zip(buckets[b], pos):
+            slots[p] = k
+    return seeds, slots
+
+
+def read_rows(path):
+    rows = []
+    with open(path) as f:
+        for line in f:
+            if "," not in line:
+                continue
+            model, vtype = line.split(",", 1)
+            model = model.strip()
+            vtype = vtype.strip()
+            if not model or vtype not in TYPES:
+                continue
+            rows.append((model, vtype))
+    return rows
+
+
+def emit_table(out, name, entry_type, seeds, slots, fmt):
+    out.append("constexpr uint32_t %s_SEEDS[] = {" % name)
+    out.extend(wrap([str(s) for s in seeds]))
+    out.append("};")
+    out.append("constexpr %s %s[] = {" % (entry_type, name))
+    for k in slots:
+        out.append("    { %s }," % fmt(k))
+    out.append("};")
+    out.append("")
+
+
+def type_enum(vtype):
+    return "VEHICLE_TYPE_" + vtype.upper()
+
+
+def wrap(items, width=16):
+    return ["    " + ", ".join(items[i:i + width]) + "," for i in range(0, len(items), width)]
+
+
+def main():
+    src = sys.argv[1] if len(sys.argv) > 1 else "vehicle_labels.csv"
+    dst = sys.argv[2] if len(sys.argv) > 2 else "VehicleTypeTable.h"
+    rows = read_rows(src)
+
+    by_hash = {}
+    by_name = {}
+    by_clipped = {}
+    for model, vtype in rows:
+        by_hash.setdefault(joaat(model), vtype)
+        name = lookup_name(model)
+        if name:
+            by_name.setdefault(name, vtype)
+    for model, vtype in rows:
+        name = lookup_name(model)
+        for k in range(MAX_CLIPPED):
+            if len(name) < 2:
+                break
+            name = name[:-1]
+            if name not in by_name:
+                by_clipped.setdefault(name, vtype)
+
+    name_hashes = {hash_name(n): n for n in by_name}
+    clipped_hashes = {hash_name(n): n for n in by_clipped}
+    assert len(name_hashes) == len(by_name) and len(clipped_hashes) == len(by_clipped), "name hash collision"
+
+    out = []
+    out.append("#pragma once")
+    out.append("")
+    out.append("//Generated by gen_vehicle_types.py from %s, do not edit." % src)
+    out.append("//%d rows, %d model hashes, %d names, %d clipped names" % (len(rows), len(by_hash), len(by_name), len(by_clipped)))
+    out.append("")
+    out.append("#include <stdint.h>")
+    out.append("#include <string_view>")
+    out.append("")
+    out.append("enum VehicleType : uint8_t {")
+    for t in TYPES:
+        out.append("    VEHICLE_TYPE_%s," % t.upper())
+    out.append("};")
+    out.append("")
+    out.append("constexpr const char* VEHICLE_TYPE_NAMES[] = { %s };" % ", ".join('"%s"' % t for t in TYPES))
+    out.append("")
+    out.append("struct VehicleModelEntry {")
+    out.append("    uint32_t model;")
+    out.append("    VehicleType type;")
+    out.append("};")
+    out.append("")
+    out.append("struct VehicleNameEntry {")
+    out.append("    const char* name;")
+    out.append("    VehicleType type;")
+    out.append("};")
+    out.append("")
+    out.append("constexpr uint32_t vtMix(uint32_t key, uint32_t seed) {")
+    out.append("    uint32_t h = key ^ (seed * 0x9E3779B9u);")
+    out.append("    h ^= h >> 16;")
+    out.append("    h *= 0x85EBCA6Bu;")
+    out.append("    h ^= h >> 13;")
+    out.append("    h *= 0xC2B2AE35u;")
+    out.append("    h ^= h >> 16;")
+    out.append("    return h;")
+    out.append("}")
+    out.append("")
+    out.append("//FNV-1a")
+    out.append("constexpr uint32_t vtHashName(std::string_view name) {")
+    out.append("    uint32_t h = 2166136261u;")
+    out.append("    for (char c : name) {")
+    out.append("        h ^= (uint8_t)c;")
+    out.append("        h *= 16777619u;")
+    out.append("    }")
+    out.append("    return h;")
+    out.append("}")
+    out.append("")
+
+    seeds, slots = build_chd(list(by_hash))
+    emit_table(out, "VT_MODEL_TABLE", "VehicleModelEntry", seeds, slots,
+               lambda k: "0x%08X, %s" % (k, type_enum(by_hash[k])))
+    seeds, slots = build_chd(list(name_hashes))
+    emit_table(out, "VT_NAME_TABLE", "VehicleNameEntry", seeds, slots,
+               lambda k: '"%s", %s' % (name_hashes[k], type_enum(by_name[name_hashes[k]])))
+    seeds, slots = build_chd(list(clipped_hashes))
+    emit_table(out, "VT_CLIPPED_TABLE", "VehicleNameEntry", seeds, slots,
+               lambda k: '"%s", %s' % (clipped_hashes[k], type_enum(by_clipped[clipped_hashes[k]])))
+
+    out.append("template <size_t S, size_t N>")
+    out.append("constexpr VehicleType vtFindModel(const uint32_t (&seeds)[S], const VehicleModelEntry (&table)[N], uint32_t model) {")
+    out.append("    const VehicleModelEntry& e = table[vtMix(model, seeds[vtMix(model, 0) % S]) % N];")
+    out.append("    return e.model == model ? e.type : VEHICLE_TYPE_UNKNOWN;")
+    out.append("}")
+    out.append("")
+    out.append("template <size_t S, size_t N>")
+    out.append("constexpr VehicleType vtFindName(const uint32_t (&seeds)[S], const VehicleNameEntry (&table)[N], std::string_view name) {")
+    out.append("    uint32_t h = vtHashName(name);")
+    out.append("    const VehicleNameEntry& e = table[vtMix(h, seeds[vtMix(h, 0) % S]) % N];")
+    out.append("    return name == e.name ? e.type : VEHICLE_TYPE_UNKNOWN;")
+    out.append("}")
+    out.append("")
+    out.append("//Model hash as returned by GET_ENTITY_MODEL")
+    out.append("constexpr VehicleType vehicleTypeFromModel(uint32_t model) {")
+    out.append("    return vtFindModel(VT_MODEL_TABLE_SEEDS, VT_MODEL_TABLE, model);")
+    out.append("}")
+    out.append("")
+    out.append("//Lowercase letters of the display name. Exact names are tried before clipped ones.")
+    out.append("constexpr VehicleType vehicleTypeFromName(std::string_view name) {")
+    out.append("    VehicleType type = vtFindName(VT_NAME_TABLE_SEEDS, VT_NAME_TABLE, name);")
+    out.append("    if (type != VEHICLE_TYPE_UNKNOWN) return type;")
+    out.append("    return vtFindName(VT_CLIPPED_TABLE_SEEDS, VT_CLIPPED_TABLE, name);")
+    out.append("}")
+    if rows:
+        model, vtype = rows[0]
+        out.append("")
+        out.append('static_assert(vehicleTypeFromModel(0x%08X) == %s, "Vehicle type table is broken");' % (joaat(model), type_enum(vtype)))
+        out.append('static_assert(vehicleTypeFromName("%s") == %s, "Vehicle type table is broken");' % (lookup_name(model), type_enum(by_name[lookup_name(model)])))
+
+    with open(dst, "w", newline="\n") as f:
+        f.write("\n".join(out) + "\n")
+
+
+if __name__ == "__main__":
+    main()
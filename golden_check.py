@@ -0,0 +1,474 @@
+#!/usr/bin/env python3
+"""Compares an export directory against the expected outputs of a golden corpus.
+
+A corpus is a captured collection (OUTPUT_WORLD_STATE on) kept together with
+the outputs a trusted build produced for it:
+
+  corpus/
+    depth/ stencil/ worldState/ calib/    recorded inputs (what ReplaySession reads)
+    DeepGTAVSettings.ini                  optional: settings the corpus is replayed with
+    expected/                             replay output of the reference build
+    golden.json                           optional: {"tolerances": {"<key>": <abs>}, "ignore": ["<field>", ...]}
+
+Replay the corpus with the build under test into a new directory, then run
+  python golden_check.py corpus/ new_output/ [--tol label_2.location=0.01 ...]
+tests/golden holds the corpora CTest replays (tests/GoldenTest.cmake), deepgtav_golden_corpus
+records new inputs.
+
+Every file under expected/ is compared with the file at the same relative path:
+  .png  decoded pixels (grey, RGB, RGBA of any depth, palette as RGBA), exact unless the field has a tolerance
+  .bin  float32 point clouds (velodyne_*: x, y, z, value; depthPC*, velodyneU/Raycast:
+        FLOATS_PER_POINT floats), point count exact, values within tolerance
+  .glb  binary labels (BinaryLabels.h), version 1 (232 byte) and 2 (236 byte) records.
+        Header and record fields by name: integers and strings exact, floats within
+        tolerance. Header fields are named header.<name>.
+  .txt  whitespace separated tokens per line: integers (occlusion, IDs, classes) and
+        strings exact, other numbers within tolerance. KITTI label columns are named.
+  .json structure, strings and integers exact, other numbers within tolerance
+  other bytes exact
+An expected file ending in .gz is decompressed and compared with the file without it.
+
+Tolerances are absolute. The most specific key wins: <field>.<column>, <field>, <column>,
+then --default-tol. A field is the first directory of the relative path (label_2,
+velodyne_entity, instSegMasks, ...). golden.json is read first, --tol overrides it.
+Ignored fields (golden.json or --ignore) are neither compared nor reported as extra.
+
+Prints a mismatch summary per field (and per column where values differ) and exits
+with 1 if anything differs or is missing. Runs with the standard library only.
+"""
+
+import argparse
+import gzip
+import json
+import math
+import os
+import struct
+import sys
+import zlib
+
+FLOATS_PER_POINT = 10
+VELODYNE_FLOATS_PER_POINT = 4
+
+KITTI_COLUMNS = ["type", "truncated", "occluded", "alpha",
+                 "bbox", "bbox", "bbox", "bbox",
+                 "dimensions", "dimensions", "dimensions",
+                 "location", "location", "location",
+                 "rotation_y"]
+VELODYNE_COLUMNS = ["x", "y", "z", "value"]
+LABEL_FIELDS = ("label_2", "label_aug_2", "labelsUnprocessed")
+
+# BinaryLabels.h, little-endian and packed
+GLB_MAGIC = 0x31424C47
+GLB_HEADER = [("magic", "I"), ("version", "H"), ("recordSize", "H"), ("count", "I"),
+              ("instanceIndex", "i"), ("seriesIndex", "i"), ("timeHours", "i"), ("focalLen", "f"),
+              ("speed", "f"), ("yawRate", "f"), ("imageWidth", "i"), ("imageHeight", "i")]
+# Layout of the file, not compared
+GLB_LAYOUT_FIELDS = ("magic", "version", "recordSize", "count")
+GLB_RECORD = [("entityID", "i"), ("classID", "i"), ("flags", "I"), ("objType", "16s"), ("modelString", "32s"),
+              ("truncation", "f"), ("occlusion", "i"), ("alpha", "f"), ("bbox2d", "4i"), ("bbox2dUnprocessed", "4i"),
+              ("height", "f"), ("width", "f"), ("length", "f"), ("location", "3f"), ("rotation_y", "f"),
+              ("distance", "f"), ("pointsHit2D", "i"), ("pointsHit3D", "i"), ("speed", "f"), ("roll", "f"),
+              ("pitch", "f"), ("vPedIsIn", "i"),
+              ("entity_velocity_vector", "3f"), ("own_vehicle_velocity_vector", "3f"),
+              ("entity_world_coordinates", "3f"), ("player_world_coordinates", "3f"),
+              ("entity_velocity_vector_camcoords", "3f"), ("own_vehicle_velocity_vector_camcoords", "3f"),
+              ("towLink", "i")]  # version 2
+GLB_V1_RECORD_SIZE = 232
+
+
+class FieldStats:
+    def __init__(self):
+        self.files = 0
+        self.mismatched_files = 0
+        self.missing = []
+        self.values = 0
+        self.mismatches = 0
+        self.columns = {}  # column -> [mismatches, max abs error]
+        self.notes = []
+
+    def value(self, column, ok, err=0.0):
+        self.values += 1
+        if ok:
+            return True
+        self.mismatches += 1
+        col = self.columns.setdefault(column, [0, 0.0])
+        col[0] += 1
+        if err is not None and not math.isnan(err):
+            col[1] = max(col[1], err)
+        return False
+
+
+class Checker:
+    def __init__(self, tolerances, default_tol):
+        self.tolerances = tolerances
+        self.default_tol = default_tol
+        self.fields = {}
+
+    def tol(self, field, column, exact_default=False):
+        for key in ("%s.%s" % (field, column), field, column):
+            if key in self.tolerances:
+                return self.tolerances[key]
+        return 0.0 if exact_default else self.default_tol
+
+    def close(self, stats, field, column, a, b, exact_default=False):
+        if a == b or (math.isnan(a) and math.isnan(b)):
+            return stats.value(column, True)
+        err = abs(a - b)
+        return stats.value(column, err <= self.tol(field, column, exact_default), err)
+
+    def check_file(self, field, rel, expected, actual):
+        """rel and actual are without the .gz of a compressed expected file"""
+        stats = self.fields.setdefault(field, FieldStats())
+        stats.files += 1
+        if not os.path.exists(actual):
+            stats.missing.append(rel)
+            stats.mismatched_files += 1
+            return
+        before = stats.mismatches
+        ext = os.path.splitext(rel)[1].lower()
+        try:
+            a = read_file(expected)
+            b = read_file(actual)
+            if ext == ".png":
+                self.check_png(stats, field, a, b)
+            elif ext == ".bin" and (field.startswith("velodyne") or field.startswith("depthPC")):
+                self.check_points(stats, field, a, b)
+            elif ext == ".glb":
+                self.check_glb(stats, field, a, b)
+            elif ext == ".txt":
+                self.check_text(stats, field, a, b)
+            elif ext == ".json":
+                self.check_json(stats, field, a, b)
+            else:
+                stats.value("bytes", a == b)
+        except (ValueError, struct.error) as e:
+            stats.notes.append("%s: %s" % (rel, e))
+            stats.values += 1
+            stats.mismatches += 1
+        if stats.mismatches != before:
+            stats.mismatched_files += 1
+
+    def check_png(self, stats, field, a, b):
+        wa, ha, pa = read_png(a)
+        wb, hb, pb = read_png(b)
+        if (wa, ha, len(pa)) != (wb, hb, len(pb)):
+            raise ValueError("size %dx%d (%d values) vs %dx%d (%d values)" % (wa, ha, len(pa), wb, hb, len(pb)))
+        tol = self.tol(field, "pixel", exact_default=True)
+        for a, b in zip(pa, pb):
+            stats.value("pixel", abs(a - b) <= tol, abs(a - b))
+
+    def check_points(self, stats, field, a, b):
+        width = VELODYNE_FLOATS_PER_POINT if field.startswith("velodyne_") else FLOATS_PER_POINT
+        a = read_floats(a)
+        b = read_floats(b)
+        if len(a) != len(b):
+            raise ValueError("%d points vs %d" % (len(a) // width, len(b) // width))
+        for k in range(len(a)):
+            col = k % width
+            column = VELODYNE_COLUMNS[col] if width == VELODYNE_FLOATS_PER_POINT else "f%d" % col
+            self.close(stats, field, column, a[k], b[k])
+
+    def check_glb(self, stats, field, a, b):
+        ha, ra = read_glb(a)
+        hb, rb = read_glb(b)
+        for name, fmt in GLB_HEADER:
+            if name not in GLB_LAYOUT_FIELDS:
+                self.compare_value(stats, field, "header." + name, fmt, ha[name], hb[name])
+        if len(ra) != len(rb):
+            raise ValueError("%d records vs %d" % (len(ra), len(rb)))
+        for rec_a, rec_b in zip(ra, rb):
+            for name, fmt in GLB_RECORD:
+                self.compare_value(stats, field, name, fmt, rec_a[name], rec_b[name])
+            # Fields of versions this script does not know
+            stats.value("unknown fields", rec_a["_rest"] == rec_b["_rest"], None)
+
+    def compare_value(self, stats, field, column, fmt, a, b):
+        kind = fmt[-1]
+        if kind == "f":
+            for x, y in zip(a, b):
+                self.close(stats, field, column, x, y)
+        elif kind == "s":
+            stats.value(column, a == b, None)
+        else:
+            for x, y in zip(a, b):
+                stats.value(column, x == y, abs(x - y))
+
+    def check_text(self, stats, field, a, b):
+        la = a.decode().splitlines()
+        lb = b.decode().splitlines()
+        if len(la) != len(lb):
+            raise ValueError("%d lines vs %d" % (len(la), len(lb)))
+        for line_a, line_b in zip(la, lb):
+            ta = line_a.split()
+            tb = line_b.split()
+            if len(ta) != len(tb):
+                stats.value("tokens", False, None)
+                continue
+            for k, (a, b) in enumerate(zip(ta, tb)):
+                if field in LABEL_FIELDS:
+                    column = KITTI_COLUMNS[k] if k < len(KITTI_COLUMNS) else "aug%d" % (k - len(KITTI_COLUMNS))
+                else:
+                    column = "col%d" % k
+                self.compare_token(stats, field, column, a, b)
+
+    def compare_token(self, stats, field, column, a, b):
+        ia, ib = parse_int(a), parse_int(b)
+        if ia is not None and ib is not None:
+            stats.value(column, ia == ib, abs(ia - ib))
+            return
+        fa, fb = parse_float(a), parse_float(b)
+        if fa is None or fb is None:
+            stats.value(column, a == b, None)
+            return
+        self.close(stats, field, column, fa, fb)
+
+    def check_json(self, stats, field, a, b):
+        self.compare_json(stats, field, "", json.loads(a), json.loads(b))
+
+    def compare_json(self, stats, field, key, a, b):
+        if isinstance(a, dict) and isinstance(b, dict):
+            if set(a) != set(b):
+                stats.value(key or "keys", False, None)
+            for k in a:
+                if k in b:
+                    self.compare_json(stats, field, k, a[k], b[k])
+        elif isinstance(a, list) and isinstance(b, list):
+            if len(a) != len(b):
+                stats.value(key or "length", False, None)
+                return
+            for x, y in zip(a, b):
+                self.compare_json(stats, field, key, x, y)
+        elif isinstance(a, bool) or isinstance(b, bool) or isinstance(a, str) or a is None:
+            stats.value(key, a == b, None)
+        elif isinstance(a, int) and isinstance(b, int):
+            stats.value(key, a == b, abs(a - b))
+        elif isinstance(a, (int, float)) and isinstance(b, (int, float)):
+            self.close(stats, field, key, float(a), float(b))
+        else:
+            stats.value(key, False, None)
+
+    def report(self, extra):
+        failed = False
+        for field in sorted(self.fields):
+            s = self.fields[field]
+            bad = s.mismatched_files > 0
+            failed = failed or bad
+            print("%-28s %s  files %d/%d  values %d/%d" % (field, "FAIL" if bad else "ok  ",
+                  s.files - s.mismatched_files, s.files, s.values - s.mismatches, s.values))
+            for rel in s.missing[:5]:
+                print("    missing %s" % rel)
+            if len(s.missing) > 5:
+                print("    ... %d more missing" % (len(s.missing) - 5))
+            for column in sorted(s.columns):
+                count, err = s.columns[column]
+                print("    %-20s %d mismatches, max abs error %g" % (column, count, err))
+            for note in s.notes[:5]:
+                print("    %s" % note)
+            if len(s.notes) > 5:
+                print("    ... %d more" % (len(s.notes) - 5))
+        if extra:
+            failed = True
+            print("%d files not in the corpus, e.g. %s" % (len(extra), extra[0]))
+        return failed
+
+
+def parse_int(s):
+    try:
+        return int(s)
+    except ValueError:
+        return None
+
+
+def parse_float(s):
+    try:
+        return float(s)
+    except ValueError:
+        return None
+
+
+def read_file(path):
+    """Contents of a file, decompressed if the name ends with .gz"""
+    if path.endswith(".gz"):
+        with gzip.open(path, "rb") as f:
+            return f.read()
+    with open(path, "rb") as f:
+        return f.read()
+
+
+def read_floats(data):
+    if len(data) % 4:
+        raise ValueError("size %d is not a multiple of 4" % len(data))
+    return struct.unpack("<%df" % (len(data) // 4), data)
+
+
+def read_glb(data):
+    """Returns (header, records) of a binary label file as dicts of field name -> tuple of values.
+    Records of older versions are zero-extended like BinaryLabelFile does, bytes of newer fields are kept in _rest."""
+    header = {}
+    pos = 0
+    for name, fmt in GLB_HEADER:
+        header[name] = struct.unpack_from("<" + fmt, data, pos)
+        pos += struct.calcsize("<" + fmt)
+    if header["magic"][0] != GLB_MAGIC:
+        raise ValueError("not a binary label file")
+    version, size, count = header["version"][0], header["recordSize"][0], header["count"][0]
+    if version < 1 or size < GLB_V1_RECORD_SIZE:
+        raise ValueError("unsupported binary labels (version %d, %d byte records)" % (version, size))
+    if len(data) < pos + count * size:
+        raise ValueError("%d records of %d bytes do not fit in %d bytes" % (count, size, len(data)))
+
+    records = []
+    for k in range(count):
+        start = pos + k * size
+        rec = data[start:start + size]
+        offset = 0
+        fields = {}
+        for name, fmt in GLB_RECORD:
+            width = struct.calcsize("<" + fmt)
+            if offset + width <= size:
+                value = struct.unpack_from("<" + fmt, rec, offset)
+            else:
+                # Field after the end of an older record
+                value = struct.unpack("<" + fmt, bytes(width))
+            if fmt.endswith("s"):
+                value = value[0].split(b"\0", 1)[0]
+            fields[name] = value
+            offset += width
+        fields["_rest"] = rec[offset:] if offset < size else b""
+        records.append(fields)
+    return header, records
+
+
+def read_png(data):
+    """Returns (width, height, samples) of a non-interlaced png. Grey, RGB, grey alpha and RGBA samples are
+    returned as stored (1 to 16 bits), palette images as RGBA (alpha from tRNS, else 255)."""
+    if data[:8] != b"\x89PNG\r\n\x1a\n":
+        raise ValueError("not a png")
+    pos = 8
+    idat = []
+    palette = b""
+    alpha = b""
+    while pos < len(data):
+        length, kind = struct.unpack(">I4s", data[pos:pos + 8])
+        body = data[pos + 8:pos + 8 + length]
+        if kind == b"IHDR":
+            width, height, depth, color, _, _, interlace = struct.unpack(">IIBBBBB", body)
+        elif kind == b"PLTE":
+            palette = body
+        elif kind == b"tRNS":
+            alpha = body
+        elif kind == b"IDAT":
+            idat.append(body)
+        elif kind == b"IEND":
+            break
+        pos += 12 + length
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}.get(color)
+    if channels is None or depth not in (1, 2, 4, 8, 16) or interlace:
+        raise ValueError("unsupported png (colour type %d, depth %d, interlace %d)" % (color, depth, interlace))
+    bits = channels * depth
+    # Filters work on whole bytes, at least one
+    bpp = max(1, bits // 8)
+    stride = (width * bits + 7) // 8
+    raw = zlib.decompress(b"".join(idat))
+    out = bytearray(stride * height)
+    prev = bytearray(stride)
+    for y in range(height):
+        ftype = raw[y * (stride + 1)]
+        line = bytearray(raw[y * (stride + 1) + 1:(y + 1) * (stride + 1)])
+        for x in range(stride):
+            left = line[x - bpp] if x >= bpp else 0
+            up = prev[x]
+            if ftype == 1:
+                line[x] = (line[x] + left) & 0xFF
+            elif ftype == 2:
+                line[x] = (line[x] + up) & 0xFF
+            elif ftype == 3:
+                line[x] = (line[x] + ((left + up) >> 1)) & 0xFF
+            elif ftype == 4:
+                ul = prev[x - bpp] if x >= bpp else 0
+                p = left + up - ul
+                pa, pb, pc = abs(p - left), abs(p - up), abs(p - ul)
+                pred = left if pa <= pb and pa <= pc else (up if pb <= pc else ul)
+                line[x] = (line[x] + pred) & 0xFF
+        out[y * stride:(y + 1) * stride] = line
+        prev = line
+    if depth == 16:
+        samples = struct.unpack(">%dH" % (len(out) // 2), bytes(out))
+    elif depth == 8:
+        samples = out
+    else:
+        # Packed from the high bits, rows start on a byte
+        per_row = width * channels
+        mask = (1 << depth) - 1
+        samples = []
+        for y in range(height):
+            row = out[y * stride:(y + 1) * stride]
+            for k in range(per_row):
+                bit = k * depth
+                samples.append((row[bit >> 3] >> (8 - depth - (bit & 7))) & mask)
+    if color == 3:
+        rgba = []
+        for index in samples:
+            if 3 * index + 3 > len(palette):
+                raise ValueError("palette index %d out of range" % index)
+            rgba.extend(palette[3 * index:3 * index + 3])
+            rgba.append(alpha[index] if index < len(alpha) else 255)
+        samples = rgba
+    return width, height, samples
+
+
+def list_files(root):
+    files = []
+    for dirpath, _, names in os.walk(root):
+        for name in names:
+            files.append(os.path.relpath(os.path.join(dirpath, name), root).replace(os.sep, "/"))
+    return sorted(files)
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description="Compare an export directory against a golden corpus")
+    parser.add_argument("corpus", help="corpus directory (holding expected/ and optionally golden.json)")
+    parser.add_argument("actual", help="export directory of the build under test")
+    parser.add_argument("--tol", action="append", default=[], metavar="KEY=ABS",
+                        help="absolute tolerance for <field>.<column>, <field> or <column>")
+    parser.add_argument("--default-tol", type=float, default=1e-4, help="tolerance for other floats")
+    parser.add_argument("--field", action="append", default=[], help="only check these fields")
+    parser.add_argument("--ignore", action="append", default=[], help="skip these fields")
+    args = parser.parse_args(argv)
+
+    tolerances = {}
+    ignore = set(args.ignore)
+    config = os.path.join(args.corpus, "golden.json")
+    if os.path.exists(config):
+        with open(config) as f:
+            golden = json.load(f)
+        tolerances.update(golden.get("tolerances", {}))
+        ignore.update(golden.get("ignore", []))
+    for item in args.tol:
+        key, _, value = item.partition("=")
+        tolerances[key] = float(value)
+
+    expected_root = os.path.join(args.corpus, "expected")
+    if not os.path.isdir(expected_root):
+        print("%s has no expected/ directory" % args.corpus)
+        return 2
+
+    def selected(rel):
+        field = rel.split("/")[0]
+        return field not in ignore and (not args.field or field in args.field)
+
+    checker = Checker(tolerances, args.default_tol)
+    known = set()
+    for rel in list_files(expected_root):
+        if not selected(rel):
+            continue
+        name = rel[:-3] if rel.endswith(".gz") else rel
+        known.add(name)
+        checker.check_file(name.split("/")[0], name, os.path.join(expected_root, rel), os.path.join(args.actual, name))
+
+    extra = [rel for rel in list_files(args.actual) if rel not in known and selected(rel)]
+    return 1 if checker.report(extra) else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
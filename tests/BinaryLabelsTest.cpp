@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include "BinaryLabels.h"
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::string labelPath(const char* name) {
+    return ::testing::TempDir() + "deepgtav_" + name + ".glb";
+}
+
+BinaryLabelHeader makeHeader(uint16_t version, uint16_t recordSize, uint32_t count) {
+    BinaryLabelHeader header = {};
+    header.magic = BINARY_LABEL_MAGIC;
+    header.version = version;
+    header.recordSize = recordSize;
+    header.count = count;
+    header.instanceIndex = 12;
+    header.imageWidth = 1920;
+    header.imageHeight = 1080;
+    return header;
+}
+
+BinaryLabelRecord makeRecord(int entityID) {
+    BinaryLabelRecord rec = {};
+    rec.entityID = entityID;
+    rec.classID = 0;
+    strncpy(rec.objType, "Car", BINARY_LABEL_TYPE_LEN - 1);
+    rec.location[2] = 10.5f + entityID;
+    rec.own_vehicle_velocity_vector_camcoords[2] = 3.0f;
+    rec.towLink = 77;
+    return rec;
+}
+
+//Writes records truncated to recordSize bytes, as an older writer laid them out
+void writeTruncated(const std::string& path, const BinaryLabelHeader& header, const std::vector<BinaryLabelRecord>& records) {
+    FILE* f = fopen(path.c_str(), "wb");
+    ASSERT_NE(f, nullptr);
+    fwrite(&header, sizeof(header), 1, f);
+    for (const BinaryLabelRecord& rec : records) {
+        fwrite(&rec, header.recordSize, 1, f);
+    }
+    fclose(f);
+}
+
+}
+
+TEST(BinaryLabels, CurrentVersionRoundTrips) {
+    std::string path = labelPath("current");
+    std::vector<BinaryLabelRecord> records = { makeRecord(5), makeRecord(6) };
+    ASSERT_TRUE(writeBinaryLabels(path, makeHeader(BINARY_LABEL_VERSION, sizeof(BinaryLabelRecord), 2), records));
+
+    BinaryLabelFile file;
+    ASSERT_TRUE(file.open(path));
+    ASSERT_EQ(file.count(), 2u);
+    EXPECT_EQ(file.header()->instanceIndex, 12);
+    EXPECT_EQ(file.record(1)->entityID, 6);
+    EXPECT_EQ(file.record(1)->towLink, 77);
+    EXPECT_EQ(file.record(2), nullptr);
+}
+
+TEST(BinaryLabels, Version1RecordsAreZeroExtended) {
+    std::string path = labelPath("v1");
+    std::vector<BinaryLabelRecord> records = { makeRecord(5), makeRecord(6), makeRecord(7) };
+    writeTruncated(path, makeHeader(1, BINARY_LABEL_V1_RECORD_SIZE, 3), records);
+
+    BinaryLabelFile file;
+    ASSERT_TRUE(file.open(path));
+    ASSERT_EQ(file.count(), 3u);
+    for (uint32_t k = 0; k < 3; ++k) {
+        const BinaryLabelRecord* rec = file.record(k);
+        ASSERT_NE(rec, nullptr);
+        EXPECT_EQ(rec->entityID, 5 + (int)k);
+        EXPECT_STREQ(rec->objType, "Car");
+        EXPECT_FLOAT_EQ(rec->location[2], 15.5f + k);
+        EXPECT_FLOAT_EQ(rec->own_vehicle_velocity_vector_camcoords[2], 3.0f);
+        //Added in version 2
+        EXPECT_EQ(rec->towLink, 0);
+    }
+}
+
+TEST(BinaryLabels, RejectsNewerVersionsAndShortFiles) {
+    std::string newer = labelPath("newer");
+    std::vector<BinaryLabelRecord> records = { makeRecord(5) };
+    ASSERT_TRUE(writeBinaryLabels(newer, makeHeader(BINARY_LABEL_VERSION + 1, sizeof(BinaryLabelRecord), 1), records));
+    BinaryLabelFile file;
+    EXPECT_FALSE(file.open(newer));
+
+    //Header claims two records, the file holds one
+    std::string truncated = labelPath("truncated");
+    ASSERT_TRUE(writeBinaryLabels(truncated, makeHeader(BINARY_LABEL_VERSION, sizeof(BinaryLabelRecord), 2), records));
+    EXPECT_FALSE(file.open(truncated));
+}
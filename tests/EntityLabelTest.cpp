@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+#include "EntityLabel.h"
+#include "GeometryCore.h"
+#include "ModelInfoCache.h"
+
+namespace {
+
+Vector3 vec(float x, float y, float z) {
+    Vector3 v;
+    v.x = x;
+    v.y = y;
+    v.z = z;
+    return v;
+}
+
+//Camera at the origin looking north (GTA y), one entity facing north in the snapshot
+struct NorthScene : public ::testing::Test {
+    void SetUp() override {
+        cam.pos = vec(0, 0, 0);
+        frame = { &cam, vec(0, 1, 0), vec(1, 0, 0), vec(0, 0, 1), vec(0, 1, 0), EgoSnapshot() };
+        frame.ego.velocity = vec(0, 5, 0);
+
+        snap.resize(1);
+        snap.ids[0] = 42;
+        snap.models[0] = 0x1234;
+        snap.forward[0] = vec(0, 1, 0);
+        snap.right[0] = vec(1, 0, 0);
+        snap.up[0] = vec(0, 0, 1);
+        snap.distance[0] = 10;
+        snap.cullTier[0] = CULL_TIER_FULL;
+
+        info.min = vec(-1, -2, -0.5f);
+        info.max = vec(1, 2, 1);
+        info.displayName = "ADDER";
+        geom.info = &info;
+    }
+
+    ObjEntity label(int classid, const char* type) {
+        entityGeometry(snap, 0, info, classid == PEDESTRIAN_CLASS_ID, geom);
+        ObjEntity e;
+        entityLabel(snap, 0, geom, frame, classid, type, e);
+        return e;
+    }
+
+    CamParams cam;
+    LabelFrameState frame;
+    EntitySnapshot snap;
+    ModelInfo info;
+    EntityGeometry geom;
+};
+
+}
+
+TEST_F(NorthScene, VehicleLabelFromModelBounds) {
+    snap.position[0] = vec(2, 10, 0);
+    ObjEntity e = label(0, "Car");
+
+    EXPECT_EQ(e.entityID, 42);
+    EXPECT_EQ(e.objType, "Car");
+    EXPECT_EQ(e.modelString, "ADDER");
+    EXPECT_FLOAT_EQ(e.width, 2);
+    EXPECT_FLOAT_EQ(e.length, 4);
+    EXPECT_FLOAT_EQ(e.height, 1.5f);
+    //Bottom center: model min z below the origin
+    EXPECT_FLOAT_EQ(e.worldPos.z, -0.5f);
+    EXPECT_FLOAT_EQ(e.location.x, 2);
+    EXPECT_FLOAT_EQ(e.location.y, 0.5f);
+    EXPECT_FLOAT_EQ(e.location.z, 10);
+    EXPECT_NEAR(e.rotation_y, -PI / 2, 1e-6);
+    EXPECT_TRUE(e.inFrustum);
+    EXPECT_FLOAT_EQ(e.own_vehicle_velocity_vector.y, 5);
+}
+
+TEST_F(NorthScene, SameInputsGiveTheSameLabel) {
+    snap.position[0] = vec(-3, 20, 1);
+    snap.speed[0] = 4;
+    snap.speedVector[0] = vec(1, 4, 0);
+    entityGeometry(snap, 0, info, false, geom);
+
+    ObjEntity first;
+    entityLabel(snap, 0, geom, frame, 0, "Car", first);
+    //An entity reused from another label gets every field overwritten
+    ObjEntity second = label(PEDESTRIAN_CLASS_ID, "Pedestrian");
+    entityGeometry(snap, 0, info, false, geom);
+    entityLabel(snap, 0, geom, frame, 0, "Car", second);
+
+    EXPECT_EQ(second.objType, first.objType);
+    EXPECT_EQ(second.classID, first.classID);
+    EXPECT_FLOAT_EQ(second.location.x, first.location.x);
+    EXPECT_FLOAT_EQ(second.location.y, first.location.y);
+    EXPECT_FLOAT_EQ(second.location.z, first.location.z);
+    EXPECT_FLOAT_EQ(second.heading, first.heading);
+    EXPECT_FLOAT_EQ(second.alpha, first.alpha);
+    EXPECT_FLOAT_EQ(second.height, first.height);
+    EXPECT_FLOAT_EQ(second.entity_velocity_vector_camcoords.x, first.entity_velocity_vector_camcoords.x);
+}
+
+TEST_F(NorthScene, PedBoxIsLoweredToTheGround) {
+    snap.position[0] = vec(0, 5, 1);
+    snap.groundZ[0] = 0.2f;
+    info.min = vec(-0.3f, -0.3f, -1);
+    info.max = vec(0.3f, 0.3f, 0.8f);
+    ObjEntity e = label(PEDESTRIAN_CLASS_ID, "Pedestrian");
+
+    EXPECT_EQ(e.objType, "Pedestrian");
+    EXPECT_FLOAT_EQ(e.height, 1.6f);
+    EXPECT_FLOAT_EQ(e.worldPos.z, 0.2f);
+    if (SET_PED_BOXES) {
+        EXPECT_FLOAT_EQ(e.width, PED_BOX_WIDTH);
+        EXPECT_FLOAT_EQ(e.length, PED_BOX_LENGTH);
+    }
+
+    //Short peds are sitting
+    info.max.z = 0.1f;
+    EXPECT_EQ(label(PEDESTRIAN_CLASS_ID, "Pedestrian").objType, "Person_sitting");
+}
+
+TEST_F(NorthScene, PedCullRadiusHoldsTheLoweredBox) {
+    info.min = vec(-0.3f, -0.3f, -0.9f);
+    info.max = vec(0.3f, 0.3f, 0.9f);
+    info.radius = 0.95f;
+    float radius = pedBoxRadius(info);
+
+    //Ground just above the furthest drop, walking (the longest box)
+    snap.position[0] = vec(0, 5, 10);
+    snap.groundZ[0] = 10 - PED_MAX_GROUND_DROP + 0.01f;
+    snap.speed[0] = 2;
+    entityGeometry(snap, 0, info, true, geom);
+    EXPECT_LT(geom.min.z, -1.9f);
+    for (float x : { geom.min.x, geom.max.x }) {
+        for (float y : { geom.min.y, geom.max.y }) {
+            for (float z : { geom.min.z, geom.max.z }) {
+                EXPECT_LE(sqrt(x * x + y * y + z * z), radius) << x << " " << y << " " << z;
+            }
+        }
+    }
+}
+
+TEST(Riders, VerticalWindowFollowsTheGrowingBox) {
+    //Bike 10 m ahead, riders are scanned in ascending ID order along camera y
+    ObjEntity bike(100);
+    bike.location = vec(0, 0, 10);
+    bike.height = 1;
+    bike.width = 0.8f;
+    bike.length = 2;
+
+    struct { int id; Vector3 location; float height; } peds[] = {
+        { 1, vec(0.1f, 1.8f, 10), 2 },
+        //2.9 m below the bike, only within the window once the first rider has moved the box
+        { 2, vec(0, 2.9f, 10.1f), 1.7f },
+        { 3, vec(0, 6, 10), 1.7f },//Too far below
+        { 4, vec(1, 1, 10), 1.7f },//Beside the bike
+    };
+    EntityTable table;
+    PedSpatialHash grid;
+    for (auto& p : peds) {
+        ObjEntity ped(p.id);
+        ped.location = p.location;
+        ped.height = p.height;
+        ped.width = 0.6f;
+        ped.length = 0.5f;
+        table.insert(ped);
+        grid.add(p.id, p.location);
+    }
+    grid.build();
+
+    std::vector<int> hits;
+    EXPECT_EQ(mergeRidersInRange(bike, grid, table, hits), 2);
+    EXPECT_TRUE(table.record(table.find(1)).isPedInV);
+    EXPECT_EQ(table.record(table.find(2)).vPedIsIn, 100);
+    EXPECT_FALSE(table.record(table.find(3)).isPedInV);
+    EXPECT_FALSE(table.record(table.find(4)).isPedInV);
+    //First rider: bottom from 0.5 to 2.8 (center 1.15), second: to 3.75
+    EXPECT_NEAR(bike.location.y + bike.height / 2, 3.75f, 1e-5);
+    EXPECT_NEAR(bike.location.y - bike.height / 2, -0.5f, 1e-5);
+    EXPECT_FLOAT_EQ(bike.width, 0.8f);
+}
@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include "EntityState.h"
+#include <math.h>
+
+namespace {
+
+const int PED = 7;
+const Hash MODEL = 0x1234;
+
+Vector3 vec(float x, float y, float z) {
+    Vector3 v;
+    v.x = x;
+    v.y = y;
+    v.z = z;
+    return v;
+}
+
+//One frame of an entity at a position with the identity basis, filled like getEntityVector does on a recompute
+EntityGeometry& see(EntityStateStore& store, int entityID, Vector3 position, float groundZ) {
+    EntityGeometry& g = store.lookup(entityID, MODEL, vec(0, 1, 0), vec(1, 0, 0), vec(0, 0, 1), position, false);
+    if (!g.valid) {
+        g.valid = true;
+        g.groundZ = groundZ;
+        g.groundZValid = true;
+    }
+    return g;
+}
+
+}
+
+TEST(EntityStateStore, UnchangedPoseIsReused) {
+    EntityStateStore store;
+    store.beginFrame();
+    see(store, PED, vec(10, 20, 30), 29);
+    store.endFrame();
+    EXPECT_EQ(store.stats().recomputed, 1);
+
+    float groundZ = 0;
+    ASSERT_TRUE(store.cachedGroundZ(PED, vec(10, 20, 30), groundZ));
+    EXPECT_EQ(groundZ, 29);
+
+    store.beginFrame();
+    EntityGeometry& g = see(store, PED, vec(10, 20, 30), 0);
+    store.endFrame();
+    EXPECT_TRUE(g.valid);
+    EXPECT_EQ(g.groundZ, 29);
+    EXPECT_EQ(store.stats().reused, 1);
+    EXPECT_EQ(store.stats().recomputed, 0);
+    EXPECT_EQ(store.reuseRatio(), 1.0f);
+}
+
+TEST(EntityStateStore, EntitiesNotSeenForAFrameAreEvicted) {
+    EntityStateStore store;
+    store.beginFrame();
+    see(store, PED, vec(10, 20, 30), 29);
+    see(store, PED + 1, vec(0, 0, 0), -1);
+    store.endFrame();
+
+    store.beginFrame();
+    see(store, PED + 1, vec(0, 0, 0), -1);
+    EXPECT_EQ(store.find(PED), nullptr);
+    EXPECT_NE(store.find(PED + 1), nullptr);
+    store.endFrame();
+    EXPECT_EQ(store.stats().evicted, 1);
+    EXPECT_EQ(store.size(), 1u);
+
+    //The ground Z goes with the entry, the ped pays for the native again
+    float groundZ = 0;
+    EXPECT_FALSE(store.cachedGroundZ(PED, vec(10, 20, 30), groundZ));
+
+    store.beginFrame();
+    EntityGeometry& g = store.lookup(PED, MODEL, vec(0, 1, 0), vec(1, 0, 0), vec(0, 0, 1), vec(10, 20, 30), false);
+    EXPECT_FALSE(g.valid);
+    EXPECT_FALSE(g.groundZValid);
+}
+
+TEST(EntityStateStore, PoseEpsilon) {
+    float eps = ENTITY_POSE_EPSILON;
+    ENTITY_POSE_EPSILON = 0.01f;
+
+    EntityStateStore store;
+    store.beginFrame();
+    see(store, PED, vec(10, 20, 30), 29);
+    store.endFrame();
+
+    //Within epsilon the stored key (and its ground Z) is kept
+    float groundZ = 0;
+    EXPECT_TRUE(store.cachedGroundZ(PED, vec(10.005f, 20, 30), groundZ));
+    store.beginFrame();
+    EntityGeometry& same = see(store, PED, vec(10.005f, 19.995f, 30), 0);
+    EXPECT_EQ(store.stats().reused, 1);
+    EXPECT_EQ(same.position.x, 10);
+    EXPECT_EQ(same.groundZ, 29);
+    store.endFrame();
+
+    //Beyond it on any axis the geometry and the ground Z are recomputed
+    EXPECT_FALSE(store.cachedGroundZ(PED, vec(10, 20, 30.02f), groundZ));
+    store.beginFrame();
+    EntityGeometry& moved = see(store, PED, vec(10, 20, 30.02f), 28);
+    EXPECT_EQ(store.stats().recomputed, 1);
+    EXPECT_EQ(moved.groundZ, 28);
+    store.endFrame();
+
+    //A turn in place is a new pose too
+    store.beginFrame();
+    EntityGeometry& turned = store.lookup(PED, MODEL, vec(1, 0, 0), vec(0, -1, 0), vec(0, 0, 1), vec(10, 20, 30.02f), false);
+    EXPECT_FALSE(turned.valid);
+    EXPECT_FALSE(turned.groundZValid);
+    store.endFrame();
+
+    ENTITY_POSE_EPSILON = eps;
+}
+
+TEST(EntityStateStore, SlowDriftIsRecomputedBeforeItExceedsTheEpsilon) {
+    float eps = ENTITY_POSE_EPSILON;
+    ENTITY_POSE_EPSILON = 0.01f;
+
+    //A quarter of the epsilon per frame: every single step looks unchanged
+    const int FRAMES = 400;
+    const float STEP = 0.0025f;
+    EntityStateStore store;
+    int recomputed = 0;
+    for (int f = 0; f < FRAMES; ++f) {
+        Vector3 position = vec(10 + f * STEP, 20, 30);
+        store.beginFrame();
+        EntityGeometry& g = see(store, PED, position, 29);
+        recomputed += store.stats().recomputed;
+        store.endFrame();
+
+        //The geometry in use is never further than the epsilon from the actual pose
+        EXPECT_LE(fabs(g.position.x - position.x), ENTITY_POSE_EPSILON + 1e-5f) << "frame " << f;
+    }
+    //Recomputed about every 4th frame, not once at the start
+    EXPECT_GE(recomputed, FRAMES / 5);
+    EXPECT_LE(recomputed, FRAMES / 3);
+
+    ENTITY_POSE_EPSILON = eps;
+}
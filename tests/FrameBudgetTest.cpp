@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+#include "FrameBudget.h"
+#include <string>
+
+namespace {
+
+struct StageMs {
+    double generate;//Includes lidar, ground and debug
+    double exports;
+    double lidar;
+    double ground;
+    double debug;
+};
+
+std::string budgetLog(const char* test) {
+    return ::testing::TempDir() + "deepgtav_budget_" + test + ".csv";
+}
+
+//Runs frames with fixed stage times, as generateMessage and the exports would report them
+void runFrames(FrameBudget& budget, int& frame, int count, const StageMs& ms) {
+    for (int i = 0; i < count; ++i, ++frame) {
+        budget.beginFrame(frame, 0);
+        budget.addStage(BUDGET_STAGE_GENERATE, ms.generate);
+        budget.addStage(BUDGET_STAGE_LIDAR, ms.lidar);
+        budget.addStage(BUDGET_STAGE_GROUND, ms.ground);
+        budget.addStage(BUDGET_STAGE_DEBUG, ms.debug);
+        budget.addStage(BUDGET_STAGE_EXPORT_DETECTIONS, ms.exports / 2);
+        budget.addStage(BUDGET_STAGE_EXPORT_IMAGE, ms.exports / 2);
+    }
+    budget.endFrame();
+}
+
+}
+
+TEST(FrameBudget, ExportsCountTowardsTheFrameTime) {
+    FrameBudget budget;
+    ASSERT_TRUE(budget.open(budgetLog("exports"), 60.0f));
+    int frame = 0;
+    //generateMessage alone is under budget, with the exports it is not
+    runFrames(budget, frame, 10, { 40, 40, 20, 10, 5 });
+    EXPECT_GT(budget.quality().level, 0);
+    EXPECT_NEAR(budget.stageAverage(BUDGET_STAGE_EXPORT_IMAGE), 20.0, 1e-6);
+}
+
+TEST(FrameBudget, LowersTheStageThatSavesTheMost) {
+    FrameBudget budget;
+    ASSERT_TRUE(budget.open(budgetLog("stages"), 50.0f));
+    int frame = 0;
+    //LiDAR dominates: halving it saves more than dropping the debug outputs
+    runFrames(budget, frame, 5, { 80, 0, 60, 4, 6 });
+    EXPECT_EQ(budget.quality().level, 1);
+    EXPECT_EQ(budget.quality().lidarAzimuthStride, 2);
+    EXPECT_TRUE(budget.quality().debugOutputs);
+    EXPECT_EQ(budget.quality().groundGridInterval, 2);
+
+    //Ground points now cost the most, they are lowered twice before anything else
+    runFrames(budget, frame, 10, { 70, 0, 10, 40, 6 });
+    EXPECT_EQ(budget.quality().level, 3);
+    EXPECT_EQ(budget.quality().lidarAzimuthStride, 2);
+    EXPECT_EQ(budget.quality().groundGridInterval, 8);
+    EXPECT_TRUE(budget.quality().debugOutputs);
+}
+
+TEST(FrameBudget, StaysAtFullQualityWhenNothingWouldHelp) {
+    FrameBudget budget;
+    ASSERT_TRUE(budget.open(budgetLog("exports_only"), 50.0f));
+    int frame = 0;
+    //All the time is in the exports, which are never degraded
+    runFrames(budget, frame, 20, { 5, 100, 0, 0, 0 });
+    EXPECT_EQ(budget.quality().level, 0);
+    EXPECT_TRUE(budget.quality().debugOutputs);
+}
+
+TEST(FrameBudget, RestoresTheLastStepFirst) {
+    FrameBudget budget;
+    ASSERT_TRUE(budget.open(budgetLog("recover"), 50.0f));
+    int frame = 0;
+    runFrames(budget, frame, 5, { 80, 0, 60, 4, 6 });
+    runFrames(budget, frame, 5, { 80, 0, 10, 4, 30 });
+    ASSERT_EQ(budget.quality().level, 2);
+    EXPECT_FALSE(budget.quality().debugOutputs);
+
+    //Well under budget: the debug outputs come back before the LiDAR density
+    runFrames(budget, frame, 40, { 10, 0, 5, 1, 0 });
+    EXPECT_EQ(budget.quality().level, 1);
+    EXPECT_TRUE(budget.quality().debugOutputs);
+    EXPECT_EQ(budget.quality().lidarAzimuthStride, 2);
+    runFrames(budget, frame, 30, { 10, 0, 5, 1, 0 });
+    EXPECT_EQ(budget.quality().level, 0);
+    EXPECT_EQ(budget.quality().lidarAzimuthStride, 1);
+}
@@ -0,0 +1,28 @@
+#include <gtest/gtest.h>
+#include "FrameBufferPool.h"
+
+TEST(FrameBufferPool, BuffersStayIntactUntilReused) {
+    FrameBufferPool pool;
+    pool.init(4, 2, 8, 2);
+
+    FrameBufferSet& first = pool.next();
+    first.instanceSeg[3] = 42;
+    first.stencilSeg[5] = 7;
+    first.occlusionImage[1] = 255;
+
+    //Filling the second set leaves the first one as written
+    FrameBufferSet& second = pool.next();
+    EXPECT_NE(&first, &second);
+    second.instanceSeg[0] = 9;
+    EXPECT_EQ(first.instanceSeg[3], 42u);
+    EXPECT_EQ(first.stencilSeg[5], 7);
+    EXPECT_EQ(first.occlusionImage[1], 255);
+
+    //Handed out again, cleared
+    FrameBufferSet& reused = pool.next();
+    EXPECT_EQ(&reused, &first);
+    EXPECT_EQ(reused.instanceSeg[3], 0u);
+    EXPECT_EQ(reused.stencilSeg[5], 0);
+    EXPECT_EQ(reused.occlusionImage[1], 0);
+    EXPECT_EQ(second.instanceSeg[0], 9u);
+}
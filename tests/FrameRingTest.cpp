@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include "FrameRing.h"
+#include <string.h>
+#include <string>
+#include <vector>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace {
+
+const uint32_t RECORD_BYTES = 1024 * 1024;
+//Producer CPU time, long enough for readers to be preempted mid-copy even on a single core
+const double PRODUCE_SECONDS = 0.5;
+const int READERS = 3;
+
+std::string ringName(const char* test) {
+    return std::string("deepgtav_test_") + test + "_" + std::to_string(getpid());
+}
+
+//Every byte of a frame's record is the low byte of its frame sequence, so torn copies are visible
+void writeFrame(FrameRingProducer& ring, int frame, bool last) {
+    ring.beginFrame(last ? -1 : frame, 0);
+    uint8_t* p = (uint8_t*)ring.reserveRecord(FRAME_RECORD_DEPTH, RECORD_BYTES, 128, 128);
+    ASSERT_NE(p, nullptr);
+    memset(p, (uint8_t)(frame + 1), RECORD_BYTES);
+    ring.publishFrame();
+}
+
+//Child process: reads until the last frame and returns 0 if every validated copy was intact
+int readFrames(const std::string& name, int readyFd) {
+    FrameRingReader reader;
+    if (!reader.attach(name, true)) return 2;
+    char ready = 1;
+    if (write(readyFd, &ready, 1) != 1) return 2;
+
+    FrameView view;
+    std::vector<uint8_t> buffer;
+    uint64_t lastSeq = 0;
+    int frames = 0;
+    time_t deadline = time(NULL) + 120;
+    while (time(NULL) < deadline) {
+        if (!reader.copyFrame(view, buffer)) continue;
+
+        uint32_t size = 0;
+        const uint8_t* data = view.find(FRAME_RECORD_DEPTH, &size);
+        if (!data || size != RECORD_BYTES) return 3;
+        for (uint32_t k = 0; k < size; ++k) {
+            if (data[k] != (uint8_t)view.frameSeq) return 4;
+        }
+        if (view.frameSeq <= lastSeq) return 5;
+        lastSeq = view.frameSeq;
+        ++frames;
+        if (view.instanceIndex == -1) return frames > 1 ? 0 : 6;
+    }
+    return 7;
+}
+
+}
+
+TEST(FrameRing, ReaderSeesPublishedRecords) {
+    std::string name = ringName("single");
+    FrameRingProducer ring;
+    ASSERT_TRUE(ring.init(name, 2, RECORD_BYTES));
+    FrameRingReader reader;
+    ASSERT_TRUE(reader.attach(name, true));
+
+    FrameView view;
+    EXPECT_FALSE(reader.next(view));
+    writeFrame(ring, 0, false);
+    ASSERT_TRUE(reader.next(view));
+    EXPECT_EQ(view.frameSeq, 1u);
+    uint32_t size = 0;
+    const uint8_t* data = view.find(FRAME_RECORD_DEPTH, &size);
+    ASSERT_NE(data, nullptr);
+    EXPECT_EQ(size, RECORD_BYTES);
+    EXPECT_EQ(data[RECORD_BYTES - 1], 1);
+    EXPECT_TRUE(reader.stillValid(view));
+
+    //Two more frames in a two slot ring overwrite the first
+    writeFrame(ring, 1, false);
+    writeFrame(ring, 2, false);
+    EXPECT_FALSE(reader.stillValid(view));
+}
+
+TEST(FrameRing, ConcurrentReadersNeverSeeTornFrames) {
+    std::string name = ringName("readers");
+    FrameRingProducer ring;
+    ASSERT_TRUE(ring.init(name, 2, RECORD_BYTES));
+
+    int readyPipe[2];
+    ASSERT_EQ(pipe(readyPipe), 0);
+    std::vector<pid_t> readers;
+    for (int r = 0; r < READERS; ++r) {
+        pid_t pid = fork();
+        ASSERT_GE(pid, 0);
+        if (pid == 0) {
+            close(readyPipe[0]);
+            _exit(readFrames(name, readyPipe[1]));
+        }
+        readers.push_back(pid);
+    }
+    close(readyPipe[1]);
+    for (int r = 0; r < READERS; ++r) {
+        char ready;
+        ASSERT_EQ(read(readyPipe[0], &ready, 1), 1);
+    }
+    close(readyPipe[0]);
+
+    //The producer never waits, readers that fall behind drop frames
+    int frame = 0;
+    clock_t start = clock();
+    while ((double)(clock() - start) / CLOCKS_PER_SEC < PRODUCE_SECONDS) {
+        writeFrame(ring, frame++, false);
+    }
+    writeFrame(ring, frame, true);
+
+    for (pid_t pid : readers) {
+        int status = 0;
+        ASSERT_EQ(waitpid(pid, &status, 0), pid);
+        ASSERT_TRUE(WIFEXITED(status));
+        EXPECT_EQ(WEXITSTATUS(status), 0);
+    }
+}
@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include "GeometryCore.h"
+
+namespace {
+
+Vector3 vec(float x, float y, float z) {
+    Vector3 v;
+    v.x = x;
+    v.y = y;
+    v.z = z;
+    return v;
+}
+
+//Camera at the origin looking north (GTA y), right is east and up is z
+struct NorthCamera : public ::testing::Test {
+    void SetUp() override {
+        cam.pos = vec(0, 0, 0);
+        forward = vec(0, 1, 0);
+        right = vec(1, 0, 0);
+        up = vec(0, 0, 1);
+    }
+
+    CamParams cam;
+    Vector3 forward;
+    Vector3 right;
+    Vector3 up;
+};
+
+}
+
+TEST_F(NorthCamera, KittiLocationIsRightDownForward) {
+    Vector3 location = kittiLocation(cam, vec(2, 10, -1.5f), forward, right, up);
+    EXPECT_FLOAT_EQ(location.x, 2);
+    EXPECT_FLOAT_EQ(location.y, 1.5f);
+    EXPECT_FLOAT_EQ(location.z, 10);
+}
+
+TEST_F(NorthCamera, KittiLocationIsRelativeToTheCamera) {
+    cam.pos = vec(100, 200, 30);
+    Vector3 location = kittiLocation(cam, vec(102, 210, 28.5f), forward, right, up);
+    EXPECT_FLOAT_EQ(location.x, 2);
+    EXPECT_FLOAT_EQ(location.y, 1.5f);
+    EXPECT_FLOAT_EQ(location.z, 10);
+}
+
+TEST_F(NorthCamera, RotationYIsZeroAlongCameraX) {
+    EXPECT_NEAR(kittiRotationY(vec(1, 0, 0), forward, right, up), 0, 1e-6);
+    //Driving away from the camera
+    EXPECT_NEAR(kittiRotationY(vec(0, 1, 0), forward, right, up), -PI / 2, 1e-6);
+    //Towards the camera
+    EXPECT_NEAR(kittiRotationY(vec(0, -1, 0), forward, right, up), PI / 2, 1e-6);
+}
+
+TEST_F(NorthCamera, AlphaEqualsRotationYStraightAhead) {
+    //On the optical axis the observation angle is the yaw
+    float rotY = kittiRotationY(vec(0, 1, 0), forward, right, up);
+    Vector3 location = kittiLocation(cam, vec(0, 20, 0), forward, right, up);
+    EXPECT_NEAR(kittiAlpha(rotY, location), rotY, 1e-6);
+}
+
+TEST_F(NorthCamera, AlphaIncludesTheViewingRay) {
+    float rotY = 0.3f;
+    Vector3 location = vec(5, 1, 5);
+    EXPECT_NEAR(kittiAlpha(rotY, location), 0.3f + PI / 4 - PI / 2, 1e-6);
+}
+
+TEST(OcclusionLevel, Thresholds) {
+    float visibility;
+    EXPECT_EQ(occlusionLevel(0, 100, visibility), 0);
+    EXPECT_FLOAT_EQ(visibility, 1);
+    EXPECT_EQ(occlusionLevel(19, 81, visibility), 0);
+    EXPECT_EQ(occlusionLevel(20, 80, visibility), 1);
+    EXPECT_EQ(occlusionLevel(59, 41, visibility), 1);
+    EXPECT_EQ(occlusionLevel(60, 40, visibility), 2);
+    EXPECT_NEAR(visibility, 0.4f, 1e-6);
+}
+
+TEST(OcclusionLevel, NoPixelsIsFullyOccluded) {
+    float visibility;
+    EXPECT_EQ(occlusionLevel(0, 0, visibility), 2);
+    EXPECT_FLOAT_EQ(visibility, 0);
+}
+
+TEST(Vdist2, SquaredDistance) {
+    EXPECT_FLOAT_EQ(vdist2(1, 2, 3, 4, 6, 3), 25);
+    EXPECT_FLOAT_EQ(vdist2(0, 0, 0, 0, 0, 0), 0);
+}
+
+TEST(HeadingFromVector2d, NorthIsZeroAndAnglesGrowCounterclockwise) {
+    EXPECT_NEAR(headingFromVector2d(0, 1), 0, 1e-4);
+    EXPECT_NEAR(headingFromVector2d(-1, 0), 90, 1e-4);
+    EXPECT_NEAR(headingFromVector2d(0, -1), 180, 1e-4);
+    EXPECT_NEAR(headingFromVector2d(1, 0), 270, 1e-4);
+    EXPECT_NEAR(headingFromVector2d(-2, 2), 45, 1e-4);
+    EXPECT_NEAR(headingFromVector2d(3, 3), 315, 1e-4);
+}
+
+TEST(HeadingFromVector2d, StaysInRange) {
+    //Just east of north is just below 360, never 360 itself
+    float heading = headingFromVector2d(1e-9f, 1);
+    EXPECT_GE(heading, 0);
+    EXPECT_LT(heading, 360);
+    EXPECT_NEAR(headingFromVector2d(-1e-3f, -1), 180, 0.1);
+    EXPECT_NEAR(headingFromVector2d(1e-3f, -1), 180, 0.1);
+    for (int k = 0; k < 360; ++k) {
+        float rad = (float)(k * D2R);
+        heading = headingFromVector2d(-sinf(rad), cosf(rad));
+        EXPECT_GE(heading, 0);
+        EXPECT_LT(heading, 360);
+        EXPECT_NEAR(fmod(heading - k + 540, 360) - 180, 0, 1e-3) << k;
+    }
+}
@@ -0,0 +1,57 @@
+#include "SceneWorld.h"
+#include "WorldState.h"
+#include "DepthCompression.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+//Records the inputs of a golden corpus (see golden_check.py) from a SyntheticWorld, the way the plugin stores a
+//collection: worldState/<frame>.bin, depth/<frame>.gdz (lossless, as with COMPRESS_DEPTH_BUFFER) and stencil/<frame>.raw
+//  deepgtav_golden_corpus <corpus dir> [<frames>]
+//The expected outputs are the replay of these inputs with a trusted build (deepgtav_replay <corpus dir> <corpus dir>/expected)
+//without the fields golden.json ignores, large files may be gzipped.
+int main(int argc, char** argv) {
+    if (argc != 2 && argc != 3) {
+        fprintf(stderr, "Usage: %s <corpus dir> [<frames>]\n", argv[0]);
+        return 2;
+    }
+    fs::path dir = argv[1];
+    int frames = argc == 3 ? atoi(argv[2]) : 1;
+
+    //Small enough to keep in the repository, with vehicles and peds in front of the camera
+    SyntheticWorld world(320, 180, 12, 6, 3);
+    for (int k = 0; k < frames; ++k) {
+        char rel[16];
+        snprintf(rel, sizeof(rel), "%06d", k);
+
+        WorldStateFrame state = world.frame();
+        state.instanceIndex = k;
+        state.seriesIndex = 0;
+        fs::create_directories(dir / "worldState");
+        if (!writeWorldState((dir / "worldState" / (std::string(rel) + ".bin")).string(), state)) {
+            fprintf(stderr, "Could not write the world state of frame %d\n", k);
+            return 1;
+        }
+
+        std::vector<float> depth;
+        std::vector<uint8_t> stencil;
+        std::vector<uint8_t> compressed;
+        world.render(depth, stencil);
+        if (!compressDepthBuffer(depth.data(), state.width, state.height, compressed)) {
+            fprintf(stderr, "Could not compress the depth of frame %d\n", k);
+            return 1;
+        }
+        fs::create_directories(dir / "depth");
+        fs::create_directories(dir / "stencil");
+        std::ofstream((dir / "depth" / (std::string(rel) + ".gdz")), std::ios::binary).write((const char*)compressed.data(), compressed.size());
+        std::ofstream((dir / "stencil" / (std::string(rel) + ".raw")), std::ios::binary).write((const char*)stencil.data(), stencil.size());
+
+        world.step();
+    }
+    printf("Recorded %d frames in %s\n", frames, dir.string().c_str());
+    return 0;
+}
@@ -0,0 +1,22 @@
+# Replays a golden corpus with deepgtav_replay and compares the output with its expected/ directory (golden_check.py)
+#   cmake -DREPLAY=<deepgtav_replay> -DPYTHON=<python3> -DCHECK=<golden_check.py> -DCORPUS=<dir> -DOUT=<dir> -P GoldenTest.cmake
+
+file(REMOVE_RECURSE ${OUT})
+# The export creates one directory level, like the plugin
+file(MAKE_DIRECTORY ${OUT})
+if(EXISTS ${CORPUS}/DeepGTAVSettings.ini)
+    set(ENV{DEEPGTAV_SETTINGS} ${CORPUS}/DeepGTAVSettings.ini)
+else()
+    # Defaults, not whatever settings file is in the working directory
+    set(ENV{DEEPGTAV_SETTINGS} ${OUT}.ini)
+endif()
+
+execute_process(COMMAND ${REPLAY} ${CORPUS} ${OUT} RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "Replay of ${CORPUS} failed (${result})")
+endif()
+
+execute_process(COMMAND ${PYTHON} ${CHECK} ${CORPUS} ${OUT} RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "${OUT} differs from ${CORPUS}/expected")
+endif()
@@ -0,0 +1,204 @@
+#include <gtest/gtest.h>
+#include "InstanceMasks.h"
+#include <vector>
+
+namespace {
+
+const int WIDTH = 12;
+const int HEIGHT = 10;
+
+//Builds the masks in the row-major order the segmentation fills them
+struct MaskImage {
+    MaskImage() : seg(WIDTH * HEIGHT, 0) {
+        masks.reset(WIDTH, HEIGHT);
+    }
+
+    void set(int entityID, int i, int j) {
+        seg[j * WIDTH + i] = entityID;
+    }
+
+    std::string json(int format) {
+        for (int j = 0; j < HEIGHT; ++j) {
+            for (int i = 0; i < WIDTH; ++i) {
+                if (seg[j * WIDTH + i]) masks.addPixel(seg[j * WIDTH + i], i, j);
+            }
+        }
+        return masks.toJson(format, seg.data(), 7);
+    }
+
+    std::vector<uint32_t> seg;
+    InstanceMaskSet masks;
+};
+
+}
+
+TEST(InstanceMaskPolygons, SquareHasItsFourCorners) {
+    MaskImage image;
+    for (int j = 1; j <= 3; ++j) {
+        for (int i = 2; i <= 4; ++i) image.set(5, i, j);
+    }
+    std::string json = image.json(INSTANCE_MASK_POLYGON);
+    EXPECT_NE(json.find("\"segmentation\": [[2, 1, 2, 3, 4, 3, 4, 1]]"), std::string::npos) << json;
+    EXPECT_NE(json.find("\"area\": 9"), std::string::npos) << json;
+}
+
+TEST(InstanceMaskPolygons, ComponentInsideAHoleIsNotExternal) {
+    MaskImage image;
+    //Ring from (1,1) to (7,7) with a pixel in the middle of the hole
+    for (int j = 1; j <= 7; ++j) {
+        for (int i = 1; i <= 7; ++i) {
+            if (i == 1 || i == 7 || j == 1 || j == 7) image.set(3, i, j);
+        }
+    }
+    image.set(3, 4, 4);
+    std::string json = image.json(INSTANCE_MASK_POLYGON);
+    EXPECT_NE(json.find("\"segmentation\": [[1, 1, 1, 7, 7, 7, 7, 1]]"), std::string::npos) << json;
+}
+
+TEST(InstanceMaskPolygons, DiagonalPixelsAreOneComponent) {
+    MaskImage image;
+    for (int k = 0; k < 4; ++k) {
+        image.set(9, 3 + k, 2 + k);
+        image.set(9, 4 + k, 2 + k);
+    }
+    std::string json = image.json(INSTANCE_MASK_POLYGON);
+    //A single polygon
+    EXPECT_EQ(json.find("], ["), std::string::npos) << json;
+    EXPECT_NE(json.find("\"segmentation\": [[3, 2"), std::string::npos) << json;
+}
+
+TEST(InstanceMaskPolygons, SeparateComponentsEachGetAPolygon) {
+    MaskImage image;
+    for (int j = 0; j < 2; ++j) {
+        for (int i = 0; i < 2; ++i) {
+            image.set(4, i, j);
+            image.set(4, i + 8, j + 6);
+        }
+    }
+    std::string json = image.json(INSTANCE_MASK_POLYGON);
+    EXPECT_NE(json.find("[[0, 0, 0, 1, 1, 1, 1, 0], [8, 6, 8, 7, 9, 7, 9, 6]]"), std::string::npos) << json;
+}
+
+//The fixtures below give the points cv::findContours (RETR_EXTERNAL, CHAIN_APPROX_SIMPLE) lists: from the first pixel
+//in raster order down the left side, one point per change of direction, diagonal steps around inner corners
+
+TEST(InstanceMaskPolygons, HoleIsIgnoredAndNotchIsFollowed) {
+    MaskImage image;
+    //4x3 block with a two pixel hole and a 2x2 tail below its right half
+    for (int j = 1; j <= 3; ++j) {
+        for (int i = 2; i <= 5; ++i) {
+            if (!(j == 2 && (i == 3 || i == 4))) image.set(1, i, j);
+        }
+    }
+    for (int j = 4; j <= 5; ++j) {
+        for (int i = 4; i <= 5; ++i) image.set(1, i, j);
+    }
+    std::string json = image.json(INSTANCE_MASK_POLYGON);
+    EXPECT_NE(json.find("\"segmentation\": [[2, 1, 2, 3, 3, 3, 4, 4, 4, 5, 5, 5, 5, 1]]"), std::string::npos) << json;
+    EXPECT_NE(json.find("\"area\": 14"), std::string::npos) << json;
+}
+
+TEST(InstanceMaskPolygons, BayOpenToTheOutsideIsTraced) {
+    MaskImage image;
+    //U shape: two 2 pixel wide arms on a 2 pixel thick base
+    for (int j = 1; j <= 6; ++j) {
+        for (int i = 1; i <= 6; ++i) {
+            if (i <= 2 || i >= 5 || j >= 5) image.set(1, i, j);
+        }
+    }
+    std::string json = image.json(INSTANCE_MASK_POLYGON);
+    EXPECT_NE(json.find("\"segmentation\": [[1, 1, 1, 6, 6, 6, 6, 1, 5, 1, 5, 4, 4, 5, 3, 5, 2, 4, 2, 1]]"), std::string::npos) << json;
+}
+
+TEST(InstanceMaskPolygons, BlocksTouchingAtACornerAreOneContour) {
+    MaskImage image;
+    for (int j = 0; j < 2; ++j) {
+        for (int i = 0; i < 2; ++i) {
+            image.set(1, i, j);
+            image.set(1, i + 2, j + 2);
+        }
+    }
+    std::string json = image.json(INSTANCE_MASK_POLYGON);
+    //The corner pixels are passed twice
+    EXPECT_NE(json.find("\"segmentation\": [[0, 0, 0, 1, 1, 1, 2, 2, 2, 3, 3, 3, 3, 2, 2, 2, 1, 1, 1, 0]]"), std::string::npos) << json;
+}
+
+TEST(InstanceMaskPolygons, NestedRingsGiveTheOutermostContour) {
+    MaskImage image;
+    //Ring in the hole of a ring with a pixel in the hole of the inner ring
+    for (int j = 0; j <= 8; ++j) {
+        for (int i = 0; i <= 8; ++i) {
+            bool outer = i == 0 || i == 8 || j == 0 || j == 8;
+            bool inner = i >= 2 && i <= 6 && j >= 2 && j <= 6 && (i == 2 || i == 6 || j == 2 || j == 6);
+            if (outer || inner || (i == 4 && j == 4)) image.set(1, i, j);
+        }
+    }
+    std::string json = image.json(INSTANCE_MASK_POLYGON);
+    EXPECT_NE(json.find("\"segmentation\": [[0, 0, 0, 8, 8, 8, 8, 0]]"), std::string::npos) << json;
+    EXPECT_NE(json.find("\"area\": 49"), std::string::npos) << json;
+}
+
+TEST(InstanceMaskPolygons, EntityInTheHoleOfAnotherGetsItsOwnContour) {
+    MaskImage image;
+    //Entity 2 fills the hole of entity 1 and touches it on every side
+    for (int j = 1; j <= 6; ++j) {
+        for (int i = 1; i <= 6; ++i) image.set(i >= 3 && i <= 4 && j >= 3 && j <= 4 ? 2 : 1, i, j);
+    }
+    std::string json = image.json(INSTANCE_MASK_POLYGON);
+    EXPECT_NE(json.find("\"entity_id\": 1, \"bbox\": [1, 1, 6, 6], \"area\": 32, \"segmentation\": [[1, 1, 1, 6, 6, 6, 6, 1]]"), std::string::npos) << json;
+    EXPECT_NE(json.find("\"entity_id\": 2, \"bbox\": [3, 3, 2, 2], \"area\": 4, \"segmentation\": [[3, 3, 3, 4, 4, 4, 4, 3]]"), std::string::npos) << json;
+}
+
+TEST(InstanceMaskPolygons, TouchingInstancesAreSeparate) {
+    MaskImage image;
+    for (int j = 2; j <= 4; ++j) {
+        for (int i = 1; i <= 6; ++i) image.set(i <= 3 ? 1 : 2, i, j);
+    }
+    std::string json = image.json(INSTANCE_MASK_POLYGON);
+    EXPECT_NE(json.find("\"entity_id\": 1, \"bbox\": [1, 2, 3, 3], \"area\": 9, \"segmentation\": [[1, 2, 1, 4, 3, 4, 3, 2]]"), std::string::npos) << json;
+    EXPECT_NE(json.find("\"entity_id\": 2, \"bbox\": [4, 2, 3, 3], \"area\": 9, \"segmentation\": [[4, 2, 4, 4, 6, 4, 6, 2]]"), std::string::npos) << json;
+}
+
+TEST(InstanceMaskJson, BoxIsThatOfTheFinalMask) {
+    MaskImage image;
+    for (int j = 1; j <= 3; ++j) {
+        for (int i = 2; i <= 4; ++i) image.masks.addPixel(5, i, j);
+    }
+    //A closer entity takes over the right column and the bottom row of entity 5
+    for (int j = 1; j <= 3; ++j) {
+        for (int i = 2; i <= 4; ++i) image.set(i == 4 || j == 3 ? 6 : 5, i, j);
+    }
+    for (int j = 1; j <= 3; ++j) image.masks.addPixel(6, 4, j);
+    for (int i = 2; i <= 3; ++i) image.masks.addPixel(6, i, 3);
+
+    std::string json = image.masks.toJson(INSTANCE_MASK_RLE, image.seg.data(), 7);
+    EXPECT_NE(json.find("\"entity_id\": 5, \"bbox\": [2, 1, 2, 2], \"area\": 4"), std::string::npos) << json;
+    EXPECT_NE(json.find("\"entity_id\": 6, \"bbox\": [2, 1, 3, 3], \"area\": 5"), std::string::npos) << json;
+}
+
+TEST(InstanceMaskJson, InterleavedEntitiesKeepTheirPixels) {
+    MaskImage image;
+    //Alternating pixels, each lookup misses the cached last entity
+    for (int i = 0; i < WIDTH; ++i) image.set(i % 2 ? 2 : 1, i, 4);
+    std::string json = image.json(INSTANCE_MASK_RLE);
+    EXPECT_NE(json.find("\"entity_id\": 1, \"bbox\": [0, 4, 11, 1], \"area\": 6"), std::string::npos) << json;
+    EXPECT_NE(json.find("\"entity_id\": 2, \"bbox\": [1, 4, 11, 1], \"area\": 6"), std::string::npos) << json;
+}
+
+TEST(InstanceMaskJson, RleBackslashIsEscaped) {
+    MaskImage image;
+    //Column-major offset 44 encodes as a backslash followed by a continuation
+    image.set(5, 4, 4);
+    std::string json = image.json(INSTANCE_MASK_RLE);
+    EXPECT_NE(json.find("\"counts\": \"\\\\1"), std::string::npos) << json;
+}
+
+TEST(InstanceMaskJson, FullyReassignedMaskIsDropped) {
+    MaskImage image;
+    image.masks.addPixel(5, 3, 3);
+    image.set(6, 3, 3);
+    image.masks.addPixel(6, 3, 3);
+    std::string json = image.masks.toJson(INSTANCE_MASK_POLYGON, image.seg.data(), 7);
+    EXPECT_EQ(json.find("\"entity_id\": 5"), std::string::npos) << json;
+    EXPECT_NE(json.find("\"entity_id\": 6"), std::string::npos) << json;
+}
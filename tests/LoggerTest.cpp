@@ -0,0 +1,42 @@
+#include <gtest/gtest.h>
+#include "Logger.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+namespace {
+
+std::string readLog(const std::string& path) {
+    std::ifstream in(path);
+    std::stringstream s;
+    s << in.rdbuf();
+    return s.str();
+}
+
+}
+
+TEST(Logger, ShutdownWritesQueuedMessagesAndLaterWritesRestartTheThread) {
+    std::string path = ::testing::TempDir() + "deepgtav_logger.log";
+    remove(path.c_str());
+    //The file is taken from the environment when the logger is constructed
+    setenv("DEEPGTAV_LOG_FILE", path.c_str(), 1);
+    std::unique_ptr<Logger> logger(new Logger());
+    unsetenv("DEEPGTAV_LOG_FILE");
+
+    ASSERT_TRUE(logger->enabled(LOG_LEVEL_INFO));
+    logger->write(LOG_LEVEL_INFO, "first");
+    logger->shutdown();
+    EXPECT_NE(readLog(path).find("INFO first"), std::string::npos);
+
+    //Nothing to join twice
+    logger->shutdown();
+
+    logger->write(LOG_LEVEL_WARN, "second");
+    logger->flush();
+    EXPECT_NE(readLog(path).find("WARN second"), std::string::npos);
+    logger->shutdown();
+    remove(path.c_str());
+}
@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+#include "NativeProfiler.h"
+#include <fstream>
+#include <sstream>
+#include <string>
+
+//Built with PROFILE_NATIVES (tests/CMakeLists.txt), the natives are stubs
+
+namespace {
+
+int s_modelCalls = 0;
+
+int GET_ENTITY_MODEL(int entity) {
+    ++s_modelCalls;
+    return entity * 2;
+}
+
+bool IS_ENTITY_DEAD(int) {
+    return false;
+}
+
+std::string readText(const std::string& path) {
+    std::ifstream in(path);
+    std::ostringstream oss;
+    oss << in.rdbuf();
+    return oss.str();
+}
+
+size_t countOf(const std::string& text, const std::string& needle) {
+    size_t count = 0;
+    for (size_t pos = text.find(needle); pos != std::string::npos; pos = text.find(needle, pos + 1)) ++count;
+    return count;
+}
+
+}
+
+TEST(NativeProfiler, CountsCallsPerFrame) {
+    std::string csv = ::testing::TempDir() + "deepgtav_NativeProfile.csv";
+    std::string trace = ::testing::TempDir() + "deepgtav_NativeTrace.json";
+    ASSERT_TRUE(s_nativeProfiler.open(csv, trace));
+
+    s_nativeProfiler.beginFrame(7);
+    for (int k = 0; k < 5; ++k) {
+        EXPECT_EQ(NATIVE(GET_ENTITY_MODEL)(k), 2 * k);
+    }
+    NATIVE(IS_ENTITY_DEAD)(1);
+    NATIVE(IS_ENTITY_DEAD)(2);
+    s_nativeProfiler.beginFrame(8);
+    NATIVE(GET_ENTITY_MODEL)(3);
+    //Calls outside a frame are dropped
+    s_nativeProfiler.endFrame();
+    NATIVE(GET_ENTITY_MODEL)(4);
+    s_nativeProfiler.close();
+    EXPECT_EQ(s_modelCalls, 7);
+
+    std::string rows = readText(csv);
+    EXPECT_EQ(rows.find("frame,native,calls,total_us,max_us\n"), 0u);
+    EXPECT_NE(rows.find("\n7,GET_ENTITY_MODEL,5,"), std::string::npos) << rows;
+    EXPECT_NE(rows.find("\n7,IS_ENTITY_DEAD,2,"), std::string::npos) << rows;
+    EXPECT_NE(rows.find("\n8,GET_ENTITY_MODEL,1,"), std::string::npos) << rows;
+    EXPECT_EQ(rows.find("\n8,IS_ENTITY_DEAD"), std::string::npos) << rows;
+    EXPECT_EQ(countOf(rows, "\n"), 4u);
+
+    std::string events = readText(trace);
+    EXPECT_EQ(events.front(), '[');
+    EXPECT_EQ(events.substr(events.size() - 3), "\n]\n");
+    EXPECT_EQ(countOf(events, "\"name\":\"GET_ENTITY_MODEL\""), 6u);
+    EXPECT_EQ(countOf(events, "\"name\":\"IS_ENTITY_DEAD\""), 2u);
+    EXPECT_EQ(countOf(events, "\"args\":{\"frame\":8}"), 1u);
+    EXPECT_EQ(countOf(events, "\"ph\":\"X\""), 8u);
+}
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include "Replay.h"
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+const int WIDTH = 320;
+const int HEIGHT = 180;
+
+fs::path testDir(const std::string& name) {
+    fs::path dir = fs::path(::testing::TempDir()) / ("deepgtav_" + name);
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    return dir;
+}
+
+void writeFile(const fs::path& path, const void* data, size_t size) {
+    fs::create_directories(path.parent_path());
+    std::ofstream out(path, std::ios::binary);
+    out.write((const char*)data, size);
+}
+
+//Records a synthetic frame the way the plugin stores it: worldState/<rel>.bin, depth/<rel>.bin, stencil/<rel>.raw
+void recordFrame(const fs::path& dir, const std::string& rel, SyntheticWorld& world, int instanceIndex, int seriesIndex) {
+    WorldStateFrame state = world.frame();
+    state.instanceIndex = instanceIndex;
+    state.seriesIndex = seriesIndex;
+    fs::create_directories((dir / "worldState" / rel).parent_path());
+    ASSERT_TRUE(writeWorldState((dir / "worldState" / (rel + ".bin")).string(), state));
+
+    std::vector<float> depth;
+    std::vector<uint8_t> stencil;
+    world.render(depth, stencil);
+    writeFile(dir / "depth" / (rel + ".bin"), depth.data(), depth.size() * sizeof(float));
+    writeFile(dir / "stencil" / (rel + ".raw"), stencil.data(), stencil.size());
+}
+
+std::string readText(const fs::path& path) {
+    std::ifstream in(path);
+    std::ostringstream oss;
+    oss << in.rdbuf();
+    return oss.str();
+}
+
+}
+
+TEST(Replay, RecordedFrameIsLabelled) {
+    fs::path input = testDir("replay_in");
+    fs::path output = testDir("replay_out");
+    SyntheticWorld world(WIDTH, HEIGHT, 12, 6, 3);
+    recordFrame(input, "000000", world, 0, 0);
+
+    ReplaySession session;
+    ASSERT_TRUE(session.open(input.string()));
+    ASSERT_EQ(session.frameCount(), 1u);
+    std::unique_ptr<ObjectDetection> detection(new ObjectDetection());
+    EXPECT_EQ(session.run(*detection, output.string()), 1);
+
+    std::string labels = readText(output / "label_2" / "000000.txt");
+    EXPECT_NE(labels.find("Car "), std::string::npos) << labels;
+}
+
+TEST(Replay, MissingBuffersFailTheFrame) {
+    fs::path input = testDir("replay_missing");
+    SyntheticWorld world(WIDTH, HEIGHT, 4, 0, 3);
+    recordFrame(input, "000000", world, 0, 0);
+    fs::remove(input / "stencil" / "000000.raw");
+
+    ReplaySession session;
+    ASSERT_TRUE(session.open(input.string()));
+    std::unique_ptr<ObjectDetection> detection(new ObjectDetection());
+    EXPECT_EQ(session.run(*detection, (testDir("replay_missing_out")).string()), 0);
+}
+
+TEST(ReplaySharding, TrackingCollectionsShardBySeries) {
+    fs::path input = testDir("replay_series");
+    //Three series of 3, 2 and 1 frames
+    const int frames[] = { 3, 2, 1 };
+    for (int series = 0; series < 3; ++series) {
+        for (int k = 0; k < frames[series]; ++k) {
+            char rel[32];
+            snprintf(rel, sizeof(rel), "%04d/%06d.bin", series, k);
+            writeFile(input / "worldState" / rel, "", 0);
+        }
+    }
+
+    ReplaySession shard0, shard1;
+    ASSERT_TRUE(shard0.open(input.string(), 0, 2));
+    ASSERT_TRUE(shard1.open(input.string(), 1, 2));
+    //Series 0 and 2 in shard 0, series 1 in shard 1
+    EXPECT_EQ(shard0.frameCount(), 4u);
+    EXPECT_EQ(shard1.frameCount(), 2u);
+}
+
+TEST(ReplaySharding, FlatCollectionsShardInBlocks) {
+    fs::path input = testDir("replay_flat");
+    for (int k = 0; k < 5; ++k) {
+        char rel[32];
+        snprintf(rel, sizeof(rel), "%06d.bin", k);
+        writeFile(input / "worldState" / rel, "", 0);
+    }
+
+    size_t total = 0;
+    for (int shard = 0; shard < 3; ++shard) {
+        ReplaySession session;
+        ASSERT_TRUE(session.open(input.string(), shard, 3));
+        EXPECT_GE(session.frameCount(), 1u);
+        total += session.frameCount();
+    }
+    EXPECT_EQ(total, 5u);
+}
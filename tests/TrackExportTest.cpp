@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+#include "TrackExport.h"
+#include <stdio.h>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+//One parsed MOT line
+struct MotRow {
+    int frame;
+    int id;
+    int motClass;
+};
+
+std::string trackPath(const char* name, const char* ext) {
+    return ::testing::TempDir() + "deepgtav_" + name + ext;
+}
+
+ObjEntity makeEntity(int entityID, int classID, const char* type) {
+    ObjEntity e(entityID);
+    e.classID = classID;
+    e.objType = type;
+    e.truncation = 0;
+    e.occlusion = 0;
+    e.alpha = 0;
+    e.height = 1.5f;
+    e.width = 1.8f;
+    e.length = 4.2f;
+    e.location.x = 0;
+    e.location.y = 0;
+    e.location.z = 10;
+    e.rotation_y = 0;
+    e.entity_velocity_vector_camcoords = e.location;
+    e.bbox2d.left = 10;
+    e.bbox2d.top = 20;
+    e.bbox2d.right = 50;
+    e.bbox2d.bottom = 60;
+    return e;
+}
+
+std::vector<MotRow> readMot(const std::string& path) {
+    std::vector<MotRow> rows;
+    std::ifstream in(path);
+    std::string line;
+    while (std::getline(in, line)) {
+        MotRow row;
+        int left, top, width, height, conf;
+        if (sscanf(line.c_str(), "%d,%d,%d,%d,%d,%d,%d,%d", &row.frame, &row.id, &left, &top, &width, &height, &conf, &row.motClass) == 8) {
+            rows.push_back(row);
+        }
+    }
+    return rows;
+}
+
+//Runs frames 0..frames-1, entities[f] are added in frame f
+std::vector<MotRow> exportFrames(const char* name, const std::vector<std::vector<ObjEntity>>& entities, size_t* activeAtEnd = NULL) {
+    std::string kitti = trackPath(name, ".txt");
+    std::string mot = trackPath(name, ".mot");
+    {
+        TrackExporter tracks;
+        EXPECT_TRUE(tracks.open(kitti, mot));
+        for (int f = 0; f < (int)entities.size(); ++f) {
+            tracks.beginFrame(f);
+            for (const ObjEntity& e : entities[f]) tracks.addEntity(e);
+            tracks.endFrame();
+        }
+        if (activeAtEnd) *activeAtEnd = tracks.activeTracks();
+    }
+    std::vector<MotRow> rows = readMot(mot);
+    remove(kitti.c_str());
+    remove(mot.c_str());
+    return rows;
+}
+
+struct TrackEviction : public ::testing::Test {
+    void SetUp() override {
+        saved = TRACK_EVICT_FRAMES;
+        TRACK_EVICT_FRAMES = 3;
+    }
+    void TearDown() override {
+        TRACK_EVICT_FRAMES = saved;
+    }
+    int saved;
+};
+
+}
+
+TEST_F(TrackEviction, IdsPersistWhileEntitiesAreSeen) {
+    ObjEntity car = makeEntity(100, 0, "Car");
+    ObjEntity ped = makeEntity(200, 10, "Pedestrian");
+    std::vector<std::vector<ObjEntity>> frames = { { car }, { car, ped }, { ped, car }, { car } };
+    std::vector<MotRow> rows = exportFrames("persist", frames);
+    ASSERT_EQ(rows.size(), 6u);
+    //1-based frames and IDs in order of first sight
+    EXPECT_EQ(rows[0].frame, 1);
+    EXPECT_EQ(rows[0].id, 1);
+    EXPECT_EQ(rows[1].id, 1);
+    EXPECT_EQ(rows[2].id, 2);
+    EXPECT_EQ(rows[3].id, 2);
+    EXPECT_EQ(rows[4].id, 1);
+    EXPECT_EQ(rows[5].frame, 4);
+    EXPECT_EQ(rows[5].id, 1);
+}
+
+TEST_F(TrackEviction, GapUpToEvictFramesKeepsTheTrack) {
+    ObjEntity car = makeEntity(100, 0, "Car");
+    //Unseen in frames 1-3, back in frame 4
+    std::vector<std::vector<ObjEntity>> frames = { { car }, {}, {}, {}, { car } };
+    std::vector<MotRow> rows = exportFrames("gap", frames);
+    ASSERT_EQ(rows.size(), 2u);
+    EXPECT_EQ(rows[1].frame, 5);
+    EXPECT_EQ(rows[1].id, 1);
+}
+
+TEST_F(TrackEviction, LongerGapStartsANewTrack) {
+    ObjEntity car = makeEntity(100, 0, "Car");
+    ObjEntity other = makeEntity(300, 0, "Car");
+    //Evicted at the end of frame 4, so frame 5 sees a new track
+    std::vector<std::vector<ObjEntity>> frames = { { car }, { other }, { other }, { other }, { other }, { car } };
+    size_t active = 0;
+    std::vector<MotRow> rows = exportFrames("evict", frames, &active);
+    ASSERT_EQ(rows.size(), 6u);
+    EXPECT_EQ(rows[0].id, 1);
+    EXPECT_EQ(rows[1].id, 2);
+    EXPECT_EQ(rows[5].frame, 6);
+    EXPECT_EQ(rows[5].id, 3);
+    EXPECT_EQ(active, 2u);
+}
+
+TEST(MotClass, MiscAndOffRoadAreDistractors) {
+    std::vector<std::vector<ObjEntity>> frames = { {
+        makeEntity(1, 10, "Pedestrian"),
+        makeEntity(2, 10, "Person_sitting"),
+        makeEntity(3, 0, "Car"),
+        makeEntity(4, 0, "Truck"),
+        makeEntity(5, 2, "Cyclist"),
+        makeEntity(6, 1, "Cyclist"),
+        makeEntity(7, 11, "Misc"),//Animal
+        makeEntity(8, 0, "Misc"),//Forklift
+        makeEntity(9, 4, "UNK"),//Boat
+    } };
+    std::vector<MotRow> rows = exportFrames("classes", frames);
+    std::vector<int> classes;
+    for (const MotRow& row : rows) classes.push_back(row.motClass);
+    EXPECT_EQ(classes, std::vector<int>({ 1, 7, 3, 3, 4, 5, 8, 8, 8 }));
+}
@@ -0,0 +1,214 @@
+#!/usr/bin/env python3
+"""Self-test of golden_check.py: builds small corpora and export directories and checks the verdicts."""
+
+import contextlib
+import gzip
+import io
+import json
+import os
+import shutil
+import struct
+import sys
+import tempfile
+import unittest
+import zlib
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), ".."))
+import golden_check  # noqa: E402
+
+GLB_HEADER_FMT = "<" + "".join(fmt for _, fmt in golden_check.GLB_HEADER)
+GLB_V2_FMT = "<" + "".join(fmt for _, fmt in golden_check.GLB_RECORD)
+
+
+def glb_record(entity_id=7, obj_type=b"Car", location=(1.0, 2.0, 3.0), alpha=0.5, tow_link=None):
+    values = []
+    for name, fmt in golden_check.GLB_RECORD:
+        count = int(fmt[:-1]) if fmt[:-1] and fmt[-1] != "s" else 1
+        if name == "entityID":
+            values.append(entity_id)
+        elif name == "objType":
+            values.append(obj_type)
+        elif name == "modelString":
+            values.append(b"adder")
+        elif name == "location":
+            values.extend(location)
+        elif name == "alpha":
+            values.append(alpha)
+        elif name == "towLink":
+            values.append(-1 if tow_link is None else tow_link)
+        else:
+            values.extend([0.25 if fmt[-1] == "f" else 1] * count)
+    return struct.pack(GLB_V2_FMT, *values)
+
+
+def glb_file(records, version=2):
+    """Version 1 files keep the first 232 bytes of each record (no towLink)"""
+    size = golden_check.GLB_V1_RECORD_SIZE if version == 1 else struct.calcsize(GLB_V2_FMT)
+    header = struct.pack(GLB_HEADER_FMT, golden_check.GLB_MAGIC, version, size, len(records),
+                         3, 0, 12, 160.0, 5.0, 0.0, 320, 180)
+    return header + b"".join(r[:size] for r in records)
+
+
+def png_palette(width, height, indices, palette):
+    """4-bit palette png, rows packed from the high bits"""
+    raw = bytearray()
+    for y in range(height):
+        raw.append(0)
+        row = indices[y * width:(y + 1) * width] + [0]
+        for x in range(0, width, 2):
+            raw.append((row[x] << 4) | row[x + 1])
+
+    def chunk(kind, body):
+        return struct.pack(">I", len(body)) + kind + body + struct.pack(">I", zlib.crc32(kind + body) & 0xFFFFFFFF)
+
+    return (b"\x89PNG\r\n\x1a\n" + chunk(b"IHDR", struct.pack(">IIBBBBB", width, height, 4, 3, 0, 0, 0)) +
+            chunk(b"PLTE", bytes(c for rgb in palette for c in rgb)) + chunk(b"IDAT", zlib.compress(bytes(raw))) +
+            chunk(b"IEND", b""))
+
+
+class GoldenCheckTest(unittest.TestCase):
+    def setUp(self):
+        self.root = tempfile.mkdtemp()
+        self.corpus = os.path.join(self.root, "corpus")
+        self.actual = os.path.join(self.root, "actual")
+
+    def tearDown(self):
+        shutil.rmtree(self.root)
+
+    def write(self, base, rel, data):
+        path = os.path.join(base, rel)
+        os.makedirs(os.path.dirname(path), exist_ok=True)
+        with open(path, "wb") as f:
+            f.write(data if isinstance(data, bytes) else data.encode())
+
+    def expect(self, rel, data):
+        self.write(os.path.join(self.corpus, "expected"), rel, data)
+
+    def produce(self, rel, data):
+        self.write(self.actual, rel, data)
+
+    def check(self, *args, golden=None):
+        if golden is not None:
+            self.write(self.corpus, "golden.json", json.dumps(golden))
+        out = io.StringIO()
+        with contextlib.redirect_stdout(out):
+            result = golden_check.main([self.corpus, self.actual] + list(args))
+        self.output = out.getvalue()
+        return result
+
+    def test_identical_outputs_pass(self):
+        label = "Car 0 0 1.5 10 20 30 40 1.5 1.9 4.6 -3.5 1.66 20.79 1.57\n"
+        self.expect("label_2/000000.txt", label)
+        self.produce("label_2/000000.txt", label)
+        self.assertEqual(self.check(), 0)
+        self.assertIn("label_2", self.output)
+
+    def test_text_floats_within_tolerance_integers_exact(self):
+        self.expect("label_2/000000.txt", "Car 0 0 1.5 10 20 30 40 1.5 1.9 4.6 -3.5 1.66 20.79 1.57\n")
+        self.produce("label_2/000000.txt", "Car 0 0 1.5 10 20 30 40 1.5 1.9 4.6 -3.5 1.66 20.80 1.57\n")
+        self.assertEqual(self.check(), 1)
+        self.assertIn("location", self.output)
+        self.assertEqual(self.check("--tol", "label_2.location=0.02"), 0)
+
+        # Occlusion is an integer, no tolerance applies
+        self.produce("label_2/000000.txt", "Car 0 1 1.5 10 20 30 40 1.5 1.9 4.6 -3.5 1.66 20.79 1.57\n")
+        self.assertEqual(self.check("--default-tol", "10"), 1)
+        self.assertIn("occluded", self.output)
+
+    def test_json_structure(self):
+        self.expect("instSegMasks/000000.json", json.dumps([{"id": 3, "score": 0.5, "counts": "a\\b"}]))
+        self.produce("instSegMasks/000000.json", json.dumps([{"id": 3, "score": 0.50001, "counts": "a\\b"}]))
+        self.assertEqual(self.check(), 0)
+        self.produce("instSegMasks/000000.json", json.dumps([{"id": 4, "score": 0.5, "counts": "a\\b"}]))
+        self.assertEqual(self.check(), 1)
+
+    def test_palette_png_is_compared_as_rgba(self):
+        palette = [(0, 0, 0), (255, 0, 0), (0, 255, 0)]
+        self.assertEqual(golden_check.read_png(png_palette(3, 2, [0, 1, 2, 2, 1, 0], palette))[2][:8],
+                         [0, 0, 0, 255, 255, 0, 0, 255])
+        self.expect("instSeg/000000.png", png_palette(3, 2, [0, 1, 2, 2, 1, 0], palette))
+        self.produce("instSeg/000000.png", png_palette(3, 2, [0, 1, 2, 2, 1, 0], palette))
+        self.assertEqual(self.check(), 0)
+        self.produce("instSeg/000000.png", png_palette(3, 2, [0, 1, 2, 2, 2, 0], palette))
+        self.assertEqual(self.check(), 1)
+        self.assertIn("pixel", self.output)
+
+    def test_point_cloud_columns(self):
+        points = struct.pack("<8f", 1, 2, 3, 1, 4, 5, 6, 0)
+        self.expect("velodyne_entity/000000.bin", points)
+        self.produce("velodyne_entity/000000.bin", struct.pack("<8f", 1, 2, 3.01, 1, 4, 5, 6, 0))
+        self.assertEqual(self.check(), 1)
+        self.assertIn(" z ", self.output)
+        self.assertEqual(self.check(golden={"tolerances": {"z": 0.05}}), 0)
+
+        # One point fewer
+        self.produce("velodyne_entity/000000.bin", points[:16])
+        self.assertEqual(self.check(), 1)
+        self.assertIn("2 points vs 1", self.output)
+
+    def test_glb_fields_by_name(self):
+        self.expect("label_bin/000000.glb", glb_file([glb_record(location=(1.0, 2.0, 3.0))]))
+        self.produce("label_bin/000000.glb", glb_file([glb_record(location=(1.0, 2.0, 3.001))]))
+        self.assertEqual(self.check(), 1)
+        self.assertIn("location", self.output)
+        self.assertNotIn("alpha", self.output)
+        self.assertEqual(self.check("--tol", "location=0.01"), 0)
+
+        # Strings and integers stay exact
+        self.produce("label_bin/000000.glb", glb_file([glb_record(obj_type=b"Truck")]))
+        self.assertEqual(self.check("--default-tol", "10"), 1)
+        self.assertIn("objType", self.output)
+        self.produce("label_bin/000000.glb", glb_file([glb_record(entity_id=8)]))
+        self.assertEqual(self.check("--default-tol", "10"), 1)
+        self.assertIn("entityID", self.output)
+
+        self.produce("label_bin/000000.glb", glb_file([glb_record(), glb_record()]))
+        self.assertEqual(self.check(), 1)
+        self.assertIn("1 records vs 2", self.output)
+
+    def test_glb_version_1_records_are_zero_extended(self):
+        v1 = glb_file([glb_record(tow_link=5)], version=1)
+        header, records = golden_check.read_glb(v1)
+        self.assertEqual(header["recordSize"][0], golden_check.GLB_V1_RECORD_SIZE)
+        self.assertEqual(records[0]["towLink"], (0,))
+        self.assertEqual(records[0]["location"], (1.0, 2.0, 3.0))
+        self.assertEqual(records[0]["objType"], b"Car")
+
+        # A version 2 export with towLink 0 matches the version 1 reference
+        self.expect("label_bin/000000.glb", v1)
+        self.produce("label_bin/000000.glb", glb_file([glb_record(tow_link=0)]))
+        self.assertEqual(self.check(), 0)
+        self.produce("label_bin/000000.glb", glb_file([glb_record(tow_link=5)]))
+        self.assertEqual(self.check(), 1)
+        self.assertIn("towLink", self.output)
+
+    def test_glb_unknown_trailing_fields(self):
+        rec = glb_record()
+        size = len(rec) + 4
+        header = struct.pack(GLB_HEADER_FMT, golden_check.GLB_MAGIC, 3, size, 1, 3, 0, 12, 160.0, 5.0, 0.0, 320, 180)
+        self.expect("label_bin/000000.glb", header + rec + b"\x01\x00\x00\x00")
+        self.produce("label_bin/000000.glb", header + rec + b"\x02\x00\x00\x00")
+        self.assertEqual(self.check(), 1)
+        self.assertIn("unknown fields", self.output)
+
+    def test_gzipped_expected_file(self):
+        points = struct.pack("<4f", 1, 2, 3, 1)
+        self.expect("velodyne_entity/000000.bin.gz", gzip.compress(points))
+        self.produce("velodyne_entity/000000.bin", points)
+        self.assertEqual(self.check(), 0)
+
+    def test_missing_extra_and_ignored_files(self):
+        self.expect("calib/000000.txt", "P0: 1 0 0\n")
+        self.assertEqual(self.check(), 1)
+        self.assertIn("missing calib/000000.txt", self.output)
+
+        self.produce("calib/000000.txt", "P0: 1 0 0\n")
+        self.produce("depth/000000.bin", b"\0" * 8)
+        self.assertEqual(self.check(), 1)
+        self.assertIn("not in the corpus", self.output)
+        self.assertEqual(self.check("--ignore", "depth"), 0)
+        self.assertEqual(self.check(golden={"ignore": ["depth"]}), 0)
+
+
+if __name__ == "__main__":
+    unittest.main()